@@ -0,0 +1,425 @@
+/**
+ * @file bench.c
+ * @brief Benchmarks do banco, do sorteio e do ranking ("make bench" gera o executável).
+ *
+ * Para cada tamanho de banco pedido (padrão: 1k, 100k e 1M itens), gera um CSV
+ * sintético em um diretório temporário e mede:
+ *
+ * - leArquivoCSV, salvarItensBinario e carregarItensBinario (operação inteira,
+ *   repetida algumas vezes);
+ * - buscarItemPorResposta com respostas existentes e inexistentes (a busca de
+ *   pesquisaItem), obterItemAleatorio, copiarDica com as dicas em texto e
+ *   compactadas (codificarDicasBanco, uma vez, entre as duas),
+ *   construirIndiceDicas e consultarIndiceDicas (um termo raro, E com um termo
+ *   raro e OU entre termos de todos os itens), removerItemBanco (o que
+ *   excluirItem faz, incluindo as compactações que ele dispara e a
+ *   atualização do índice das dicas) e salvarRanking (uma amostra por chamada).
+ *
+ * Cada linha do resultado traz a mediana e o p99 das amostras, o tempo total e
+ * os bytes pedidos a malloc/calloc/realloc durante as operações medidas (na
+ * glibc, o bench intercepta essas funções; -1 em outras bibliotecas C). A saída vai para a saída padrão em CSV (padrão) ou
+ * JSON; as mensagens das funções medidas são descartadas.
+ *
+ * Uso: bench [--tamanhos 1000,100000,1000000] [--repeticoes N] [--formato csv|json] [--semente N]
+ *
+ * @date 2025-11-26
+ */
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "funcoes.h"
+
+#define MAX_TAMANHOS_BENCH 16
+#define MAX_AMOSTRAS_MICRO 200000       // Operações medidas uma a uma por benchmark
+#define MAX_AMOSTRAS_RANKING 100000
+#define PERCENTUAL_REMOVIDOS 30         // Acima de PERCENTUAL_COMPACTACAO: inclui compactações (até MAX_AMOSTRAS_MICRO remoções)
+
+/**
+ * @brief Amostras (em nanossegundos) de um benchmark.
+ */
+typedef struct{
+    uint64_t *valores;
+    size_t total;
+    long long bytesAlocados;    // Soma das operações medidas (-1 se não há contagem)
+}AmostrasBench;
+
+static FILE* saidaResultados;           // Saída padrão original (stdout vai para o nulo)
+static int formatoJson = 0;
+static int resultadosEscritos = 0;
+
+static uint64_t nanossegundosAgora(void){
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    return (uint64_t)agora.tv_sec * 1000000000ULL + (uint64_t)agora.tv_nsec;
+}
+
+#ifdef __GLIBC__
+/*
+ * Contagem de alocações: o executável define malloc, calloc e realloc, que
+ * somam o tamanho pedido e repassam às versões internas da glibc. Inclui as
+ * alocações da própria biblioteca C (fopen, por exemplo).
+ */
+extern void* __libc_malloc(size_t tamanho);
+extern void* __libc_calloc(size_t quantidade, size_t tamanho);
+extern void* __libc_realloc(void* ponteiro, size_t tamanho);
+
+static unsigned long long bytesPedidos = 0;
+
+void* malloc(size_t tamanho){
+    __atomic_add_fetch(&bytesPedidos, tamanho, __ATOMIC_RELAXED);
+    return __libc_malloc(tamanho);
+}
+
+void* calloc(size_t quantidade, size_t tamanho){
+    __atomic_add_fetch(&bytesPedidos, quantidade * tamanho, __ATOMIC_RELAXED);
+    return __libc_calloc(quantidade, tamanho);
+}
+
+void* realloc(void* ponteiro, size_t tamanho){
+    __atomic_add_fetch(&bytesPedidos, tamanho, __ATOMIC_RELAXED);
+    return __libc_realloc(ponteiro, tamanho);
+}
+#endif
+
+/**
+ * @brief Total de bytes pedidos ao alocador até agora (-1 se não há contagem).
+ */
+static long long bytesAlocadosAteAgora(void){
+#ifdef __GLIBC__
+    return (long long)__atomic_load_n(&bytesPedidos, __ATOMIC_RELAXED);
+#else
+    return -1;
+#endif
+}
+
+static int compararAmostras(const void* a, const void* b){
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Ordena as amostras e escreve uma linha (CSV) ou um objeto (JSON) do resultado.
+ */
+static void escreverResultado(const char* nome, int itens, AmostrasBench* amostras){
+    if (amostras->total == 0) return;
+    qsort(amostras->valores, amostras->total, sizeof(uint64_t), compararAmostras);
+    uint64_t total = 0;
+    for (size_t i = 0; i < amostras->total; i++) total += amostras->valores[i];
+    uint64_t mediana = amostras->valores[(amostras->total - 1) / 2];
+    uint64_t p99 = amostras->valores[(amostras->total * 99 + 99) / 100 - 1];  // Posição mais próxima
+
+    if (formatoJson){
+        fprintf(saidaResultados, "%s\n  {\"benchmark\": \"%s\", \"itens\": %d, \"amostras\": %zu, \"mediana_ns\": %llu, "
+                "\"p99_ns\": %llu, \"total_ns\": %llu, \"bytes_alocados\": %lld}",
+                resultadosEscritos ? "," : "", nome, itens, amostras->total, (unsigned long long)mediana,
+                (unsigned long long)p99, (unsigned long long)total, amostras->bytesAlocados);
+    } else {
+        fprintf(saidaResultados, "%s,%d,%zu,%llu,%llu,%llu,%lld\n", nome, itens, amostras->total,
+                (unsigned long long)mediana, (unsigned long long)p99, (unsigned long long)total, amostras->bytesAlocados);
+    }
+    fflush(saidaResultados);
+    resultadosEscritos++;
+    amostras->total = 0;
+}
+
+/**
+ * @brief Gera o CSV sintético de 'itens' linhas em ARQUIVO_CSV (diretório atual).
+ *
+ * As respostas são únicas ("item <n> <sufixo>"), os níveis e as categorias
+ * (uma por sufixo, em outra ordem) uniformes e as dicas curtas, com tamanhos variados; tudo derivado da semente.
+ */
+static int gerarCSVBench(int itens, uint64_t semente){
+    FILE* arquivo = fopen(ARQUIVO_CSV, "w");
+    if (arquivo == NULL) return -1;
+    static const char* sufixos[] = {"alfa", "beta", "gama", "delta", "epsilon", "zeta", "teta", "lambda"};
+    GeradorAleatorio gerador;
+    iniciarGerador(&gerador, semente);
+    fprintf(arquivo, "Resposta;Nivel;Categoria;Dica1;Dica2;Dica3;Dica4;Dica5\n");
+    for (int i = 0; i < itens; i++){
+        fprintf(arquivo, "item %d %s;%u", i, sufixos[aleatorioAte(&gerador, 8)], 1 + aleatorioAte(&gerador, NUM_NIVEIS));
+        fprintf(arquivo, ";%s", sufixos[7 - aleatorioAte(&gerador, 8)]);
+        for (int d = 1; d <= MAX_DICAS; d++){
+            fprintf(arquivo, ";dica %d do item %d%.*s", d, i, (int)aleatorioAte(&gerador, 24), "........................");
+        }
+        fputc('\n', arquivo);
+    }
+    return fclose(arquivo);
+}
+
+/**
+ * @brief Roda todos os benchmarks para um banco de 'itens' itens.
+ */
+static int medirTamanho(int itens, int repeticoes, uint64_t semente, AmostrasBench* amostras){
+    if (gerarCSVBench(itens, semente) != 0){
+        fprintf(stderr, "[Erro] Não foi possível gerar o CSV de %d itens.\n", itens);
+        return -1;
+    }
+    GeradorAleatorio gerador;
+    iniciarGerador(&gerador, semente ^ (uint64_t)itens);
+    size_t operacoes = (size_t)itens < MAX_AMOSTRAS_MICRO ? (size_t)itens : MAX_AMOSTRAS_MICRO;
+
+    // leArquivoCSV: o banco da última repetição segue para os outros benchmarks
+    BancoInformacoes* banco = NULL;
+    long long antes = bytesAlocadosAteAgora();
+    for (int r = 0; r < repeticoes; r++){
+        liberarBanco(banco);
+        banco = inicializarBanco();
+        uint64_t inicio = nanossegundosAgora();
+        leArquivoCSV(banco);
+        amostras->valores[amostras->total++] = nanossegundosAgora() - inicio;
+    }
+    amostras->bytesAlocados = antes < 0 ? -1 : bytesAlocadosAteAgora() - antes;
+    escreverResultado("leArquivoCSV", itens, amostras);
+
+    // Busca por resposta, como em pesquisaItem (o índice é construído antes)
+    construirIndiceRespostas(banco);
+    antes = bytesAlocadosAteAgora();
+    for (size_t i = 0; i < operacoes; i++){
+        const char* resposta = obterResposta(banco, &banco->itens[aleatorioAte(&gerador, (uint32_t)banco->totalItens)]);
+        uint64_t inicio = nanossegundosAgora();
+        int posicao = buscarItemPorResposta(banco, resposta);
+        amostras->valores[amostras->total++] = nanossegundosAgora() - inicio;
+        if (posicao < 0) fprintf(stderr, "[Aviso] Resposta não encontrada: '%s'.\n", resposta);
+    }
+    amostras->bytesAlocados = antes < 0 ? -1 : bytesAlocadosAteAgora() - antes;
+    escreverResultado("buscarItemPorResposta_acerto", itens, amostras);
+
+    // O snprintf também aloca; só as buscas entram na contagem
+    char inexistente[TAM_MAX_RESPOSTA];
+    amostras->bytesAlocados = antes < 0 ? -1 : 0;
+    for (size_t i = 0; i < operacoes; i++){
+        snprintf(inexistente, sizeof(inexistente), "ausente %u", aleatorioAte(&gerador, (uint32_t)itens));
+        antes = bytesAlocadosAteAgora();
+        uint64_t inicio = nanossegundosAgora();
+        buscarItemPorResposta(banco, inexistente);
+        amostras->valores[amostras->total++] = nanossegundosAgora() - inicio;
+        if (antes >= 0) amostras->bytesAlocados += bytesAlocadosAteAgora() - antes;
+    }
+    escreverResultado("buscarItemPorResposta_falha", itens, amostras);
+
+    antes = bytesAlocadosAteAgora();
+    for (size_t i = 0; i < operacoes; i++){
+        uint64_t inicio = nanossegundosAgora();
+        obterItemAleatorio(banco);
+        amostras->valores[amostras->total++] = nanossegundosAgora() - inicio;
+    }
+    amostras->bytesAlocados = antes < 0 ? -1 : bytesAlocadosAteAgora() - antes;
+    escreverResultado("obterItemAleatorio", itens, amostras);
+
+    // criarSorteador mais uma rodada: o banco todo ou uma categoria nos níveis 4-5
+    // (fatias do índice por categoria e nível, sem varrer o banco)
+    const char* nomesSorteador[2] = {"criarSorteador_todas", "criarSorteador_categoria"};
+    int categoriaBench = buscarCategoria(banco, "lambda");
+    for (int filtrado = 0; filtrado <= 1; filtrado++){
+        antes = bytesAlocadosAteAgora();
+        for (int r = 0; r < repeticoes; r++){
+            uint64_t inicio = nanossegundosAgora();
+            SorteadorItens* sorteador = criarSorteador(banco, filtrado ? categoriaBench : CATEGORIA_TODAS, semente);
+            if (sorteador != NULL) sortearItem(sorteador, filtrado ? DIFICIL : MUITOFACIL, MUITODIFICIL);
+            amostras->valores[amostras->total++] = nanossegundosAgora() - inicio;
+            liberarSorteador(sorteador);
+        }
+        amostras->bytesAlocados = antes < 0 ? -1 : bytesAlocadosAteAgora() - antes;
+        escreverResultado(nomesSorteador[filtrado], itens, amostras);
+    }
+
+    // Índice das dicas: construção (repetida) e consultas com limite de 20 itens. O
+    // número do item só aparece nas dicas dele ("dica 3 do item 42"); "dica" e "item"
+    // estão em todos. O índice fica para removerItemBanco, como no menu.
+    antes = bytesAlocadosAteAgora();
+    for (int r = 0; r < repeticoes; r++){
+        uint64_t inicio = nanossegundosAgora();
+        construirIndiceDicas(banco, 0);
+        amostras->valores[amostras->total++] = nanossegundosAgora() - inicio;
+    }
+    amostras->bytesAlocados = antes < 0 ? -1 : bytesAlocadosAteAgora() - antes;
+    escreverResultado("construirIndiceDicas", itens, amostras);
+
+    const char* nomesConsulta[3] = {"consultarIndiceDicas_raro", "consultarIndiceDicas_e", "consultarIndiceDicas_ou"};
+    for (int tipo = 0; tipo < 3 && itens > 10; tipo++){
+        // A consulta OU percorre as listas inteiras: poucas amostras
+        size_t consultas = (tipo == 2) ? (size_t)repeticoes : operacoes;
+        char consulta[64];
+        amostras->bytesAlocados = antes < 0 ? -1 : 0;
+        for (size_t i = 0; i < consultas; i++){
+            unsigned numero = 10 + aleatorioAte(&gerador, (uint32_t)itens - 10);
+            if (tipo == 0) snprintf(consulta, sizeof(consulta), "%u", numero);
+            else if (tipo == 1) snprintf(consulta, sizeof(consulta), "item %u", numero);
+            else snprintf(consulta, sizeof(consulta), "dica item");
+            ResultadoConsultaDicas resultado;
+            antes = bytesAlocadosAteAgora();
+            uint64_t inicio = nanossegundosAgora();
+            consultarIndiceDicas(banco, consulta, tipo == 2, 20, &resultado);
+            liberarConsultaDicas(&resultado);
+            amostras->valores[amostras->total++] = nanossegundosAgora() - inicio;
+            if (antes >= 0) amostras->bytesAlocados += bytesAlocadosAteAgora() - antes;
+        }
+        escreverResultado(nomesConsulta[tipo], itens, amostras);
+    }
+
+    // salvarItensBinario e carregarItensBinario (snapshot em ARQUIVO_BINARIO)
+    antes = bytesAlocadosAteAgora();
+    for (int r = 0; r < repeticoes; r++){
+        uint64_t inicio = nanossegundosAgora();
+        salvarItensBinario(banco);
+        amostras->valores[amostras->total++] = nanossegundosAgora() - inicio;
+    }
+    amostras->bytesAlocados = antes < 0 ? -1 : bytesAlocadosAteAgora() - antes;
+    escreverResultado("salvarItensBinario", itens, amostras);
+
+    antes = bytesAlocadosAteAgora();
+    for (int r = 0; r < repeticoes; r++){
+        uint64_t inicio = nanossegundosAgora();
+        BancoInformacoes* carregado = carregarItensBinario(ARQUIVO_BINARIO);
+        amostras->valores[amostras->total++] = nanossegundosAgora() - inicio;
+        if (carregado == NULL || carregado->totalItens != banco->totalItens){
+            fprintf(stderr, "[Aviso] O snapshot de %d itens não foi relido por inteiro.\n", itens);
+        }
+        liberarBanco(carregado);
+    }
+    amostras->bytesAlocados = antes < 0 ? -1 : bytesAlocadosAteAgora() - antes;
+    escreverResultado("carregarItensBinario", itens, amostras);
+
+    // copiarDica (uma dica ao acaso por chamada), antes e depois de compactar as dicas
+    char dica[TAM_MAX_DICA];
+    const char* nomesDica[2] = {"copiarDica_texto", "copiarDica_compactada"};
+    for (int compactada = 0; compactada <= 1; compactada++){
+        if (compactada){
+            antes = bytesAlocadosAteAgora();
+            uint64_t inicio = nanossegundosAgora();
+            codificarDicasBanco(banco);
+            amostras->valores[amostras->total++] = nanossegundosAgora() - inicio;
+            amostras->bytesAlocados = antes < 0 ? -1 : bytesAlocadosAteAgora() - antes;
+            escreverResultado("codificarDicasBanco", itens, amostras);
+        }
+        antes = bytesAlocadosAteAgora();
+        for (size_t i = 0; i < operacoes; i++){
+            const Item* item = &banco->itens[aleatorioAte(&gerador, (uint32_t)banco->totalItens)];
+            int numeroDica = 1 + (int)aleatorioAte(&gerador, MAX_DICAS);
+            uint64_t inicio = nanossegundosAgora();
+            copiarDica(banco, item, numeroDica, dica, sizeof(dica));
+            amostras->valores[amostras->total++] = nanossegundosAgora() - inicio;
+        }
+        amostras->bytesAlocados = antes < 0 ? -1 : bytesAlocadosAteAgora() - antes;
+        escreverResultado(nomesDica[compactada], itens, amostras);
+    }
+
+    // removerItemBanco (o que excluirItem faz), em ordem aleatória de ids; as
+    // posições mudam a cada compactação, então cada id é localizado antes
+    size_t remocoes = (size_t)itens * PERCENTUAL_REMOVIDOS / 100;
+    if (remocoes > MAX_AMOSTRAS_MICRO) remocoes = MAX_AMOSTRAS_MICRO;
+    uint32_t* ids = malloc((size_t)banco->totalItens * sizeof(uint32_t));
+    if (ids != NULL){
+        for (int i = 0; i < banco->totalItens; i++) ids[i] = banco->itens[i].id;
+        for (int i = banco->totalItens - 1; i > 0; i--){
+            uint32_t j = aleatorioAte(&gerador, (uint32_t)i + 1);
+            uint32_t troca = ids[i]; ids[i] = ids[j]; ids[j] = troca;
+        }
+        antes = bytesAlocadosAteAgora();
+        for (size_t i = 0; i < remocoes; i++){
+            int posicao = buscarItemPorId(banco, ids[i]);
+            uint64_t inicio = nanossegundosAgora();
+            removerItemBanco(banco, posicao);
+            amostras->valores[amostras->total++] = nanossegundosAgora() - inicio;
+        }
+        amostras->bytesAlocados = antes < 0 ? -1 : bytesAlocadosAteAgora() - antes;
+        free(ids);
+        escreverResultado("removerItemBanco", itens, amostras);
+    }
+    liberarBanco(banco);
+
+    // salvarRanking, partindo de um ranking vazio
+    encerrarRanking();
+    remove(ARQUIVO_RANKING);
+    size_t pontuacoes = (size_t)itens < MAX_AMOSTRAS_RANKING ? (size_t)itens : MAX_AMOSTRAS_RANKING;
+    char nome[TAM_MAX_NOME];
+    antes = bytesAlocadosAteAgora();
+    for (size_t i = 0; i < pontuacoes; i++){
+        snprintf(nome, sizeof(nome), "jogador%zu", i);
+        int pontos = (int)aleatorioAte(&gerador, 1000);
+        uint64_t inicio = nanossegundosAgora();
+        salvarRanking(nome, pontos);
+        amostras->valores[amostras->total++] = nanossegundosAgora() - inicio;
+    }
+    amostras->bytesAlocados = antes < 0 ? -1 : bytesAlocadosAteAgora() - antes;
+    escreverResultado("salvarRanking", itens, amostras);
+    encerrarRanking();
+    return 0;
+}
+
+/**
+ * @brief Apaga os arquivos que os benchmarks criam no diretório temporário.
+ */
+static void limparDiretorio(void){
+    const char* arquivos[] = {ARQUIVO_CSV, ARQUIVO_BINARIO, ARQUIVO_BINARIO ".tmp", ARQUIVO_DIARIO,
+                              ARQUIVO_RANKING, ARQUIVO_RANKING ".lock", ARQUIVO_RANKING ".tmp"};
+    for (size_t i = 0; i < sizeof(arquivos) / sizeof(arquivos[0]); i++) remove(arquivos[i]);
+}
+
+int main(int argc, char* argv[]){
+    int tamanhos[MAX_TAMANHOS_BENCH] = {1000, 100000, 1000000};
+    int numeroTamanhos = 3;
+    int repeticoes = 0;                 // 0: depende do tamanho
+    uint64_t semente = 42;
+
+    for (int i = 1; i < argc; i++){
+        int temValor = i + 1 < argc;
+        if (strcmp(argv[i], "--tamanhos") == 0 && temValor){
+            numeroTamanhos = 0;
+            char* contexto = NULL;
+            for (char* parte = strtok_r(argv[++i], ",", &contexto); parte != NULL && numeroTamanhos < MAX_TAMANHOS_BENCH;
+                 parte = strtok_r(NULL, ",", &contexto)){
+                tamanhos[numeroTamanhos++] = atoi(parte);
+            }
+        } else if (strcmp(argv[i], "--repeticoes") == 0 && temValor){
+            // Cada repetição é uma amostra: não passa do vetor de MAX_AMOSTRAS_MICRO
+            repeticoes = atoi(argv[++i]);
+            if (repeticoes > MAX_AMOSTRAS_MICRO) repeticoes = MAX_AMOSTRAS_MICRO;
+        } else if (strcmp(argv[i], "--formato") == 0 && temValor){
+            formatoJson = strcmp(argv[++i], "json") == 0;
+        } else if (strcmp(argv[i], "--semente") == 0 && temValor){
+            semente = strtoull(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "Uso: bench [--tamanhos 1000,100000,1000000] [--repeticoes N] [--formato csv|json] [--semente N]\n");
+            return 1;
+        }
+    }
+
+    // Diretório temporário próprio: as funções medidas usam os nomes fixos de arquivo
+    char diretorio[] = "/tmp/perfil-bench-XXXXXX";
+    if (mkdtemp(diretorio) == NULL || chdir(diretorio) != 0){
+        fprintf(stderr, "[Erro] Não foi possível criar o diretório temporário.\n");
+        return 1;
+    }
+    // Os resultados vão para a saída original; as mensagens das funções medidas, para o nulo
+    fflush(stdout);
+    saidaResultados = fdopen(dup(STDOUT_FILENO), "w");
+    if (saidaResultados == NULL || freopen("/dev/null", "w", stdout) == NULL){
+        fprintf(stderr, "[Erro] Não foi possível redirecionar a saída.\n");
+        return 1;
+    }
+    setenv("PERFIL_SEMENTE", "1", 1);   // obterItemAleatorio reproduzível
+
+    AmostrasBench amostras = {NULL, 0, 0};
+    amostras.valores = malloc(MAX_AMOSTRAS_MICRO * sizeof(uint64_t));
+    if (amostras.valores == NULL) return 1;
+    if (formatoJson) fprintf(saidaResultados, "[");
+    else fprintf(saidaResultados, "benchmark,itens,amostras,mediana_ns,p99_ns,total_ns,bytes_alocados\n");
+
+    int codigo = 0;
+    for (int t = 0; t < numeroTamanhos; t++){
+        if (tamanhos[t] < 1) continue;
+        int repeticoesTamanho = repeticoes > 0 ? repeticoes : (tamanhos[t] <= 10000 ? 20 : (tamanhos[t] <= 100000 ? 5 : 3));
+        if (medirTamanho(tamanhos[t], repeticoesTamanho, semente, &amostras) != 0) codigo = 1;
+        limparDiretorio();
+    }
+    if (formatoJson) fprintf(saidaResultados, "\n]\n");
+    fclose(saidaResultados);
+    free(amostras.valores);
+    if (chdir("/") == 0) rmdir(diretorio);
+    return codigo;
+}
@@ -0,0 +1,495 @@
+/**
+ * @file busca.c
+ * @brief Busca de um texto em todas as dicas do banco ("quais itens mencionam X?").
+ *
+ * A busca por trecho de texto não usa índice: cada consulta varre as dicas de
+ * todos os itens, o que acha também pedaços de palavras e expressões com
+ * pontuação. Buscas por palavras inteiras, com os itens ordenados por
+ * relevância, usam o índice invertido de indice.c (pesquisarPalavrasChave()
+ * e "jogo buscar --palavras"). A varredura é limitada pela banda de memória:
+ *
+ * - os itens são repartidos em faixas contíguas, uma por thread, e as
+ *   ocorrências de cada faixa são juntadas na ordem dos itens;
+ * - a comparação ignora maiúsculas/minúsculas (ASCII) e usa SIMD: para cada
+ *   bloco de 16 (SSE2) ou 32 (AVX2) posições, compara de uma vez o primeiro e
+ *   o último caractere do texto procurado e só confirma o meio nas posições
+ *   em que os dois batem. AVX2 é escolhido na hora, se o processador tiver;
+ *   fora do x86 (ou com PERFIL_SIMD=escalar) a versão escalar é usada.
+ *
+ * Os blocos nunca leem além do fim da dica; o final de cada dica é tratado
+ * pela versão escalar.
+ *
+ * @date 2025-11-26
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "funcoes.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define BUSCA_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#define MAX_THREADS_BUSCA 64
+#define MIN_ITENS_POR_THREAD_BUSCA 16384
+#define LIMITE_PADRAO_BUSCA 20          // Ocorrências mostradas por padrão
+
+/**
+ * @brief Procura 'padrao' (já em minúsculas, tamPadrao >= 1) em 'texto'. Retorna 1 se achar.
+ */
+typedef int (*FuncaoBusca)(const char* texto, size_t tam, const char* padrao, size_t tamPadrao);
+
+static unsigned char minuscula(unsigned char c){
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c - 'A' + 'a') : c;
+}
+
+/**
+ * @brief Compara 'tam' bytes ignorando maiúsculas no texto (o padrão já está em minúsculas).
+ */
+static int iguaisSemCaixa(const char* texto, const char* padrao, size_t tam){
+    for (size_t k = 0; k < tam; k++){
+        if (minuscula((unsigned char)texto[k]) != (unsigned char)padrao[k]) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Busca escalar a partir da posição 'inicio' (final das versões SIMD e fallback).
+ */
+static int buscarEscalarDesde(const char* texto, size_t tam, const char* padrao, size_t tamPadrao, size_t inicio){
+    if (tamPadrao > tam) return 0;
+    unsigned char primeiro = (unsigned char)padrao[0];
+    for (size_t i = inicio; i + tamPadrao <= tam; i++){
+        if (minuscula((unsigned char)texto[i]) == primeiro && iguaisSemCaixa(texto + i + 1, padrao + 1, tamPadrao - 1)){
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int buscarEscalar(const char* texto, size_t tam, const char* padrao, size_t tamPadrao){
+    return buscarEscalarDesde(texto, tam, padrao, tamPadrao, 0);
+}
+
+#ifdef BUSCA_SIMD_X86
+/**
+ * @brief Converte 'A'..'Z' em minúsculas nos 16 bytes (os demais ficam iguais).
+ *
+ * Subtrair 'A' + 128 leva 'A'..'Z' para -128..-103 (com sinal), os únicos
+ * valores menores que -102.
+ */
+static inline __m128i minusculas16(__m128i v){
+    __m128i deslocado = _mm_sub_epi8(v, _mm_set1_epi8((char)('A' + 128)));
+    __m128i maiusculas = _mm_cmplt_epi8(deslocado, _mm_set1_epi8(-128 + 26));
+    return _mm_or_si128(v, _mm_and_si128(maiusculas, _mm_set1_epi8(0x20)));
+}
+
+static int buscarSSE2(const char* texto, size_t tam, const char* padrao, size_t tamPadrao){
+    if (tamPadrao > tam) return 0;
+    const __m128i primeiro = _mm_set1_epi8(padrao[0]);
+    const __m128i ultimo = _mm_set1_epi8(padrao[tamPadrao - 1]);
+    size_t i = 0;
+    for (; i + tamPadrao - 1 + 16 <= tam; i += 16){
+        __m128i blocoInicio = minusculas16(_mm_loadu_si128((const __m128i*)(texto + i)));
+        __m128i blocoFim = minusculas16(_mm_loadu_si128((const __m128i*)(texto + i + tamPadrao - 1)));
+        unsigned candidatos = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blocoInicio, primeiro),
+                                                                         _mm_cmpeq_epi8(blocoFim, ultimo)));
+        while (candidatos != 0){
+            size_t posicao = i + (size_t)__builtin_ctz(candidatos);
+            if (tamPadrao <= 2 || iguaisSemCaixa(texto + posicao + 1, padrao + 1, tamPadrao - 2)) return 1;
+            candidatos &= candidatos - 1;
+        }
+    }
+    return buscarEscalarDesde(texto, tam, padrao, tamPadrao, i);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i minusculas32(__m256i v){
+    __m256i deslocado = _mm256_sub_epi8(v, _mm256_set1_epi8((char)('A' + 128)));
+    __m256i maiusculas = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), deslocado);
+    return _mm256_or_si256(v, _mm256_and_si256(maiusculas, _mm256_set1_epi8(0x20)));
+}
+
+__attribute__((target("avx2")))
+static int buscarAVX2(const char* texto, size_t tam, const char* padrao, size_t tamPadrao){
+    if (tamPadrao > tam) return 0;
+    const __m256i primeiro = _mm256_set1_epi8(padrao[0]);
+    const __m256i ultimo = _mm256_set1_epi8(padrao[tamPadrao - 1]);
+    size_t i = 0;
+    for (; i + tamPadrao - 1 + 32 <= tam; i += 32){
+        __m256i blocoInicio = minusculas32(_mm256_loadu_si256((const __m256i*)(texto + i)));
+        __m256i blocoFim = minusculas32(_mm256_loadu_si256((const __m256i*)(texto + i + tamPadrao - 1)));
+        unsigned candidatos = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blocoInicio, primeiro),
+                                                                              _mm256_cmpeq_epi8(blocoFim, ultimo)));
+        while (candidatos != 0){
+            size_t posicao = i + (size_t)__builtin_ctz(candidatos);
+            if (tamPadrao <= 2 || iguaisSemCaixa(texto + posicao + 1, padrao + 1, tamPadrao - 2)) return 1;
+            candidatos &= candidatos - 1;
+        }
+    }
+    // Menos de 32 posições: o restante cabe em blocos de 16. O GCC encadeia a
+    // chamada como salto sem vzeroupper, e o código SSE2 pagaria a transição.
+    _mm256_zeroupper();
+    return buscarSSE2(texto + i, tam - i, padrao, tamPadrao);
+}
+#endif
+
+/**
+ * @brief Escolhe a versão da busca: a melhor disponível, ou a de PERFIL_SIMD (escalar, sse2, avx2).
+ *
+ * @param nome Saída: nome da versão escolhida.
+ */
+static FuncaoBusca escolherFuncaoBusca(const char** nome){
+    const char* pedido = getenv("PERFIL_SIMD");
+    if (pedido == NULL) pedido = "";
+#ifdef BUSCA_SIMD_X86
+    if (strcmp(pedido, "escalar") != 0 && strcmp(pedido, "sse2") != 0 && __builtin_cpu_supports("avx2")){
+        *nome = "avx2";
+        return buscarAVX2;
+    }
+    if (strcmp(pedido, "escalar") != 0){
+        *nome = "sse2";
+        return buscarSSE2;
+    }
+#endif
+    *nome = "escalar";
+    return buscarEscalar;
+}
+
+/**
+ * @brief Faixa de itens varrida por uma thread, com as suas ocorrências.
+ */
+typedef struct{
+    const BancoInformacoes* banco;
+    const char* padrao;
+    size_t tamPadrao;
+    FuncaoBusca buscar;
+    int inicio;
+    int fim;
+    OcorrenciaDica* ocorrencias;
+    long total;
+    long capacidade;
+    uint64_t bytesLidos;
+    int falhou;
+}FatiaBusca;
+
+static void* varrerFatiaBusca(void* argumento){
+    FatiaBusca* fatia = (FatiaBusca*)argumento;
+    const BancoInformacoes* banco = fatia->banco;
+    const char* textos = banco->textos.dados;
+    char dica[TAM_MAX_DICA];
+    for (int i = fatia->inicio; i < fatia->fim; i++){
+        if (banco->itens[i].marcas & ITEM_EXCLUIDO) continue;
+        const DicasItem* dicas = &banco->dicas[i];
+        int codificadas = (banco->itens[i].marcas & ITEM_DICAS_CODIFICADAS) != 0;
+        for (int d = 0; d < MAX_DICAS; d++){
+            // Dicas compactadas são decodificadas uma a uma antes da varredura
+            const char* texto = textos + dicas->dica[d];
+            size_t tam = dicas->tamDica[d];
+            if (codificadas){
+                tam = copiarDica(banco, &banco->itens[i], d + 1, dica, sizeof(dica));
+                texto = dica;
+            }
+            fatia->bytesLidos += tam;
+            if (!fatia->buscar(texto, tam, fatia->padrao, fatia->tamPadrao)) continue;
+            if (fatia->total == fatia->capacidade){
+                long novaCapacidade = fatia->capacidade ? fatia->capacidade * 2 : 64;
+                OcorrenciaDica* novas = realloc(fatia->ocorrencias, (size_t)novaCapacidade * sizeof(OcorrenciaDica));
+                if (novas == NULL){
+                    fatia->falhou = 1;
+                    return NULL;
+                }
+                fatia->ocorrencias = novas;
+                fatia->capacidade = novaCapacidade;
+            }
+            fatia->ocorrencias[fatia->total].posicao = i;
+            fatia->ocorrencias[fatia->total].numeroDica = d + 1;
+            fatia->total++;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Procura um texto em todas as dicas do banco, em paralelo.
+ *
+ * @param banco Banco a ser varrido (não é alterado).
+ * @param texto Texto procurado; maiúsculas/minúsculas ASCII são ignoradas.
+ * @param threads Número de threads (0 = uma por núcleo); bancos pequenos usam menos.
+ * @param resultado Saída: ocorrências na ordem dos itens e das dicas. Liberar
+ * com liberarResultadoBusca().
+ * @return int 0 em caso de sucesso, -1 se o texto for vazio ou faltar memória.
+ */
+int buscarTextoNasDicas(const BancoInformacoes* banco, const char* texto, int threads, ResultadoBuscaDicas* resultado){
+    memset(resultado, 0, sizeof(*resultado));
+    size_t tamPadrao = strlen(texto);
+    if (banco == NULL || tamPadrao == 0 || tamPadrao >= TAM_MAX_DICA) return -1;
+    char padrao[TAM_MAX_DICA];
+    for (size_t k = 0; k <= tamPadrao; k++) padrao[k] = (char)minuscula((unsigned char)texto[k]);
+    FuncaoBusca buscar = escolherFuncaoBusca(&resultado->versao);
+
+    if (threads <= 0){
+        threads = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+        threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    }
+    int maximoPorTamanho = banco->totalItens / MIN_ITENS_POR_THREAD_BUSCA;
+    if (threads > maximoPorTamanho) threads = maximoPorTamanho;
+    if (threads > MAX_THREADS_BUSCA) threads = MAX_THREADS_BUSCA;
+    if (threads < 1) threads = 1;
+
+    FatiaBusca fatias[MAX_THREADS_BUSCA];
+    pthread_t idsThreads[MAX_THREADS_BUSCA];
+    int threadCriada[MAX_THREADS_BUSCA] = {0};
+    for (int t = 0; t < threads; t++){
+        memset(&fatias[t], 0, sizeof(fatias[t]));
+        fatias[t].banco = banco;
+        fatias[t].padrao = padrao;
+        fatias[t].tamPadrao = tamPadrao;
+        fatias[t].buscar = buscar;
+        fatias[t].inicio = (int)((int64_t)banco->totalItens * t / threads);
+        fatias[t].fim = (int)((int64_t)banco->totalItens * (t + 1) / threads);
+    }
+    for (int t = 1; t < threads; t++){
+        threadCriada[t] = (pthread_create(&idsThreads[t], NULL, varrerFatiaBusca, &fatias[t]) == 0);
+        if (!threadCriada[t]) varrerFatiaBusca(&fatias[t]);
+    }
+    varrerFatiaBusca(&fatias[0]);
+
+    long total = 0;
+    int falhou = 0;
+    for (int t = 0; t < threads; t++){
+        if (threadCriada[t]) pthread_join(idsThreads[t], NULL);
+        total += fatias[t].total;
+        falhou = falhou || fatias[t].falhou;
+        resultado->bytesLidos += fatias[t].bytesLidos;
+    }
+    resultado->threads = threads;
+    if (!falhou && total > 0){
+        resultado->ocorrencias = malloc((size_t)total * sizeof(OcorrenciaDica));
+        falhou = (resultado->ocorrencias == NULL);
+    }
+    for (int t = 0; t < threads; t++){
+        if (!falhou && fatias[t].total > 0){
+            memcpy(resultado->ocorrencias + resultado->total, fatias[t].ocorrencias,
+                   (size_t)fatias[t].total * sizeof(OcorrenciaDica));
+            resultado->total += fatias[t].total;
+        }
+        free(fatias[t].ocorrencias);
+    }
+    if (falhou){
+        printf("[Erro] Houve um erro na alocação de memória para o resultado da busca.\n");
+        liberarResultadoBusca(resultado);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Libera as ocorrências de uma busca.
+ */
+void liberarResultadoBusca(ResultadoBuscaDicas* resultado){
+    free(resultado->ocorrencias);
+    resultado->ocorrencias = NULL;
+    resultado->total = 0;
+}
+
+/**
+ * @brief Mostra até 'limite' ocorrências (0 = todas) e o resumo da busca.
+ */
+static void mostrarResultadoBusca(const BancoInformacoes* banco, const ResultadoBuscaDicas* resultado,
+                                  long limite, double segundos){
+    long mostrar = (limite > 0 && limite < resultado->total) ? limite : resultado->total;
+    char dica[TAM_MAX_DICA];
+    for (long k = 0; k < mostrar; k++){
+        const Item* item = &banco->itens[resultado->ocorrencias[k].posicao];
+        int numeroDica = resultado->ocorrencias[k].numeroDica;
+        copiarDica(banco, item, numeroDica, dica, sizeof(dica));
+        printf("Item %u (%s), dica %d: %s\n", (unsigned)item->id, obterResposta(banco, item), numeroDica, dica);
+    }
+    if (mostrar < resultado->total){
+        printf("... e mais %ld ocorrência(s).\n", resultado->total - mostrar);
+    }
+    double megabytes = (double)resultado->bytesLidos / (1 << 20);
+    printf("[OK] %ld ocorrência(s); %.1f MiB de dicas lidos em %.1f ms (%.2f GiB/s, %s, %d thread(s)).\n",
+           resultado->total, megabytes, segundos * 1e3, segundos > 0 ? megabytes / 1024 / segundos : 0.0,
+           resultado->versao, resultado->threads);
+}
+
+/**
+ * @brief Opção do menu: lista os itens cujas dicas contêm o texto digitado.
+ *
+ * @param banco Ponteiro para a estrutura BancoInformacoes contendo os itens.
+ */
+void pesquisarDicas(BancoInformacoes* banco){
+    if (banco == NULL || itensAtivos(banco) == 0){
+        printf("[Aviso] O banco de informaçôes está vazio.\n");
+        return;
+    }
+    char texto[TAM_MAX_DICA];
+    printf("Digite o texto a ser procurado nas dicas.\n");
+    lerString(texto, TAM_MAX_DICA);
+
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    ResultadoBuscaDicas resultado;
+    if (buscarTextoNasDicas(banco, texto, 0, &resultado) != 0){
+        printf("[Aviso] Digite um texto para procurar.\n");
+        return;
+    }
+    double segundos = segundosDesde(&inicio);
+    if (resultado.total == 0){
+        printf("[Aviso] Nenhuma dica contém o texto informado.\n");
+    } else {
+        mostrarResultadoBusca(banco, &resultado, LIMITE_PADRAO_BUSCA, segundos);
+    }
+    liberarResultadoBusca(&resultado);
+}
+
+/**
+ * @brief Mostra os itens de uma consulta por palavras e o resumo dela.
+ */
+static void mostrarConsultaDicas(const BancoInformacoes* banco, const ResultadoConsultaDicas* resultado,
+                                 int qualquerTermo, double segundos){
+    for (int k = 0; k < resultado->total; k++){
+        const Item* item = &banco->itens[resultado->itens[k].posicao];
+        printf("Item %u (%s): pontuação %.3f\n", (unsigned)item->id, obterResposta(banco, item),
+               resultado->itens[k].pontuacao);
+    }
+    if (resultado->total < resultado->encontrados){
+        printf("... e mais %ld item(ns).\n", resultado->encontrados - resultado->total);
+    }
+    printf("[OK] %ld item(ns) com %s das %d palavra(s) (%d presente(s) nas dicas), consulta em %.3f ms.\n",
+           resultado->encontrados, qualquerTermo ? "alguma" : "todas", resultado->termos,
+           resultado->termosConhecidos, segundos * 1e3);
+}
+
+/**
+ * @brief Opção do menu: lista os itens cujas dicas têm as palavras digitadas, os mais relevantes primeiro.
+ *
+ * O índice das dicas é construído na primeira pesquisa, se ainda não existir.
+ *
+ * @param banco Ponteiro para a estrutura BancoInformacoes contendo os itens.
+ */
+void pesquisarPalavrasChave(BancoInformacoes* banco){
+    if (banco == NULL || itensAtivos(banco) == 0){
+        printf("[Aviso] O banco de informaçôes está vazio.\n");
+        return;
+    }
+    if (banco->indiceDicas == NULL && construirIndiceDicas(banco, 0) != 0) return;
+
+    char palavras[TAM_MAX_DICA];
+    printf("Digite as palavras a serem procuradas nas dicas.\n");
+    lerString(palavras, TAM_MAX_DICA);
+    printf("Os itens devem ter todas as palavras (e) ou qualquer uma delas (o)? ");
+    char opcao;
+    scanf(" %c", &opcao);
+    setbuf(stdin, NULL);
+    int qualquerTermo = (opcao == 'o' || opcao == 'O');
+
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    ResultadoConsultaDicas resultado;
+    if (consultarIndiceDicas(banco, palavras, qualquerTermo, LIMITE_PADRAO_BUSCA, &resultado) != 0){
+        printf("[Aviso] Digite de 1 a 16 palavras (com pelo menos duas letras) para procurar.\n");
+        return;
+    }
+    double segundos = segundosDesde(&inicio);
+    if (resultado.encontrados == 0){
+        printf("[Aviso] Nenhum item tem nas dicas as palavras informadas.\n");
+    } else {
+        mostrarConsultaDicas(banco, &resultado, qualquerTermo, segundos);
+    }
+    liberarConsultaDicas(&resultado);
+}
+
+/**
+ * @brief Consulta por palavras da linha de comando: constrói o índice e mede a consulta.
+ */
+static int executarConsultaPalavras(BancoInformacoes* banco, const char* palavras, int qualquerTermo,
+                                    int threads, long limite, int repeticoes){
+    if (construirIndiceDicas(banco, threads) != 0) return 1;
+    ResultadoConsultaDicas resultado;
+    double melhor = 0;
+    for (int r = 0; r < repeticoes; r++){
+        if (r > 0) liberarConsultaDicas(&resultado);
+        struct timespec inicio;
+        clock_gettime(CLOCK_MONOTONIC, &inicio);
+        if (consultarIndiceDicas(banco, palavras, qualquerTermo, (int)limite, &resultado) != 0){
+            printf("[Erro] A consulta deve ter de 1 a 16 palavras com pelo menos duas letras.\n");
+            return 1;
+        }
+        double segundos = segundosDesde(&inicio);
+        if (r == 0 || segundos < melhor) melhor = segundos;
+    }
+    mostrarConsultaDicas(banco, &resultado, qualquerTermo, melhor);
+    int codigo = resultado.encontrados > 0 ? 0 : 1;
+    liberarConsultaDicas(&resultado);
+    return codigo;
+}
+
+/**
+ * @brief Busca nas dicas pela linha de comando ("jogo buscar texto [opções]").
+ *
+ * Opções: --threads N (padrão: uma por núcleo), --limite N (ocorrências
+ * mostradas, padrão 20; 0 = todas) e --repeticoes N (repete a varredura e
+ * informa a mais rápida, para medir a banda). Com --palavras, o texto é uma
+ * lista de palavras procuradas no índice das dicas (construído com
+ * --threads), todas ou, com --ou, qualquer uma; os itens saem ordenados por
+ * TF-IDF e --limite diz quantos mostrar.
+ *
+ * @param banco Banco com os itens; só ganha o índice das dicas.
+ * @param argc Quantidade de argumentos.
+ * @param argv Argumentos (sem o nome do programa nem a palavra "buscar").
+ * @return int Código de saída do programa (1 se não houver ocorrências).
+ */
+int executarBusca(BancoInformacoes* banco, int argc, char* argv[]){
+    const char* texto = NULL;
+    int threads = 0;
+    long limite = LIMITE_PADRAO_BUSCA;
+    int repeticoes = 1;
+    int palavras = 0, qualquerTermo = 0;
+    for (int i = 0; i < argc; i++){
+        int temValor = i + 1 < argc;
+        if (strcmp(argv[i], "--palavras") == 0) palavras = 1;
+        else if (strcmp(argv[i], "--ou") == 0) qualquerTermo = 1;
+        else if (strcmp(argv[i], "--threads") == 0 && temValor) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--limite") == 0 && temValor) limite = atol(argv[++i]);
+        else if (strcmp(argv[i], "--repeticoes") == 0 && temValor) repeticoes = atoi(argv[++i]);
+        else if (texto == NULL && strncmp(argv[i], "--", 2) != 0) texto = argv[i];
+        else {
+            printf("[Erro] Opção inválida: '%s'.\n", argv[i]);
+            texto = NULL;
+            break;
+        }
+    }
+    if (texto == NULL || *texto == '\0' || strlen(texto) >= TAM_MAX_DICA || limite < 0 || limite > INT_MAX ||
+        repeticoes < 1 || (qualquerTermo && !palavras)){
+        printf("Uso: jogo buscar texto [--threads N] [--limite N] [--repeticoes N]\n"
+               "     jogo buscar --palavras \"palavra ...\" [--ou] [--threads N] [--limite N] [--repeticoes N]\n");
+        return 1;
+    }
+    if (palavras) return executarConsultaPalavras(banco, texto, qualquerTermo, threads, limite, repeticoes);
+
+    ResultadoBuscaDicas resultado;
+    double melhor = 0;
+    for (int r = 0; r < repeticoes; r++){
+        if (r > 0) liberarResultadoBusca(&resultado);
+        struct timespec inicio;
+        clock_gettime(CLOCK_MONOTONIC, &inicio);
+        if (buscarTextoNasDicas(banco, texto, threads, &resultado) != 0) return 1;
+        double segundos = segundosDesde(&inicio);
+        if (r == 0 || segundos < melhor) melhor = segundos;
+    }
+    mostrarResultadoBusca(banco, &resultado, limite, melhor);
+    int codigo = resultado.total > 0 ? 0 : 1;
+    liberarResultadoBusca(&resultado);
+    return codigo;
+}
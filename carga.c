@@ -0,0 +1,443 @@
+/**
+ * @file carga.c
+ * @brief Cliente de carga do modo servidor: muitas sessões simultâneas de jogadores-robô.
+ *
+ * Iniciado com "jogo carga [opções]", na mesma máquina do "jogo servidor". Abre
+ * várias conexões, repartidas entre algumas threads com um epoll cada, e em
+ * cada uma joga sessões seguidas pelo protocolo descrito em servidor.c: NOVA,
+ * ações sorteadas (RESPONDER, LETRA, DICA, PULAR) até FIM_ITEM, PROXIMO até
+ * completar as rodadas da sessão e, por fim, SAIR.
+ *
+ * Cada conexão tem no máximo um comando em voo; a latência de um turno é o
+ * tempo entre o envio do comando e a chegada da linha vazia que termina a
+ * resposta. Ao final são informadas as sessões por segundo e os percentis
+ * (p50, p90, p99) da latência por turno.
+ *
+ * As ações dos robôs vêm do xoshiro256** (ver sorteio.c): com a mesma semente,
+ * o mesmo servidor e o mesmo banco, cada conexão toma as mesmas decisões.
+ *
+ * @date 2025-11-26
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "funcoes.h"
+
+#ifdef __linux__
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define MAX_THREADS_CARGA 64
+#define TAM_BUFFER_CARGA 4096           // Comporta qualquer bloco de resposta do servidor
+#define ESPERA_CARGA_MS 5000            // Sem resposta por este tempo, a conexão é dada como perdida
+
+/**
+ * @brief Uma conexão do cliente de carga e o jogador-robô que a usa.
+ */
+typedef struct{
+    int descritor;
+    GeradorAleatorio gerador;
+    char entrada[TAM_BUFFER_CARGA];
+    size_t usadoEntrada;
+    char mascara[TAM_MAX_RESPOSTA];     // Última máscara recebida do item em jogo
+    int rodadasFeitas;
+    struct timespec enviadoEm;
+}ConexaoCarga;
+
+/**
+ * @brief Parâmetros do teste, compartilhados por todas as threads.
+ */
+typedef struct{
+    int porta;
+    const char* caminhoUnix;
+    int rodadas;                        // Itens jogados por sessão
+    int jogadores;                      // Jogadores por sessão
+    long sessoesPedidas;
+    long sessoesDistribuidas;           // Atualizado atomicamente
+    uint64_t semente;
+}ParametrosCarga;
+
+/**
+ * @brief Uma thread do cliente: as suas conexões e as medidas que ela colheu.
+ */
+typedef struct{
+    pthread_t thread;
+    ParametrosCarga* parametros;
+    int primeiraConexao;
+    int numeroConexoes;
+    long sessoesConcluidas;
+    long erros;
+    uint64_t *latencias;                // Nanossegundos por turno
+    size_t totalLatencias;
+    size_t capLatencias;
+}ThreadCarga;
+
+static uint64_t nanossegundosEntre(const struct timespec* inicio, const struct timespec* fim){
+    return (uint64_t)(fim->tv_sec - inicio->tv_sec) * 1000000000ULL + (uint64_t)(fim->tv_nsec - inicio->tv_nsec);
+}
+
+/**
+ * @brief Reserva a próxima sessão do teste, se ainda houver.
+ */
+static int reservarSessao(ParametrosCarga* parametros){
+    long numero = __atomic_fetch_add(&parametros->sessoesDistribuidas, 1, __ATOMIC_RELAXED);
+    return numero < parametros->sessoesPedidas;
+}
+
+/**
+ * @brief Conecta ao servidor (TCP em 127.0.0.1 ou socket Unix).
+ *
+ * O socket fica bloqueante: cada comando cabe no buffer de envio, e a leitura
+ * só é feita quando o epoll indica que há dados.
+ *
+ * @return int Descritor conectado, ou -1 em caso de erro.
+ */
+static int conectarServidor(const ParametrosCarga* parametros){
+    int descritor;
+    if (parametros->caminhoUnix != NULL){
+        struct sockaddr_un endereco;
+        memset(&endereco, 0, sizeof(endereco));
+        endereco.sun_family = AF_UNIX;
+        snprintf(endereco.sun_path, sizeof(endereco.sun_path), "%s", parametros->caminhoUnix);
+        descritor = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (descritor < 0) return -1;
+        if (connect(descritor, (struct sockaddr*)&endereco, sizeof(endereco)) != 0){
+            close(descritor);
+            return -1;
+        }
+    } else {
+        struct sockaddr_in endereco;
+        memset(&endereco, 0, sizeof(endereco));
+        endereco.sin_family = AF_INET;
+        endereco.sin_port = htons((uint16_t)parametros->porta);
+        endereco.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        descritor = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (descritor < 0) return -1;
+        if (connect(descritor, (struct sockaddr*)&endereco, sizeof(endereco)) != 0){
+            close(descritor);
+            return -1;
+        }
+        int ativo = 1;
+        setsockopt(descritor, IPPROTO_TCP, TCP_NODELAY, &ativo, sizeof(ativo));
+    }
+    return descritor;
+}
+
+/**
+ * @brief Envia um comando e marca o início da medida do turno.
+ *
+ * @return int 0 em caso de sucesso, -1 se a conexão caiu.
+ */
+static int enviarComando(ConexaoCarga* conexao, const char* comando){
+    size_t tamanho = strlen(comando), enviado = 0;
+    clock_gettime(CLOCK_MONOTONIC, &conexao->enviadoEm);
+    while (enviado < tamanho){
+        ssize_t parte = send(conexao->descritor, comando + enviado, tamanho - enviado, MSG_NOSIGNAL);
+        if (parte < 0 && errno == EINTR) continue;
+        if (parte <= 0) return -1;
+        enviado += (size_t)parte;
+    }
+    return 0;
+}
+
+/**
+ * @brief Inicia uma sessão na conexão: NOVA com nível e nomes de robôs.
+ */
+static int iniciarSessaoCarga(ConexaoCarga* conexao, const ParametrosCarga* parametros, int numeroConexao){
+    char comando[TAM_MAX_LINHA_SERVIDOR];
+    int usado = snprintf(comando, sizeof(comando), "NOVA 0 ");
+    for (int j = 0; j < parametros->jogadores; j++){
+        usado += snprintf(comando + usado, sizeof(comando) - (size_t)usado, "%srobo%d_%d",
+                          j ? ";" : "", numeroConexao, j + 1);
+    }
+    snprintf(comando + usado, sizeof(comando) - (size_t)usado, "\n");
+    conexao->rodadasFeitas = 0;
+    conexao->mascara[0] = '\0';
+    return enviarComando(conexao, comando);
+}
+
+/**
+ * @brief Lê a resposta completa e decide o próximo comando do robô.
+ *
+ * @return int 1 para continuar, 0 se a conexão terminou as suas sessões,
+ * -1 em caso de erro do servidor.
+ */
+static int tratarResposta(ThreadCarga* thread, ConexaoCarga* conexao, char* bloco, int numeroConexao){
+    ParametrosCarga* parametros = thread->parametros;
+    int fimDoItem = 0, fimDaSessao = 0, erro = 0;
+    char* contexto = NULL;
+    for (char* linha = strtok_r(bloco, "\n", &contexto); linha != NULL; linha = strtok_r(NULL, "\n", &contexto)){
+        if (strncmp(linha, "ITEM ", 5) == 0 || strncmp(linha, "LETRA ", 6) == 0){
+            snprintf(conexao->mascara, sizeof(conexao->mascara), "%s", strchr(linha, ' ') + 1);
+        } else if (strncmp(linha, "FIM_ITEM", 8) == 0){
+            fimDoItem = 1;
+        } else if (strcmp(linha, "TCHAU") == 0){
+            fimDaSessao = 1;
+        } else if (strncmp(linha, "ERRO ", 5) == 0){
+            erro = 1;
+        }
+    }
+    if (erro){
+        thread->erros++;
+        return -1;
+    }
+    if (fimDaSessao){
+        thread->sessoesConcluidas++;
+        if (!reservarSessao(parametros)) return 0;
+        return iniciarSessaoCarga(conexao, parametros, numeroConexao) == 0 ? 1 : -1;
+    }
+    if (fimDoItem){
+        conexao->rodadasFeitas++;
+        return enviarComando(conexao, conexao->rodadasFeitas >= parametros->rodadas ? "SAIR\n" : "PROXIMO\n") == 0 ? 1 : -1;
+    }
+
+    // Com a resposta toda revelada, o robô acerta; senão sorteia uma ação
+    char comando[TAM_MAX_LINHA_SERVIDOR];
+    uint32_t sorteio = aleatorioAte(&conexao->gerador, 100);
+    if (conexao->mascara[0] != '\0' && strchr(conexao->mascara, '_') == NULL){
+        snprintf(comando, sizeof(comando), "RESPONDER %s\n", conexao->mascara);
+    } else if (sorteio < 35){
+        snprintf(comando, sizeof(comando), "RESPONDER palpite%u\n", sorteio);
+    } else if (sorteio < 60){
+        snprintf(comando, sizeof(comando), "LETRA\n");
+    } else if (sorteio < 85){
+        snprintf(comando, sizeof(comando), "DICA\n");
+    } else {
+        snprintf(comando, sizeof(comando), "PULAR\n");
+    }
+    return enviarComando(conexao, comando) == 0 ? 1 : -1;
+}
+
+/**
+ * @brief Guarda a latência de um turno.
+ */
+static void registrarLatencia(ThreadCarga* thread, uint64_t nanossegundos){
+    if (thread->totalLatencias == thread->capLatencias){
+        size_t capacidade = thread->capLatencias ? thread->capLatencias * 2 : 4096;
+        uint64_t* latencias = realloc(thread->latencias, capacidade * sizeof(uint64_t));
+        if (latencias == NULL) return;
+        thread->latencias = latencias;
+        thread->capLatencias = capacidade;
+    }
+    thread->latencias[thread->totalLatencias++] = nanossegundos;
+}
+
+/**
+ * @brief Laço de uma thread do cliente: joga sessões até acabarem as do teste.
+ */
+static void* executarConexoesCarga(void* argumento){
+    ThreadCarga* thread = argumento;
+    ParametrosCarga* parametros = thread->parametros;
+    ConexaoCarga* conexoes = calloc((size_t)thread->numeroConexoes, sizeof(ConexaoCarga));
+    int epoll = epoll_create1(EPOLL_CLOEXEC);
+    int ativas = 0;
+    if (conexoes == NULL || epoll < 0){
+        thread->erros += thread->numeroConexoes;
+        free(conexoes);
+        if (epoll >= 0) close(epoll);
+        return NULL;
+    }
+
+    for (int i = 0; i < thread->numeroConexoes; i++){
+        ConexaoCarga* conexao = &conexoes[i];
+        int numero = thread->primeiraConexao + i;
+        conexao->descritor = -1;
+        iniciarGerador(&conexao->gerador, parametros->semente + (uint64_t)numero);
+        if (!reservarSessao(parametros)) break;
+        conexao->descritor = conectarServidor(parametros);
+        struct epoll_event evento = {.events = EPOLLIN, .data.u32 = (uint32_t)i};
+        if (conexao->descritor < 0 || epoll_ctl(epoll, EPOLL_CTL_ADD, conexao->descritor, &evento) != 0
+            || iniciarSessaoCarga(conexao, parametros, numero) != 0){
+            thread->erros++;
+            if (conexao->descritor >= 0) close(conexao->descritor);
+            conexao->descritor = -1;
+            continue;
+        }
+        ativas++;
+    }
+
+    struct epoll_event eventos[64];
+    while (ativas > 0){
+        int total = epoll_wait(epoll, eventos, 64, ESPERA_CARGA_MS);
+        if (total < 0 && errno == EINTR) continue;
+        if (total <= 0){
+            // Servidor parado ou travado: desiste das conexões restantes
+            thread->erros += ativas;
+            break;
+        }
+        for (int e = 0; e < total; e++){
+            int i = (int)eventos[e].data.u32;
+            ConexaoCarga* conexao = &conexoes[i];
+            int continuar = 1;
+            ssize_t lidos = recv(conexao->descritor, conexao->entrada + conexao->usadoEntrada,
+                                 sizeof(conexao->entrada) - 1 - conexao->usadoEntrada, 0);
+            if (lidos <= 0){
+                thread->erros++;
+                continuar = -1;
+            } else {
+                conexao->usadoEntrada += (size_t)lidos;
+                conexao->entrada[conexao->usadoEntrada] = '\0';
+                // Um comando por vez: no máximo um bloco completo por conexão
+                char* fimBloco = strstr(conexao->entrada, "\n\n");
+                if (fimBloco != NULL){
+                    struct timespec agora;
+                    clock_gettime(CLOCK_MONOTONIC, &agora);
+                    registrarLatencia(thread, nanossegundosEntre(&conexao->enviadoEm, &agora));
+                    fimBloco[1] = '\0';
+                    conexao->usadoEntrada = 0;
+                    continuar = tratarResposta(thread, conexao, conexao->entrada, thread->primeiraConexao + i);
+                } else if (conexao->usadoEntrada == sizeof(conexao->entrada) - 1){
+                    thread->erros++;
+                    continuar = -1;
+                }
+            }
+            if (continuar <= 0){
+                close(conexao->descritor);
+                conexao->descritor = -1;
+                ativas--;
+            }
+        }
+    }
+    for (int i = 0; i < thread->numeroConexoes; i++){
+        if (conexoes[i].descritor >= 0) close(conexoes[i].descritor);
+    }
+    close(epoll);
+    free(conexoes);
+    return NULL;
+}
+
+static int compararLatencias(const void* a, const void* b){
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Latência (em microssegundos) no percentil pedido de um vetor ordenado.
+ */
+static double percentil(const uint64_t* ordenadas, size_t total, double fracao){
+    if (total == 0) return 0;
+    size_t posicao = (size_t)(fracao * (double)(total - 1) + 0.5);
+    return (double)ordenadas[posicao] / 1000.0;
+}
+
+/**
+ * @brief Cliente de carga: joga sessões contra um servidor local e mede o desempenho.
+ *
+ * Opções: --porta N | --unix CAMINHO (mesmo endereço do servidor),
+ * --conexoes N (padrão 64), --sessoes N (padrão 10000), --rodadas N (itens por
+ * sessão, padrão 3), --jogadores N (por sessão, padrão 1), --threads N (padrão 2)
+ * e --semente N.
+ *
+ * @param argc Quantidade de opções.
+ * @param argv Opções (sem o nome do programa nem a palavra "carga").
+ * @return int Código de saída do programa (0 se não houve erros).
+ */
+int executarCarga(int argc, char* argv[]){
+    ParametrosCarga parametros;
+    memset(&parametros, 0, sizeof(parametros));
+    parametros.porta = PORTA_PADRAO_SERVIDOR;
+    parametros.rodadas = 3;
+    parametros.jogadores = 1;
+    parametros.sessoesPedidas = 10000;
+    parametros.semente = sementePadrao();
+    int numeroConexoes = 64, numeroThreads = 2;
+
+    for (int i = 0; i < argc; i++){
+        int temValor = i + 1 < argc;
+        if (strcmp(argv[i], "--porta") == 0 && temValor) parametros.porta = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--unix") == 0 && temValor) parametros.caminhoUnix = argv[++i];
+        else if (strcmp(argv[i], "--conexoes") == 0 && temValor) numeroConexoes = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--sessoes") == 0 && temValor) parametros.sessoesPedidas = atol(argv[++i]);
+        else if (strcmp(argv[i], "--rodadas") == 0 && temValor) parametros.rodadas = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--jogadores") == 0 && temValor) parametros.jogadores = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && temValor) numeroThreads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--semente") == 0 && temValor) parametros.semente = strtoull(argv[++i], NULL, 10);
+        else {
+            printf("[Erro] Opção inválida: '%s'.\n", argv[i]);
+            printf("Uso: jogo carga [--porta N | --unix CAMINHO] [--conexoes N] [--sessoes N] [--rodadas N]"
+                   " [--jogadores N] [--threads N] [--semente N]\n");
+            return 1;
+        }
+    }
+    if (numeroConexoes < 1 || parametros.sessoesPedidas < 1 || parametros.rodadas < 1
+        || parametros.jogadores < 1 || parametros.jogadores > MAX_JOGADORES_SESSAO
+        || numeroThreads < 1 || numeroThreads > MAX_THREADS_CARGA){
+        printf("[Erro] Parâmetros do teste de carga inválidos.\n");
+        return 1;
+    }
+    if (numeroThreads > numeroConexoes) numeroThreads = numeroConexoes;
+
+    ThreadCarga* threads = calloc((size_t)numeroThreads, sizeof(ThreadCarga));
+    if (threads == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para o teste de carga.\n");
+        return 1;
+    }
+    printf("Teste de carga: %ld sessões de %d rodada(s), %d conexões, %d thread(s), semente %llu\n",
+           parametros.sessoesPedidas, parametros.rodadas, numeroConexoes, numeroThreads,
+           (unsigned long long)parametros.semente);
+    fflush(stdout);
+
+    struct timespec inicio, fim;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    int primeira = 0, iniciadas = 0;
+    for (; iniciadas < numeroThreads; iniciadas++){
+        ThreadCarga* thread = &threads[iniciadas];
+        thread->parametros = &parametros;
+        thread->primeiraConexao = primeira;
+        thread->numeroConexoes = numeroConexoes / numeroThreads + (iniciadas < numeroConexoes % numeroThreads);
+        primeira += thread->numeroConexoes;
+        if (pthread_create(&thread->thread, NULL, executarConexoesCarga, thread) != 0) break;
+    }
+    long sessoes = 0, erros = 0;
+    size_t totalLatencias = 0;
+    for (int i = 0; i < iniciadas; i++){
+        pthread_join(threads[i].thread, NULL);
+        sessoes += threads[i].sessoesConcluidas;
+        erros += threads[i].erros;
+        totalLatencias += threads[i].totalLatencias;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+    double segundos = (double)nanossegundosEntre(&inicio, &fim) / 1e9;
+
+    uint64_t* latencias = malloc((totalLatencias ? totalLatencias : 1) * sizeof(uint64_t));
+    size_t juntadas = 0;
+    for (int i = 0; i < iniciadas; i++){
+        if (latencias != NULL) memcpy(latencias + juntadas, threads[i].latencias, threads[i].totalLatencias * sizeof(uint64_t));
+        juntadas += threads[i].totalLatencias;
+        free(threads[i].latencias);
+    }
+    free(threads);
+    if (latencias == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para o teste de carga.\n");
+        return 1;
+    }
+    qsort(latencias, totalLatencias, sizeof(uint64_t), compararLatencias);
+
+    printf("[OK] %ld sessões em %.2f s: %.0f sessões/s\n", sessoes, segundos, segundos > 0 ? (double)sessoes / segundos : 0.0);
+    printf("Turnos: %zu (%.0f/s)\n", totalLatencias, segundos > 0 ? (double)totalLatencias / segundos : 0.0);
+    printf("Latência por turno (us): p50 %.1f | p90 %.1f | p99 %.1f | máx %.1f\n",
+           percentil(latencias, totalLatencias, 0.50), percentil(latencias, totalLatencias, 0.90),
+           percentil(latencias, totalLatencias, 0.99), percentil(latencias, totalLatencias, 1.0));
+    if (erros > 0) printf("[Aviso] %ld conexão(ões) terminaram com erro.\n", erros);
+    free(latencias);
+    return erros > 0 ? 1 : 0;
+}
+
+#else
+
+int executarCarga(int argc, char* argv[]){
+    (void)argc; (void)argv;
+    printf("[Erro] O cliente de carga só está disponível no Linux.\n");
+    return 1;
+}
+
+#endif
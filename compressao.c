@@ -0,0 +1,539 @@
+/**
+ * @file compressao.c
+ * @brief Dicas guardadas compactadas, com um dicionário de palavras compartilhado pelo banco.
+ *
+ * As dicas são a maior parte dos textos do banco e repetem muito as mesmas
+ * palavras ("Sou", "um", "Fui", "fundada", "por"...). Com PERFIL_DICAS=compactadas,
+ * depois de carregar o banco:
+ *
+ * - as dicas de todos os itens são quebradas nos espaços e as palavras são
+ *   contadas; as que compensam (repetidas o bastante para pagar a sua entrada
+ *   no dicionário) ganham um código, as mais frequentes com os menores;
+ * - cada dica passa a ser a sequência dos códigos das suas palavras, em
+ *   varint (1 byte para as 128 mais frequentes, até 3 bytes). O espaço entre
+ *   palavras fica implícito; o código 0 introduz uma palavra literal (varint
+ *   do tamanho e os bytes), para as que ficaram fora do dicionário;
+ * - a arena é reescrita com as dicas codificadas e o dicionário, e os itens
+ *   recebem a marca ITEM_DICAS_CODIFICADAS.
+ *
+ * O dicionário fica na própria arena ([total][início de cada palavra][bytes]),
+ * por isso vai junto para o snapshot e é mapeado sem cópia na próxima
+ * abertura. Uma dica é decodificada sozinha, palavra por palavra, só quando
+ * alguém vai mostrá-la (copiarDica()); o sorteio e as buscas por resposta não
+ * olham as dicas e não pagam nada. Itens inseridos depois ficam com as dicas
+ * em texto até a próxima codificação. PERFIL_DICAS=texto desfaz a codificação.
+ *
+ * @date 2025-11-29
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "funcoes.h"
+
+#define TAM_MAX_DICA_CODIFICADA (4 * TAM_MAX_DICA)  // Pior caso: só palavras literais curtas
+#define MAX_AMOSTRAS_DECODIFICACAO 100000           // Dicas decodificadas para medir a latência
+
+/**
+ * @brief Uma palavra distinta das dicas e quantas vezes ela aparece.
+ */
+typedef struct{
+    uint32_t inicio;        // Posição em TabelaPalavras::bytes
+    uint32_t frequencia;
+    uint32_t codigo;        // Código no dicionário (0 = gravada literal)
+    uint16_t tam;
+}PalavraDicas;
+
+/**
+ * @brief Palavras distintas das dicas, com uma tabela hash (sondagem linear) para achá-las.
+ */
+typedef struct{
+    PalavraDicas *palavras;
+    size_t total;
+    size_t capacidade;
+    int32_t *posicoes;      // Índices em 'palavras' (-1 = posição vazia)
+    uint32_t capacidadeTabela;
+    char *bytes;
+    size_t usado;
+    size_t capacidadeBytes;
+}TabelaPalavras;
+
+/**
+ * @brief Dobra a tabela hash e reinsere todas as palavras.
+ */
+static int crescerTabela(TabelaPalavras* tabela){
+    uint32_t capacidade = tabela->capacidadeTabela ? tabela->capacidadeTabela * 2 : 4096;
+    int32_t* posicoes = malloc((size_t)capacidade * sizeof(int32_t));
+    if (posicoes == NULL) return -1;
+    for (uint32_t s = 0; s < capacidade; s++) posicoes[s] = -1;
+    for (size_t p = 0; p < tabela->total; p++){
+        const PalavraDicas* palavra = &tabela->palavras[p];
+        uint32_t slot = hashBytes(tabela->bytes + palavra->inicio, palavra->tam) & (capacidade - 1);
+        while (posicoes[slot] >= 0) slot = (slot + 1) & (capacidade - 1);
+        posicoes[slot] = (int32_t)p;
+    }
+    free(tabela->posicoes);
+    tabela->posicoes = posicoes;
+    tabela->capacidadeTabela = capacidade;
+    return 0;
+}
+
+/**
+ * @brief Localiza uma palavra na tabela, acrescentando-a (com frequência 0) se ainda não existir.
+ *
+ * @return PalavraDicas* A palavra, ou NULL se faltar memória.
+ */
+static PalavraDicas* encontrarPalavra(TabelaPalavras* tabela, const char* texto, size_t tam){
+    if ((tabela->total + 1) * 2 > tabela->capacidadeTabela && crescerTabela(tabela) != 0) return NULL;
+    uint32_t mascara = tabela->capacidadeTabela - 1;
+    uint32_t slot = hashBytes(texto, tam) & mascara;
+    while (tabela->posicoes[slot] >= 0){
+        PalavraDicas* palavra = &tabela->palavras[tabela->posicoes[slot]];
+        if (palavra->tam == tam && memcmp(tabela->bytes + palavra->inicio, texto, tam) == 0) return palavra;
+        slot = (slot + 1) & mascara;
+    }
+    if (tabela->usado + tam > UINT32_MAX ||
+        crescerVetor((void**)&tabela->palavras, &tabela->capacidade, tabela->total + 1, sizeof(PalavraDicas)) != 0 ||
+        crescerVetor((void**)&tabela->bytes, &tabela->capacidadeBytes, tabela->usado + tam, 1) != 0){
+        return NULL;
+    }
+    PalavraDicas* palavra = &tabela->palavras[tabela->total];
+    palavra->inicio = (uint32_t)tabela->usado;
+    palavra->tam = (uint16_t)tam;
+    palavra->frequencia = 0;
+    palavra->codigo = 0;
+    memcpy(tabela->bytes + tabela->usado, texto, tam);
+    tabela->usado += tam;
+    tabela->posicoes[slot] = (int32_t)tabela->total;
+    return &tabela->palavras[tabela->total++];
+}
+
+static void liberarTabela(TabelaPalavras* tabela){
+    free(tabela->palavras);
+    free(tabela->posicoes);
+    free(tabela->bytes);
+}
+
+static size_t gravarVarint(unsigned char* destino, uint32_t valor){
+    size_t n = 0;
+    while (valor >= 0x80){
+        destino[n++] = (unsigned char)(valor | 0x80);
+        valor >>= 7;
+    }
+    destino[n++] = (unsigned char)valor;
+    return n;
+}
+
+/**
+ * @brief Lê um varint; devolve UINT32_MAX se os bytes acabarem antes dele.
+ */
+static uint32_t lerVarint(const unsigned char** cursor, const unsigned char* fim){
+    uint32_t valor = 0;
+    for (int deslocamento = 0; *cursor < fim && deslocamento < 32; deslocamento += 7){
+        unsigned char byte = *(*cursor)++;
+        valor |= (uint32_t)(byte & 0x7F) << deslocamento;
+        if (byte < 0x80) return valor;
+    }
+    return UINT32_MAX;
+}
+
+/**
+ * @brief Decodifica 'tam' bytes de uma dica codificada com o dicionário do banco.
+ *
+ * Dados inválidos (código fora do dicionário, literal cortado) encerram a
+ * decodificação no ponto em que aparecem.
+ */
+static size_t decodificarDica(const BancoInformacoes* banco, const unsigned char* p, size_t tam,
+                              char* destino, size_t tamDestino){
+    const unsigned char* fim = p + tam;
+    const char* dicionario = banco->textos.dados + banco->dicionarioDicas;
+    uint32_t totalPalavras = 0;
+    if (banco->tamDicionarioDicas >= sizeof(uint32_t)) memcpy(&totalPalavras, dicionario, sizeof(uint32_t));
+    size_t tamIndice = sizeof(uint32_t) * ((size_t)totalPalavras + 2);
+    if (tamIndice > banco->tamDicionarioDicas){
+        totalPalavras = 0;      // Dicionário corrompido: só as palavras literais são decodificadas
+        tamIndice = banco->tamDicionarioDicas;
+    }
+    const char* bytes = dicionario + tamIndice;
+    size_t tamBytes = banco->tamDicionarioDicas - tamIndice;
+
+    size_t n = 0, limite = tamDestino - 1;
+    for (int primeira = 1; p < fim; primeira = 0){
+        if (!primeira && n < limite) destino[n++] = ' ';
+        uint32_t codigo = lerVarint(&p, fim);
+        const char* palavra;
+        size_t tamPalavra;
+        if (codigo == 0){
+            tamPalavra = lerVarint(&p, fim);
+            if (tamPalavra > (size_t)(fim - p)) break;
+            palavra = (const char*)p;
+            p += tamPalavra;
+        } else {
+            if (codigo > totalPalavras) break;
+            uint32_t limites[2];
+            memcpy(limites, dicionario + sizeof(uint32_t) * codigo, sizeof(limites));
+            if (limites[0] > limites[1] || limites[1] > tamBytes) break;
+            palavra = bytes + limites[0];
+            tamPalavra = limites[1] - limites[0];
+        }
+        if (tamPalavra > limite - n) tamPalavra = limite - n;
+        memcpy(destino + n, palavra, tamPalavra);
+        n += tamPalavra;
+    }
+    destino[n] = '\0';
+    return n;
+}
+
+/**
+ * @brief Copia uma das dicas de um item para 'destino', decodificando-a se preciso.
+ *
+ * Decodifica só a dica pedida, sem tocar nas outras do item.
+ *
+ * @param banco Banco ao qual o item pertence.
+ * @param item Ponteiro para um item de banco->itens.
+ * @param numeroDica Número da dica, de 1 a MAX_DICAS (fora disso, copia a string vazia).
+ * @param destino Onde a dica é gravada, terminada em '\0'.
+ * @param tamDestino Tamanho de 'destino' (pelo menos 1; TAM_MAX_DICA cabe qualquer dica).
+ * @return size_t Tamanho da dica copiada, sem o '\0'.
+ */
+size_t copiarDica(const BancoInformacoes* banco, const Item* item, int numeroDica, char* destino, size_t tamDestino){
+    if (numeroDica < 1 || numeroDica > MAX_DICAS){
+        destino[0] = '\0';
+        return 0;
+    }
+    const DicasItem* dicas = &banco->dicas[item - banco->itens];
+    const char* texto = banco->textos.dados + dicas->dica[numeroDica - 1];
+    size_t tam = dicas->tamDica[numeroDica - 1];
+    if (item->marcas & ITEM_DICAS_CODIFICADAS){
+        return decodificarDica(banco, (const unsigned char*)texto, tam, destino, tamDestino);
+    }
+    if (tam > tamDestino - 1) tam = tamDestino - 1;
+    memcpy(destino, texto, tam);
+    destino[tam] = '\0';
+    return tam;
+}
+
+/**
+ * @brief Conta as palavras de todas as dicas do banco.
+ */
+static int contarPalavras(const BancoInformacoes* banco, TabelaPalavras* tabela){
+    char dica[TAM_MAX_DICA];
+    for (int i = 0; i < banco->totalItens; i++){
+        for (int d = 1; d <= MAX_DICAS; d++){
+            size_t tam = copiarDica(banco, &banco->itens[i], d, dica, sizeof(dica));
+            if (tam == 0) continue;
+            for (size_t inicio = 0; inicio <= tam; ){
+                const char* espaco = memchr(dica + inicio, ' ', tam - inicio);
+                size_t fimPalavra = espaco ? (size_t)(espaco - dica) : tam;
+                PalavraDicas* palavra = encontrarPalavra(tabela, dica + inicio, fimPalavra - inicio);
+                if (palavra == NULL) return -1;
+                palavra->frequencia++;
+                inicio = fimPalavra + 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int compararFrequencia(const void* a, const void* b){
+    const PalavraDicas* x = *(const PalavraDicas* const*)a;
+    const PalavraDicas* y = *(const PalavraDicas* const*)b;
+    if (x->frequencia != y->frequencia) return x->frequencia > y->frequencia ? -1 : 1;
+    return (x->inicio > y->inicio) - (x->inicio < y->inicio);
+}
+
+/**
+ * @brief Escolhe as palavras do dicionário, dá os códigos e monta o bloco que vai para a arena.
+ *
+ * Uma palavra entra se o que ela economiza (a cada ocorrência, o literal
+ * menos um código de até 2 bytes) passa do que ela custa no dicionário
+ * (os bytes e 4 bytes de índice).
+ *
+ * @return int 0 em caso de sucesso, -1 se faltar memória.
+ */
+static int montarDicionario(TabelaPalavras* tabela, char** bloco, size_t* tamBloco, size_t* totalPalavras){
+    PalavraDicas** escolhidas = malloc((tabela->total + 1) * sizeof(PalavraDicas*));
+    if (escolhidas == NULL) return -1;
+    size_t total = 0;
+    for (size_t p = 0; p < tabela->total; p++){
+        PalavraDicas* palavra = &tabela->palavras[p];
+        uint64_t economia = (uint64_t)palavra->frequencia * (palavra->tam + (palavra->tam < 128 ? 2 : 3) - 2);
+        if (economia > (uint64_t)palavra->tam + 4) escolhidas[total++] = palavra;
+    }
+    qsort(escolhidas, total, sizeof(PalavraDicas*), compararFrequencia);
+    if (total > MAX_PALAVRAS_DICIONARIO) total = MAX_PALAVRAS_DICIONARIO;
+
+    size_t tamIndice = sizeof(uint32_t) * (total + 2);
+    size_t tamBytes = 0;
+    for (size_t k = 0; k < total; k++) tamBytes += escolhidas[k]->tam;
+    *bloco = malloc(tamIndice + tamBytes);
+    if (*bloco == NULL){
+        free(escolhidas);
+        return -1;
+    }
+    // [total][início da palavra 1]...[início da palavra total][fim da última][bytes]
+    uint32_t valor = (uint32_t)total;
+    memcpy(*bloco, &valor, sizeof(valor));
+    uint32_t inicio = 0;
+    for (size_t k = 0; k < total; k++){
+        escolhidas[k]->codigo = (uint32_t)k + 1;
+        memcpy(*bloco + sizeof(uint32_t) * (k + 1), &inicio, sizeof(inicio));
+        memcpy(*bloco + tamIndice + inicio, tabela->bytes + escolhidas[k]->inicio, escolhidas[k]->tam);
+        inicio += escolhidas[k]->tam;
+    }
+    memcpy(*bloco + sizeof(uint32_t) * (total + 1), &inicio, sizeof(inicio));
+    *tamBloco = tamIndice + tamBytes;
+    *totalPalavras = total;
+    free(escolhidas);
+    return 0;
+}
+
+/**
+ * @brief Codifica uma dica com os códigos da tabela.
+ *
+ * @return size_t Bytes gravados em 'destino' (até TAM_MAX_DICA_CODIFICADA).
+ */
+static size_t codificarDica(TabelaPalavras* tabela, const char* dica, size_t tam, unsigned char* destino){
+    size_t n = 0;
+    for (size_t inicio = 0; inicio <= tam; ){
+        const char* espaco = memchr(dica + inicio, ' ', tam - inicio);
+        size_t fimPalavra = espaco ? (size_t)(espaco - dica) : tam;
+        size_t tamPalavra = fimPalavra - inicio;
+        const PalavraDicas* palavra = encontrarPalavra(tabela, dica + inicio, tamPalavra);    // Já contada
+        if (palavra != NULL && palavra->codigo != 0){
+            n += gravarVarint(destino + n, palavra->codigo);
+        } else {
+            n += gravarVarint(destino + n, 0);
+            n += gravarVarint(destino + n, (uint32_t)tamPalavra);
+            memcpy(destino + n, dica + inicio, tamPalavra);
+            n += tamPalavra;
+        }
+        inicio = fimPalavra + 1;
+    }
+    return n;
+}
+
+/**
+ * @brief Bytes do nome de uma categoria na arena, com a chave que o segue ("nome\0chave\0").
+ */
+static size_t tamanhoCategoria(const char* nome){
+    size_t tamNome = strlen(nome) + 1;
+    return tamNome + strlen(nome + tamNome) + 1;
+}
+
+/**
+ * @brief Reescreve a arena com as dicas codificadas (comDicionario = 1) ou em texto (0).
+ *
+ * A arena nova tem, nesta ordem: a string vazia, as respostas, os nomes das categorias,
+ * o dicionário e as dicas. As posições dos itens não mudam; textos sem uso
+ * (de itens alterados) ficam para trás, como em compactarBanco().
+ *
+ * @param totalPalavras Saída: palavras do dicionário.
+ * @param bytesTexto Saída: bytes que as dicas ocupam em texto (com os '\0').
+
+ * @return int 0 em caso de sucesso, -1 se faltar memória (o banco fica como estava).
+ */
+static int reescreverDicas(BancoInformacoes* banco, int comDicionario, size_t* totalPalavras, uint64_t* bytesTexto){
+    if (prepararEscrita(banco) != 0) return -1;
+    TabelaPalavras tabela = {0};
+    char* bloco = NULL;
+    size_t tamBloco = 0;
+    *totalPalavras = 0;
+    *bytesTexto = 0;
+    if (comDicionario && (contarPalavras(banco, &tabela) != 0 ||
+                          montarDicionario(&tabela, &bloco, &tamBloco, totalPalavras) != 0)){
+        liberarTabela(&tabela);
+        return -1;
+    }
+
+    // As dicas vão primeiro para um buffer à parte; o deslocamento final é somado depois
+    DicasItem* dicas = malloc((size_t)(banco->totalItens > 0 ? banco->totalItens : 1) * sizeof(DicasItem));
+    unsigned char* codificadas = NULL;
+    size_t usado = 0, capacidade = 0, tamOutros = 1;
+    int erro = (dicas == NULL);
+    char dica[TAM_MAX_DICA];
+    for (int i = 0; i < banco->totalItens && !erro; i++){
+        const Item* item = &banco->itens[i];
+        dicas[i] = banco->dicas[i];
+        tamOutros += (size_t)item->tamResposta + item->tamChave + 2;
+        for (int d = 0; d < MAX_DICAS && !erro; d++){
+            size_t tam = copiarDica(banco, item, d + 1, dica, sizeof(dica));
+            dicas[i].dica[d] = 0;
+            dicas[i].tamDica[d] = 0;
+            if (tam == 0) continue;
+            *bytesTexto += tam + 1;
+            if (crescerVetor((void**)&codificadas, &capacidade, usado + TAM_MAX_DICA_CODIFICADA + 1, 1) != 0){
+                erro = 1;
+                break;
+            }
+            size_t tamGravado = tam;
+            if (comDicionario) tamGravado = codificarDica(&tabela, dica, tam, codificadas + usado);
+            else memcpy(codificadas + usado, dica, tam);
+            codificadas[usado + tamGravado] = '\0';     // Para compactarBanco() copiar como texto
+            dicas[i].dica[d] = (uint32_t)usado;
+            dicas[i].tamDica[d] = (uint16_t)tamGravado;
+            usado += tamGravado + 1;
+        }
+    }
+    liberarTabela(&tabela);
+    for (uint32_t c = 1; c < banco->categorias.total; c++){
+        tamOutros += tamanhoCategoria(banco->textos.dados + banco->categorias.nomes[c]);
+    }
+
+    size_t tamArena = tamOutros + tamBloco + usado;
+    ArenaTexto textos = {NULL, 1, tamArena};
+    if (!erro && (tamArena > UINT32_MAX || (textos.dados = malloc(tamArena)) == NULL)) erro = 1;
+    if (erro){
+        printf("[Erro] Houve um erro na alocação de memória para reescrever as dicas.\n");
+        free(dicas);
+        free(codificadas);
+        free(bloco);
+        return -1;
+    }
+
+    textos.dados[0] = '\0';
+    const char* antigos = banco->textos.dados;
+    for (int i = 0; i < banco->totalItens; i++){
+        Item* item = &banco->itens[i];
+        size_t tamResposta = (size_t)item->tamResposta + item->tamChave + 2;
+        memcpy(textos.dados + textos.usado, antigos + item->resposta, tamResposta);
+        item->resposta = (uint32_t)textos.usado;
+        textos.usado += tamResposta;
+    }
+    for (uint32_t c = 1; c < banco->categorias.total; c++){
+        size_t tam = tamanhoCategoria(antigos + banco->categorias.nomes[c]);
+        memcpy(textos.dados + textos.usado, antigos + banco->categorias.nomes[c], tam);
+        banco->categorias.nomes[c] = (uint32_t)textos.usado;
+        textos.usado += tam;
+    }
+    banco->dicionarioDicas = 0;
+    banco->tamDicionarioDicas = 0;
+    if (comDicionario){
+        memcpy(textos.dados + textos.usado, bloco, tamBloco);
+        banco->dicionarioDicas = (uint32_t)textos.usado;
+        banco->tamDicionarioDicas = (uint32_t)tamBloco;
+        textos.usado += tamBloco;
+    }
+    uint32_t base = (uint32_t)textos.usado;
+    memcpy(textos.dados + textos.usado, codificadas, usado);
+    textos.usado += usado;
+    for (int i = 0; i < banco->totalItens; i++){
+        for (int d = 0; d < MAX_DICAS; d++){
+            if (dicas[i].tamDica[d] != 0) dicas[i].dica[d] += base;
+        }
+        banco->dicas[i] = dicas[i];
+        if (comDicionario) banco->itens[i].marcas |= ITEM_DICAS_CODIFICADAS;
+        else banco->itens[i].marcas &= (uint8_t)~ITEM_DICAS_CODIFICADAS;
+    }
+    free(banco->textos.dados);
+    banco->textos = textos;
+    free(dicas);
+    free(codificadas);
+    free(bloco);
+    return 0;
+}
+
+/**
+ * @brief Bytes que as dicas ocupam na arena como estão (com os '\0'), mais o dicionário.
+ */
+static uint64_t bytesDasDicas(const BancoInformacoes* banco){
+    uint64_t total = banco->tamDicionarioDicas;
+    for (int i = 0; i < banco->totalItens; i++){
+        for (int d = 0; d < MAX_DICAS; d++){
+            if (banco->dicas[i].tamDica[d] != 0) total += (uint64_t)banco->dicas[i].tamDica[d] + 1;
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Mede o tempo médio de copiarDica() em até MAX_AMOSTRAS_DECODIFICACAO dicas espalhadas pelo banco.
+ */
+static void medirDecodificacao(const BancoInformacoes* banco){
+    long dicas = (long)banco->totalItens * MAX_DICAS;
+    long passo = dicas / MAX_AMOSTRAS_DECODIFICACAO + 1;
+    char dica[TAM_MAX_DICA];
+    long medidas = 0;
+    uint64_t bytes = 0;
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    for (long k = 0; k < dicas; k += passo){
+        bytes += copiarDica(banco, &banco->itens[k / MAX_DICAS], (int)(k % MAX_DICAS) + 1, dica, sizeof(dica));
+        medidas++;
+    }
+    double segundos = segundosDesde(&inicio);
+    if (medidas == 0) return;
+    printf("[OK] Decodificação: %.0f ns por dica (média de %ld dicas, %.0f bytes por dica).\n",
+           segundos * 1e9 / (double)medidas, medidas, (double)bytes / (double)medidas);
+}
+
+/**
+ * @brief Codifica as dicas de todos os itens com um dicionário montado a partir delas.
+ *
+ * Refaz o dicionário do zero (as dicas já codificadas são decodificadas
+ * antes) e informa a razão de compressão e a latência de decodificação.
+ *
+ * @param banco Banco a codificar; se vier de um snapshot, passa para o heap.
+ * @return int 0 em caso de sucesso, -1 se faltar memória (o banco fica como estava).
+ */
+int codificarDicasBanco(BancoInformacoes* banco){
+    if (banco == NULL) return -1;
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    size_t arenaAntes = banco->textos.usado;
+    size_t totalPalavras;
+    uint64_t antes;
+    if (reescreverDicas(banco, 1, &totalPalavras, &antes) != 0) return -1;
+    uint64_t depois = bytesDasDicas(banco);
+    printf("[OK] Dicas compactadas em %.0f ms: %.2f MiB em texto -> %.2f MiB (%.1f%%), com um dicionário de %zu palavras "
+           "(%.1f KiB). Arena de textos: %.2f MiB -> %.2f MiB.\n",
+           segundosDesde(&inicio) * 1e3, (double)antes / (1 << 20), (double)depois / (1 << 20),
+           antes > 0 ? 100.0 * (double)depois / (double)antes : 100.0, totalPalavras,
+           (double)banco->tamDicionarioDicas / 1024, (double)arenaAntes / (1 << 20),
+           (double)banco->textos.usado / (1 << 20));
+    medirDecodificacao(banco);
+    return 0;
+}
+
+/**
+ * @brief Volta a guardar as dicas de todos os itens em texto e descarta o dicionário.
+ *
+ * @return int 0 em caso de sucesso, -1 se faltar memória (o banco fica como estava).
+ */
+int decodificarDicasBanco(BancoInformacoes* banco){
+    if (banco == NULL) return -1;
+    size_t totalPalavras;
+    uint64_t bytesTexto;
+    if (reescreverDicas(banco, 0, &totalPalavras, &bytesTexto) != 0) return -1;
+    printf("[OK] Dicas guardadas de novo em texto (%.2f MiB).\n", (double)bytesDasDicas(banco) / (1 << 20));
+    return 0;
+}
+
+/**
+ * @brief Aplica ao banco recém-carregado o modo de guardar as dicas pedido em PERFIL_DICAS.
+ *
+ * "compactadas" codifica as dicas se algum item ainda as tem em texto;
+ * "texto" desfaz a codificação. Sem a variável, o banco fica como veio (um
+ * snapshot gravado com as dicas compactadas continua compactado).
+ *
+ * @param banco Banco carregado.
+ */
+void aplicarModoDicas(BancoInformacoes* banco){
+    const char* modo = getenv("PERFIL_DICAS");
+    if (banco == NULL || modo == NULL) return;
+    int compactar = (strcmp(modo, "compactadas") == 0);
+    if (!compactar && strcmp(modo, "texto") != 0){
+        printf("[Aviso] PERFIL_DICAS deve ser 'compactadas' ou 'texto'; as dicas ficam como estão.\n");
+        return;
+    }
+    int pendentes = 0;
+    for (int i = 0; i < banco->totalItens && !pendentes; i++){
+        int codificado = (banco->itens[i].marcas & ITEM_DICAS_CODIFICADAS) != 0;
+        pendentes = compactar ? !codificado : codificado;
+    }
+    if (!compactar && banco->dicionarioDicas != 0) pendentes = 1;
+    if (!pendentes) return;
+    if (compactar) codificarDicasBanco(banco);
+    else decodificarDicasBanco(banco);
+}
@@ -0,0 +1,431 @@
+/**
+ * @file diario.c
+ * @brief Diário das alterações feitas pelo menu (inserir, alterar e excluir itens).
+ *
+ * Cada alteração é acrescentada a ARQUIVO_DIARIO assim que é feita, como um
+ * RegistroDiario (cabeçalho fixo com checksum, seguido só dos textos que
+ * mudaram). O item é identificado pelo Item::id, que a compactação não muda.
+ * Sair do programa custa só sincronizar o diário, e não regravar o banco.
+ *
+ * - O CabecalhoDiario guarda o checksum do cabeçalho do snapshot sobre o qual
+ *   o diário vale. Ao carregar o snapshot, carregarBancoInicial() reaplica o
+ *   diário (abrirDiario()); um diário de outro snapshot, ou com o banco lido
+ *   do CSV, é deixado de lado em "<diário>.antigo".
+ * - Os fsync são agrupados como no log do ranking: um a cada
+ *   LOTE_SINCRONIA_DIARIO registros ou INTERVALO_SINCRONIA_DIARIO segundos, e
+ *   na saída. Uma queda do processo não perde nada; uma queda de energia perde
+ *   no máximo o lote aberto.
+ * - Uma gravação interrompida deixa no fim um registro incompleto ou com
+ *   checksum errado: a leitura para nele e a próxima gravação o descarta.
+ * - Quando o diário passa de TAM_MIN_DOBRA_DIARIO bytes e de
+ *   PERCENTUAL_DOBRA_DIARIO% do snapshot, ele é dobrado: o banco vai para um
+ *   snapshot novo e o diário recomeça vazio. O snapshot é renomeado antes da
+ *   troca do diário; uma queda entre as duas deixa um diário de outro
+ *   snapshot, que é ignorado (as alterações já estão no snapshot novo).
+ * - Se o banco veio do CSV, não há snapshot para o diário valer: a primeira
+ *   alteração grava um (que já a contém) e o diário começa vazio.
+ *
+ * Só o processo do menu grava o diário; os outros modos apenas o reaplicam ao
+ * carregar o banco.
+ *
+ * @date 2025-11-28
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef _WIN32
+#include <io.h>
+#define fsync _commit
+#endif
+#include "funcoes.h"
+
+#define TAM_MAX_TEXTOS_DIARIO (TAM_MAX_RESPOSTA + MAX_DICAS * TAM_MAX_DICA + TAM_MAX_CATEGORIA)
+
+/**
+ * @brief Estado do diário de ARQUIVO_DIARIO neste processo.
+ */
+typedef struct{
+    int ativo;                  // Há um snapshot base e o diário vale sobre ele
+    uint64_t checksumSnapshot;
+    uint64_t tamanhoSnapshot;
+    uint64_t tamanhoValido;     // Bytes do arquivo até o último registro válido (0 = sem cabeçalho)
+    int descritor;              // Aberto na primeira gravação
+    long registros;             // Registros sobre o snapshot base
+    int semSincronia;
+    int64_t inicioSemSincronia;
+}EstadoDiario;
+
+static EstadoDiario diario = {0, 0, 0, 0, -1, 0, 0, 0};
+
+static CabecalhoDiario montarCabecalhoDiario(uint64_t checksumSnapshot){
+    CabecalhoDiario cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.magica, MAGICA_DIARIO, sizeof(cabecalho.magica));
+    cabecalho.versao = VERSAO_DIARIO;
+    cabecalho.tamanhoRegistro = sizeof(RegistroDiario);
+    cabecalho.checksumSnapshot = checksumSnapshot;
+    return cabecalho;
+}
+
+/**
+ * @brief Checksum de um registro (com o campo checksum zerado) e dos seus textos.
+ */
+static uint64_t checksumRegistro(RegistroDiario registro, const char* textos){
+    registro.checksum = 0;
+    uint64_t checksum = atualizarChecksum(CHECKSUM_INICIAL, &registro, sizeof(registro));
+    return atualizarChecksum(checksum, textos, registro.tamTextos);
+}
+
+/**
+ * @brief Lê o checksum do cabeçalho e o tamanho do snapshot em ARQUIVO_BINARIO.
+ */
+static int lerBaseSnapshot(uint64_t* checksum, uint64_t* tamanho){
+    FILE* arquivo = fopen(ARQUIVO_BINARIO, "rb");
+    if (arquivo == NULL) return -1;
+    CabecalhoSnapshot cabecalho;
+    int lido = fread(&cabecalho, sizeof(cabecalho), 1, arquivo) == 1;
+    struct stat info;
+    int temTamanho = fstat(fileno(arquivo), &info) == 0;
+    fclose(arquivo);
+    if (!lido || !temTamanho) return -1;
+    *checksum = cabecalho.checksumCabecalho;
+    *tamanho = (uint64_t)info.st_size;
+    return 0;
+}
+
+static void fecharDescritor(void){
+    if (diario.descritor < 0) return;
+    sincronizarDiario();
+    close(diario.descritor);
+    diario.descritor = -1;
+}
+
+/**
+ * @brief Move um diário que não vale para o banco atual para "<diário>.antigo".
+ */
+static void deixarDiarioDeLado(const char* motivo){
+    char antigo[FILENAME_MAX];
+    snprintf(antigo, sizeof(antigo), "%s.antigo", ARQUIVO_DIARIO);
+    remove(antigo);
+    if (rename(ARQUIVO_DIARIO, antigo) == 0){
+        printf("[Aviso] O diário '%s' %s e não foi aplicado; ele foi movido para '%s'.\n", ARQUIVO_DIARIO, motivo, antigo);
+    }
+}
+
+/**
+ * @brief Retira o próximo texto (terminado em '\0') dos textos de um registro.
+ *
+ * @return const char* O texto, ou NULL se os textos acabaram.
+ */
+static const char* proximoTexto(const char** cursor, const char* fim){
+    const char* texto = *cursor;
+    const char* nulo = (texto < fim) ? memchr(texto, '\0', (size_t)(fim - texto)) : NULL;
+    if (nulo == NULL) return NULL;
+    *cursor = nulo + 1;
+    return texto;
+}
+
+/**
+ * @brief Refaz no banco a alteração descrita por um registro do diário.
+ *
+ * @return int 0 em caso de sucesso, -1 se o registro não se aplica ao banco.
+ */
+static int aplicarRegistro(BancoInformacoes* banco, const RegistroDiario* registro, const char* textos){
+    const char* cursor = textos;
+    const char* fim = textos + registro->tamTextos;
+    if (registro->operacao == DIARIO_INSERIR){
+        const char* resposta = proximoTexto(&cursor, fim);
+        const char* dicas[MAX_DICAS];
+        for (int d = 0; d < MAX_DICAS; d++) dicas[d] = proximoTexto(&cursor, fim);
+        const char* categoria = proximoTexto(&cursor, fim);
+        if (categoria == NULL || registro->id < banco->proximoId ||
+            registro->nivel < MUITOFACIL || registro->nivel > MUITODIFICIL) return -1;
+        banco->proximoId = registro->id;    // O item volta com o mesmo identificador
+        return adicionarItemBanco(banco, resposta, registro->nivel, dicas, categoria) < 0 ? -1 : 0;
+    }
+
+    int posicao = buscarItemPorId(banco, registro->id);
+    if (posicao < 0) return -1;
+    switch (registro->operacao){
+    case DIARIO_RESPOSTA: {
+        const char* resposta = proximoTexto(&cursor, fim);
+        return resposta != NULL ? alterarRespostaItem(banco, posicao, resposta) : -1;
+    }
+    case DIARIO_CATEGORIA: {
+        const char* categoria = proximoTexto(&cursor, fim);
+        return categoria != NULL ? alterarCategoriaItem(banco, posicao, categoria) : -1;
+    }
+    case DIARIO_DICAS: {
+        const char* dicas[MAX_DICAS];
+        for (int d = 0; d < MAX_DICAS; d++) dicas[d] = proximoTexto(&cursor, fim);
+        return dicas[MAX_DICAS - 1] != NULL ? alterarDicasItem(banco, posicao, dicas) : -1;
+    }
+    case DIARIO_NIVEL:
+        return alterarNivelItem(banco, posicao, registro->nivel);
+    case DIARIO_EXCLUIR:
+        return removerItemBanco(banco, posicao);
+    default:
+        return -1;
+    }
+}
+
+/**
+ * @brief Liga o diário ao banco recém-carregado e reaplica as alterações dele.
+ *
+ * Se o banco veio do snapshot e o diário vale sobre ele, os registros são
+ * refeitos em ordem até o fim do arquivo ou até o primeiro registro
+ * incompleto ou corrompido (descartado na próxima gravação).
+ *
+ * @param banco Banco carregado por carregarBancoInicial().
+ * @param doSnapshot 1 se o banco veio de ARQUIVO_BINARIO, 0 se veio do CSV.
+ * @return int Quantidade de registros reaplicados, ou -1 se o snapshot não pôde ser lido.
+ */
+int abrirDiario(BancoInformacoes* banco, int doSnapshot){
+    fecharDescritor();
+    memset(&diario, 0, sizeof(diario));
+    diario.descritor = -1;
+    FILE* arquivo = fopen(ARQUIVO_DIARIO, "rb");
+    if (!doSnapshot){
+        if (arquivo != NULL){
+            fclose(arquivo);
+            deixarDiarioDeLado("é de um snapshot mais antigo que o CSV");
+        }
+        return 0;
+    }
+    if (lerBaseSnapshot(&diario.checksumSnapshot, &diario.tamanhoSnapshot) != 0){
+        if (arquivo != NULL) fclose(arquivo);
+        return -1;
+    }
+    diario.ativo = 1;
+    if (arquivo == NULL) return 0;
+
+    CabecalhoDiario esperado = montarCabecalhoDiario(diario.checksumSnapshot);
+    CabecalhoDiario cabecalho;
+    if (fread(&cabecalho, sizeof(cabecalho), 1, arquivo) != 1){
+        fclose(arquivo);    // Vazio ou com o cabeçalho pela metade: é recriado na próxima gravação
+        return 0;
+    }
+    if (memcmp(&cabecalho, &esperado, sizeof(cabecalho)) != 0){
+        fclose(arquivo);
+        deixarDiarioDeLado("é de outro snapshot");
+        return 0;
+    }
+    diario.tamanhoValido = sizeof(cabecalho);
+
+    static char textos[TAM_MAX_TEXTOS_DIARIO];
+    RegistroDiario registro;
+    long aplicados = 0, recusados = 0;
+    while (fread(&registro, sizeof(registro), 1, arquivo) == 1){
+        if (registro.tamTextos > sizeof(textos) ||
+            fread(textos, 1, registro.tamTextos, arquivo) != registro.tamTextos ||
+            checksumRegistro(registro, textos) != registro.checksum){
+            break;
+        }
+        if (aplicarRegistro(banco, &registro, textos) == 0) aplicados++;
+        else recusados++;
+        diario.tamanhoValido += sizeof(registro) + registro.tamTextos;
+    }
+    struct stat info;
+    if (fstat(fileno(arquivo), &info) == 0 && (uint64_t)info.st_size > diario.tamanhoValido){
+        printf("[Aviso] O diário terminava com um registro incompleto, que será descartado.\n");
+    }
+    fclose(arquivo);
+
+    diario.registros = aplicados + recusados;
+    if (aplicados > 0){
+        printf("[OK] %ld alteração(ões) do diário '%s' reaplicada(s). Total de itens: %d\n",
+               aplicados, ARQUIVO_DIARIO, itensAtivos(banco));
+    }
+    if (recusados > 0){
+        printf("[Aviso] %ld registro(s) do diário não se aplicavam ao banco e foram ignorados.\n", recusados);
+    }
+    return (int)aplicados;
+}
+
+/**
+ * @brief Começa um diário vazio sobre o snapshot que acabou de ser gravado em ARQUIVO_BINARIO.
+ *
+ * O diário novo é gravado em "<diário>.tmp" e renomeado sobre o antigo.
+ *
+ * @return int 0 em caso de sucesso, -1 em caso de falha (o diário fica desligado).
+ */
+int reiniciarDiario(void){
+    fecharDescritor();
+    diario.ativo = 0;
+    if (lerBaseSnapshot(&diario.checksumSnapshot, &diario.tamanhoSnapshot) != 0) return -1;
+
+    char temporario[FILENAME_MAX];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", ARQUIVO_DIARIO);
+    FILE* arquivo = fopen(temporario, "wb");
+    if (arquivo == NULL) return -1;
+    CabecalhoDiario cabecalho = montarCabecalhoDiario(diario.checksumSnapshot);
+    int erro = fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo) != 1;
+    erro = erro || fflush(arquivo) != 0;
+    erro = erro || fsync(fileno(arquivo)) != 0;
+    erro = (fclose(arquivo) != 0) || erro;
+#ifdef _WIN32
+    if (!erro) remove(ARQUIVO_DIARIO); // rename() do Windows não substitui um arquivo existente
+#endif
+    if (erro || rename(temporario, ARQUIVO_DIARIO) != 0){
+        remove(temporario);
+        printf("[Aviso] Não foi possível criar o diário '%s'; as alterações só serão salvas na saída.\n", ARQUIVO_DIARIO);
+        return -1;
+    }
+    diario.tamanhoValido = sizeof(cabecalho);
+    diario.registros = 0;
+    diario.ativo = 1;
+    return 0;
+}
+
+/**
+ * @brief Abre o diário para acrescentar registros, descartando um registro
+ * incompleto no fim e criando o cabeçalho se ele ainda não existir.
+ */
+static int abrirParaGravar(void){
+    if (diario.descritor >= 0) return 0;
+    diario.descritor = open(ARQUIVO_DIARIO, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (diario.descritor < 0) return -1;
+    struct stat info;
+    if (fstat(diario.descritor, &info) != 0) return -1;
+    if (diario.tamanhoValido == 0){
+        CabecalhoDiario cabecalho = montarCabecalhoDiario(diario.checksumSnapshot);
+        if (ftruncate(diario.descritor, 0) != 0 || gravarTudo(diario.descritor, &cabecalho, sizeof(cabecalho)) != 0){
+            return -1;
+        }
+        diario.tamanhoValido = sizeof(cabecalho);
+    } else if ((uint64_t)info.st_size > diario.tamanhoValido){
+        if (ftruncate(diario.descritor, (off_t)diario.tamanhoValido) != 0) return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Grava o banco em um snapshot novo e recomeça o diário sobre ele.
+ *
+ * O banco não é compactado, para que as posições dos itens não mudem no meio
+ * de uma alteração do menu; os excluídos vão para o snapshot marcados.
+ */
+static int gravarSnapshotBase(BancoInformacoes* banco){
+    if (salvarSnapshot(banco, ARQUIVO_BINARIO) != 0){
+        printf("[Erro] Não foi possível gravar o snapshot '%s'.\n", ARQUIVO_BINARIO);
+        return -1;
+    }
+    return reiniciarDiario();
+}
+
+/**
+ * @brief Acrescenta ao diário uma alteração que acabou de ser feita no banco.
+ *
+ * Os dados gravados são lidos do próprio banco: o item inteiro para uma
+ * inserção, o campo alterado (ou as dicas) para as alterações e só o id para a exclusão.
+ * Sem snapshot base (banco lido do CSV), grava o snapshot, que já contém a
+ * alteração. Depois do acréscimo, sincroniza o lote de registros ou dobra o
+ * diário em um snapshot novo, se for a hora.
+ *
+ * @param banco Banco alterado.
+ * @param operacao Alteração feita.
+ * @param id Item::id do item alterado (na exclusão, o item já está marcado como excluído).
+ * @return int 0 em caso de sucesso, -1 se não foi possível gravar.
+ */
+int registrarNoDiario(BancoInformacoes* banco, OperacaoDiario operacao, uint32_t id){
+    if (!diario.ativo) return gravarSnapshotBase(banco);
+
+    static char bloco[sizeof(RegistroDiario) + TAM_MAX_TEXTOS_DIARIO];
+    RegistroDiario registro;
+    memset(&registro, 0, sizeof(registro));
+    registro.id = id;
+    registro.operacao = (uint8_t)operacao;
+    char* textos = bloco + sizeof(registro);
+    size_t tamTextos = 0;
+    if (operacao != DIARIO_EXCLUIR){
+        int posicao = buscarItemPorId(banco, id);
+        if (posicao < 0) return -1;
+        const Item* item = &banco->itens[posicao];
+        if (operacao == DIARIO_INSERIR || operacao == DIARIO_RESPOSTA){
+            size_t tam = strlen(obterResposta(banco, item)) + 1;
+            memcpy(textos + tamTextos, obterResposta(banco, item), tam);
+            tamTextos += tam;
+        }
+        if (operacao == DIARIO_INSERIR || operacao == DIARIO_DICAS){
+            for (int d = 1; d <= MAX_DICAS; d++){
+                tamTextos += copiarDica(banco, item, d, textos + tamTextos, TAM_MAX_DICA) + 1;
+            }
+        }
+        if (operacao == DIARIO_INSERIR || operacao == DIARIO_CATEGORIA){
+            size_t tam = strlen(obterCategoria(banco, item)) + 1;
+            memcpy(textos + tamTextos, obterCategoria(banco, item), tam);
+            tamTextos += tam;
+        }
+        registro.nivel = item->nivel;
+    }
+    registro.tamTextos = (uint16_t)tamTextos;
+    registro.checksum = checksumRegistro(registro, textos);
+    memcpy(bloco, &registro, sizeof(registro));
+
+    if (abrirParaGravar() != 0 || gravarTudo(diario.descritor, bloco, sizeof(registro) + tamTextos) != 0){
+        printf("[Erro] Não foi possível gravar no diário '%s'; a alteração só será salva na saída.\n", ARQUIVO_DIARIO);
+        fecharDescritor();
+        diario.ativo = 0;   // A saída grava o snapshot inteiro
+        return -1;
+    }
+    diario.tamanhoValido += sizeof(registro) + tamTextos;
+    diario.registros++;
+
+    int64_t agora = (int64_t)time(NULL);
+    if (diario.semSincronia++ == 0) diario.inicioSemSincronia = agora;
+    if (diario.semSincronia >= LOTE_SINCRONIA_DIARIO || agora - diario.inicioSemSincronia >= INTERVALO_SINCRONIA_DIARIO){
+        sincronizarDiario();
+    }
+    if (diario.tamanhoValido >= TAM_MIN_DOBRA_DIARIO &&
+        diario.tamanhoValido * 100 >= diario.tamanhoSnapshot * PERCENTUAL_DOBRA_DIARIO){
+        return gravarSnapshotBase(banco);
+    }
+    return 0;
+}
+
+/**
+ * @brief Força o fsync dos registros do diário ainda não sincronizados.
+ *
+ * @return int 0 em caso de sucesso (ou se não havia nada pendente), -1 se o fsync falhar.
+ */
+int sincronizarDiario(void){
+    if (diario.semSincronia == 0 || diario.descritor < 0) return 0;
+    diario.semSincronia = 0;
+    return fsync(diario.descritor) == 0 ? 0 : -1;
+}
+
+/**
+ * @brief Opção "Sair" do menu: garante em disco todas as alterações feitas.
+ *
+ * Com o diário ligado, basta sincronizá-lo (custo proporcional às alterações
+ * ainda não sincronizadas). Sem ele (banco lido do CSV e nunca alterado, ou
+ * diário com erro), o banco inteiro é gravado com salvarItensBinario().
+ *
+ * @param banco Banco do menu.
+ */
+void salvarAlteracoes(BancoInformacoes* banco){
+    if (!diario.ativo){
+        salvarItensBinario(banco);
+        return;
+    }
+    if (sincronizarDiario() != 0){
+        printf("[Erro] Não foi possível sincronizar o diário '%s'.\n", ARQUIVO_DIARIO);
+        return;
+    }
+    printf("[OK] %ld alteração(ões) guardada(s) no diário '%s' desde o último snapshot.\n",
+           diario.registros, ARQUIVO_DIARIO);
+}
+
+/**
+ * @brief Sincroniza e fecha o diário no fim do programa.
+ */
+void encerrarDiario(void){
+    fecharDescritor();
+}
@@ -0,0 +1,369 @@
+/**
+ * @file duplicatas.c
+ * @brief Itens repetidos na importação do CSV: detecção por resposta e por dicas, e a política para eles.
+ *
+ * Bancos juntados de vários editores trazem a mesma resposta muitas vezes,
+ * com dicas um pouco diferentes, e cada cópia aumenta a chance de o item ser
+ * sorteado. Um item é duplicata de um anterior (no banco ou mais acima no
+ * arquivo) quando tem:
+ *
+ * - a mesma resposta normalizada (normalizarResposta(): maiúsculas, acentos e
+ *   pontuação não contam), comparada pela chave guardada de cada item; ou
+ * - outra resposta mas as mesmas cinco dicas (sem diferenciar maiúsculas
+ *   ASCII), comparadas pelo hash de 64 bits delas (calcularHashDicas(); itens
+ *   sem dicas não entram).
+ *
+ * O hash das dicas é calculado pelas threads do leitor, junto com a leitura
+ * de cada fatia; tratarDuplicatas() faz depois uma única passada, na ordem do
+ * arquivo, com duas tabelas hash que só guardam posições. O que acontece com
+ * as duplicatas vem de PERFIL_DUPLICATAS:
+ *
+ * - manter (padrão): ficam todas, só são contadas;
+ * - mesclar: as dicas que a cópia tem e o primeiro item não tem vão para as
+ *   posições vazias dele, e a cópia sai; cópias só pelas dicas apenas saem;
+ * - rejeitar: a cópia sai e o primeiro item fica como estava.
+ *
+ * As cópias que saem são marcadas como excluídas e removidas pela
+ * compactação que o leitor faz em seguida. inserirItem() segue a mesma
+ * política para a resposta digitada.
+ *
+ * @date 2025-12-01
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "funcoes.h"
+
+static PoliticaDuplicatas politica = DUPLICATAS_MANTER;
+static int politicaLidaAmbiente = 0;
+
+static const char* nomesPoliticas[] = {"manter", "mesclar", "rejeitar"};
+
+/**
+ * @brief Retorna a política de duplicatas em uso, lendo PERFIL_DUPLICATAS na primeira chamada.
+ */
+PoliticaDuplicatas politicaDuplicatas(void){
+    if (politicaLidaAmbiente) return politica;
+    politicaLidaAmbiente = 1;
+    const char* valor = getenv("PERFIL_DUPLICATAS");
+    if (valor == NULL || *valor == '\0') return politica;
+    for (int p = DUPLICATAS_MANTER; p <= DUPLICATAS_REJEITAR; p++){
+        if (strcmp(valor, nomesPoliticas[p]) == 0){
+            politica = (PoliticaDuplicatas)p;
+            return politica;
+        }
+    }
+    printf("[Aviso] PERFIL_DUPLICATAS deve ser 'manter', 'mesclar' ou 'rejeitar'; as duplicatas serão mantidas.\n");
+    return politica;
+}
+
+/**
+ * @brief Define a política de duplicatas; substitui também a lida do ambiente.
+ */
+void definirPoliticaDuplicatas(PoliticaDuplicatas nova){
+    politica = nova;
+    politicaLidaAmbiente = 1;
+}
+
+/**
+ * @brief Nome de uma política de duplicatas ("manter", "mesclar" ou "rejeitar").
+ */
+const char* nomePoliticaDuplicatas(PoliticaDuplicatas qual){
+    return nomesPoliticas[qual];
+}
+
+/**
+ * @brief Mistura final do splitmix64: espalha cada bit da entrada por toda a saída.
+ */
+static uint64_t misturar(uint64_t x){
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Troca as letras 'A'..'Z' de 8 bytes por minúsculas de uma vez (os demais bytes ficam).
+ */
+static uint64_t minusculasAscii(uint64_t palavra){
+    const uint64_t altos = 0x8080808080808080ULL;
+    uint64_t semAlto = palavra & ~altos;
+    uint64_t depoisDoA = semAlto + 0x3F3F3F3F3F3F3F3FULL;     // Byte com bit alto se >= 'A'
+    uint64_t depoisDoZ = semAlto + 0x2525252525252525ULL;     // Byte com bit alto se > 'Z'
+    uint64_t maiusculas = depoisDoA & ~depoisDoZ & ~palavra & altos;
+    return palavra | (maiusculas >> 2);
+}
+
+/**
+ * @brief Hash de 64 bits das dicas de um item, sem diferenciar maiúsculas ASCII.
+ *
+ * Ao contrário da resposta, a dica não é normalizada: normalizar as cinco
+ * dicas de cada linha custaria mais que ler o CSV. O texto entra de 8 em 8
+ * bytes, com as maiúsculas ASCII trocadas todas de uma vez, e cada bloco passa
+ * pela mistura do splitmix64; o tamanho de cada dica fecha a dica, para que
+ * "ab","c" e "a","bc" sejam diferentes. O hash não é gravado em lugar nenhum.
+ *
+ * @return uint64_t O hash, ou 0 se o item não tiver nenhuma dica.
+ */
+uint64_t calcularHashDicas(const BancoInformacoes* banco, const Item* item){
+    char dica[TAM_MAX_DICA];
+    const DicasItem* dicas = &banco->dicas[item - banco->itens];
+    int codificadas = (item->marcas & ITEM_DICAS_CODIFICADAS) != 0;
+    uint64_t hash = CHECKSUM_INICIAL;
+    size_t total = 0;
+    for (int d = 0; d < MAX_DICAS; d++){
+        const char* texto;
+        size_t tam;
+        if (codificadas){
+            tam = copiarDica(banco, item, d + 1, dica, sizeof(dica));
+            texto = dica;
+        } else {
+            tam = dicas->tamDica[d];
+            texto = obterDica(banco, item, d + 1);
+        }
+        size_t i = 0;
+        for (; i + 8 <= tam; i += 8){
+            uint64_t palavra;
+            memcpy(&palavra, texto + i, 8);
+            hash = (hash ^ misturar(minusculasAscii(palavra))) * 0x9E3779B97F4A7C15ULL;
+        }
+        uint64_t resto = 0;
+        memcpy(&resto, texto + i, tam - i);
+        hash = (hash ^ misturar(minusculasAscii(resto) ^ ((uint64_t)tam << 56))) * 0x9E3779B97F4A7C15ULL;
+        total += tam;
+    }
+    hash = misturar(hash);
+    return (total == 0 || hash == 0) ? 0 : hash;
+}
+
+/**
+ * @brief Acrescenta a um item as dicas que ele ainda não tem, nas posições vazias.
+ *
+ * Dicas iguais depois da normalização a uma que o item já tem são ignoradas;
+ * as que não couberem (sem posição vazia) também.
+ *
+ * @param dicas Vetor com MAX_DICAS dicas candidatas (posições NULL ou vazias são ignoradas).
+ * @return int Quantas dicas foram acrescentadas, ou -1 se faltar memória (o item fica como estava).
+ */
+int mesclarDicasItem(BancoInformacoes* banco, int posicao, const char* dicas[MAX_DICAS]){
+    char textos[MAX_DICAS][TAM_MAX_DICA];
+    char chaves[MAX_DICAS][2 * TAM_MAX_DICA];
+    const char* novas[MAX_DICAS];
+    for (int d = 0; d < MAX_DICAS; d++){
+        size_t tam = copiarDica(banco, &banco->itens[posicao], d + 1, textos[d], TAM_MAX_DICA);
+        normalizarResposta(textos[d], tam, chaves[d], sizeof(chaves[d]));
+        novas[d] = textos[d];
+    }
+
+    int acrescentadas = 0;
+    for (int k = 0; k < MAX_DICAS; k++){
+        if (dicas[k] == NULL || dicas[k][0] == '\0') continue;
+        char chave[2 * TAM_MAX_DICA];
+        if (normalizarResposta(dicas[k], strlen(dicas[k]), chave, sizeof(chave)) == 0) continue;
+        int livre = -1, repetida = 0;
+        for (int d = 0; d < MAX_DICAS && !repetida; d++){
+            if (textos[d][0] == '\0'){
+                if (livre < 0) livre = d;
+            } else {
+                repetida = (strcmp(chaves[d], chave) == 0);
+            }
+        }
+        if (repetida || livre < 0) continue;
+        snprintf(textos[livre], TAM_MAX_DICA, "%s", dicas[k]);
+        strcpy(chaves[livre], chave);
+        acrescentadas++;
+    }
+    if (acrescentadas == 0) return 0;
+    return alterarDicasItem(banco, posicao, novas) != 0 ? -1 : acrescentadas;
+}
+
+/**
+ * @brief Tabela hash de posições de itens (sondagem linear, -1 = vazia).
+ */
+typedef struct{
+    int32_t* posicoes;
+    uint32_t mascara;
+}TabelaItens;
+
+static int criarTabelaItens(TabelaItens* tabela, int itens){
+    uint32_t capacidade = 16;
+    while (capacidade < (uint32_t)itens * 2u) capacidade *= 2;
+    tabela->posicoes = malloc((size_t)capacidade * sizeof(int32_t));
+    if (tabela->posicoes == NULL) return -1;
+    memset(tabela->posicoes, 0xFF, (size_t)capacidade * sizeof(int32_t));
+    tabela->mascara = capacidade - 1;
+    return 0;
+}
+
+/**
+ * @brief Procura um item mantido com a mesma resposta do item i.
+ *
+ * @param livre Saída: posição vazia da tabela onde i seria registrado.
+ * @return int Posição do item anterior, ou -1 se não houver.
+ */
+static int procurarResposta(const TabelaItens* tabela, const BancoInformacoes* banco, int i, uint32_t* livre){
+    const Item* item = &banco->itens[i];
+    const char* chave = obterChaveResposta(banco, item);
+    uint32_t slot = item->hashResposta & tabela->mascara;
+    while (tabela->posicoes[slot] >= 0){
+        const Item* anterior = &banco->itens[tabela->posicoes[slot]];
+        if (anterior->hashResposta == item->hashResposta && anterior->tamChave == item->tamChave &&
+            memcmp(obterChaveResposta(banco, anterior), chave, item->tamChave) == 0){
+            return tabela->posicoes[slot];
+        }
+        slot = (slot + 1) & tabela->mascara;
+    }
+    *livre = slot;
+    return -1;
+}
+
+/**
+ * @brief Diz se dois itens têm as mesmas cinco dicas, sem diferenciar maiúsculas ASCII.
+ *
+ * Confirma uma coincidência do hash de calcularHashDicas(), que sozinho
+ * poderia descartar um item por colisão.
+ */
+static int dicasIguais(const BancoInformacoes* banco, int a, int b){
+    char dicaA[TAM_MAX_DICA], dicaB[TAM_MAX_DICA];
+    for (int d = 1; d <= MAX_DICAS; d++){
+        size_t tamA = copiarDica(banco, &banco->itens[a], d, dicaA, sizeof(dicaA));
+        size_t tamB = copiarDica(banco, &banco->itens[b], d, dicaB, sizeof(dicaB));
+        if (tamA != tamB) return 0;
+        for (size_t k = 0; k < tamA; k++){
+            unsigned char x = (unsigned char)dicaA[k], y = (unsigned char)dicaB[k];
+            if (x >= 'A' && x <= 'Z') x = (unsigned char)(x - 'A' + 'a');
+            if (y >= 'A' && y <= 'Z') y = (unsigned char)(y - 'A' + 'a');
+            if (x != y) return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Procura um item mantido com as mesmas dicas do item i (hash e texto iguais).
+ *
+ * @param livre Saída: posição vazia da tabela onde i seria registrado.
+ * @return int Posição do item anterior, ou -1 se não houver.
+ */
+static int procurarDicas(const TabelaItens* tabela, const BancoInformacoes* banco, const uint64_t* hashes, int i,
+                         uint32_t* livre){
+    uint64_t hash = hashes[i];
+    uint32_t slot = (uint32_t)(hash ^ (hash >> 32)) & tabela->mascara;
+    while (tabela->posicoes[slot] >= 0){
+        int anterior = tabela->posicoes[slot];
+        if (hashes[anterior] == hash && dicasIguais(banco, anterior, i)) return anterior;
+        slot = (slot + 1) & tabela->mascara;
+    }
+    *livre = slot;
+    return -1;
+}
+
+/**
+ * @brief Mostra quantas duplicatas a importação trouxe e o que foi feito com elas.
+ */
+static void mostrarResumo(const ResumoDuplicatas* resumo, int importados, double segundos){
+    long total = resumo->pelaResposta + resumo->pelasDicas;
+    if (total == 0) return;
+    printf("[Aviso] %ld duplicata(s) entre %d item(ns) importado(s): %ld pela resposta, %ld pelas dicas "
+           "(política '%s', %.0f ms).\n", total, importados, resumo->pelaResposta, resumo->pelasDicas,
+           nomePoliticaDuplicatas(resumo->politica), segundos * 1e3);
+    if (resumo->mesclados > 0){
+        printf("[OK] %ld cópia(s) mesclada(s) ao item original, com %ld dica(s) nova(s).\n",
+               resumo->mesclados, resumo->dicasAcrescentadas);
+    }
+    if (resumo->rejeitados > 0){
+        printf("[OK] %ld cópia(s) descartada(s).\n", resumo->rejeitados);
+    }
+}
+
+/**
+ * @brief Aplica a política de duplicatas aos itens recém-importados [inicio, totalItens).
+ *
+ * Os itens anteriores a 'inicio' (já no banco) e os importados mais acima no
+ * arquivo valem como originais; só os importados podem sair. As cópias que
+ * saem são apenas marcadas com ITEM_EXCLUIDO: cabe ao chamador compactar o
+ * banco (e refazer os índices) depois. Se houver duplicatas, o resumo
+ * também é mostrado.
+ *
+ * @param banco Banco com os itens importados no fim, na ordem do arquivo.
+ * @param inicio Posição do primeiro item importado.
+ * @param hashesDicas calcularHashDicas() de cada item importado (hashesDicas[0] é o de 'inicio').
+ * @param resumo Saída: duplicatas encontradas e o que foi feito com elas.
+ * @return int Quantidade de itens marcados como excluídos, ou -1 se faltar memória (nada muda).
+ */
+int tratarDuplicatas(BancoInformacoes* banco, int inicio, const uint64_t* hashesDicas, ResumoDuplicatas* resumo){
+    struct timespec inicioTempo;
+    clock_gettime(CLOCK_MONOTONIC, &inicioTempo);
+    memset(resumo, 0, sizeof(*resumo));
+    resumo->politica = politicaDuplicatas();
+
+    // Os itens que já estavam no banco também entram nas tabelas, com o hash calculado aqui
+    uint64_t* hashes = malloc((size_t)(banco->totalItens > 0 ? banco->totalItens : 1) * sizeof(uint64_t));
+    TabelaItens respostas = {NULL, 0}, dicas = {NULL, 0};
+    if (hashes == NULL || criarTabelaItens(&respostas, banco->totalItens) != 0 ||
+        criarTabelaItens(&dicas, banco->totalItens) != 0){
+        printf("[Erro] Houve um erro na alocação de memória para procurar duplicatas.\n");
+        free(hashes);
+        free(respostas.posicoes);
+        return -1;
+    }
+    for (int i = 0; i < inicio; i++){
+        if (!(banco->itens[i].marcas & ITEM_EXCLUIDO)) hashes[i] = calcularHashDicas(banco, &banco->itens[i]);
+    }
+    memcpy(hashes + inicio, hashesDicas, (size_t)(banco->totalItens - inicio) * sizeof(uint64_t));
+
+    int removidos = 0;
+    char textos[MAX_DICAS][TAM_MAX_DICA];
+    const char* dicasCopia[MAX_DICAS];
+    for (int i = 0; i < banco->totalItens; i++){
+        if (banco->itens[i].marcas & ITEM_EXCLUIDO) continue;
+        // Só os itens que ficam entram nas tabelas: uma cópia descartada não pode virar original
+        uint32_t livreResposta = 0, livreDicas = 0;
+        int original = procurarResposta(&respostas, banco, i, &livreResposta);
+        int pelaResposta = (original >= 0);
+        int dicasNovas = 0;
+        if (hashes[i] != 0){
+            int mesmasDicas = procurarDicas(&dicas, banco, hashes, i, &livreDicas);
+            dicasNovas = (mesmasDicas < 0);
+            if (!pelaResposta) original = mesmasDicas;
+        }
+        int descartar = 0;
+        if (original >= 0 && i >= inicio){      // Repetições antigas do banco não são da importação
+            if (pelaResposta) resumo->pelaResposta++;
+            else resumo->pelasDicas++;
+            if (resumo->politica == DUPLICATAS_MESCLAR && pelaResposta){
+                for (int d = 0; d < MAX_DICAS; d++){
+                    copiarDica(banco, &banco->itens[i], d + 1, textos[d], TAM_MAX_DICA);
+                    dicasCopia[d] = textos[d];
+                }
+                int acrescentadas = mesclarDicasItem(banco, original, dicasCopia);
+                if (acrescentadas >= 0){        // Sem memória para mesclar: a cópia fica
+                    resumo->mesclados++;
+                    resumo->dicasAcrescentadas += acrescentadas;
+                    descartar = 1;
+                }
+            } else if (resumo->politica != DUPLICATAS_MANTER){
+                resumo->rejeitados++;
+                descartar = 1;
+            }
+        }
+        if (!descartar){
+            if (!pelaResposta) respostas.posicoes[livreResposta] = i;
+            if (dicasNovas) dicas.posicoes[livreDicas] = i;
+            continue;
+        }
+
+        desindexarDicasItem(banco, i);
+        banco->itens[i].marcas |= ITEM_EXCLUIDO;
+        banco->totalExcluidos++;
+        removidos++;
+    }
+    free(hashes);
+    free(respostas.posicoes);
+    free(dicas.posicoes);
+    mostrarResumo(resumo, banco->totalItens - inicio, segundosDesde(&inicioTempo));
+    return removidos;
+}
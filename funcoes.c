@@ -11,9 +11,11 @@
  * 
  * - Leitura segura de strings a partir da entrada padrão, com normalização de caixa.
  * - Inicialização e liberação do banco de informações dinâmico.
- * - Inserção, listagem, pesquisa, alteração e exclusão de itens no banco.
- * - Leitura do arquivo CSV
- * - Salvamento e carregamento dos dados em arquivos binários, preservando o estado do jogo.
+ * - Inserção, listagem, pesquisa, alteração e exclusão de itens no banco, com
+ *   identificadores estáveis, exclusão por marcação e compactação periódica.
+ * - Leitura do arquivo CSV, mapeado em memória e processado em paralelo
+ * - Salvamento e carregamento dos dados em snapshots binários mapeáveis em memória,
+ *   preservando o estado do jogo entre execuções.
  * 
  * O arquivo faz uso de alocação dinâmica de memória (`malloc`, `realloc`, `free`) e controle de erros
  * básico, garantindo maior robustez durante as operações de inserção e expansão do banco de dados.
@@ -26,11 +28,23 @@
  * @copyright Copyright (c) 2025
  * 
  */
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <errno.h>
 #include <time.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#else
+#include <io.h>
+#endif
 #include "funcoes.h"
 
 /**
@@ -39,7 +53,7 @@
  * Esta função realiza as seguintes operações:
  * 1. Limpa o buffer de entrada (`stdin`).
  * 2. Lê uma string (incluindo espaços) até o tamanho máximo especificado.
- * 3. Converte todos os caracteres da string lida para minúsculas.
+ * 3. Converte as letras ASCII da string lida para minúsculas (acentos são tratados por normalizarResposta()).
  * 4. Remove o caractere de nova linha ('\n') adicionado pelo fgets, substituindo-o por um terminador nulo ('\0').
  *
  * @note Requer as bibliotecas <stdio.h>, <string.h> e <ctype.h> para funcionar corretamente.
@@ -47,103 +61,1545 @@
  * @param texto Ponteiro para o array de caracteres (string) onde o texto lido será armazenado.
  * @param tamanho O tamanho máximo do array 'texto', que limita o número de caracteres a serem lidos.
  *
- * @return void Esta função não retorna valor.
+ * @return void Esta função não retorna valor.
+ */
+void lerString(char texto[], int tamanho){
+    fgets(texto, tamanho, stdin);
+    for (int i = 0; texto[i]; i++){
+        // Só ASCII: com setlocale(), tolower() trocaria bytes de caracteres UTF-8
+        if ((unsigned char)texto[i] < 0x80) texto[i] = tolower((unsigned char)texto[i]);
+    }
+    texto[strcspn(texto, "\n")] = '\0';
+    setbuf(stdin, NULL);
+}
+
+/**
+ * @brief Remove todos os caracteres de espaço (' ') de uma string.
+ *
+ * Esta função percorre a string, copiando apenas os caracteres que não são espaço
+ * para o início da mesma string, efetivamente eliminando os espaços.
+ *
+ * @param str A string a ser processada.
+ * @return void
+ */
+void removerEspacos(char str[]){
+    int i, j = 0;
+    // Percorre a string
+    for (i = 0; str[i] != '\0'; i++) {
+        // Se o caractere atual NÃO for um espaço, ele é copiado
+        if (str[i] != ' ') {
+            str[j] = str[i];
+            j++;
+        }
+    }
+    // Finaliza a nova string no ponto correto
+    str[j] = '\0';
+}
+
+/**
+ * @brief Garante que caibam mais 'extra' bytes na arena, dobrando sua capacidade se preciso.
+ *
+ * @param arena Arena de textos do banco.
+ * @param extra Quantidade de bytes que será acrescentada a partir de arena->usado.
+ * @return int 0 em caso de sucesso, -1 se faltar memória ou se o limite de 4 GiB for excedido.
+ */
+static int reservarTextos(ArenaTexto* arena, size_t extra){
+    if (arena->usado + extra <= arena->capacidade) return 0;
+
+    // Os deslocamentos dos itens são de 32 bits
+    if (arena->usado + extra > UINT32_MAX){
+        printf("[Erro] A arena de textos excedeu o limite de 4 GiB.\n");
+        return -1;
+    }
+    size_t novaCapacidade = arena->capacidade * 2;
+    while (novaCapacidade < arena->usado + extra) novaCapacidade *= 2;
+    if (novaCapacidade > UINT32_MAX) novaCapacidade = UINT32_MAX;
+
+    char* novosDados = realloc(arena->dados, novaCapacidade);
+    if (novosDados == NULL){
+        printf("[Erro] Houve um erro na realocação de memória para os textos do banco.\n");
+        return -1;
+    }
+    arena->dados = novosDados;
+    arena->capacidade = novaCapacidade;
+    return 0;
+}
+
+/**
+ * @brief Copia um trecho de texto (não necessariamente terminado em '\0') para o fim da arena.
+ *
+ * O trecho é truncado em (limite - 1) bytes, mesmo limite dos antigos vetores
+ * fixos de Item, e gravado com terminador '\0'. Textos vazios não ocupam
+ * espaço: todos apontam para o deslocamento 0, reservado para a string vazia.
+ *
+ * @param arena Arena de textos do banco.
+ * @param texto Início do trecho a ser copiado.
+ * @param tam Quantidade de bytes do trecho.
+ * @param limite Tamanho máximo do campo, incluindo o '\0'.
+ * @param deslocamento Saída: posição do texto na arena.
+ * @param tamanho Saída: tamanho do texto gravado, sem o '\0'.
+ * @return int 0 em caso de sucesso, -1 se faltar memória.
+ */
+static int guardarTrecho(ArenaTexto* arena, const char* texto, size_t tam, size_t limite,
+                         uint32_t* deslocamento, uint16_t* tamanho){
+    if (tam > limite - 1) tam = limite - 1;
+    if (tam == 0){
+        *deslocamento = 0;
+        *tamanho = 0;
+        return 0;
+    }
+
+    if (reservarTextos(arena, tam + 1) != 0) return -1;
+
+    memcpy(arena->dados + arena->usado, texto, tam);
+    arena->dados[arena->usado + tam] = '\0';
+    *deslocamento = (uint32_t)arena->usado;
+    *tamanho = (uint16_t)tam;
+    arena->usado += tam + 1;
+    return 0;
+}
+
+/**
+ * @brief Conteúdo de um arquivo inteiro disponível em memória para leitura.
+ *
+ * Em sistemas POSIX o arquivo é mapeado com mmap(); no Windows ele é lido
+ * para um buffer alocado. Em ambos os casos é liberado por desmapearArquivo().
+ */
+typedef struct{
+    const char* dados;
+    size_t tamanho;
+    int mapeado;    // 1 se veio de mmap(), 0 se foi lido para um buffer
+}ArquivoMapeado;
+
+/**
+ * @brief Disponibiliza o conteúdo de um arquivo em memória.
+ *
+ * Com 'gravavel' = 1 o mapeamento é privado e permite escrita (copy-on-write):
+ * as páginas alteradas são copiadas só para este processo e o arquivo não muda.
+ *
+ * @param caminho Caminho do arquivo.
+ * @param gravavel 1 para permitir escrita na memória mapeada, 0 para somente leitura.
+ * @param arquivo Saída: ponteiro e tamanho do conteúdo.
+ * @return int 0 em caso de sucesso, -1 se o arquivo não puder ser aberto ou lido.
+ */
+static int mapearArquivo(const char* caminho, int gravavel, ArquivoMapeado* arquivo){
+    arquivo->dados = "";
+    arquivo->tamanho = 0;
+    arquivo->mapeado = 0;
+#ifndef _WIN32
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat info;
+    if (fstat(fd, &info) != 0){
+        close(fd);
+        return -1;
+    }
+    if (info.st_size > 0){
+        int protecao = gravavel ? (PROT_READ | PROT_WRITE) : PROT_READ;
+        void* dados = mmap(NULL, (size_t)info.st_size, protecao, MAP_PRIVATE, fd, 0);
+        if (dados == MAP_FAILED){
+            close(fd);
+            return -1;
+        }
+        arquivo->dados = dados;
+        arquivo->tamanho = (size_t)info.st_size;
+        arquivo->mapeado = 1;
+    }
+    close(fd); // O mapeamento continua válido depois do close
+    return 0;
+#else
+    FILE* f = fopen(caminho, "rb");
+    if (f == NULL) return -1;
+    fseek(f, 0, SEEK_END);
+    long tamanho = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (tamanho > 0){
+        char* dados = malloc((size_t)tamanho);
+        if (dados == NULL || fread(dados, 1, (size_t)tamanho, f) != (size_t)tamanho){
+            free(dados);
+            fclose(f);
+            return -1;
+        }
+        arquivo->dados = dados;
+        arquivo->tamanho = (size_t)tamanho;
+    }
+    fclose(f);
+    (void)gravavel;
+    return 0;
+#endif
+}
+
+/**
+ * @brief Libera a memória obtida por mapearArquivo().
+ */
+static void desmapearArquivo(ArquivoMapeado* arquivo){
+#ifndef _WIN32
+    if (arquivo->mapeado) munmap((void*)arquivo->dados, arquivo->tamanho);
+#else
+    if (arquivo->tamanho > 0) free((void*)arquivo->dados);
+#endif
+    arquivo->dados = "";
+    arquivo->tamanho = 0;
+    arquivo->mapeado = 0;
+}
+
+/**
+ * @brief Converte um banco que usa um snapshot mapeado em um banco com vetores no heap.
+ *
+ * Bancos abertos por abrirSnapshot() podem ser lidos e alterados no lugar, mas
+ * não podem crescer (realloc) enquanto apontam para o mapeamento. Esta função é
+ * chamada antes de qualquer crescimento: copia itens, dicas, textos e categorias para o heap,
+ * com folga, e desfaz o mapeamento.
+ *
+ * @param banco Ponteiro para a estrutura BancoInformacoes.
+ * @return int 0 em caso de sucesso (ou se o banco já estava no heap), -1 se faltar memória.
+ */
+int prepararEscrita(BancoInformacoes* banco){
+    if (banco->mapeamento == NULL) return 0;
+
+    int capacidade = banco->totalItens + banco->totalItens / 2 + 16;
+    size_t capacidadeTextos = banco->textos.usado + banco->textos.usado / 2 + 4096;
+    if (capacidadeTextos > UINT32_MAX) capacidadeTextos = UINT32_MAX;
+    uint32_t capacidadeCategorias = banco->categorias.total * 2;
+    Item* itens = malloc((size_t)capacidade * sizeof(Item));
+    DicasItem* dicas = malloc((size_t)capacidade * sizeof(DicasItem));
+    char* textos = malloc(capacidadeTextos);
+    uint32_t* nomesCategorias = malloc(capacidadeCategorias * sizeof(uint32_t));
+    if (itens == NULL || dicas == NULL || textos == NULL || nomesCategorias == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para copiar o banco.\n");
+        free(itens);
+        free(dicas);
+        free(textos);
+        free(nomesCategorias);
+        return -1;
+    }
+    memcpy(itens, banco->itens, (size_t)banco->totalItens * sizeof(Item));
+    memcpy(dicas, banco->dicas, (size_t)banco->totalItens * sizeof(DicasItem));
+    memcpy(textos, banco->textos.dados, banco->textos.usado);
+    memcpy(nomesCategorias, banco->categorias.nomes, banco->categorias.total * sizeof(uint32_t));
+
+    ArquivoMapeado arquivo = {banco->mapeamento, banco->tamanhoMapeamento, 1};
+    desmapearArquivo(&arquivo);
+    banco->mapeamento = NULL;
+    banco->tamanhoMapeamento = 0;
+    banco->itens = itens;
+    banco->dicas = dicas;
+    banco->textos.dados = textos;
+    banco->textos.capacidade = capacidadeTextos;
+    banco->capacidadeArmazenamento = capacidade;
+    banco->categorias.nomes = nomesCategorias;
+    banco->categorias.capacidade = capacidadeCategorias;
+    return 0;
+}
+
+/**
+ * @brief Garante espaço para pelo menos 'minimo' itens nos vetores do banco.
+ *
+ * A capacidade é dobrada até atingir o mínimo pedido, realocando com
+ * crescerVetor() os vetores paralelos de itens e de dicas. Se faltar memória,
+ * a capacidade do banco não muda e os dois vetores continuam válidos para ela.
+ *
+ * @param banco Ponteiro para a estrutura BancoInformacoes.
+ * @param minimo Quantidade de itens que deve caber no banco.
+ * @return int 0 em caso de sucesso, -1 se faltar memória.
+ */
+static int garantirCapacidade(BancoInformacoes* banco, int minimo){
+    if (minimo <= banco->capacidadeArmazenamento) return 0;
+    if (prepararEscrita(banco) != 0) return -1;
+    if (minimo <= banco->capacidadeArmazenamento) return 0;
+
+    // Cada vetor cresce com a sua própria capacidade; a do banco só muda quando os dois cresceram.
+    // Se o segundo falhar, o primeiro fica maior que o necessário, mas o banco continua válido
+    size_t capacidadeItens = (size_t)banco->capacidadeArmazenamento;
+    size_t capacidadeDicas = (size_t)banco->capacidadeArmazenamento;
+    if (crescerVetor((void**)&banco->itens, &capacidadeItens, (size_t)minimo, sizeof(Item)) != 0 ||
+        crescerVetor((void**)&banco->dicas, &capacidadeDicas, (size_t)minimo, sizeof(DicasItem)) != 0){
+        printf("[Erro] Houve um erro na realocação de memória para expandir o banco.\n");
+        return -1;
+    }
+    size_t capacidade = capacidadeItens < capacidadeDicas ? capacidadeItens : capacidadeDicas;
+    banco->capacidadeArmazenamento = capacidade > INT32_MAX ? INT32_MAX : (int)capacidade;
+    return 0;
+}
+
+/**
+ * @brief Letras de U+00C0 a U+00FF (À..ÿ) sem acento e em minúsculas ("" = descartar).
+ *
+ * Servem tanto para a forma UTF-8 (0xC3 seguido de 0x80..0xBF) quanto para o
+ * byte Latin-1 isolado, que alguns consoles do Windows ainda enviam.
+ */
+static const char* const letrasSemAcento[64] = {
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",    // À..Ï
+    "d", "n", "o", "o", "o", "o", "o", "", "o", "u", "u", "u", "u", "y", "th", "ss",    // Ð..ß (× descartado)
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",    // à..ï
+    "d", "n", "o", "o", "o", "o", "o", "", "o", "u", "u", "u", "u", "y", "th", "y"      // ð..ÿ (÷ descartado)
+};
+
+/**
+ * @brief Gera a chave de comparação de uma resposta ou palpite.
+ *
+ * A chave tem só letras minúsculas sem acento e dígitos: espaços, pontuação e
+ * símbolos são descartados e as letras acentuadas do português (e do resto do
+ * Latin-1: "ç" vira "c", "ß" vira "ss") perdem o acento, tanto em UTF-8 quanto
+ * em Latin-1. Assim "Alan Turing", "alan-turing" e "ALANTURING" têm a mesma
+ * chave, e "Pelé" é igual a "pele". Outros caracteres UTF-8 (fora do Latin-1)
+ * são mantidos como estão. Não depende de setlocale().
+ *
+ * É a rotina usada tanto para a chave guardada com cada resposta (ver
+ * obterChaveResposta()) quanto para os palpites e buscas.
+ *
+ * @param texto Resposta original.
+ * @param tam Tamanho da resposta em bytes.
+ * @param saida Buffer que recebe a chave (terminada em '\0').
+ * @param tamSaida Tamanho do buffer de saída.
+ * @return size_t Tamanho da chave gerada.
+ */
+size_t normalizarResposta(const char* texto, size_t tam, char* saida, size_t tamSaida){
+    const unsigned char* p = (const unsigned char*)texto;
+    size_t n = 0;
+    for (size_t i = 0; i < tam && p[i] != '\0' && n + 1 < tamSaida; i++){
+        unsigned char c = p[i];
+        if (c < 0x80){
+            if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) saida[n++] = (char)c;
+            else if (c >= 'A' && c <= 'Z') saida[n++] = (char)(c - 'A' + 'a');
+            continue;
+        }
+        int continuacao = (i + 1 < tam) && (p[i + 1] & 0xC0) == 0x80;
+        if (c >= 0xC0 && !continuacao){
+            c -= 0xC0;                                          // Byte Latin-1 isolado (À..ÿ)
+        } else if (c == 0xC3){
+            c = p[++i] - 0x80;                                  // U+00C0..U+00FF em UTF-8
+        } else if (c == 0xC2 || c < 0xC0){
+            i += (c == 0xC2);                                   // U+0080..U+00BF ou símbolo Latin-1: descarta
+            continue;
+        } else {
+            // Demais sequências UTF-8: mantidas inteiras, exceto a pontuação geral (U+2000..U+206F)
+            size_t tamSequencia = (c >= 0xF0) ? 4 : (c >= 0xE0) ? 3 : 2;
+            if (i + tamSequencia > tam) break;
+            int pontuacao = (c == 0xE2 && (p[i + 1] == 0x80 || p[i + 1] == 0x81));
+            if (!pontuacao){
+                if (n + tamSequencia >= tamSaida) break;
+                memcpy(saida + n, p + i, tamSequencia);
+                n += tamSequencia;
+            }
+            i += tamSequencia - 1;
+            continue;
+        }
+        for (const char* letra = letrasSemAcento[c]; *letra != '\0' && n + 1 < tamSaida; letra++){
+            saida[n++] = *letra;
+        }
+    }
+    saida[n] = '\0';
+    return n;
+}
+
+/**
+ * @brief Hash FNV-1a de 32 bits de um trecho de bytes.
+ *
+ * Usado pelo índice de respostas, pelas categorias e pelas tabelas de palavras
+ * do dicionário das dicas (compressao.c) e do índice invertido (indice.c).
+ */
+uint32_t hashBytes(const char* dados, size_t tam){
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < tam; i++){
+        hash ^= (unsigned char)dados[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Calcula o hash da chave normalizada de uma resposta.
+ *
+ * @return uint32_t Hash guardado em Item::hashResposta e usado pelo índice.
+ */
+uint32_t calcularHashResposta(const char* resposta, size_t tam){
+    char chave[TAM_MAX_RESPOSTA];
+    size_t tamChave = normalizarResposta(resposta, tam, chave, sizeof(chave));
+    return hashBytes(chave, tamChave);
+}
+
+/**
+ * @brief Grava a resposta de um item seguida da sua chave normalizada ("resposta\0chave\0").
+ *
+ * A resposta é truncada em TAM_MAX_RESPOSTA - 1 bytes e, ao contrário dos
+ * outros textos, é gravada mesmo vazia: a chave fica sempre logo depois dela
+ * (ver obterChaveResposta()). Também calcula Item::hashResposta.
+ *
+ * @return int 0 em caso de sucesso, -1 se faltar memória.
+ */
+static int guardarResposta(ArenaTexto* arena, const char* resposta, size_t tam, Item* item){
+    if (tam > TAM_MAX_RESPOSTA - 1) tam = TAM_MAX_RESPOSTA - 1;
+    char chave[TAM_MAX_RESPOSTA];
+    size_t tamChave = normalizarResposta(resposta, tam, chave, sizeof(chave));
+    if (reservarTextos(arena, tam + tamChave + 2) != 0) return -1;
+
+    char* destino = arena->dados + arena->usado;
+    memcpy(destino, resposta, tam);
+    destino[tam] = '\0';
+    memcpy(destino + tam + 1, chave, tamChave + 1);
+    item->resposta = (uint32_t)arena->usado;
+    item->tamResposta = (uint8_t)tam;
+    item->tamChave = (uint8_t)tamChave;
+    item->hashResposta = hashBytes(chave, tamChave);
+    arena->usado += tam + tamChave + 2;
+    return 0;
+}
+
+/**
+ * @brief Libera o índice de respostas; ele será refeito na próxima busca.
+ */
+static void descartarIndiceRespostas(BancoInformacoes* banco){
+    free(banco->indice.posicoes);
+    banco->indice.posicoes = NULL;
+    banco->indice.capacidade = 0;
+    banco->indice.ocupadas = 0;
+}
+
+/**
+ * @brief Grava a posição de um item na tabela do índice, sem verificar a carga.
+ */
+static void inserirNaTabela(IndiceRespostas* indice, uint32_t hash, int32_t posicao){
+    uint32_t mascara = indice->capacidade - 1;
+    uint32_t slot = hash & mascara;
+    while (indice->posicoes[slot] >= 0){
+        slot = (slot + 1) & mascara;
+    }
+    if (indice->posicoes[slot] == INDICE_VAZIO) indice->ocupadas++;
+    indice->posicoes[slot] = posicao;
+}
+
+/**
+ * @brief (Re)constrói de uma vez o índice de respostas do banco.
+ *
+ * A tabela usa endereçamento aberto com sondagem linear e tem capacidade
+ * potência de 2 de pelo menos o dobro do número de itens. Como o hash de cada
+ * resposta já fica guardado no Item, a construção não lê os textos. Itens
+ * marcados como excluídos não entram no índice.
+ *
+ * @param banco Ponteiro para a estrutura BancoInformacoes.
+ * @return int 0 em caso de sucesso, -1 se faltar memória.
+ */
+int construirIndiceRespostas(BancoInformacoes* banco){
+    uint32_t capacidade = 16;
+    while (capacidade < (uint32_t)banco->totalItens * 2u) capacidade *= 2;
+
+    int32_t* posicoes = malloc((size_t)capacidade * sizeof(int32_t));
+    if (posicoes == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para o índice de respostas.\n");
+        return -1;
+    }
+    for (uint32_t s = 0; s < capacidade; s++) posicoes[s] = INDICE_VAZIO;
+
+    descartarIndiceRespostas(banco);
+    banco->indice.posicoes = posicoes;
+    banco->indice.capacidade = capacidade;
+    for (int i = 0; i < banco->totalItens; i++){
+        if (banco->itens[i].marcas & ITEM_EXCLUIDO) continue;
+        inserirNaTabela(&banco->indice, banco->itens[i].hashResposta, i);
+    }
+    return 0;
+}
+
+/**
+ * @brief Acrescenta um item ao índice de respostas, se o índice já existir.
+ *
+ * Quando a ocupação (incluindo entradas removidas) passa de 3/4, a tabela é
+ * reconstruída com o dobro do tamanho. Se o índice ainda não foi construído,
+ * nada é feito: ele incluirá o item quando for construído.
+ */
+static void indexarItem(BancoInformacoes* banco, int posicao){
+    IndiceRespostas* indice = &banco->indice;
+    if (indice->posicoes == NULL) return;
+    if ((indice->ocupadas + 1) * 4 > indice->capacidade * 3){
+        if (construirIndiceRespostas(banco) != 0) descartarIndiceRespostas(banco);
+        return; // A reconstrução já inclui o novo item
+    }
+    inserirNaTabela(indice, banco->itens[posicao].hashResposta, posicao);
+}
+
+/**
+ * @brief Retira um item do índice de respostas, deixando uma marca de remoção.
+ */
+static void desindexarItem(BancoInformacoes* banco, int posicao){
+    IndiceRespostas* indice = &banco->indice;
+    if (indice->posicoes == NULL) return;
+    uint32_t mascara = indice->capacidade - 1;
+    uint32_t slot = banco->itens[posicao].hashResposta & mascara;
+    while (indice->posicoes[slot] != INDICE_VAZIO){
+        if (indice->posicoes[slot] == posicao){
+            indice->posicoes[slot] = INDICE_REMOVIDO;
+            return;
+        }
+        slot = (slot + 1) & mascara;
+    }
+}
+
+/**
+ * @brief Localiza um item pela resposta usando o índice de respostas.
+ *
+ * A resposta buscada é normalizada (normalizarResposta()) e o índice é
+ * consultado em tempo constante, comparando com a chave guardada de cada item; ele é construído na primeira busca se
+ * ainda não existir (por exemplo, logo após abrir um snapshot).
+ *
+ * @param banco Ponteiro para a estrutura BancoInformacoes.
+ * @param resposta Resposta (nome) procurada.
+ * @return int Posição do item em banco->itens, ou -1 se não existir.
+ */
+int buscarItemPorResposta(BancoInformacoes* banco, const char* resposta){
+    if (banco == NULL || banco->totalItens == 0) return -1;
+    if (banco->indice.posicoes == NULL && construirIndiceRespostas(banco) != 0) return -1;
+
+    char chave[TAM_MAX_RESPOSTA];
+    size_t tamChave = normalizarResposta(resposta, strlen(resposta), chave, sizeof(chave));
+    uint32_t hash = hashBytes(chave, tamChave);
+
+    IndiceRespostas* indice = &banco->indice;
+    uint32_t mascara = indice->capacidade - 1;
+    uint32_t slot = hash & mascara;
+    while (indice->posicoes[slot] != INDICE_VAZIO){
+        int32_t posicao = indice->posicoes[slot];
+        if (posicao >= 0 && banco->itens[posicao].hashResposta == hash){
+            const Item* item = &banco->itens[posicao];
+            if (item->tamChave == tamChave && memcmp(obterChaveResposta(banco, item), chave, tamChave) == 0){
+                return posicao;
+            }
+        }
+        slot = (slot + 1) & mascara;
+    }
+    return -1;
+}
+
+/**
+ * @brief Chave normalizada de uma categoria, gravada na arena logo depois do nome.
+ */
+static const char* chaveCategoria(const BancoInformacoes* banco, uint32_t categoria){
+    const char* nome = banco->textos.dados + banco->categorias.nomes[categoria];
+    return nome + strlen(nome) + 1;
+}
+
+/**
+ * @brief (Re)constrói a tabela hash das categorias com espaço para pelo menos 'minimo' delas.
+ *
+ * @return int 0 em caso de sucesso, -1 se faltar memória (a tabela anterior continua).
+ */
+static int construirTabelaCategorias(BancoInformacoes* banco, uint32_t minimo){
+    CategoriasBanco* categorias = &banco->categorias;
+    uint32_t capacidade = 16;
+    while (capacidade < minimo * 2u) capacidade *= 2;
+    uint16_t* tabela = calloc(capacidade, sizeof(uint16_t));
+    if (tabela == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para a tabela de categorias.\n");
+        return -1;
+    }
+    free(categorias->tabela);
+    categorias->tabela = tabela;
+    categorias->capacidadeTabela = capacidade;
+    for (uint32_t c = 1; c < categorias->total; c++){
+        const char* chave = chaveCategoria(banco, c);
+        uint32_t slot = hashBytes(chave, strlen(chave)) & (capacidade - 1);
+        while (tabela[slot] != 0) slot = (slot + 1) & (capacidade - 1);
+        tabela[slot] = (uint16_t)c;
+    }
+    return 0;
+}
+
+/**
+ * @brief Procura uma categoria pela chave normalizada.
+ *
+ * @return int Identificador da categoria (0 para a chave vazia), ou -1 se não existir.
+ */
+static int localizarCategoria(const BancoInformacoes* banco, const char* chave, size_t tamChave){
+    if (tamChave == 0) return 0;
+    const CategoriasBanco* categorias = &banco->categorias;
+    if (categorias->tabela == NULL) return -1;
+    uint32_t mascara = categorias->capacidadeTabela - 1;
+    uint32_t slot = hashBytes(chave, tamChave) & mascara;
+    while (categorias->tabela[slot] != 0){
+        const char* outra = chaveCategoria(banco, categorias->tabela[slot]);
+        if (memcmp(outra, chave, tamChave) == 0 && outra[tamChave] == '\0') return categorias->tabela[slot];
+        slot = (slot + 1) & mascara;
+    }
+    return -1;
+}
+
+/**
+ * @brief Cadastra uma categoria cujo nome (seguido da chave) já está na arena.
+ *
+ * @return int Identificador da nova categoria, ou -1 se faltar memória ou se
+ * o banco já tiver MAX_CATEGORIAS categorias.
+ */
+static int registrarCategoria(BancoInformacoes* banco, uint32_t deslocamento){
+    CategoriasBanco* categorias = &banco->categorias;
+    if (categorias->total >= MAX_CATEGORIAS){
+        printf("[Erro] O banco já tem o máximo de %d categorias.\n", MAX_CATEGORIAS - 1);
+        return -1;
+    }
+    if (prepararEscrita(banco) != 0) return -1;
+    if (categorias->total == categorias->capacidade){
+        uint32_t capacidade = categorias->capacidade * 2;
+        uint32_t* nomes = realloc(categorias->nomes, capacidade * sizeof(uint32_t));
+        if (nomes == NULL){
+            printf("[Erro] Houve um erro na realocação de memória para as categorias.\n");
+            return -1;
+        }
+        categorias->nomes = nomes;
+        categorias->capacidade = capacidade;
+    }
+    uint32_t categoria = categorias->total;
+    categorias->nomes[categoria] = deslocamento;
+    categorias->total++;
+    // Carga máxima de 1/2; a reconstrução já inclui a categoria nova
+    if (categorias->total * 2 > categorias->capacidadeTabela){
+        if (construirTabelaCategorias(banco, categorias->total) != 0){
+            categorias->total--;
+            return -1;
+        }
+        return (int)categoria;
+    }
+    const char* chave = chaveCategoria(banco, categoria);
+    uint32_t mascara = categorias->capacidadeTabela - 1;
+    uint32_t slot = hashBytes(chave, strlen(chave)) & mascara;
+    while (categorias->tabela[slot] != 0) slot = (slot + 1) & mascara;
+    categorias->tabela[slot] = (uint16_t)categoria;
+    return (int)categoria;
+}
+
+/**
+ * @brief Identificador da categoria com este nome, cadastrando-a se ainda não existir.
+ *
+ * O nome é truncado em TAM_MAX_CATEGORIA - 1 bytes. Nomes sem letras nem
+ * dígitos (chave vazia) são a categoria 0.
+ *
+ * @return int Identificador da categoria, ou -1 em caso de falha.
+ */
+static int internarCategoria(BancoInformacoes* banco, const char* nome, size_t tam){
+    if (tam > TAM_MAX_CATEGORIA - 1) tam = TAM_MAX_CATEGORIA - 1;
+    char chave[TAM_MAX_CATEGORIA];
+    size_t tamChave = normalizarResposta(nome, tam, chave, sizeof(chave));
+    int categoria = localizarCategoria(banco, chave, tamChave);
+    if (categoria >= 0) return categoria;
+
+    if (prepararEscrita(banco) != 0 || reservarTextos(&banco->textos, tam + tamChave + 2) != 0) return -1;
+    uint32_t deslocamento = (uint32_t)banco->textos.usado;
+    char* destino = banco->textos.dados + deslocamento;
+    memcpy(destino, nome, tam);
+    destino[tam] = '\0';
+    memcpy(destino + tam + 1, chave, tamChave + 1);
+    banco->textos.usado += tam + tamChave + 2;
+    return registrarCategoria(banco, deslocamento);
+}
+
+/**
+ * @brief Localiza uma categoria pelo nome.
+ *
+ * O nome é comparado pela chave normalizada (normalizarResposta()): não
+ * importam maiúsculas, acentos nem pontuação.
+ *
+ * @param banco Ponteiro para a estrutura BancoInformacoes.
+ * @param nome Nome da categoria.
+ * @return int Identificador da categoria (0 se o nome não tiver letras nem
+ * dígitos), ou -1 se não houver categoria com esse nome.
+ */
+int buscarCategoria(const BancoInformacoes* banco, const char* nome){
+    char chave[TAM_MAX_CATEGORIA];
+    size_t tamChave = normalizarResposta(nome, strlen(nome), chave, sizeof(chave));
+    return localizarCategoria(banco, chave, tamChave);
+}
+
+/**
+ * @brief Retorna o nome de uma categoria pelo seu identificador.
+ *
+ * @return const char* Nome da categoria (vazio para a categoria 0 ou um identificador inválido).
+ */
+const char* nomeCategoria(const BancoInformacoes* banco, int categoria){
+    if (categoria < 0 || (uint32_t)categoria >= banco->categorias.total) return banco->textos.dados;
+    return banco->textos.dados + banco->categorias.nomes[categoria];
+}
+
+/**
+ * @brief Libera o índice composto (categoria, nível); os sorteadores varrem o banco enquanto ele não for refeito.
+ */
+static void descartarIndiceCategorias(BancoInformacoes* banco){
+    free(banco->indiceCategorias.posicoes);
+    free(banco->indiceCategorias.inicios);
+    banco->indiceCategorias.posicoes = NULL;
+    banco->indiceCategorias.inicios = NULL;
+    banco->indiceCategorias.totalCategorias = 0;
+}
+
+/**
+ * @brief (Re)constrói o índice composto (categoria, nível) -> posições dos itens.
+ *
+ * É uma ordenação por contagem, em duas passadas lineares pelo vetor de dicas:
+ * conta os itens de cada faixa (categoria, nível), acumula as contagens em
+ * 'inicios' e distribui as posições. Dentro de cada faixa os itens ficam na
+ * ordem do banco. Itens excluídos não entram no índice.
+ *
+ * @param banco Ponteiro para a estrutura BancoInformacoes.
+ * @return int 0 em caso de sucesso, -1 se faltar memória (o banco fica sem índice).
+ */
+int construirIndiceCategorias(BancoInformacoes* banco){
+    descartarIndiceCategorias(banco);
+    uint32_t totalCategorias = banco->categorias.total;
+    size_t faixas = (size_t)totalCategorias * NUM_NIVEIS;
+    uint32_t* inicios = calloc(faixas + 1, sizeof(uint32_t));
+    int32_t* posicoes = malloc(((size_t)banco->totalItens + 1) * sizeof(int32_t));
+    if (inicios == NULL || posicoes == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para o índice de categorias.\n");
+        free(inicios);
+        free(posicoes);
+        return -1;
+    }
+
+    for (int i = 0; i < banco->totalItens; i++){
+        const Item* item = &banco->itens[i];
+        uint32_t categoria = banco->dicas[i].categoria;
+        if ((item->marcas & ITEM_EXCLUIDO) || categoria >= totalCategorias ||
+            item->nivel < MUITOFACIL || item->nivel > MUITODIFICIL) continue;
+        inicios[(size_t)categoria * NUM_NIVEIS + item->nivel]++;
+    }
+    for (size_t f = 1; f <= faixas; f++) inicios[f] += inicios[f - 1];
+    // Cada posição avança o início da sua faixa, que termina no início da seguinte...
+    for (int i = 0; i < banco->totalItens; i++){
+        const Item* item = &banco->itens[i];
+        uint32_t categoria = banco->dicas[i].categoria;
+        if ((item->marcas & ITEM_EXCLUIDO) || categoria >= totalCategorias ||
+            item->nivel < MUITOFACIL || item->nivel > MUITODIFICIL) continue;
+        posicoes[inicios[(size_t)categoria * NUM_NIVEIS + item->nivel - 1]++] = i;
+    }
+    // ... e por isso os inícios voltam uma faixa
+    memmove(inicios + 1, inicios, faixas * sizeof(uint32_t));
+    inicios[0] = 0;
+
+    banco->indiceCategorias.posicoes = posicoes;
+    banco->indiceCategorias.inicios = inicios;
+    banco->indiceCategorias.totalCategorias = totalCategorias;
+    return 0;
+}
+
+/**
+ * @brief Quantidade de itens de uma categoria com nível entre nivelMinimo e nivelMaximo.
+ *
+ * Com o índice de categorias é só uma subtração por nível; sem ele, o banco é
+ * varrido. Itens excluídos depois da construção do índice ainda são contados
+ * até a próxima compactação.
+ *
+ * @param categoria Identificador da categoria, ou CATEGORIA_TODAS.
+ */
+long contarItensCategoria(const BancoInformacoes* banco, int categoria, int nivelMinimo, int nivelMaximo){
+    if (nivelMinimo < MUITOFACIL) nivelMinimo = MUITOFACIL;
+    if (nivelMaximo > MUITODIFICIL) nivelMaximo = MUITODIFICIL;
+    const IndiceCategorias* indice = &banco->indiceCategorias;
+    long total = 0;
+    if (categoria != CATEGORIA_TODAS && indice->posicoes != NULL && categoria >= 0 &&
+        (uint32_t)categoria < indice->totalCategorias){
+        const uint32_t* inicios = indice->inicios + (size_t)categoria * NUM_NIVEIS;
+        return (long)(inicios[nivelMaximo] - inicios[nivelMinimo - 1]);
+    }
+    for (int i = 0; i < banco->totalItens; i++){
+        const Item* item = &banco->itens[i];
+        if ((item->marcas & ITEM_EXCLUIDO) || item->nivel < nivelMinimo || item->nivel > nivelMaximo) continue;
+        if (categoria == CATEGORIA_TODAS || banco->dicas[i].categoria == categoria) total++;
+    }
+    return total;
+}
+
+/**
+ * @brief Adiciona um item ao final do banco a partir de trechos de texto com tamanho explícito.
+ *
+ * Versão de adicionarItemBanco() usada pelo leitor de CSV, que aponta os campos
+ * diretamente dentro do arquivo mapeado, sem copiá-los para buffers intermediários.
+ * Cada campo é truncado no tamanho máximo correspondente (TAM_MAX_*).
+ *
+ * @return int Índice do novo item, ou -1 em caso de falha.
+ */
+static int adicionarItemTrechos(BancoInformacoes* banco, const char* resposta, size_t tamResposta, int nivel,
+                                const char* const dicas[MAX_DICAS], const size_t tamDicas[MAX_DICAS],
+                                const char* categoria, size_t tamCategoria){
+    if (banco == NULL) return -1;
+    if (garantirCapacidade(banco, banco->totalItens + 1) != 0) return -1;
+
+    int indice = banco->totalItens;
+    Item* item = &banco->itens[indice];
+    DicasItem* dicasItem = &banco->dicas[indice];
+
+    if (guardarResposta(&banco->textos, resposta, tamResposta, item) != 0) return -1;
+    for (int d = 0; d < MAX_DICAS; d++){
+        if (guardarTrecho(&banco->textos, dicas[d], tamDicas[d], TAM_MAX_DICA,
+                          &dicasItem->dica[d], &dicasItem->tamDica[d]) != 0) return -1;
+    }
+    int idCategoria = internarCategoria(banco, categoria, tamCategoria);
+    if (idCategoria < 0) return -1;
+    dicasItem->categoria = (uint16_t)idCategoria;
+    item->nivel = (uint8_t)nivel;
+    item->marcas = 0;
+    item->id = banco->proximoId++;
+
+    banco->totalItens++;
+    indexarItem(banco, indice);
+    indexarDicasItem(banco, indice);
+    descartarIndiceCategorias(banco);  // Refeito antes da próxima partida (ver construirIndiceCategorias())
+    return indice;
+}
+
+/**
+ * @brief Adiciona um item ao final do banco a partir de textos já lidos.
+ *
+ * É a rotina usada pelo leitor de CSV e pela inserção interativa. Os textos
+ * são copiados para a arena do banco, portanto os buffers de origem podem ser
+ * reutilizados logo depois da chamada.
+ *
+ * @param banco Ponteiro para a estrutura BancoInformacoes.
+ * @param resposta Resposta (nome) do item.
+ * @param nivel Nível de dificuldade, de 1 a 5.
+ * @param dicas Vetor com as MAX_DICAS dicas (o vetor ou suas posições podem ser NULL).
+ * @param categoria Categoria do item (pode ser NULL).
+ * @return int Índice do novo item, ou -1 em caso de falha.
+ */
+int adicionarItemBanco(BancoInformacoes* banco, const char* resposta, int nivel,
+                       const char* dicas[MAX_DICAS], const char* categoria){
+    const char* textosDicas[MAX_DICAS];
+    size_t tamDicas[MAX_DICAS];
+    for (int d = 0; d < MAX_DICAS; d++){
+        textosDicas[d] = (dicas != NULL && dicas[d] != NULL) ? dicas[d] : "";
+        tamDicas[d] = strlen(textosDicas[d]);
+    }
+    return adicionarItemTrechos(banco, resposta, resposta ? strlen(resposta) : 0, nivel,
+                                textosDicas, tamDicas, categoria, categoria ? strlen(categoria) : 0);
+}
+
+/**
+ * @brief Troca a resposta de um item, mantendo o índice de respostas em dia.
+ *
+ * O texto antigo fica sem uso na arena (até a próxima compactação); o novo vai para o fim dela.
+ *
+ * @return int 0 em caso de sucesso, -1 se faltar memória (o item e o índice ficam como estavam).
+ */
+int alterarRespostaItem(BancoInformacoes* banco, int posicao, const char* resposta){
+    if (prepararEscrita(banco) != 0) return -1;
+    // A nova resposta vai primeiro para a arena: só depois o item troca de posição no índice
+    Item alterado = banco->itens[posicao];
+    if (guardarResposta(&banco->textos, resposta, strlen(resposta), &alterado) != 0) return -1;
+    desindexarItem(banco, posicao);
+    banco->itens[posicao] = alterado;
+    indexarItem(banco, posicao);
+    return 0;
+}
+
+/**
+ * @brief Troca a categoria de um item, cadastrando-a se ainda não existir.
+ *
+ * @return int 0 em caso de sucesso, -1 se faltar memória.
+ */
+int alterarCategoriaItem(BancoInformacoes* banco, int posicao, const char* categoria){
+    int idCategoria = internarCategoria(banco, categoria, strlen(categoria));
+    if (idCategoria < 0 || prepararEscrita(banco) != 0) return -1;
+    if (banco->dicas[posicao].categoria != idCategoria){
+        banco->dicas[posicao].categoria = (uint16_t)idCategoria;
+        descartarIndiceCategorias(banco);
+    }
+    return 0;
+}
+
+/**
+ * @brief Troca as dicas de um item, mantendo o índice das dicas em dia.
+ *
+ * As dicas novas vão em texto para o fim da arena (mesmo que o banco use o
+ * dicionário, ver compressao.c) e as antigas ficam sem uso até a próxima
+ * compactação.
+ *
+ * @param dicas Vetor com as MAX_DICAS novas dicas (posições NULL ficam vazias).
+ * @return int 0 em caso de sucesso, -1 se faltar memória (o item fica como estava).
+ */
+int alterarDicasItem(BancoInformacoes* banco, int posicao, const char* dicas[MAX_DICAS]){
+    if (prepararEscrita(banco) != 0) return -1;
+    DicasItem novas = banco->dicas[posicao];
+    for (int d = 0; d < MAX_DICAS; d++){
+        const char* texto = dicas[d] != NULL ? dicas[d] : "";
+        if (guardarTrecho(&banco->textos, texto, strlen(texto), TAM_MAX_DICA,
+                          &novas.dica[d], &novas.tamDica[d]) != 0) return -1;
+    }
+    desindexarDicasItem(banco, posicao);
+    banco->dicas[posicao] = novas;
+    banco->itens[posicao].marcas &= (uint8_t)~ITEM_DICAS_CODIFICADAS;
+    indexarDicasItem(banco, posicao);
+    return 0;
+}
+
+/**
+ * @brief Troca o nível de dificuldade de um item.
+ *
+ * @return int 0 em caso de sucesso, -1 se o nível não estiver entre 1 e 5.
+ */
+int alterarNivelItem(BancoInformacoes* banco, int posicao, int nivel){
+    if (nivel < MUITOFACIL || nivel > MUITODIFICIL) return -1;
+    if (banco->itens[posicao].nivel != nivel){
+        banco->itens[posicao].nivel = (uint8_t)nivel;
+        descartarIndiceCategorias(banco);
+    }
+    return 0;
+}
+
+/**
+ * @brief Quantidade de itens do banco que não estão marcados como excluídos.
+ */
+int itensAtivos(const BancoInformacoes* banco){
+    return banco->totalItens - banco->totalExcluidos;
+}
+
+/**
+ * @brief Localiza um item pelo seu identificador estável.
+ *
+ * Os identificadores são atribuídos em ordem crescente e a compactação
+ * preserva a ordem dos itens, então o vetor está sempre ordenado por id e a
+ * busca é binária.
+ *
+ * @param banco Ponteiro para a estrutura BancoInformacoes.
+ * @param id Identificador do item (Item::id).
+ * @return int Posição do item em banco->itens, ou -1 se não existir ou tiver sido excluído.
+ */
+int buscarItemPorId(const BancoInformacoes* banco, uint32_t id){
+    if (banco == NULL) return -1;
+    int inicio = 0, fim = banco->totalItens;
+    while (inicio < fim){
+        int meio = inicio + (fim - inicio) / 2;
+        if (banco->itens[meio].id < id) inicio = meio + 1;
+        else fim = meio;
+    }
+    if (inicio == banco->totalItens || banco->itens[inicio].id != id) return -1;
+    if (banco->itens[inicio].marcas & ITEM_EXCLUIDO) return -1;
+    return inicio;
+}
+
+/**
+ * @brief Copia um texto da arena antiga para a arena compactada.
+ *
+ * @return uint32_t Novo deslocamento do texto (0 para a string vazia).
+ */
+static uint32_t moverTexto(ArenaTexto* destino, const char* origem, uint32_t deslocamento, uint16_t tam){
+    if (deslocamento == 0 || tam == 0) return 0;
+    uint32_t novo = (uint32_t)destino->usado;
+    memcpy(destino->dados + novo, origem + deslocamento, (size_t)tam + 1);
+    destino->usado += (size_t)tam + 1;
+    return novo;
+}
+
+/**
+ * @brief Copia a resposta de um item junto com a sua chave (ver guardarResposta()).
+ */
+static void moverResposta(ArenaTexto* destino, const char* origem, Item* item){
+    size_t tam = (size_t)item->tamResposta + item->tamChave + 2;
+    memcpy(destino->dados + destino->usado, origem + item->resposta, tam);
+    item->resposta = (uint32_t)destino->usado;
+    destino->usado += tam;
+}
+
+/**
+ * @brief Copia o nome de uma categoria junto com a sua chave ("nome\0chave\0").
+ *
+ * @return uint32_t Novo deslocamento do nome.
+ */
+static uint32_t moverCategoria(ArenaTexto* destino, const char* origem, uint32_t deslocamento){
+    size_t tamNome = strlen(origem + deslocamento) + 1;
+    size_t tam = tamNome + strlen(origem + deslocamento + tamNome) + 1;
+    uint32_t novo = (uint32_t)destino->usado;
+    memcpy(destino->dados + novo, origem + deslocamento, tam);
+    destino->usado += tam;
+    return novo;
+}
+
+/**
+ * @brief Remove de vez os itens excluídos e os textos que ficaram sem uso.
+ *
+ * Os itens restantes são deslocados para o início dos vetores, na mesma ordem
+ * (os identificadores continuam crescentes), e seus textos são copiados para
+ * uma arena nova, descartando os de itens excluídos e os substituídos por
+ * alterarItem(); dicas codificadas são copiadas como estão, junto com o
+ * dicionário (ver compressao.c), e os nomes das categorias vão para o fim. É uma única passada linear; as posições dos itens mudam, por
+ * isso os índices de respostas e de categorias são refeitos e banco->geracao é incrementado (os
+ * sorteadores remontam as sacolas ao perceber a mudança).
+ *
+ * @param banco Ponteiro para a estrutura BancoInformacoes.
+ * @return int 0 em caso de sucesso, -1 se faltar memória (o banco fica como estava).
+ */
+int compactarBanco(BancoInformacoes* banco){
+    if (banco == NULL) return -1;
+    if (prepararEscrita(banco) != 0) return -1;
+
+    // Os textos vivos nunca ocupam mais que a arena atual
+    ArenaTexto textos;
+    textos.capacidade = banco->textos.usado;
+    textos.dados = malloc(textos.capacidade);
+    if (textos.dados == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para compactar o banco.\n");
+        return -1;
+    }
+    textos.dados[0] = '\0';
+    textos.usado = 1;
+
+    const char* antigos = banco->textos.dados;
+    int ativos = 0;
+    for (int i = 0; i < banco->totalItens; i++){
+        if (banco->itens[i].marcas & ITEM_EXCLUIDO) continue;
+        Item item = banco->itens[i];
+        DicasItem dicas = banco->dicas[i];
+        moverResposta(&textos, antigos, &item);
+        for (int d = 0; d < MAX_DICAS; d++){
+            dicas.dica[d] = moverTexto(&textos, antigos, dicas.dica[d], dicas.tamDica[d]);
+        }
+        banco->itens[ativos] = item;
+        banco->dicas[ativos] = dicas;
+        ativos++;
+    }
+    if (banco->dicionarioDicas != 0){
+        memcpy(textos.dados + textos.usado, antigos + banco->dicionarioDicas, banco->tamDicionarioDicas);
+        banco->dicionarioDicas = (uint32_t)textos.usado;
+        textos.usado += banco->tamDicionarioDicas;
+    }
+    // As categorias ficam todas, mesmo sem itens: os identificadores não mudam
+    for (uint32_t c = 1; c < banco->categorias.total; c++){
+        banco->categorias.nomes[c] = moverCategoria(&textos, antigos, banco->categorias.nomes[c]);
+    }
+
+    free(banco->textos.dados);
+    banco->textos = textos;
+    banco->totalItens = ativos;
+    banco->totalExcluidos = 0;
+    banco->geracao++;
+    if (construirIndiceRespostas(banco) != 0) descartarIndiceRespostas(banco);
+    construirIndiceCategorias(banco);   // Se faltar memória, os sorteadores varrem o banco
+    return 0;
+}
+
+/**
+ * @brief Exclui um item do banco sem interação com o usuário.
+ *
+ * O item apenas recebe a marca ITEM_EXCLUIDO e sai do índice de respostas, em
+ * tempo constante. Quando os excluídos passam de PERCENTUAL_COMPACTACAO% dos
+ * itens (e são pelo menos MIN_EXCLUIDOS_COMPACTACAO), o banco é compactado;
+ * o custo da compactação fica assim diluído entre muitas exclusões.
+ *
+ * @param banco Ponteiro para a estrutura BancoInformacoes.
+ * @param posicao Posição do item em banco->itens.
+ * @return int 0 em caso de sucesso, -1 se a posição for inválida ou o item já
+ * estiver excluído. Após a chamada as posições podem ter mudado: guarde o
+ * Item::id para localizar itens depois.
+ */
+int removerItemBanco(BancoInformacoes* banco, int posicao){
+    if (banco == NULL || posicao < 0 || posicao >= banco->totalItens) return -1;
+    if (banco->itens[posicao].marcas & ITEM_EXCLUIDO) return -1;
+
+    desindexarItem(banco, posicao);
+    desindexarDicasItem(banco, posicao);
+    banco->itens[posicao].marcas |= ITEM_EXCLUIDO;
+    banco->totalExcluidos++;
+    if (banco->totalExcluidos >= MIN_EXCLUIDOS_COMPACTACAO &&
+        (int64_t)banco->totalExcluidos * 100 >= (int64_t)banco->totalItens * PERCENTUAL_COMPACTACAO){
+        compactarBanco(banco); // Se faltar memória, os itens continuam apenas marcados
+    }
+    return 0;
+}
+
+/**
+ * @brief Retorna a resposta (nome) de um item.
+ *
+ * @param banco Banco ao qual o item pertence.
+ * @param item Ponteiro para um item de banco->itens.
+ * @return const char* Texto terminado em '\0', válido até a próxima alteração do banco.
+ */
+const char* obterResposta(const BancoInformacoes* banco, const Item* item){
+    return banco->textos.dados + item->resposta;
+}
+
+/**
+ * @brief Retorna a chave normalizada da resposta de um item (normalizarResposta()).
+ *
+ * A chave é calculada uma única vez, quando a resposta é gravada, e fica na
+ * arena logo depois dela; comparar um palpite já normalizado com a resposta é
+ * só comparar Item::tamChave e fazer um memcmp().
+ *
+ * @param banco Banco ao qual o item pertence.
+ * @param item Ponteiro para um item de banco->itens.
+ * @return const char* Chave terminada em '\0', com Item::tamChave bytes.
+ */
+const char* obterChaveResposta(const BancoInformacoes* banco, const Item* item){
+    return banco->textos.dados + item->resposta + item->tamResposta + 1;
+}
+
+/**
+ * @brief Retorna uma das dicas de um item, direto da arena.
+ *
+ * Só serve para itens com as dicas em texto; para os que têm a marca
+ * ITEM_DICAS_CODIFICADAS devolve a string vazia. Quem mostra dicas de um
+ * banco qualquer usa copiarDica().
+ *
+ * @param banco Banco ao qual o item pertence.
+ * @param item Ponteiro para um item de banco->itens.
+ * @param numeroDica Número da dica, de 1 a MAX_DICAS.
+ * @return const char* Texto da dica, ou string vazia se o número for inválido.
+ */
+const char* obterDica(const BancoInformacoes* banco, const Item* item, int numeroDica){
+    if (numeroDica < 1 || numeroDica > MAX_DICAS || (item->marcas & ITEM_DICAS_CODIFICADAS)) return banco->textos.dados;
+    const DicasItem* dicas = &banco->dicas[item - banco->itens];
+    return banco->textos.dados + dicas->dica[numeroDica - 1];
+}
+
+/**
+ * @brief Retorna a categoria de um item.
+ *
+ * @param banco Banco ao qual o item pertence.
+ * @param item Ponteiro para um item de banco->itens.
+ * @return const char* Texto da categoria (vazio se não cadastrada).
+ */
+const char* obterCategoria(const BancoInformacoes* banco, const Item* item){
+    return nomeCategoria(banco, banco->dicas[item - banco->itens].categoria);
+}
+
+/**
+ * @brief Aloca um banco vazio com as capacidades informadas, sem mensagens de sucesso.
+ *
+ * Usada por inicializarBanco() e pelos leitores de arquivo, que já sabem
+ * aproximadamente quantos itens e bytes de texto vão precisar.
+ *
+ * @param capacidadeItens Capacidade inicial dos vetores de itens e de dicas.
+ * @param capacidadeTextos Capacidade inicial da arena, em bytes (mínimo 1).
+ * @return BancoInformacoes* Banco alocado, ou NULL em caso de falha.
+ */
+static BancoInformacoes* criarBanco(int capacidadeItens, size_t capacidadeTextos){
+    BancoInformacoes *banco = malloc(sizeof(BancoInformacoes));
+    if (banco == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para o banco.\n");//Se possível marcar como [Erro], pois fica mais legível
+        return NULL;
+    }
+    if (capacidadeItens < 1) capacidadeItens = 1;
+    if (capacidadeTextos < 1) capacidadeTextos = 1;
+
+    banco->capacidadeArmazenamento = capacidadeItens;
+    banco->totalItens = 0;
+    banco->itens = malloc((size_t)capacidadeItens * sizeof(Item));
+    banco->dicas = malloc((size_t)capacidadeItens * sizeof(DicasItem));
+    banco->textos.capacidade = capacidadeTextos;
+    banco->textos.dados = malloc(capacidadeTextos);
+    banco->categorias.capacidade = 16;
+    banco->categorias.nomes = malloc(banco->categorias.capacidade * sizeof(uint32_t));
+
+    if (banco->itens == NULL || banco->dicas == NULL || banco->textos.dados == NULL || banco->categorias.nomes == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para os itens.\n");
+        free(banco->itens);
+        free(banco->dicas);
+        free(banco->textos.dados);
+        free(banco->categorias.nomes);
+        free(banco);
+        return NULL;
+    }
+    banco->textos.dados[0] = '\0'; // Deslocamento 0: string vazia compartilhada
+    banco->textos.usado = 1;
+    banco->mapeamento = NULL;
+    banco->tamanhoMapeamento = 0;
+    banco->indice.posicoes = NULL;
+    banco->indice.capacidade = 0;
+    banco->indice.ocupadas = 0;
+    banco->totalExcluidos = 0;
+    banco->proximoId = 0;
+    banco->geracao = 0;
+    banco->dicionarioDicas = 0;
+    banco->tamDicionarioDicas = 0;
+    banco->categorias.nomes[0] = 0;    // Categoria 0: sem categoria (string vazia)
+    banco->categorias.total = 1;
+    banco->categorias.tabela = NULL;   // Criada com a primeira categoria
+    banco->categorias.capacidadeTabela = 0;
+    banco->indiceCategorias.posicoes = NULL;
+    banco->indiceCategorias.inicios = NULL;
+    banco->indiceCategorias.totalCategorias = 0;
+    banco->indiceDicas = NULL;
+    return banco;
+}
+
+/**
+ * @brief Inicializa e aloca dinamicamente a memória para a estrutura BancoInformacoes.
+ *
+ * A função aloca o espaço para a estrutura BancoInformacoes e, em seguida,
+ * aloca os vetores de itens e de dicas com uma capacidade inicial arbitrária (40)
+ * e a arena que guarda os textos de todos os itens.
+ * O total de itens é inicializado como zero (0).
+ *
+ * @return BancoInformacoes* Retorna um ponteiro para a estrutura BancoInformacoes
+ * alocada e inicializada com sucesso, ou NULL em caso de falha na alocação de memória.
+ */
+BancoInformacoes* inicializarBanco(){
+    BancoInformacoes *banco = criarBanco(40, 4096);//Valor abitrário de capacidade inicial
+    if (banco == NULL){
+        return NULL;
+    }
+    printf("Deu certo função inicializarBanco\n");
+    return banco;
+}
+
+/**
+ * @brief Obtém um item aleatório do banco de informações para o jogo.
+ *
+ * A função inicializa a semente do gerador xoshiro256** (apenas uma vez)
+ * e calcula um índice aleatório válido dentro do total de itens carregados.
+ * Sorteia com reposição e sem filtro de nível, descartando itens excluídos;
+ * as sessões de jogo usam um SorteadorItens próprio (ver criarSorteador()).
+ *
+ * @param banco Ponteiro para a estrutura BancoInformacoes.
+ * @return Item* Retorna um ponteiro para o item escolhido, ou NULL se o banco estiver vazio.
+ */
+Item* obterItemAleatorio(BancoInformacoes *banco){
+    if (banco == NULL || itensAtivos(banco) == 0){
+        printf("[Aviso] O banco de informaçôes está vazio.\n");
+        return NULL;
+    }
+    
+    //Inicialização da semente (isso aqui me deu dor de cabeça de entender)
+    static GeradorAleatorio gerador;
+    static int seed_initialized = 0;
+    if (!seed_initialized) {
+        iniciarGerador(&gerador, sementePadrao()); // Relógio, ou PERFIL_SEMENTE para repetir a sequência
+        seed_initialized = 1;
+    }
+    // Os excluídos são no máximo ~PERCENTUAL_COMPACTACAO% do vetor, então poucas tentativas bastam
+    Item* item;
+    do{
+        uint32_t indiceAleatorio = aleatorioAte(&gerador, (uint32_t)banco->totalItens);//Aqui é gerado o valor pseudo-aleatório, sem o viés do %.
+        item = &banco->itens[indiceAleatorio];
+    } while (item->marcas & ITEM_EXCLUIDO);
+    return item;
+
+}
+
+/**
+ * @brief Anexa todos os itens de 'origem' ao final de 'destino'.
+ *
+ * A arena de 'origem' é copiada de uma vez para o fim da arena de 'destino' e
+ * os deslocamentos dos itens são corrigidos pela posição de cópia. Os
+ * identificadores dos itens de 'origem' são somados a destino->proximoId, para
+ * continuarem únicos e crescentes, e as categorias de 'origem' são trocadas
+ * pelas de mesmo nome em 'destino' (cadastradas lá se ainda não existirem). Se 'destino' nunca teve itens, os vetores são
+ * simplesmente trocados, sem cópia.
+ *
+ * @param destino Banco que recebe os itens.
+ * @param origem Banco cujos itens são anexados; continua válido e deve ser liberado pelo chamador.
+ * @return int 0 em caso de sucesso, -1 se faltar memória.
+ */
+static int anexarBanco(BancoInformacoes* destino, BancoInformacoes* origem){
+    if (origem->totalItens == 0) return 0;
+    if (destino->totalItens == 0 && destino->proximoId == 0){
+        BancoInformacoes temporario = *destino;
+        *destino = *origem;
+        *origem = temporario;
+        return 0;
+    }
+
+    descartarIndiceDicas(destino);     // Os itens anexados não estão nele (ver construirIndiceDicas())
+    if (prepararEscrita(destino) != 0) return -1;
+    if (garantirCapacidade(destino, destino->totalItens + origem->totalItens) != 0) return -1;
+    if (reservarTextos(&destino->textos, origem->textos.usado) != 0) return -1;
+
+    uint32_t base = (uint32_t)destino->textos.usado;
+    memcpy(destino->textos.dados + base, origem->textos.dados, origem->textos.usado);
+    destino->textos.usado += origem->textos.usado;
+
+    // Os nomes das categorias novas já foram copiados com a arena: só são cadastrados
+    uint16_t* mapaCategorias = malloc(origem->categorias.total * sizeof(uint16_t));
+    if (mapaCategorias == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para as categorias.\n");
+        return -1;
+    }
+    mapaCategorias[0] = 0;
+    for (uint32_t c = 1; c < origem->categorias.total; c++){
+        const char* chave = chaveCategoria(origem, c);
+        int categoria = localizarCategoria(destino, chave, strlen(chave));
+        if (categoria < 0) categoria = registrarCategoria(destino, base + origem->categorias.nomes[c]);
+        if (categoria < 0){
+            free(mapaCategorias);
+            return -1;
+        }
+        mapaCategorias[c] = (uint16_t)categoria;
+    }
+
+    // O deslocamento 0 (string vazia) continua apontando para a string vazia do destino
+    for (int i = 0; i < origem->totalItens; i++){
+        Item item = origem->itens[i];
+        DicasItem dicas = origem->dicas[i];
+        item.resposta += base;     // A resposta nunca usa o deslocamento 0 (ver guardarResposta())
+        item.id += destino->proximoId;
+        for (int d = 0; d < MAX_DICAS; d++){
+            if (dicas.dica[d] != 0) dicas.dica[d] += base;
+        }
+        dicas.categoria = mapaCategorias[dicas.categoria];
+        destino->itens[destino->totalItens + i] = item;
+        destino->dicas[destino->totalItens + i] = dicas;
+    }
+    free(mapaCategorias);
+    descartarIndiceCategorias(destino);
+    destino->totalItens += origem->totalItens;
+    destino->totalExcluidos += origem->totalExcluidos;
+    destino->proximoId += origem->proximoId;
+    return 0;
+}
+
+/**
+ * @brief Trecho do CSV processado por uma thread do leitor paralelo.
+ */
+typedef struct{
+    const char* inicio;         // Primeiro byte da fatia (início de linha)
+    const char* fim;            // Um byte após o fim da fatia (após um '\n' ou fim do arquivo)
+    BancoInformacoes* parcial;  // Itens lidos da fatia, com arena própria
+    int comCategoria;           // O CSV tem a coluna Categoria depois do nível
+    uint64_t* hashesDicas;      // calcularHashDicas() de cada item do parcial (ver tratarDuplicatas())
+    int itensLidos;
+    long linhasInvalidas;
+    int falhou;
+}FatiaCSV;
+
+/**
+ * @brief Lê um nível de dificuldade (1 a 5) de um campo do CSV.
+ *
+ * @return int O nível lido, ou 0 se o campo não for um número entre 1 e 5.
  */
-void lerString(char texto[], int tamanho){
-    fgets(texto, tamanho, stdin);
-    for (int i = 0; texto[i]; i++){
-        texto[i] = tolower((unsigned char)texto[i]);
+static int lerNivelCampo(const char* campo, size_t tam){
+    size_t i = 0;
+    int valor = 0, digitos = 0;
+    while (i < tam && isspace((unsigned char)campo[i])) i++;
+    while (i < tam && isdigit((unsigned char)campo[i]) && digitos < 3){
+        valor = valor * 10 + (campo[i] - '0');
+        digitos++;
+        i++;
     }
-    texto[strcspn(texto, "\n")] = '\0';
-    setbuf(stdin, NULL);
+    while (i < tam && isspace((unsigned char)campo[i])) i++;
+    if (digitos == 0 || i != tam || valor < MUITOFACIL || valor > MUITODIFICIL) return 0;
+    return valor;
 }
 
 /**
- * @brief Remove todos os caracteres de espaço (' ') de uma string.
- *
- * Esta função percorre a string, copiando apenas os caracteres que não são espaço
- * para o início da mesma string, efetivamente eliminando os espaços.
- *
- * @param str A string a ser processada.
- * @return void
+ * @brief Diz se o cabeçalho do CSV tem a coluna Categoria ("Resposta;Nivel;Categoria;Dica1...").
  */
-void removerEspacos(char str[]){
-    int i, j = 0;
-    // Percorre a string
-    for (i = 0; str[i] != '\0'; i++) {
-        // Se o caractere atual NÃO for um espaço, ele é copiado
-        if (str[i] != ' ') {
-            str[j] = str[i];
-            j++;
-        }
+static int temColunaCategoria(const char* cabecalho, const char* fim){
+    for (int campo = 0; campo < 2; campo++){
+        const char* separador = memchr(cabecalho, ';', (size_t)(fim - cabecalho));
+        if (separador == NULL) return 0;
+        cabecalho = separador + 1;
     }
-    // Finaliza a nova string no ponto correto
-    str[j] = '\0';
+    while (cabecalho < fim && isspace((unsigned char)*cabecalho)) cabecalho++;
+    const char* nome = "categoria";
+    size_t tam = strlen(nome);
+    if ((size_t)(fim - cabecalho) < tam) return 0;
+    for (size_t i = 0; i < tam; i++){
+        if (tolower((unsigned char)cabecalho[i]) != nome[i]) return 0;
+    }
+    cabecalho += tam;
+    while (cabecalho < fim && isspace((unsigned char)*cabecalho)) cabecalho++;
+    return cabecalho == fim || *cabecalho == ';';
 }
 
 /**
- * @brief Inicializa e aloca dinamicamente a memória para a estrutura BancoInformacoes.
+ * @brief Converte as linhas de uma fatia do CSV em itens de um banco parcial.
  *
- * A função aloca o espaço para a estrutura BancoInformacoes e, em seguida,
- * aloca o array dinâmico de Itens com uma capacidade inicial arbitrária (10).
- * O total de itens é inicializado como zero (0).
+ * Cada linha tem o formato "Resposta;Nivel;Dica1;Dica2;Dica3;Dica4;Dica5", ou
+ * "Resposta;Nivel;Categoria;Dica1;...;Dica5" se o CSV tiver a coluna Categoria. Como no
+ * leitor original, a última dica vai até o fim da linha (podendo conter ';').
+ * Linhas em branco são ignoradas e linhas mal formadas são contadas e descartadas.
  *
- * @return BancoInformacoes* Retorna um ponteiro para a estrutura BancoInformacoes
- * alocada e inicializada com sucesso, ou NULL em caso de falha na alocação de memória.
+ * @param argumento Ponteiro para a FatiaCSV a ser processada.
+ * @return void* Sempre NULL (formato exigido por pthread_create).
  */
-BancoInformacoes* inicializarBanco(){
-    BancoInformacoes *banco = malloc(sizeof(BancoInformacoes));
-    if (banco == NULL){
-        printf("[Erro] Houve um erro na alocação de memória para o banco.\n");//Se possível marcar como [Erro], pois fica mais legível
-        return NULL;
+static void* processarFatiaCSV(void* argumento){
+    FatiaCSV* fatia = argumento;
+    const char* p = fatia->inicio;
+
+    while (p < fatia->fim){
+        const char* fimLinha = memchr(p, '\n', (size_t)(fatia->fim - p));
+        if (fimLinha == NULL) fimLinha = fatia->fim;
+        const char* proximaLinha = (fimLinha < fatia->fim) ? fimLinha + 1 : fatia->fim;
+        const char* e = fimLinha;
+        if (e > p && e[-1] == '\r') e--;
+        while (p < e && isspace((unsigned char)*p)) p++;
+        if (p == e){
+            p = proximaLinha;
+            continue;
+        }
+
+        const char* campos[3 + MAX_DICAS];
+        size_t tams[3 + MAX_DICAS];
+        int ultimo = 1 + fatia->comCategoria + MAX_DICAS;     // Campo que vai até o fim da linha
+        int n = 0;
+        const char* c = p;
+        while (n < ultimo){
+            const char* separador = memchr(c, ';', (size_t)(e - c));
+            if (separador == NULL) break;
+            campos[n] = c;
+            tams[n] = (size_t)(separador - c);
+            n++;
+            c = separador + 1;
+        }
+        campos[n] = c;
+        tams[n] = (size_t)(e - c);
+
+        int nivel = (n == ultimo) ? lerNivelCampo(campos[1], tams[1]) : 0;
+        if (nivel == 0 || tams[0] == 0){
+            fatia->linhasInvalidas++;
+        } else if (adicionarItemTrechos(fatia->parcial, campos[0], tams[0], nivel,
+                                        campos + 2 + fatia->comCategoria, tams + 2 + fatia->comCategoria,
+                                        fatia->comCategoria ? campos[2] : NULL,
+                                        fatia->comCategoria ? tams[2] : 0) < 0){
+            fatia->falhou = 1;
+            return NULL;
+        }
+        p = proximaLinha;
     }
-    
-    banco->capacidadeArmazenamento = 40;//Valor abitrário de capacidade inicial
-    banco->totalItens = 0;
-    banco->itens = malloc(banco->capacidadeArmazenamento * sizeof(Item));
-    printf("Deu certo função inicializarBanco\n");
 
-    if (banco->itens == NULL){
-        printf("[Erro] Houve um erro na alocação de memória para os itens.\n");
-        free(banco);
+    // O hash das dicas sai aqui, em paralelo, para a busca de duplicatas ser só uma passada
+    BancoInformacoes* parcial = fatia->parcial;
+    fatia->hashesDicas = malloc((size_t)(parcial->totalItens > 0 ? parcial->totalItens : 1) * sizeof(uint64_t));
+    if (fatia->hashesDicas == NULL){
+        fatia->falhou = 1;
         return NULL;
     }
-    return banco;
+    for (int i = 0; i < parcial->totalItens; i++){
+        fatia->hashesDicas[i] = calcularHashDicas(parcial, &parcial->itens[i]);
+    }
+    fatia->itensLidos = parcial->totalItens;
+    return NULL;
 }
 
 /**
- * @brief Obtém um item aleatório do banco de informações para o jogo.
+ * @brief Carrega um arquivo CSV de itens, em paralelo, anexando-os ao banco.
  *
- * A função inicializa a semente de números aleatórios (apenas uma vez)
- * e calcula um índice aleatório válido dentro do total de itens carregados.
+ * O arquivo é mapeado em memória e, após o cabeçalho, dividido em fatias
+ * alinhadas em início de linha (no mínimo 1 MiB cada, no máximo uma por núcleo).
+ * A coluna Categoria é opcional: ela existe se o terceiro campo do cabeçalho se
+ * chamar "Categoria" (CSVs antigos, sem ela, continuam sendo lidos).
+ * Cada fatia é processada por uma thread em um banco parcial, com cópia limitada
+ * de cada campo ao seu tamanho máximo, e os parciais são anexados ao banco na
+ * ordem do arquivo. Não há limite de quantidade: o banco cresce conforme o arquivo.
+ * Por fim, as duplicatas (mesma resposta ou mesmas dicas de um item anterior)
+ * são tratadas conforme PERFIL_DUPLICATAS (ver tratarDuplicatas()) e relatadas.
  *
- * @param banco Ponteiro para a estrutura BancoInformacoes.
- * @return Item* Retorna um ponteiro para o item escolhido, ou NULL se o banco estiver vazio.
+ * @param banco Banco inicializado que receberá os itens.
+ * @param caminho Caminho do arquivo CSV.
+ * @return int Quantidade de itens lidos, ou -1 se o arquivo não puder ser aberto
+ * ou faltar memória.
  */
-Item* obterItemAleatorio(BancoInformacoes *banco){
-    if (banco == NULL || banco->totalItens == 0){
-        printf("[Aviso] O banco de informaçôes está vazio.\n");
-        return NULL;
+int carregarCSV(BancoInformacoes* banco, const char* caminho){
+    if (banco == NULL) return -1;
+    ArquivoMapeado arquivo;
+    if (mapearArquivo(caminho, 0, &arquivo) != 0) return -1;
+#ifndef _WIN32
+    if (arquivo.mapeado) posix_madvise((void*)arquivo.dados, arquivo.tamanho, POSIX_MADV_SEQUENTIAL);
+#endif
+
+    // Pula a primeira linha (cabeçalho), que diz se há a coluna Categoria
+    const char* inicio = arquivo.dados;
+    const char* fim = arquivo.dados + arquivo.tamanho;
+    const char* fimCabecalho = memchr(inicio, '\n', arquivo.tamanho);
+    int comCategoria = temColunaCategoria(inicio, fimCabecalho != NULL ? fimCabecalho : fim);
+    inicio = (fimCabecalho != NULL) ? fimCabecalho + 1 : fim;
+
+    size_t tamanhoDados = (size_t)(fim - inicio);
+    long numeroFatias = (long)(tamanhoDados / TAM_MIN_FATIA_CSV);
+    long nucleos = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+    nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (numeroFatias > nucleos) numeroFatias = nucleos;
+    if (numeroFatias > MAX_THREADS_LEITURA) numeroFatias = MAX_THREADS_LEITURA;
+    if (numeroFatias < 1) numeroFatias = 1;
+
+    FatiaCSV fatias[MAX_THREADS_LEITURA];
+    const char* atual = inicio;
+    for (long f = 0; f < numeroFatias; f++){
+        const char* corte = (f == numeroFatias - 1) ? fim : inicio + tamanhoDados / numeroFatias * (f + 1);
+        if (corte < atual) corte = atual;
+        if (corte < fim){
+            const char* quebra = memchr(corte, '\n', (size_t)(fim - corte));
+            corte = (quebra != NULL) ? quebra + 1 : fim;
+        }
+        size_t tamFatia = (size_t)(corte - atual);
+        fatias[f].inicio = atual;
+        fatias[f].fim = corte;
+        fatias[f].comCategoria = comCategoria;
+        fatias[f].hashesDicas = NULL;
+        fatias[f].itensLidos = 0;
+        fatias[f].linhasInvalidas = 0;
+        fatias[f].falhou = 0;
+        // Os textos de uma fatia ocupam a própria fatia mais as chaves das respostas
+        // (em geral menores que as respostas); a arena cresce se a estimativa não bastar
+        fatias[f].parcial = criarBanco((int)(tamFatia / 128) + 16, tamFatia + tamFatia / 4 + 2);
+        if (fatias[f].parcial == NULL){
+            for (long g = 0; g < f; g++) liberarBanco(fatias[g].parcial);
+            desmapearArquivo(&arquivo);
+            return -1;
+        }
+        atual = corte;
     }
-    
-    //Inicialização da semente (isso aqui me deu dor de cabeça de entender)
-    static int seed_initialized = 0;
-    if (!seed_initialized) {
-        srand(time(NULL)); // Inicializa o gerador com o tempo atual.
-        seed_initialized = 1;//A biblioteca de tempo vai ser utilizada pra gerar um número pseudo-aleatório.
+
+    pthread_t threads[MAX_THREADS_LEITURA];
+    int threadCriada[MAX_THREADS_LEITURA] = {0};
+    for (long f = 1; f < numeroFatias; f++){
+        threadCriada[f] = (pthread_create(&threads[f], NULL, processarFatiaCSV, &fatias[f]) == 0);
+        if (!threadCriada[f]) processarFatiaCSV(&fatias[f]);
+    }
+    processarFatiaCSV(&fatias[0]);
+
+    int totalAntes = banco->totalItens;
+    long linhasInvalidas = 0;
+    int falhou = 0;
+    for (long f = 0; f < numeroFatias; f++){
+        if (threadCriada[f]) pthread_join(threads[f], NULL);
+        linhasInvalidas += fatias[f].linhasInvalidas;
+        if (fatias[f].falhou || (!falhou && anexarBanco(banco, fatias[f].parcial) != 0)) falhou = 1;
+        liberarBanco(fatias[f].parcial);
+    }
+    desmapearArquivo(&arquivo);
+
+    // Junta os hashes das dicas na ordem do arquivo, como os itens
+    uint64_t* hashesDicas = NULL;
+    int importados = banco->totalItens - totalAntes;
+    if (!falhou){
+        hashesDicas = malloc((size_t)(importados > 0 ? importados : 1) * sizeof(uint64_t));
+        if (hashesDicas == NULL) falhou = 1;
+    }
+    size_t copiados = 0;
+    for (long f = 0; f < numeroFatias; f++){
+        if (!falhou){
+            memcpy(hashesDicas + copiados, fatias[f].hashesDicas, (size_t)fatias[f].itensLidos * sizeof(uint64_t));
+            copiados += (size_t)fatias[f].itensLidos;
+        }
+        free(fatias[f].hashesDicas);
+    }
+
+    if (linhasInvalidas > 0){
+        printf("[Aviso] %ld linha(s) inválida(s) do CSV foram ignoradas.\n", linhasInvalidas);
+    }
+    if (falhou){
+        free(hashesDicas);
+        return -1;
     }
-    int indiceAleatorio = rand() % banco->totalItens;//Aqui é gerado o valor pseudo-aleatório.
-    return &banco->itens[indiceAleatorio];
 
+    ResumoDuplicatas resumo;
+    int removidos = tratarDuplicatas(banco, totalAntes, hashesDicas, &resumo);
+    free(hashesDicas);
+    if (removidos < 0) return -1;
+
+    // Os parciais foram anexados sem índices: eles são construídos de uma vez
+    // (a compactação, que tira as cópias descartadas, já os constrói)
+    if (removidos > 0){
+        if (compactarBanco(banco) != 0) return -1;
+        if (banco->indice.posicoes == NULL || banco->indiceCategorias.posicoes == NULL) return -1;
+    } else if (construirIndiceRespostas(banco) != 0 || construirIndiceCategorias(banco) != 0){
+        return -1;
+    }
+    return banco->totalItens - totalAntes;
 }
 
 /**
- * @brief Carrega os dados de itens de um arquivo CSV para a estrutura BancoInformacoes.
- * * Esta função abre o arquivo "dados_jogoadvinhacao.csv", pula o cabeçalho
- * e lê sequencialmente os registros de itens (resposta, nível, 5 dicas).
- * A leitura utiliza o formato CSV (ou TSV) onde os campos são separados por
- * ponto e vírgula (`;`). Os itens são carregados no array dinâmico
- * 'banco->itens' até o limite da capacidade alocada.
+ * @brief Carrega os dados de itens do arquivo CSV padrão para a estrutura BancoInformacoes.
+ * * Esta função lê o arquivo "dados_jogoadvinhacao.csv" (ARQUIVO_CSV) com
+ * carregarCSV(), que pula o cabeçalho e lê os registros de itens (resposta,
+ * nível, categoria se houver a coluna, 5 dicas) separados por ponto e vírgula (`;`), em paralelo.
  *
  * O total de itens lidos é atualizado em 'banco->totalItens'.
  *
@@ -151,49 +1607,24 @@ Item* obterItemAleatorio(BancoInformacoes *banco){
  * de erro e encerra o programa com exit(1).
  *
  * @param banco Ponteiro para a estrutura BancoInformacoes, onde os dados
- * do arquivo serão armazenados. Deve ser um banco inicializado e com memória
- * alocada para 'itens'.
+ * do arquivo serão armazenados. Deve ser um banco inicializado.
  * * @return void Esta função não retorna valor.
  */
 void leArquivoCSV(BancoInformacoes* banco){
-    FILE* arquivoLeCSV = fopen("dados_jogoadvinhacao.csv", "r");
-    if (arquivoLeCSV == NULL) {
+    if (carregarCSV(banco, ARQUIVO_CSV) < 0) {
         printf("[Erro] Não foi possivel abrir o arquivo CSV.\n");
         exit(1);
     }
-
-    // Buffer para pular a primeira linha (cabeçalho)
-    char buffer[1024];
-    fgets(buffer, 1024, arquivoLeCSV); 
-
-    int i = 0;
-    int nivelTemporario; // Variável temporária para ler o nível
-
-    // O formato "%[^;]" lê tudo até o próximo ponto e vírgula.
-    while (i < banco->capacidadeArmazenamento && 
-           fscanf(arquivoLeCSV, " %[^;];%d;%[^;];%[^;];%[^;];%[^;];%[^\n]", 
-           banco->itens[i].resposta,
-           &nivelTemporario, // Lê no endereço da variável int temporária
-           banco->itens[i].dica1,
-           banco->itens[i].dica2,
-           banco->itens[i].dica3,
-           banco->itens[i].dica4,
-           banco->itens[i].dica5) == 7) 
-    {
-        banco->itens[i].nivel = (Dificuldade)nivelTemporario;
-        banco->totalItens++;
-        i++;
-    }
     printf("Deu certo função leArquivoCSV\n");
-    fclose(arquivoLeCSV);
-    printf("[OK] Dados carregados do CSV. Total de itens: %d\n", banco->totalItens);
+    printf("[OK] Dados carregados do CSV. Total de itens: %d\n", itensAtivos(banco));
 }
 
 /**
  * @brief Libera a memória alocada dinamicamente para a estrutura BancoInformacoes.
  *
- * Esta função garante que o array dinâmico de itens (`banco->itens`) e, em seguida,
- * a própria estrutura `banco` sejam desalocados da memória, prevenindo vazamentos de memória.
+ * Esta função garante que os vetores de itens e de dicas, a arena de textos (ou o
+ * snapshot mapeado de onde eles vêm) e, em seguida, a própria estrutura `banco`
+ * sejam desalocados da memória, prevenindo vazamentos de memória.
  * Os ponteiros são definidos como NULL após a liberação.
  *
  * @param banco Ponteiro para a estrutura BancoInformacoes a ser liberada.
@@ -203,8 +1634,25 @@ void leArquivoCSV(BancoInformacoes* banco){
  */
 void liberarBanco(BancoInformacoes *banco){
     if (banco){
-        free(banco->itens);
+        if (banco->mapeamento != NULL){
+            // Os vetores apontam para dentro do snapshot mapeado
+            ArquivoMapeado arquivo = {banco->mapeamento, banco->tamanhoMapeamento, 1};
+            desmapearArquivo(&arquivo);
+        } else {
+            free(banco->itens);
+            free(banco->dicas);
+            free(banco->textos.dados);
+            free(banco->categorias.nomes);
+        }
+        free(banco->indice.posicoes);
+        free(banco->categorias.tabela);
+        free(banco->indiceCategorias.posicoes);
+        free(banco->indiceCategorias.inicios);
+        descartarIndiceDicas(banco);
         banco->itens = NULL;
+        banco->dicas = NULL;
+        banco->textos.dados = NULL;
+        banco->indice.posicoes = NULL;
         free(banco);
         banco = NULL;
     }
@@ -214,12 +1662,16 @@ void liberarBanco(BancoInformacoes *banco){
  * @brief Insere um novo Item no BancoInformacoes, gerenciando a alocação dinâmica.
  *
  * Esta função realiza as seguintes etapas:
- * 1. Verifica se a capacidade do banco foi atingida e, se necessário, duplica a capacidade
- * do array `itens` utilizando `realloc`.
- * 2. Solicita ao usuário as informações do novo item (resposta e nível de dificuldade).
- * 3. Valida a entrada do nível de dificuldade, garantindo que esteja entre 1 e 5.
- * 4. Adiciona o novo item ao final do array (`banco->itens[banco->totalItens]`).
- * 5. Incrementa a contagem de `banco->totalItens`.
+ * 1. Solicita ao usuário as informações do novo item (resposta, nível de dificuldade, categoria e dicas).
+ * 2. Valida a entrada do nível de dificuldade, garantindo que esteja entre 1 e 5.
+ * 3. Adiciona o novo item ao final do banco com adicionarItemBanco(), que duplica
+ * a capacidade dos vetores e da arena quando necessário.
+ * 4. Registra a inserção no diário (ver diario.c).
+ *
+ * Se a resposta já existir no banco, segue a política de duplicatas
+ * (PERFIL_DUPLICATAS, ver duplicatas.c): 'manter' avisa e insere mesmo assim,
+ * 'rejeitar' cancela a inserção e 'mesclar' pede só as dicas e acrescenta ao
+ * item existente as que ele ainda não tem.
  *
  * @note Requer a definição da estrutura BancoInformacoes, a enum/typedef Dificuldade,
  * a função 'lerString' e as constantes de tamanho (ex: TAM_MAX_RESPOSTA).
@@ -230,22 +1682,45 @@ void liberarBanco(BancoInformacoes *banco){
  */
 void inserirItem(BancoInformacoes* banco){
     if (banco == NULL) return;
-    if (banco->totalItens >= banco->capacidadeArmazenamento){
-        int novaCapacidade = banco->capacidadeArmazenamento * 2;
-        Item* novoArray = realloc(banco->itens, novaCapacidade * sizeof(Item));
+    char resposta[TAM_MAX_RESPOSTA];
+    
+    printf("Digite a resposta (nome) do item:\n");
+    lerString(resposta, TAM_MAX_RESPOSTA);
 
-        if (novoArray == NULL){
-            printf("[Erro] Houve um erro na realocação de memória para expandir o banco.\n");
-            return;
+    char textosDicas[MAX_DICAS][TAM_MAX_DICA];
+    const char* dicas[MAX_DICAS];
+    int existente = buscarItemPorResposta(banco, resposta);
+    if (existente >= 0){
+        unsigned idExistente = (unsigned)banco->itens[existente].id;
+        switch (politicaDuplicatas()){
+            case DUPLICATAS_REJEITAR:
+                printf("[Aviso] Já existe um item com essa resposta (ID %u); a inserção foi cancelada.\n", idExistente);
+                return;
+            case DUPLICATAS_MESCLAR: {
+                printf("[Aviso] Já existe um item com essa resposta (ID %u); as dicas novas serão acrescentadas a ele.\n",
+                       idExistente);
+                for (int d = 0; d < MAX_DICAS; d++){
+                    printf("Digite a dica %d (vazio para nenhuma):\n", d + 1);
+                    lerString(textosDicas[d], TAM_MAX_DICA);
+                    dicas[d] = textosDicas[d];
+                }
+                int acrescentadas = mesclarDicasItem(banco, existente, dicas);
+                if (acrescentadas < 0) return;
+                if (acrescentadas == 0){
+                    printf("[Aviso] Nenhuma dica acrescentada: o item já tem essas dicas ou não tem posições vazias.\n");
+                    return;
+                }
+                registrarNoDiario(banco, DIARIO_DICAS, idExistente);
+                printf("[OK] %d dica(s) acrescentada(s) ao item %u.\n", acrescentadas, idExistente);
+                return;
+            }
+            default:
+                printf("[Aviso] Já existe um item com essa resposta (ID %u); o novo será inserido mesmo assim.\n",
+                       idExistente);
+                break;
         }
-        banco->itens = novoArray;
-        banco->capacidadeArmazenamento = novaCapacidade;
     }
-    Item novoItem;
-    
-    printf("Digite a resposta (nome) do item:\n");
-    lerString(novoItem.resposta, TAM_MAX_RESPOSTA);
-    
+
     int nivelTemporario;
     do{
         printf("Escolha a dificuldade do item: \n1-Muito Fácil 2-Fácil 3-Médio 4-Difícil 5-Muito Difícil\n");
@@ -256,18 +1731,31 @@ void inserirItem(BancoInformacoes* banco){
         }
         
     } while (nivelTemporario < 1 || nivelTemporario > 5);
-    novoItem.nivel = (Dificuldade)nivelTemporario;
 
-    banco->itens[banco->totalItens] = novoItem;
-    banco->totalItens++;
-    printf("[OK] Item inserido com sucesso! Total de itens: %d\n", banco->totalItens);
+    char categoria[TAM_MAX_CATEGORIA];
+    printf("Digite a categoria do item (vazio para nenhuma):\n");
+    lerString(categoria, TAM_MAX_CATEGORIA);
+
+    for (int d = 0; d < MAX_DICAS; d++){
+        printf("Digite a dica %d (vazio para nenhuma):\n", d + 1);
+        lerString(textosDicas[d], TAM_MAX_DICA);
+        dicas[d] = textosDicas[d];
+    }
+
+    int posicao = adicionarItemBanco(banco, resposta, nivelTemporario, dicas, categoria);
+    if (posicao < 0){
+        return;
+    }
+    registrarNoDiario(banco, DIARIO_INSERIR, banco->itens[posicao].id);
+    printf("[OK] Item inserido com sucesso! Total de itens: %d\n", itensAtivos(banco));
 }
 
 /**
  * @brief Exibe no console todos os itens cadastrados na estrutura BancoInformacoes.
  *
  * * A função percorre o array dinâmico de itens e imprime as informações essenciais
- * de cada um, como Nome (resposta), Categoria e Nível de Dificuldade.
+ * de cada um, como Identificador, Nome (resposta), Categoria e Nível de Dificuldade.
+ * Itens marcados como excluídos são pulados (basta testar Item::marcas).
  * * É usado um switch/case para converter o valor enumérico de dificuldade
  * (MUITOFACIL, FACIL, etc.) para sua representação em texto.
  *
@@ -285,11 +1773,14 @@ void listarItens(BancoInformacoes *banco){
     }
     
     printf("====== LISTA DE ITENS CADASTRADOS ======\n");
+    int numero = 0;
     for (int i = 0; i < banco->totalItens; i++){
         Item *item = &banco->itens[i];
-        printf("Item %d:\n", i + 1);
-        printf("Nome: %s\n", item->resposta);
-        printf("Categoria: %s\n", item->categoria);
+        if (item->marcas & ITEM_EXCLUIDO) continue;
+        printf("Item %d:\n", ++numero);
+        printf("ID: %u\n", (unsigned)item->id);
+        printf("Nome: %s\n", obterResposta(banco, item));
+        printf("Categoria: %s\n", obterCategoria(banco, item));
         printf("Nível de Dificuldade: ");
         switch (item->nivel){
             case MUITOFACIL:   printf("Muito Fácil\n"); break;
@@ -312,12 +1803,14 @@ void listarItens(BancoInformacoes *banco){
  * A função executa as seguintes etapas:
  * 1. Verifica se o banco está inicializado e se contém itens.
  * 2. Solicita ao usuário a 'resposta' (nome) do item a ser buscado.
- * 3. Percorre o array de itens, comparando a resposta de busca.
+ * 3. Localiza o item pelo índice de respostas (buscarItemPorResposta()).
  * 4. Se o item for encontrado, exibe seus dados atuais e pergunta
- * interativamente ao usuário quais campos (resposta, categoria, nível) deseja alterar.
+ * interativamente ao usuário quais campos (resposta, categoria, nível, dicas) deseja alterar.
  * 5. Garante a validação da entrada para o novo nível de dificuldade.
  * 6. Finaliza a execução após a primeira alteração bem-sucedida.
  *
+ * Cada campo alterado é registrado no diário (ver diario.c).
+ *
  * @note Requer as funções de entrada (ex: 'lerString'), a estrutura BancoInformacoes,
  * e a enum/typedef Dificuldade.
  *
@@ -326,7 +1819,7 @@ void listarItens(BancoInformacoes *banco){
  * @return void Esta função não retorna valor.
  */
 void alterarItem(BancoInformacoes *banco){
-    if (banco == NULL || banco->totalItens == 0){
+    if (banco == NULL || itensAtivos(banco) == 0){
         printf("[Aviso] O banco de informaçôes está vazio para alterações.\n");
         return;
     }
@@ -334,69 +1827,97 @@ void alterarItem(BancoInformacoes *banco){
     char busca[TAM_MAX_RESPOSTA];
     printf("Digite o nome (resposta) do item que deseja alterar: ");
     lerString(busca, TAM_MAX_RESPOSTA);
-    for (int i = 0; i < banco->totalItens; i++){
-        if (strcmp(banco->itens[i].resposta, busca) == 0){
-            printf("\nItem encontrado com sucesso! Informações atuais:\n");
-            printf("Resposta: %s\n", banco->itens[i].resposta);
-            printf("Categoria: %s\n", banco->itens[i].categoria);
-            printf("Nível de Dificuldade: %d\n", banco->itens[i].nivel);
-
-            printf("\nDeseja alterar a resposta? (digite s para sim e n para não): ");
-            char opcao;
-            scanf(" %c", &opcao);
-            setbuf(stdin, NULL);
-            if (tolower(opcao) == 's'){
-                printf("Nova resposta: ");
-                lerString((*banco).itens[i].resposta, TAM_MAX_RESPOSTA);
-            }
+    int i = buscarItemPorResposta(banco, busca);
+    if (i >= 0){
+        printf("\nItem encontrado com sucesso! Informações atuais:\n");
+        printf("Resposta: %s\n", obterResposta(banco, &banco->itens[i]));
+        printf("Categoria: %s\n", obterCategoria(banco, &banco->itens[i]));
+        printf("Nível de Dificuldade: %d\n", banco->itens[i].nivel);
 
-            printf("Deseja alterar a categoria? (digite s para sim e n para não): ");
-            scanf(" %c", &opcao);
-            setbuf(stdin, NULL);
-            if (tolower(opcao) == 's'){
-                printf("Nova categoria:\n");
-                lerString((*banco).itens[i].categoria, TAM_MAX_CATEGORIA);
-            }
+        printf("\nDeseja alterar a resposta? (digite s para sim e n para não): ");
+        char opcao;
+        scanf(" %c", &opcao);
+        setbuf(stdin, NULL);
+        if (tolower(opcao) == 's'){
+            char novaResposta[TAM_MAX_RESPOSTA];
+            printf("Nova resposta: ");
+            lerString(novaResposta, TAM_MAX_RESPOSTA);
+            if (alterarRespostaItem(banco, i, novaResposta) != 0) return;
+            registrarNoDiario(banco, DIARIO_RESPOSTA, banco->itens[i].id);
+        }
+
+        printf("Deseja alterar a categoria? (digite s para sim e n para não): ");
+        scanf(" %c", &opcao);
+        setbuf(stdin, NULL);
+        if (tolower(opcao) == 's'){
+            char novaCategoria[TAM_MAX_CATEGORIA];
+            printf("Nova categoria:\n");
+            lerString(novaCategoria, TAM_MAX_CATEGORIA);
+            if (alterarCategoriaItem(banco, i, novaCategoria) != 0) return;
+            registrarNoDiario(banco, DIARIO_CATEGORIA, banco->itens[i].id);
+        }
 
-            printf("Deseja alterar o nível de dificuldade? (digite s para sim e n para não): ");
-            scanf(" %c", &opcao);
-            setbuf(stdin, NULL);
-            if (tolower(opcao) == 's'){
-                int novoNivel;
-                do{
-                    printf("Escolha o novo nível: \n1-Muito Fácil 2-Fácil 3-Médio 4-Difícil 5-Muito Difícil\n");
-                    scanf("%d", &novoNivel);
-                    setbuf(stdin, NULL);
-                    if (novoNivel < 1 || novoNivel > 5)
-                        printf("[Erro] Valor inválido. Digite um número entre 1 e 5.\n");
-                } while (novoNivel < 1 || novoNivel > 5);
-                banco->itens[i].nivel = (Dificuldade) novoNivel;
+        printf("Deseja alterar o nível de dificuldade? (digite s para sim e n para não): ");
+        scanf(" %c", &opcao);
+        setbuf(stdin, NULL);
+        if (tolower(opcao) == 's'){
+            int novoNivel;
+            do{
+                printf("Escolha o novo nível: \n1-Muito Fácil 2-Fácil 3-Médio 4-Difícil 5-Muito Difícil\n");
+                scanf("%d", &novoNivel);
+                setbuf(stdin, NULL);
+                if (novoNivel < 1 || novoNivel > 5)
+                    printf("[Erro] Valor inválido. Digite um número entre 1 e 5.\n");
+            } while (novoNivel < 1 || novoNivel > 5);
+            alterarNivelItem(banco, i, novoNivel);
+            registrarNoDiario(banco, DIARIO_NIVEL, banco->itens[i].id);
+        }
+
+        printf("Deseja alterar as dicas? (digite s para sim e n para não): ");
+        scanf(" %c", &opcao);
+        // Sem buffer (setbuf), o '\n' do "s" ainda não foi lido e viraria a primeira dica
+        for (int c = getchar(); c != '\n' && c != EOF; c = getchar());
+        if (tolower(opcao) == 's'){
+            char textosDicas[MAX_DICAS][TAM_MAX_DICA];
+            const char* novasDicas[MAX_DICAS];
+            for (int d = 0; d < MAX_DICAS; d++){
+                copiarDica(banco, &banco->itens[i], d + 1, textosDicas[d], TAM_MAX_DICA);
+                printf("Dica %d atual: %s\nNova dica %d (vazio mantém a atual):\n", d + 1, textosDicas[d], d + 1);
+                char novaDica[TAM_MAX_DICA];
+                lerString(novaDica, TAM_MAX_DICA);
+                if (novaDica[0] != '\0') strcpy(textosDicas[d], novaDica);
+                novasDicas[d] = textosDicas[d];
             }
-            printf("\n[OK] Item alterado com sucesso!\n");
-            return;
+            if (alterarDicasItem(banco, i, novasDicas) != 0) return;
+            registrarNoDiario(banco, DIARIO_DICAS, banco->itens[i].id);
         }
+        printf("\n[OK] Item alterado com sucesso!\n");
+        return;
     }
     printf("[Aviso] Nenhum item encontrado com o nome informado.\n");
 }
 
 /**
- * @brief 
- * 
- * @param banco 
+ * @brief Pesquisa um item pela resposta (nome) e exibe o resultado.
+ *
+ * A busca usa o índice de respostas do banco (buscarItemPorResposta()), em
+ * tempo constante, e ignora maiúsculas/minúsculas e espaços.
+ *
+ * @param banco Ponteiro para a estrutura BancoInformacoes contendo os itens.
  */
 void pesquisaItem(BancoInformacoes *banco){
       
-    if (banco == NULL || banco-> totalItens == 0){
+    if (banco == NULL || itensAtivos(banco) == 0){
         printf("[Aviso] O banco de informaçôes está vazio.\n");
         return;
     }
     char buscaTemporario[TAM_MAX_RESPOSTA];
     printf("Digite o nome do item a ser pesquisado.\n");
     lerString(buscaTemporario, TAM_MAX_RESPOSTA);
-    for (int i = 0; i < (*banco).totalItens; i++){
-        if (strcmp(banco->itens[i].resposta, buscaTemporario) == 0){
-            printf("Item encontrado: %s\n", banco->itens[i].resposta);
-        }
+    int i = buscarItemPorResposta(banco, buscaTemporario);
+    if (i >= 0){
+        printf("Item encontrado: %s\n", obterResposta(banco, &banco->itens[i]));
+        return;
     }
     printf("[Aviso] Nenhum item encontrado com o nome informado.\n");
 }
@@ -405,16 +1926,18 @@ void pesquisaItem(BancoInformacoes *banco){
  * @brief Exclui um item (registro) do banco de informações baseado na sua resposta.
  * * Esta função solicita ao usuário a 'resposta' (nome) do item que deseja excluir.
  * Se o item for encontrado, pede confirmação antes de realizar a exclusão.
- * A exclusão é feita deslocando os elementos subsequentes na lista para
- * preencher a lacuna e decrementando o total de itens.
+ * A exclusão é feita por removerItemBanco(): o item é apenas marcado como
+ * excluído, sem deslocar os seguintes, e o espaço é recuperado depois pela
+ * compactação (automática ou ao salvar com salvarItensBinario()).
+ * Como as demais alterações do menu, a exclusão é registrada no diário (ver diario.c).
  *
  * @param banco Um ponteiro para a estrutura BancoInformacoes que contém os itens.
- * Não deve ser NULL e deve ter totalItens > 0 para prosseguir.
+ * Não deve ser NULL e deve ter itens ativos para prosseguir.
  * * @return void
  */
 void excluirItem(BancoInformacoes *banco){
 
-    if (banco == NULL || banco->totalItens == 0){
+    if (banco == NULL || itensAtivos(banco) == 0){
         printf("[Aviso] O banco de informaçôes está vazio para exclusão.\n");
         return;
     }
@@ -422,246 +1945,472 @@ void excluirItem(BancoInformacoes *banco){
     char busca[TAM_MAX_RESPOSTA];
     printf("Digite o nome (resposta) do item que deseja excluir:\n");
     lerString(busca, TAM_MAX_RESPOSTA);
-
-    for (int i = 0; i < banco->totalItens; i++){
-        if (strcmp(banco->itens[i].resposta, busca) == 0){
-            printf("\nItem encontrado: %s\n", banco->itens[i].resposta);
-            printf("Deseja realmente excluir este item? (digite s para sim e n para não): ");
-            char opcao;
-            scanf(" %c", &opcao);
-            setbuf(stdin, NULL);
-            if (tolower(opcao) != 's'){
-                printf("[Aviso] Exclusão cancelada pelo usuário.\n");
-                return;
-            }
-
-            // Desloca os itens seguintes para preencher o espaço
-            for (int j = i; j < banco->totalItens - 1; j++){
-                banco->itens[j] = banco->itens[j + 1];
-            }
-            banco->totalItens--;
-
-            printf("[OK] Item excluído com sucesso! Total atual: %d\n", banco->totalItens);
+    int i = buscarItemPorResposta(banco, busca);
+    if (i >= 0){
+        printf("\nItem encontrado: %s\n", obterResposta(banco, &banco->itens[i]));
+        printf("Deseja realmente excluir este item? (digite s para sim e n para não): ");
+        char opcao;
+        scanf(" %c", &opcao);
+        setbuf(stdin, NULL);
+        if (tolower(opcao) != 's'){
+            printf("[Aviso] Exclusão cancelada pelo usuário.\n");
             return;
         }
+
+        uint32_t id = banco->itens[i].id;
+        removerItemBanco(banco, i);
+        registrarNoDiario(banco, DIARIO_EXCLUIR, id);
+        printf("[OK] Item excluído com sucesso! Total atual: %d\n", itensAtivos(banco));
+        return;
     }
     printf("[Aviso] Nenhum item encontrado com o nome informado.\n");
 }
 
 /**
- * @brief Salva todos os itens do banco em um arquivo binário.
+ * @brief Acumula bytes em um checksum FNV-1a de 64 bits.
  *
- * Esta função grava em disco a estrutura BancoInformacoes, incluindo:
- * - O número total de itens cadastrados.
- * - O conteúdo completo do array dinâmico de itens.
+ * Pode ser chamada em partes: o estado devolvido por uma chamada é passado à
+ * próxima. O primeiro estado deve ser CHECKSUM_INICIAL.
  *
- * O arquivo é salvo no modo binário ("wb") e pode ser recarregado
- * posteriormente pela função carregarItensBinario().
+ * @param estado Checksum acumulado até aqui.
+ * @param dados Bytes a acrescentar.
+ * @param tamanho Quantidade de bytes.
+ * @return uint64_t Novo estado do checksum.
+ */
+uint64_t atualizarChecksum(uint64_t estado, const void* dados, size_t tamanho){
+    const unsigned char* bytes = dados;
+    for (size_t i = 0; i < tamanho; i++){
+        estado ^= bytes[i];
+        estado *= 0x100000001b3ULL;
+    }
+    return estado;
+}
+
+/**
+ * @brief Garante espaço para 'necessario' elementos em um vetor, dobrando a capacidade.
  *
- * @param banco Ponteiro para a estrutura BancoInformacoes a ser salva.
- * @param nomeArquivo Nome do arquivo binário (ex: "banco_itens.bin").
+ * @param dados Endereço do ponteiro do vetor (realocado se preciso).
+ * @param capacidade Endereço da capacidade atual, em elementos (atualizada).
+ * @param necessario Quantidade de elementos que precisa caber.
+ * @param tamElemento Tamanho de cada elemento em bytes.
+ * @return int 0 em caso de sucesso, -1 se faltar memória (o vetor fica como estava).
+ */
+int crescerVetor(void** dados, size_t* capacidade, size_t necessario, size_t tamElemento){
+    if (necessario <= *capacidade) return 0;
+    size_t novaCapacidade = *capacidade ? *capacidade * 2 : 16;
+    while (novaCapacidade < necessario) novaCapacidade *= 2;
+    void* novos = realloc(*dados, novaCapacidade * tamElemento);
+    if (novos == NULL) return -1;
+    *dados = novos;
+    *capacidade = novaCapacidade;
+    return 0;
+}
+
+/**
+ * @brief Segundos decorridos desde 'inicio', lido com clock_gettime(CLOCK_MONOTONIC).
+ */
+double segundosDesde(const struct timespec* inicio){
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    return (double)(agora.tv_sec - inicio->tv_sec) + (double)(agora.tv_nsec - inicio->tv_nsec) / 1e9;
+}
+
+/**
+ * @brief Grava exatamente 'tamanho' bytes em um descritor, repetindo gravações parciais.
  *
- * @return void Esta função não retorna valor.
+ * @return int 0 em caso de sucesso, -1 em caso de erro de escrita.
  */
-void salvarItensBinario(BancoInformacoes *banco){
-       
-    if (banco == NULL || banco->totalItens == 0){
-        printf("[Aviso] O banco de informaçôes está vazio.\n");
-        return;
+int gravarTudo(int descritor, const void* origem, size_t tamanho){
+    const char* p = origem;
+    while (tamanho > 0){
+        ssize_t gravados = write(descritor, p, tamanho);
+        if (gravados < 0 && errno == EINTR) continue;
+        if (gravados <= 0) return -1;
+        p += gravados;
+        tamanho -= (size_t)gravados;
     }
+    return 0;
+}
 
-    FILE *arquivo = fopen("jogoadvinhacao.dat", "wb");
+/**
+ * @brief Arredonda um deslocamento para o próximo múltiplo de 8.
+ */
+static uint64_t alinhar8(uint64_t deslocamento){
+    return (deslocamento + 7) & ~(uint64_t)7;
+}
 
-    if (arquivo == NULL){
-        printf("[Erro] Não foi possível abrir o arquivo para escrita.\n");
-        exit(1);
-    }
+/**
+ * @brief Grava 'quantidade' bytes zerados (preenchimento entre seções do snapshot).
+ */
+static int gravarPreenchimento(FILE* arquivo, uint64_t quantidade){
+    static const char zeros[8] = {0};
+    return fwrite(zeros, 1, (size_t)quantidade, arquivo) == quantidade ? 0 : -1;
+}
 
-    fwrite(&banco->totalItens, sizeof(int), 1, arquivo);
+/**
+ * @brief Preenche a parte fixa do cabeçalho de um snapshot: identificação e posição das seções.
+ *
+ * Quem grava completa proximoId, totalExcluidos e os checksums, e calcula
+ * checksumCabecalho por último (com ele zerado).
+ *
+ * @param cabecalho Cabeçalho a preencher (todo o conteúdo anterior é descartado).
+ * @param totalItens Quantidade de itens do vetor gravado (incluindo excluídos).
+ * @param totalCategorias Quantidade de categorias, contando a 0.
+ * @param tamanhoTextos Bytes usados da arena de textos.
+ */
+void prepararCabecalhoSnapshot(CabecalhoSnapshot* cabecalho, uint64_t totalItens, uint64_t totalCategorias,
+                               uint64_t tamanhoTextos){
+    memset(cabecalho, 0, sizeof(*cabecalho));
+    memcpy(cabecalho->magica, MAGICA_SNAPSHOT, sizeof(cabecalho->magica));
+    cabecalho->versao = VERSAO_SNAPSHOT;
+    cabecalho->marcaEndianness = MARCA_ENDIANNESS;
+    cabecalho->tamanhoItem = sizeof(Item);
+    cabecalho->tamanhoDicasItem = sizeof(DicasItem);
+    cabecalho->totalItens = totalItens;
+    cabecalho->deslocamentoItens = alinhar8(sizeof(CabecalhoSnapshot));
+    cabecalho->deslocamentoDicas = alinhar8(cabecalho->deslocamentoItens + totalItens * sizeof(Item));
+    cabecalho->deslocamentoCategorias = alinhar8(cabecalho->deslocamentoDicas + totalItens * sizeof(DicasItem));
+    cabecalho->totalCategorias = totalCategorias;
+    cabecalho->deslocamentoTextos = alinhar8(cabecalho->deslocamentoCategorias + totalCategorias * sizeof(uint32_t));
+    cabecalho->tamanhoTextos = tamanhoTextos;
+}
 
-    int itensGravados = fwrite(banco->itens, sizeof(Item), banco->totalItens, arquivo);
-    if (itensGravados != banco->totalItens){
-        printf("[Erro] Nem todos os itens foram salvos corretamente.\n");
-    } else {
-        printf("[OK] %d itens salvos com sucesso em 'jogoadvinhacao'.\n", banco->totalItens);
+/**
+ * @brief Grava o banco no formato de snapshot, de forma atômica.
+ *
+ * O snapshot é escrito primeiro em "<caminho>.tmp", sincronizado com o disco e
+ * então renomeado para 'caminho'. Assim, uma falha no meio da gravação nunca
+ * deixa um snapshot truncado no lugar do anterior.
+ *
+ * @param banco Banco a ser salvo.
+ * @param caminho Caminho final do snapshot.
+ * @return int 0 em caso de sucesso, -1 em caso de falha.
+ *
+ * @see CabecalhoSnapshot
+ */
+int salvarSnapshot(const BancoInformacoes* banco, const char* caminho){
+    char temporario[FILENAME_MAX];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", caminho);
+    FILE* arquivo = fopen(temporario, "wb");
+    if (arquivo == NULL) return -1;
+
+    uint64_t total = (uint64_t)banco->totalItens;
+    uint64_t totalCategorias = banco->categorias.total;
+    CabecalhoSnapshot cabecalho;
+    prepararCabecalhoSnapshot(&cabecalho, total, totalCategorias, banco->textos.usado);
+    cabecalho.proximoId = banco->proximoId;
+    cabecalho.totalExcluidos = (uint64_t)banco->totalExcluidos;
+    cabecalho.dicionarioDicas = banco->dicionarioDicas;
+    cabecalho.tamDicionarioDicas = banco->tamDicionarioDicas;
+    cabecalho.checksumItens = atualizarChecksum(CHECKSUM_INICIAL, banco->itens, total * sizeof(Item));
+    cabecalho.checksumDicas = atualizarChecksum(CHECKSUM_INICIAL, banco->dicas, total * sizeof(DicasItem));
+    cabecalho.checksumCategorias = atualizarChecksum(CHECKSUM_INICIAL, banco->categorias.nomes,
+                                                     totalCategorias * sizeof(uint32_t));
+    cabecalho.checksumTextos = atualizarChecksum(CHECKSUM_INICIAL, banco->textos.dados, banco->textos.usado);
+    cabecalho.checksumCabecalho = atualizarChecksum(CHECKSUM_INICIAL, &cabecalho, sizeof(cabecalho));
+
+    int erro = fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo) != 1;
+    erro = erro || gravarPreenchimento(arquivo, cabecalho.deslocamentoItens - sizeof(cabecalho)) != 0;
+    erro = erro || fwrite(banco->itens, sizeof(Item), (size_t)total, arquivo) != total;
+    erro = erro || gravarPreenchimento(arquivo, cabecalho.deslocamentoDicas -
+                                       (cabecalho.deslocamentoItens + total * sizeof(Item))) != 0;
+    erro = erro || fwrite(banco->dicas, sizeof(DicasItem), (size_t)total, arquivo) != total;
+    erro = erro || gravarPreenchimento(arquivo, cabecalho.deslocamentoCategorias -
+                                       (cabecalho.deslocamentoDicas + total * sizeof(DicasItem))) != 0;
+    erro = erro || fwrite(banco->categorias.nomes, sizeof(uint32_t), (size_t)totalCategorias, arquivo) != totalCategorias;
+    erro = erro || gravarPreenchimento(arquivo, cabecalho.deslocamentoTextos -
+                                       (cabecalho.deslocamentoCategorias + totalCategorias * sizeof(uint32_t))) != 0;
+    erro = erro || fwrite(banco->textos.dados, 1, banco->textos.usado, arquivo) != banco->textos.usado;
+    erro = erro || fflush(arquivo) != 0;
+#ifndef _WIN32
+    erro = erro || fsync(fileno(arquivo)) != 0;
+#endif
+    erro = (fclose(arquivo) != 0) || erro;
+    if (erro){
+        remove(temporario);
+        return -1;
     }
+#ifdef _WIN32
+    remove(caminho); // rename() do Windows não substitui um arquivo existente
+#endif
+    if (rename(temporario, caminho) != 0){
+        remove(temporario);
+        return -1;
+    }
+    return 0;
+}
 
-    fclose(arquivo);
+/**
+ * @brief Diz se o trecho [deslocamento, deslocamento + tamanho) termina até 'limite'.
+ *
+ * Compara por subtração: valores lidos de um arquivo corrompido não podem
+ * estourar a soma e parecer dentro do limite.
+ */
+static int secaoCabe(uint64_t deslocamento, uint64_t tamanho, uint64_t limite){
+    return deslocamento <= limite && tamanho <= limite - deslocamento;
 }
 
 /**
- * @brief Carrega os itens previamente salvos de um arquivo binário.
+ * @brief Confere os campos de todos os itens de um snapshot contra o cabeçalho.
  *
- * Esta função:
- * 1. Abre o arquivo binário no modo leitura ("rb").
- * 2. Lê o total de itens armazenados.
- * 3. Aloca dinamicamente o espaço necessário para todos os itens.
- * 4. Carrega os dados diretamente na estrutura BancoInformacoes.
+ * Uma passada linear pelos vetores de itens e de dicas (não pela arena), feita
+ * mesmo sem a verificação dos checksums: um deslocamento de texto, nível ou
+ * categoria fora dos limites faria o banco mapeado ler fora do arquivo ou
+ * escrever fora de vetores indexados por nível e categoria.
  *
- * Caso o arquivo não exista ou haja erro de leitura, o banco é inicializado vazio.
+ * @return const char* NULL se os itens são válidos, ou o motivo da recusa.
+ */
+static const char* validarItensSnapshot(const CabecalhoSnapshot* cabecalho, const char* dados){
+    const Item* itens = (const Item*)(dados + cabecalho->deslocamentoItens);
+    const DicasItem* dicas = (const DicasItem*)(dados + cabecalho->deslocamentoDicas);
+    uint64_t tamanhoTextos = cabecalho->tamanhoTextos;
+    for (uint64_t i = 0; i < cabecalho->totalItens; i++){
+        const Item* item = &itens[i];
+        // "resposta\0chave\0"
+        if ((uint64_t)item->resposta + item->tamResposta + item->tamChave + 2 > tamanhoTextos) return "textos dos itens fora da arena";
+        if (item->nivel < 1 || item->nivel > NUM_NIVEIS) return "nível de item inválido";
+        if (dicas[i].categoria >= cabecalho->totalCategorias) return "categoria de item inválida";
+        // Dicas em texto têm o '\0' depois; as codificadas, não
+        uint64_t terminador = (item->marcas & ITEM_DICAS_CODIFICADAS) ? 0 : 1;
+        for (int d = 0; d < MAX_DICAS; d++){
+            if ((uint64_t)dicas[i].dica[d] + dicas[i].tamDica[d] + terminador > tamanhoTextos) return "textos dos itens fora da arena";
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Mapeia um snapshot em memória e o usa como banco, sem copiar os dados.
  *
- * @param nomeArquivo Nome do arquivo binário (ex: "banco_itens.bin").
+ * O cabeçalho é sempre validado (mágica, versão, ordem de bytes, tamanhos das
+ * estruturas, limites das seções e checksum do próprio cabeçalho), assim como os
+ * campos de cada item (validarItensSnapshot()). Os vetores do
+ * banco passam a apontar para dentro do mapeamento, de modo que abrir um banco
+ * grande custa apenas as páginas que forem de fato acessadas. O mapeamento é
+ * privado: alterações no banco nunca chegam ao arquivo.
  *
- * @return BancoInformacoes* Retorna ponteiro para a estrutura BancoInformacoes carregada.
+ * @param caminho Caminho do snapshot.
+ * @param verificarConteudo 1 para conferir também os checksums das seções
+ * (lê o arquivo inteiro), 0 para confiar no conteúdo (início rápido).
+ * @return BancoInformacoes* Banco pronto para uso, ou NULL se o arquivo não
+ * existir ou for inválido.
  */
-BancoInformacoes* carregarItensBinario(const char *nomeArquivo){
-    
-    FILE *arquivo = fopen(nomeArquivo, "rb");
-    if (arquivo == NULL){
-        printf("[Aviso] Arquivo '%s' não encontrado. Um novo banco será criado.\n", nomeArquivo);
-        return inicializarBanco(); // cria um banco vazio
-    }
+BancoInformacoes* abrirSnapshot(const char* caminho, int verificarConteudo){
+    ArquivoMapeado arquivo;
+    if (mapearArquivo(caminho, 1, &arquivo) != 0) return NULL;
 
-    int totalItensLidos;
-    if (fread(&totalItensLidos, sizeof(int), 1, arquivo) != 1){
-        printf("[Erro] Falha ao ler o número total de itens.\n");
-        fclose(arquivo);
-        return inicializarBanco();
-    }
+    const char* motivo = NULL;
+    CabecalhoSnapshot cabecalho;
+    if (arquivo.tamanho < sizeof(cabecalho)){
+        motivo = "arquivo truncado";
+    } else {
+        memcpy(&cabecalho, arquivo.dados, sizeof(cabecalho));
+        uint64_t checksumGravado = cabecalho.checksumCabecalho;
+        cabecalho.checksumCabecalho = 0;
+        uint64_t total = cabecalho.totalItens;
 
-    BancoInformacoes *banco = malloc(sizeof(BancoInformacoes));
-    if (banco == NULL){
-        printf("[Erro] Falha na alocação de memória para o banco.\n");
-        fclose(arquivo);
-        return NULL;
+        if (memcmp(cabecalho.magica, MAGICA_SNAPSHOT, sizeof(cabecalho.magica)) != 0){
+            motivo = "formato desconhecido";
+        } else if (cabecalho.marcaEndianness != MARCA_ENDIANNESS){
+            motivo = "gravado em uma máquina com outra ordem de bytes";
+        } else if (cabecalho.versao != VERSAO_SNAPSHOT || cabecalho.tamanhoItem != sizeof(Item) ||
+                   cabecalho.tamanhoDicasItem != sizeof(DicasItem)){
+            motivo = "versão incompatível";
+        } else if (atualizarChecksum(CHECKSUM_INICIAL, &cabecalho, sizeof(cabecalho)) != checksumGravado){
+            motivo = "cabeçalho corrompido";
+        } else if (total > INT32_MAX || cabecalho.totalExcluidos > total || cabecalho.proximoId > UINT32_MAX ||
+                   cabecalho.tamanhoTextos < 1 || cabecalho.tamanhoTextos > UINT32_MAX ||
+                   cabecalho.deslocamentoItens % 8 != 0 || cabecalho.deslocamentoDicas % 8 != 0 ||
+                   cabecalho.totalCategorias < 1 || cabecalho.totalCategorias > MAX_CATEGORIAS ||
+                   cabecalho.deslocamentoCategorias % 4 != 0 ||
+                   // Seções em ordem, cada uma terminando antes da próxima começar (e a última, no arquivo)
+                   cabecalho.deslocamentoItens < sizeof(cabecalho) ||
+                   !secaoCabe(cabecalho.deslocamentoItens, total * sizeof(Item), cabecalho.deslocamentoDicas) ||
+                   !secaoCabe(cabecalho.deslocamentoDicas, total * sizeof(DicasItem), cabecalho.deslocamentoCategorias) ||
+                   !secaoCabe(cabecalho.deslocamentoCategorias, cabecalho.totalCategorias * sizeof(uint32_t),
+                              cabecalho.deslocamentoTextos) ||
+                   !secaoCabe(cabecalho.deslocamentoTextos, cabecalho.tamanhoTextos, arquivo.tamanho) ||
+                   !secaoCabe(cabecalho.dicionarioDicas, cabecalho.tamDicionarioDicas, cabecalho.tamanhoTextos) ||
+                   arquivo.dados[cabecalho.deslocamentoTextos] != '\0'){
+            motivo = "seções fora dos limites do arquivo";
+        } else if (verificarConteudo &&
+                   (atualizarChecksum(CHECKSUM_INICIAL, arquivo.dados + cabecalho.deslocamentoItens,
+                                      total * sizeof(Item)) != cabecalho.checksumItens ||
+                    atualizarChecksum(CHECKSUM_INICIAL, arquivo.dados + cabecalho.deslocamentoDicas,
+                                      total * sizeof(DicasItem)) != cabecalho.checksumDicas ||
+                    atualizarChecksum(CHECKSUM_INICIAL, arquivo.dados + cabecalho.deslocamentoCategorias,
+                                      cabecalho.totalCategorias * sizeof(uint32_t)) != cabecalho.checksumCategorias ||
+                    atualizarChecksum(CHECKSUM_INICIAL, arquivo.dados + cabecalho.deslocamentoTextos,
+                                      cabecalho.tamanhoTextos) != cabecalho.checksumTextos)){
+            motivo = "conteúdo corrompido";
+        } else {
+            // Poucos bytes: os nomes das categorias são sempre conferidos
+            const uint32_t* nomes = (const uint32_t*)(arquivo.dados + cabecalho.deslocamentoCategorias);
+            for (uint64_t c = 0; c < cabecalho.totalCategorias && motivo == NULL; c++){
+                if ((c == 0) != (nomes[c] == 0) || nomes[c] >= cabecalho.tamanhoTextos) motivo = "categorias inválidas";
+            }
+            if (motivo == NULL) motivo = validarItensSnapshot(&cabecalho, arquivo.dados);
+        }
     }
 
-    banco->totalItens = totalItensLidos;
-    banco->capacidadeArmazenamento = (totalItensLidos > 10) ? totalItensLidos : 10;
-    banco->itens = malloc(banco->capacidadeArmazenamento * sizeof(Item));
-
-    if (banco->itens == NULL){
-        printf("[Erro] Falha na alocação de memória para os itens.\n");
-        free(banco);
-        fclose(arquivo);
+    BancoInformacoes* banco = NULL;
+    if (motivo == NULL && (banco = malloc(sizeof(BancoInformacoes))) == NULL){
+        motivo = "falta de memória";
+    }
+    if (motivo != NULL){
+        printf("[Aviso] Snapshot '%s' ignorado: %s.\n", caminho, motivo);
+        desmapearArquivo(&arquivo);
         return NULL;
     }
 
-    size_t itensLidos = fread(banco->itens, sizeof(Item), totalItensLidos, arquivo);
-    if (itensLidos != (size_t)totalItensLidos){
-        printf("[Aviso] Nem todos os itens foram lidos corretamente. O banco pode estar incompleto.\n");
-    } else {
-        printf("[OK] %d itens carregados com sucesso de '%s'.\n", totalItensLidos, nomeArquivo);
+    char* base = (char*)arquivo.dados;
+    banco->itens = (Item*)(base + cabecalho.deslocamentoItens);
+    banco->dicas = (DicasItem*)(base + cabecalho.deslocamentoDicas);
+    banco->textos.dados = base + cabecalho.deslocamentoTextos;
+    banco->textos.usado = (size_t)cabecalho.tamanhoTextos;
+    banco->textos.capacidade = banco->textos.usado;
+    banco->totalItens = (int)cabecalho.totalItens;
+    banco->capacidadeArmazenamento = banco->totalItens;
+    banco->mapeamento = base;
+    banco->tamanhoMapeamento = arquivo.tamanho;
+    // O índice de respostas é construído na primeira busca, para não tocar todas as páginas agora
+    banco->indice.posicoes = NULL;
+    banco->indice.capacidade = 0;
+    banco->indice.ocupadas = 0;
+    banco->totalExcluidos = (int)cabecalho.totalExcluidos;
+    banco->proximoId = (uint32_t)cabecalho.proximoId;
+    banco->geracao = 0;
+    banco->dicionarioDicas = (uint32_t)cabecalho.dicionarioDicas;
+    banco->tamDicionarioDicas = (uint32_t)cabecalho.tamDicionarioDicas;
+    banco->categorias.nomes = (uint32_t*)(base + cabecalho.deslocamentoCategorias);
+    banco->categorias.total = (uint32_t)cabecalho.totalCategorias;
+    banco->categorias.capacidade = banco->categorias.total;
+    banco->categorias.tabela = NULL;
+    banco->categorias.capacidadeTabela = 0;
+    // O índice de categorias lê as dicas de todos os itens: fica para carregarBancoInicial()
+    banco->indiceCategorias.posicoes = NULL;
+    banco->indiceCategorias.inicios = NULL;
+    banco->indiceCategorias.totalCategorias = 0;
+    banco->indiceDicas = NULL;     // Construído à parte (ver construirIndiceDicas())
+    if (construirTabelaCategorias(banco, banco->categorias.total) != 0){
+        liberarBanco(banco);
+        return NULL;
     }
-
-    fclose(arquivo);
     return banco;
 }
 
 /**
- * @brief Adiciona o resultado de um jogador ao ranking e salva em arquivo.
+ * @brief Diz se o arquivo 'a' foi modificado depois do arquivo 'b'.
  *
- * Esta função carrega o ranking atual do arquivo binário, insere o novo registro,
- * reordena a lista por pontuação (decrescente) e grava o resultado de volta no disco.
- * @note A função mantém apenas um número fixo de melhores pontuações (ex: TOP 10).
- * Se o novo score não for alto o suficiente, ele pode ser descartado.
- *
- * @param nome Nome do jogador a ser registrado (string).
- * @param pontuacao Pontuação total acumulada na sessão.
- * * @return void
+ * Compara também os nanossegundos: um CSV editado no mesmo segundo em que o
+ * snapshot foi gravado não pode ser ignorado.
  */
-void salvarRanking(const char* nome, int pontuacao){
-    PosicaoRanking ranking[MAX_RANKING_ENTRIES + 1];
-    int totalEntries = 0;
-
-    FILE *arq = fopen(ARQUIVO_RANKING, "rb");
-    if (arq != NULL){
-        totalEntries = fread(ranking, sizeof(PosicaoRanking), MAX_RANKING_ENTRIES, arq);
-        fclose(arq);
-    }
-
-    PosicaoRanking novo;
-    strncpy(novo.nome, nome, TAM_MAX_NOME - 1);
-    novo.nome[TAM_MAX_NOME - 1] = '\0';
-    novo.pontuacao = pontuacao;
+static int maisNovo(const struct stat* a, const struct stat* b){
+#ifdef _WIN32
+    return a->st_mtime > b->st_mtime;
+#else
+    if (a->st_mtim.tv_sec != b->st_mtim.tv_sec) return a->st_mtim.tv_sec > b->st_mtim.tv_sec;
+    return a->st_mtim.tv_nsec > b->st_mtim.tv_nsec;
+#endif
+}
 
-    ranking[totalEntries] = novo;
-    totalEntries++;
+/**
+ * @brief Carrega o banco na inicialização do programa.
+ *
+ * Se o snapshot (ARQUIVO_BINARIO) existir e for mais novo que o CSV (com
+ * precisão de nanossegundos, ver maisNovo()), ele é
+ * mapeado diretamente, sem verificar o conteúdo, e nada precisa ser lido do CSV.
+ * Caso contrário (ou se o snapshot for inválido), o CSV é lido normalmente.
+ * Sobre o snapshot são reaplicadas as alterações do diário (abrirDiario()).
+ * Com PERFIL_DICAS=compactadas, as dicas são então codificadas (aplicarModoDicas()).
+ * Por fim é construído o índice composto (categoria, nível) usado pelos
+ * sorteadores (construirIndiceCategorias()); sem ele, eles varrem o banco.
+ *
+ * @return BancoInformacoes* Banco carregado, ou NULL em caso de falha de memória.
+ */
+BancoInformacoes* carregarBancoInicial(void){
+    struct stat infoCSV, infoSnapshot;
+    int temSnapshot = (stat(ARQUIVO_BINARIO, &infoSnapshot) == 0);
+    int temCSV = (stat(ARQUIVO_CSV, &infoCSV) == 0);
 
-    //Aqui foi aplicado Bubble Sort (coisa de fora)
-    for (int i = 0; i < totalEntries - 1; i++){
-        for (int j = 0; j < totalEntries - i - 1; j++){
-            if (ranking[j].pontuacao < ranking[j + 1].pontuacao){
-                PosicaoRanking temp = ranking[j];
-                ranking[j] = ranking[j + 1];
-                ranking[j + 1] = temp;
-            }
+    if (temSnapshot && (!temCSV || maisNovo(&infoSnapshot, &infoCSV))){
+        BancoInformacoes* banco = abrirSnapshot(ARQUIVO_BINARIO, 0);
+        if (banco != NULL){
+            printf("[OK] Banco carregado do snapshot '%s'. Total de itens: %d\n", ARQUIVO_BINARIO, itensAtivos(banco));
+            abrirDiario(banco, 1);
+            aplicarModoDicas(banco);
+            construirIndiceCategorias(banco);
+            return banco;
         }
     }
 
-    //SÓ GRAVA OS TOP 10!!!
-    int entriesParaGravar = (totalEntries > MAX_RANKING_ENTRIES) ? MAX_RANKING_ENTRIES : totalEntries;
-    arq = fopen(ARQUIVO_RANKING, "wb");
-    if (arq != NULL){
-        fwrite(ranking, sizeof(PosicaoRanking), entriesParaGravar, arq);
-        fclose(arq);
-        printf("[Ranking] Pontuação salva! Você está na posição %d.\n", entriesParaGravar);
-    } else {
-        printf("[Erro] Falha ao salvar ranking.\n");
+    BancoInformacoes* banco = inicializarBanco();
+    if (banco != NULL){
+        leArquivoCSV(banco);
+        abrirDiario(banco, 0);
+        aplicarModoDicas(banco);
+        if (banco->indiceCategorias.posicoes == NULL) construirIndiceCategorias(banco);  // Descartado pelo diário
     }
+    return banco;
 }
 
 /**
- * @brief Carrega o ranking do arquivo e exibe no terminal.
+ * @brief Salva todos os itens do banco em um arquivo binário.
  *
- * Abre o arquivo binário de ranking, lê os registros armazenados e os imprime
- * na saída padrão em formato de tabela (Posição | Nome | Pontos).
- * Caso o arquivo não exista ou esteja vazio, exibe uma mensagem informando.
- * * @return void
+ * Esta função grava em disco o banco no formato de snapshot (ver CabecalhoSnapshot):
+ * - Um cabeçalho com mágica, versão, ordem de bytes, total de itens e checksums.
+ * - O conteúdo completo dos vetores de itens e de dicas.
+ * - A arena com os textos referenciados pelos itens.
+ *
+ * Antes de gravar, os itens marcados como excluídos são removidos de vez com
+ * compactarBanco(), para que o snapshot não carregue itens nem textos mortos.
+ *
+ * O arquivo "jogoadvinhacao.dat" é substituído de forma atômica e pode ser
+ * recarregado posteriormente pela função carregarItensBinario() ou mapeado
+ * na inicialização por carregarBancoInicial().
+ *
+ * @param banco Ponteiro para a estrutura BancoInformacoes a ser salva.
+ *
+ * @return void Esta função não retorna valor.
  */
-void listarRanking(){
-    PosicaoRanking ranking[MAX_RANKING_ENTRIES];
-    int totalEntries = 0;
-
-    FILE *arq = fopen(ARQUIVO_RANKING, "rb");
-    if (arq != NULL) {
-        totalEntries = fread(ranking, sizeof(PosicaoRanking), MAX_RANKING_ENTRIES, arq);
-        fclose(arq);
+void salvarItensBinario(BancoInformacoes *banco){
+       
+    if (banco == NULL || itensAtivos(banco) == 0){
+        printf("[Aviso] O banco de informaçôes está vazio.\n");
+        return;
     }
 
-    printf("\n ====== HALL DA FAMA (TOP %d) ====== \n", MAX_RANKING_ENTRIES);
-    if (totalEntries == 0) {
-        printf("   [ Aviso ] Nenhum registro encontrado.\n");
+    if (banco->totalExcluidos > 0 && compactarBanco(banco) != 0){
+        printf("[Aviso] Não foi possível compactar o banco; os itens excluídos serão gravados marcados.\n");
+    }
+    if (salvarSnapshot(banco, ARQUIVO_BINARIO) != 0){
+        printf("[Erro] Nem todos os itens foram salvos corretamente.\n");
     } else {
-        printf("Pos | %-30s | Pontos\n", "Nome");
-        printf("---------------------------------------------\n");
-        for (int i = 0; i < totalEntries; i++) {
-            printf("#%02d | %-30s | %d\n", i + 1, ranking[i].nome, ranking[i].pontuacao);
-        }
+        printf("[OK] %d itens salvos com sucesso em 'jogoadvinhacao'.\n", itensAtivos(banco));
+        reiniciarDiario();  // O snapshot novo já contém tudo o que estava no diário
     }
-    printf("=============================================\n\n");
 }
 
 /**
- * @brief Apaga permanentemente todo o histórico de ranking.
+ * @brief Carrega os itens previamente salvos de um arquivo binário.
  *
- * Esta função remove o arquivo binário onde os recordes estão armazenados ("ranking.dat").
- * É uma operação irreversível utilizada para zerar o placar do jogo.
- * Geralmente inclui uma etapa de confirmação do usuário antes de deletar o arquivo.
- * * @return void
+ * Esta função abre o snapshot com abrirSnapshot(), conferindo o cabeçalho e
+ * os checksums de todo o conteúdo. Os dados não são copiados: o banco aponta
+ * para o arquivo mapeado e só passa para o heap se precisar crescer.
+ *
+ * Caso o arquivo não exista ou seja inválido, o banco é inicializado vazio.
+ *
+ * @param nomeArquivo Nome do arquivo binário (ex: "jogoadvinhacao.dat").
+ *
+ * @return BancoInformacoes* Retorna ponteiro para a estrutura BancoInformacoes carregada.
  */
-void formatarRanking(){
-    
-    FILE* arquivoRanking = fopen(ARQUIVO_RANKING, "r+");
-    char confirmacao;
-    printf("\n  ATENÇÃO: Isso apagará todo o histórico de recordes.\n");
-    printf("Tem certeza? (S/N): ");
-    
-    setbuf(stdin, NULL);
-    scanf("%c", &confirmacao);
+BancoInformacoes* carregarItensBinario(const char *nomeArquivo){
     
-    if (confirmacao == 's' || confirmacao == 'S'){
-        // Remove o arquivo e verifica o resultado NA MESMA LINHA
-        if (remove(ARQUIVO_RANKING) == 0){
-            printf("[OK] Ranking formatado com sucesso.\n");
-        } else {
-            printf("[Aviso] O arquivo de ranking não existia ou não pôde ser apagado.\n");
-        }
-    } else {
-        printf("[Ação] Formatação cancelada.\n");
+    BancoInformacoes *banco = abrirSnapshot(nomeArquivo, 1);
+    if (banco == NULL){
+        printf("[Aviso] Arquivo '%s' não encontrado. Um novo banco será criado.\n", nomeArquivo);
+        return inicializarBanco(); // cria um banco vazio
     }
-
-    fclose(arquivoRanking);
-   // return banco;
+    printf("[OK] %d itens carregados com sucesso de '%s'.\n", itensAtivos(banco), nomeArquivo);
+    return banco;
 }
-
@@ -1,45 +1,302 @@
 #ifndef FUNCOES_H
 #define FUNCOES_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #define MAX_DICAS 5
 #define TAM_MAX_DICA 200
 #define TAM_MAX_RESPOSTA 102
 #define TAM_MAX_CATEGORIA 102
 #define MAX_JOGADORES_SESSAO 4
 #define TAM_MAX_NOME 50
-#define MAX_RANKING_ENTRIES 10
+#define MAX_RANKING_ENTRIES 10         // Posições exibidas por página do ranking
+#define NIVEL_MAX_RANKING 32            // Altura máxima da skip list do ranking
+#define MIN_FORA_DE_ORDEM_RANKING 256   // Registros fora de ordem no log antes de compactá-lo
 #define ARQUIVO_RANKING "ranking.dat"
+#define MAGICA_RANKING "PERFILRK"       // 8 bytes, sem o '\0'
+#define VERSAO_RANKING 1
+#define LOTE_SINCRONIA_RANKING 16       // Acréscimos ao log do ranking por fsync
+#define INTERVALO_SINCRONIA_RANKING 1   // Segundos máximos entre um acréscimo e o seu fsync
+#define ARQUIVO_CSV "dados_jogoadvinhacao.csv"
+#define TAM_MIN_FATIA_CSV (1 << 20)     // Menor trecho do CSV entregue a uma thread do leitor
+#define MAX_THREADS_LEITURA 64
+#define ARQUIVO_BINARIO "jogoadvinhacao.dat"
+#define ARQUIVO_DIARIO "jogoadvinhacao.diario"
+#define MAGICA_DIARIO "PERFILDJ"        // 8 bytes, sem o '\0'
+#define VERSAO_DIARIO 1
+#define LOTE_SINCRONIA_DIARIO 16        // Registros no diário por fsync
+#define INTERVALO_SINCRONIA_DIARIO 1    // Segundos máximos entre um registro e o seu fsync
+#define TAM_MIN_DOBRA_DIARIO (1 << 20)  // Tamanho do diário a partir do qual ele vira um snapshot novo...
+#define PERCENTUAL_DOBRA_DIARIO 25      // ... se também passar de 25% do snapshot
+#define MAGICA_SNAPSHOT "PERFILDB"      // 8 bytes, sem o '\0'
+#define VERSAO_SNAPSHOT 6
+#define MARCA_ENDIANNESS 0x01020304u
+#define CHECKSUM_INICIAL 0xcbf29ce484222325ULL
+#define CARACTERES_POR_ERRO_PADRAO 5   // Um erro de digitação aceito a cada 5 caracteres da resposta
+#define MAX_ERROS_PADRAO 2
+#define PONTOS_ACERTOS 100              // Valor inicial de cada item
+#define PENALIDADE_LETRA 20             // Desconto no valor do item por letra revelada
+#define PENALIDADE_PULAR 30             // Desconto no total do jogador que pula a vez
+#define NUM_MAX_TENTATIVAS 5            // Tentativas de cada jogador por item
+#define PORTA_PADRAO_SERVIDOR 5050
+#define TAM_MAX_LINHA_SERVIDOR 512      // Maior linha de comando aceita pelo servidor
+#define INDICE_VAZIO (-1)               // Posição livre na tabela do índice de respostas
+#define INDICE_REMOVIDO (-2)            // Posição de um item retirado do índice
+#define ITEM_EXCLUIDO 0x01              // Marca de Item::marcas: item excluído, aguardando compactação
+#define ITEM_DICAS_CODIFICADAS 0x02     // Marca de Item::marcas: dicas codificadas com o dicionário do banco
+#define MAX_PALAVRAS_DICIONARIO ((1u << 21) - 1) // Códigos de até 3 bytes
+#define MAX_CATEGORIAS 65536           // Identificadores de categoria de 16 bits (0 = sem categoria)
+#define CATEGORIA_TODAS (-1)            // Sorteador sem filtro de categoria (ver criarSorteador)
+#define MAX_DESFAZER_SORTEIO 64         // Sorteios que reiniciarSorteador() desfaz sem remontar as sacolas
+#define PERCENTUAL_COMPACTACAO 25       // Compacta quando os excluídos passam de 25% dos itens
+#define MIN_EXCLUIDOS_COMPACTACAO 64    // ... e são pelo menos esta quantidade
 
 typedef enum {MUITOFACIL = 1, FACIL, MEDIO, DIFICIL, MUITODIFICIL}Dificuldade;
+#define NUM_NIVEIS 5
 
 /**
- * @brief Estrutura de dados que armazena todas as informações de um item no sistema.
- * 
+ * @brief Registro compacto ("quente") de um item no banco.
+ *
+ * Guarda apenas o que é percorrido em buscas e sorteios: a posição da resposta
+ * na arena de textos do banco, o hash da resposta normalizada e o nível de dificuldade. Os textos em si ficam
+ * na arena e as dicas em um vetor separado (DicasItem), de modo que varrer o
+ * banco não traz para a cache os ~1 KB de dicas de cada item.
+ *
+ * A chave normalizada da resposta (normalizarResposta()) é gravada na arena
+ * logo depois da resposta ("resposta\0chave\0"), por isso basta guardar o seu
+ * tamanho; a resposta é sempre gravada, mesmo vazia, para que a chave tenha
+ * lugar.
+ *
+ * Cada item tem um identificador numérico estável, que não muda quando outros
+ * itens são excluídos ou o banco é compactado. Itens excluídos continuam no
+ * vetor, marcados com ITEM_EXCLUIDO, até a próxima compactação.
+ *
+ * @see obterResposta
+ * @see obterChaveResposta
+ * @see compactarBanco
  */
 typedef struct{
-    char resposta[TAM_MAX_RESPOSTA];
-    char dica1[TAM_MAX_DICA];
-    char dica2[TAM_MAX_DICA];
-    char dica3[TAM_MAX_DICA];
-    char dica4[TAM_MAX_DICA];
-    char dica5[TAM_MAX_DICA];
-    char categoria[TAM_MAX_CATEGORIA];
-    Dificuldade nivel;  
+    uint32_t id;            // Identificador estável (crescente na ordem do vetor)
+    uint32_t resposta;      // Deslocamento da resposta na arena de textos
+    uint32_t hashResposta;  // Hash da resposta normalizada (ver normalizarResposta)
+    uint8_t tamResposta;    // Tamanho da resposta em bytes (sem o '\0'; até TAM_MAX_RESPOSTA - 1)
+    uint8_t tamChave;       // Tamanho da chave normalizada, gravada logo após a resposta
+    uint8_t nivel;          // Valor de Dificuldade (1 a 5)
+    uint8_t marcas;         // ITEM_EXCLUIDO, ITEM_DICAS_CODIFICADAS
 }Item;
 
+/**
+ * @brief Parte "fria" de um item: deslocamentos das dicas na arena e a categoria.
+ *
+ * O vetor de DicasItem é paralelo a BancoInformacoes::itens (mesmo índice).
+ * Se o item tem a marca ITEM_DICAS_CODIFICADAS, dica[d] e tamDica[d] indicam
+ * a dica codificada com o dicionário do banco (ver compressao.c), e não o texto.
+ * A categoria é o identificador dela em BancoInformacoes::categorias.
+ *
+ * @see copiarDica
+ * @see obterCategoria
+ */
+typedef struct{
+    uint32_t dica[MAX_DICAS];
+    uint16_t tamDica[MAX_DICAS];
+    uint16_t categoria;     // Identificador da categoria (0 = sem categoria)
+}DicasItem;
+
+/**
+ * @brief Região contígua de memória onde ficam todos os textos do banco.
+ *
+ * Cada texto é gravado uma única vez, terminado em '\0', e referenciado pelo
+ * seu deslocamento. O deslocamento 0 guarda sempre a string vazia.
+ */
+typedef struct{
+    char *dados;
+    size_t usado;
+    size_t capacidade;
+}ArenaTexto;
+
+/**
+ * @brief Índice de respostas: tabela hash de endereçamento aberto (sondagem linear).
+ *
+ * Cada posição guarda o índice de um item em BancoInformacoes::itens, ou
+ * INDICE_VAZIO / INDICE_REMOVIDO. A capacidade é sempre potência de 2.
+ *
+ * @see buscarItemPorResposta
+ */
+typedef struct{
+    int32_t *posicoes;
+    uint32_t capacidade;
+    uint32_t ocupadas;      // Posições não vazias, incluindo as removidas
+}IndiceRespostas;
+
+/**
+ * @brief Categorias do banco, cada uma guardada uma única vez.
+ *
+ * O identificador de uma categoria é a sua posição em 'nomes'; o 0 é sempre
+ * a categoria vazia ("sem categoria"). Cada nome fica na arena seguido da sua
+ * chave normalizada ("nome\0chave\0", ver normalizarResposta()), e duas
+ * categorias com a mesma chave ("Hardware" e "hardware") são a mesma: vale a
+ * grafia da primeira. A tabela hash localiza uma categoria pela chave.
+ *
+ * @see buscarCategoria
+ */
+typedef struct{
+    uint32_t *nomes;            // Deslocamento do nome de cada categoria na arena
+    uint32_t total;             // Categorias cadastradas, contando a 0
+    uint32_t capacidade;
+    uint16_t *tabela;           // Identificadores por hash da chave (sondagem linear; 0 = posição livre)
+    uint32_t capacidadeTabela;  // Potência de 2
+}CategoriasBanco;
+
+/**
+ * @brief Índice composto (categoria, nível) -> posições dos itens, para sorteios filtrados.
+ *
+ * 'posicoes' guarda os itens ordenados por categoria e, dentro dela, por
+ * nível: os da categoria c e nível n ocupam o trecho
+ * [inicios[c * NUM_NIVEIS + n - 1], inicios[c * NUM_NIVEIS + n]). Itens
+ * excluídos depois da construção continuam no índice (os sorteadores os
+ * descartam); inserções e trocas de categoria ou de nível o descartam.
+ *
+ * @see construirIndiceCategorias
+ */
+typedef struct{
+    int32_t *posicoes;          // Índices em BancoInformacoes::itens (NULL enquanto não existir)
+    uint32_t *inicios;          // totalCategorias * NUM_NIVEIS + 1 limites
+    uint32_t totalCategorias;   // Categorias existentes quando o índice foi construído
+}IndiceCategorias;
+
+/**
+ * @brief Índice invertido das dicas (palavra -> itens), definido em indice.c.
+ *
+ * @see construirIndiceDicas
+ */
+typedef struct IndiceDicas IndiceDicas;
+
 /**
  * @brief Estrutura que representa o banco de dados dinâmico de todos os itens cadastrados.
  *
  * Utilizada para gerenciar a coleção de itens, permitindo que o número
  * de itens cresça ou diminua dinamicamente na memória, sem limites fixos
- * (além da memória disponível).
+ * (além da memória disponível). Os vetores itens e dicas são paralelos e
+ * todos os textos ficam em uma única arena.
+ *
+ * A exclusão apenas marca o item; totalItens conta também os excluídos, que
+ * são removidos de vez por compactarBanco(). Use itensAtivos() para saber
+ * quantos itens estão de fato no banco.
  */
 typedef struct{
     Item *itens;
+    DicasItem *dicas;
+    ArenaTexto textos;
     int totalItens;
     int capacidadeArmazenamento;
+    void *mapeamento;           // Snapshot mapeado de onde vêm os vetores (NULL se estão no heap)
+    size_t tamanhoMapeamento;
+    IndiceRespostas indice;     // Construído sob demanda (posicoes == NULL enquanto não existir)
+    int totalExcluidos;         // Itens marcados com ITEM_EXCLUIDO em itens[0, totalItens)
+    uint32_t proximoId;         // Identificador do próximo item inserido
+    uint32_t geracao;           // Muda a cada compactação (as posições dos itens mudam)
+    uint32_t dicionarioDicas;   // Deslocamento na arena do dicionário das dicas codificadas (0 = sem dicionário)
+    uint32_t tamDicionarioDicas;
+    CategoriasBanco categorias; // 'nomes' aponta para o snapshot mapeado enquanto 'mapeamento' existir
+    IndiceCategorias indiceCategorias;
+    IndiceDicas *indiceDicas;   // Mantido em dia pelas alterações enquanto existir (NULL = sem índice)
 }BancoInformacoes;
 
+/**
+ * @brief Cabeçalho do snapshot binário do banco (arquivo ARQUIVO_BINARIO).
+ *
+ * O arquivo é formado pelo cabeçalho seguido de quatro seções alinhadas em 8 bytes:
+ * o vetor de Item, o vetor de DicasItem, os deslocamentos dos nomes das
+ * categorias (CategoriasBanco::nomes) e a arena de textos, exatamente como
+ * ficam na memória. Assim o snapshot pode ser mapeado e usado diretamente,
+ * sem cópia. Todos os deslocamentos são contados a partir do início do arquivo.
+ *
+ * @see salvarSnapshot
+ * @see abrirSnapshot
+ */
+typedef struct{
+    char magica[8];                 // MAGICA_SNAPSHOT
+    uint32_t versao;                // VERSAO_SNAPSHOT
+    uint32_t marcaEndianness;       // MARCA_ENDIANNESS, gravada na ordem de bytes de quem salvou
+    uint32_t tamanhoItem;           // sizeof(Item), para detectar mudança de layout
+    uint32_t tamanhoDicasItem;      // sizeof(DicasItem)
+    uint64_t totalItens;
+    uint64_t deslocamentoItens;
+    uint64_t deslocamentoDicas;
+    uint64_t deslocamentoCategorias;
+    uint64_t totalCategorias;       // Contando a categoria 0
+    uint64_t deslocamentoTextos;
+    uint64_t tamanhoTextos;
+    uint64_t proximoId;             // BancoInformacoes::proximoId
+    uint64_t totalExcluidos;        // Itens marcados como excluídos no vetor gravado
+    uint64_t dicionarioDicas;       // BancoInformacoes::dicionarioDicas (relativo à arena de textos)
+    uint64_t tamDicionarioDicas;
+    uint64_t checksumItens;         // FNV-1a de 64 bits de cada seção
+    uint64_t checksumDicas;
+    uint64_t checksumCategorias;
+    uint64_t checksumTextos;
+    uint64_t checksumCabecalho;     // FNV-1a do cabeçalho com este campo zerado
+}CabecalhoSnapshot;
+
+/**
+ * @brief Uma dica que contém o texto procurado por buscarTextoNasDicas().
+ */
+typedef struct{
+    int posicao;                // Posição do item em BancoInformacoes::itens
+    int numeroDica;             // 1 a MAX_DICAS
+}OcorrenciaDica;
+
+/**
+ * @brief Resultado de uma busca nas dicas (liberar com liberarResultadoBusca()).
+ */
+typedef struct{
+    OcorrenciaDica* ocorrencias;    // Na ordem dos itens e das dicas
+    long total;
+    uint64_t bytesLidos;            // Bytes de dicas comparados
+    const char* versao;             // Versão da varredura usada: "avx2", "sse2" ou "escalar"
+    int threads;
+}ResultadoBuscaDicas;
+
+/**
+ * @brief O que fazer com itens repetidos na importação (PERFIL_DUPLICATAS).
+ *
+ * @see tratarDuplicatas
+ */
+typedef enum {DUPLICATAS_MANTER, DUPLICATAS_MESCLAR, DUPLICATAS_REJEITAR}PoliticaDuplicatas;
+
+/**
+ * @brief Duplicatas de uma importação e o que foi feito com elas.
+ */
+typedef struct{
+    PoliticaDuplicatas politica;
+    long pelaResposta;          // Mesma resposta normalizada de um item anterior
+    long pelasDicas;            // Outra resposta, mas as mesmas dicas (sem diferenciar maiúsculas)
+    long mesclados;             // Cópias cujas dicas novas foram para o item original
+    long dicasAcrescentadas;
+    long rejeitados;            // Cópias descartadas sem mesclar
+}ResumoDuplicatas;
+
+/**
+ * @brief Um item encontrado por consultarIndiceDicas() e a sua pontuação TF-IDF.
+ */
+typedef struct{
+    int posicao;                // Posição do item em BancoInformacoes::itens
+    uint32_t id;                // Item::id
+    float pontuacao;
+}ItemPontuado;
+
+/**
+ * @brief Resultado de uma consulta ao índice das dicas (liberar com liberarConsultaDicas()).
+ */
+typedef struct{
+    ItemPontuado* itens;        // Em ordem decrescente de pontuação (no empate, de id)
+    int total;
+    long encontrados;           // Itens que atendem à consulta (pode passar de 'total' com limite)
+    int termos;                 // Palavras distintas da consulta
+    int termosConhecidos;       // Quantas delas aparecem em alguma dica
+}ResultadoConsultaDicas;
+
 /**
  * @brief Estrutura que armazena os dados de um jogador durante uma única sessão de jogo.
  *
@@ -68,6 +325,241 @@ typedef struct {
     int pontuacao;
 }PosicaoRanking;
 
+/**
+ * @brief Cabeçalho do log do ranking (arquivo ARQUIVO_RANKING).
+ *
+ * É seguido de registros RegistroLogRanking, um por pontuação, acrescentados
+ * ao fim do arquivo. Um arquivo sem este cabeçalho está no formato antigo
+ * (PosicaoRanking sem checksum) e é convertido na primeira gravação.
+ *
+ * @see registrarPontuacao
+ */
+typedef struct{
+    char magica[8];             // MAGICA_RANKING
+    uint32_t versao;            // VERSAO_RANKING
+    uint32_t tamanhoRegistro;   // sizeof(RegistroLogRanking)
+}CabecalhoRanking;
+
+/**
+ * @brief Registro do log do ranking: uma pontuação e o checksum dela.
+ *
+ * Registros com checksum errado (gravação interrompida) são ignorados na leitura.
+ */
+typedef struct{
+    PosicaoRanking posicao;
+    uint64_t checksum;          // FNV-1a de 64 bits de 'posicao'
+}RegistroLogRanking;
+
+/**
+ * @brief Alterações do menu registradas no diário do banco.
+ */
+typedef enum {DIARIO_INSERIR = 1, DIARIO_RESPOSTA, DIARIO_CATEGORIA, DIARIO_NIVEL, DIARIO_EXCLUIR, DIARIO_DICAS}OperacaoDiario;
+
+/**
+ * @brief Cabeçalho do diário do banco (arquivo ARQUIVO_DIARIO).
+ *
+ * O diário só vale sobre o snapshot cujo cabeçalho tem o checksum gravado aqui.
+ *
+ * @see abrirDiario
+ */
+typedef struct{
+    char magica[8];             // MAGICA_DIARIO
+    uint32_t versao;            // VERSAO_DIARIO
+    uint32_t tamanhoRegistro;   // sizeof(RegistroDiario)
+    uint64_t checksumSnapshot;  // CabecalhoSnapshot::checksumCabecalho do snapshot base
+}CabecalhoDiario;
+
+/**
+ * @brief Registro do diário: uma alteração de um item, seguida de 'tamTextos' bytes de texto.
+ *
+ * Os textos são strings terminadas em '\0': resposta, as MAX_DICAS dicas e a
+ * categoria (DIARIO_INSERIR), a nova resposta (DIARIO_RESPOSTA), a nova
+ * categoria (DIARIO_CATEGORIA) ou as MAX_DICAS novas dicas (DIARIO_DICAS).
+ */
+typedef struct{
+    uint32_t id;                // Item::id
+    uint16_t tamTextos;
+    uint8_t operacao;           // OperacaoDiario
+    uint8_t nivel;              // DIARIO_INSERIR e DIARIO_NIVEL
+    uint64_t checksum;          // FNV-1a do registro (com este campo zerado) e dos textos
+}RegistroDiario;
+
+/**
+ * @brief Configuração da comparação tolerante de palpites.
+ *
+ * @see avaliarPalpite
+ */
+typedef struct{
+    int ativo;                  // 0: só a resposta exata (após normalização) é aceita
+    int caracteresPorErro;      // Um erro de digitação aceito a cada N caracteres da resposta
+    int maxErros;               // Teto de erros, independente do tamanho da resposta
+}ToleranciaPalpite;
+
+/**
+ * @brief Estado do gerador pseudoaleatório xoshiro256**.
+ *
+ * @see iniciarGerador
+ */
+typedef struct{
+    uint64_t estado[4];
+}GeradorAleatorio;
+
+/**
+ * @brief Itens de um nível de dificuldade disponíveis para sorteio sem reposição.
+ *
+ * As posições [0, restantes) guardam os itens que ainda não saíram na volta
+ * atual; as posições [restantes, total) guardam os que já saíram.
+ */
+typedef struct{
+    int32_t *itens;     // Índices em BancoInformacoes::itens
+    int total;
+    int restantes;
+}SacolaNivel;
+
+/**
+ * @brief Sorteador de itens de uma sessão de jogo (uma sacola por nível, de uma categoria ou de todas).
+ *
+ * @see criarSorteador
+ * @see sortearItem
+ */
+typedef struct{
+    const BancoInformacoes *banco;
+    GeradorAleatorio gerador;
+    int categoria;              // Só itens desta categoria, ou CATEGORIA_TODAS
+    SacolaNivel sacolas[NUM_NIVEIS];
+    int32_t ultimoSorteado;     // Nunca sai duas vezes seguidas (-1 no início)
+    uint32_t geracao;           // BancoInformacoes::geracao quando as sacolas foram montadas
+    int32_t posicoesSorteadas[MAX_DESFAZER_SORTEIO];  // Posição sorteada na sacola, para desfazer a troca
+    uint8_t niveisSorteados[MAX_DESFAZER_SORTEIO];
+    int totalSorteados;         // Sorteios desde a montagem das sacolas (-1 se não dá mais para desfazê-los)
+}SorteadorItens;
+
+/**
+ * @brief Ligação de um nó do ranking com o seguinte em um nível da skip list.
+ */
+typedef struct NoRanking NoRanking;
+typedef struct{
+    NoRanking *proximo;
+    long largura;               // Quantas posições do ranking a ligação avança
+}LigacaoRanking;
+
+/**
+ * @brief Nó da skip list do ranking: um registro e suas ligações.
+ */
+struct NoRanking{
+    PosicaoRanking registro;
+    uint64_t sequencia;         // Ordem de chegada; desempata pontuações iguais (quem chegou antes fica à frente)
+    int altura;
+    LigacaoRanking ligacoes[];  // 'altura' ligações
+};
+
+/**
+ * @brief Ranking completo dos jogadores, ordenado por pontuação (decrescente).
+ *
+ * É uma skip list indexável: cada ligação guarda quantas posições ela pula,
+ * o que permite inserir, descobrir a posição de uma pontuação e ir direto a
+ * uma posição qualquer em O(log n) esperado. Não há limite de registros.
+ *
+ * Um RankingJogadores ligado a um log pode ser usado por vários processos ao
+ * mesmo tempo (cada um com o seu), mas não por várias threads de um processo.
+ *
+ * @see carregarRanking
+ * @see registrarPontuacao
+ */
+typedef struct{
+    NoRanking *cabeca;                          // Nó sentinela, com NIVEL_MAX_RANKING ligações
+    int nivel;                                  // Níveis em uso
+    long total;
+    uint64_t proximaSequencia;
+    NoRanking *ultimos[NIVEL_MAX_RANKING];      // Último nó de cada nível (inserção no fim em O(1))
+    long posicaoUltimos[NIVEL_MAX_RANKING];     // Posição de cada um deles (0 = cabeça)
+    long registrosForaDeOrdem;                  // Registros do log que não estão na ordem do ranking (ou inválidos)
+    GeradorAleatorio gerador;                   // Sorteia a altura dos nós
+    int descritorLog;                           // Log aberto para leitura e acréscimo (-1 se ainda não aberto)
+    int descritorTrava;                         // "<log>.lock", que recebe as travas entre processos
+    uint64_t dispositivoLog;                    // Identidade do log aberto (st_dev, st_ino), para perceber
+    uint64_t inodeLog;                          // quando outro processo o substitui
+    uint64_t bytesIncorporados;                 // Bytes do log já lidos para a memória
+    int formatoLegado;                          // Log no formato antigo, sem cabeçalho nem checksums
+    int registrosSemSincronia;                  // Acréscimos ainda sem fsync
+    int64_t inicioSemSincronia;                 // Momento (time()) do mais antigo deles
+}RankingJogadores;
+
+/**
+ * @brief Ações de um jogador na sua vez.
+ */
+typedef enum {ACAO_RESPONDER, ACAO_REVELAR_LETRA, ACAO_NOVA_DICA, ACAO_PULAR}AcaoJogador;
+
+/**
+ * @brief O que aconteceu ao aplicar uma ação (ver aplicarAcaoSessao).
+ */
+typedef enum {
+    RESULTADO_ACERTOU,          // Item encerrado; o jogador da vez ganhou pontuacaoRodada
+    RESULTADO_ERROU,
+    RESULTADO_LETRA_REVELADA,   // Posição em SessaoJogo::ultimaLetra
+    RESULTADO_SEM_LETRAS,       // Nada a revelar, mas a penalidade vale
+    RESULTADO_DICA_LIBERADA,
+    RESULTADO_SEM_DICAS,
+    RESULTADO_PULOU,
+    RESULTADO_INVALIDO          // Ação desconhecida ou nenhum item em jogo
+}ResultadoAcao;
+
+/**
+ * @brief Momento da sessão de jogo.
+ */
+typedef enum {
+    SESSAO_AGUARDANDO_ITEM,     // Antes do primeiro item (ou sem itens na faixa)
+    SESSAO_EM_JOGO,
+    SESSAO_ITEM_ENCERRADO       // Acertado ou sem tentativas; aguarda proximoItemSessao
+}EstadoSessao;
+
+/**
+ * @brief Sessão de jogo: jogadores, item em jogo e regras de pontuação, sem entrada nem saída.
+ *
+ * Os campos podem ser lidos diretamente pelas interfaces (console, servidor,
+ * gráfica); só as funções de sessao.c os alteram.
+ *
+ * @see iniciarSessao
+ * @see aplicarAcaoSessao
+ */
+typedef struct{
+    const BancoInformacoes *banco;
+    SorteadorItens *sorteador;          // Emprestado: pode ser compartilhado entre sessões
+    JogadorSessao jogadores[MAX_JOGADORES_SESSAO];
+    int numeroJogadores;
+    int nivelMinimo;
+    int nivelMaximo;
+    EstadoSessao estado;
+    const Item *item;                   // Último item sorteado (NULL antes do primeiro)
+    char mascara[TAM_MAX_RESPOSTA];     // Resposta com as letras ainda ocultas trocadas por '_'
+    int dicaAtual;                      // 1 a MAX_DICAS
+    char dica[TAM_MAX_DICA];            // Texto da dica 'dicaMostrada', decodificado só quando pedido
+    int dicaMostrada;                   // 0 se 'dica' não vale para o item e a dica atuais
+    int pontuacaoRodada;                // Quanto vale acertar o item agora
+    int jogadorAtual;                   // Índice do jogador da vez
+    int itemAdivinhado;
+    int errosUltimoAcerto;              // Erros de digitação aceitos no último acerto
+    int ultimaLetra;                    // Posição da última letra revelada
+    long itensJogados;
+}SessaoJogo;
+
+/**
+ * @brief Um banco publicado pela recarga, com contador de referências (ver recarga.c).
+ *
+ * Os Item* de uma versão valem enquanto o chamador segura uma referência a ela.
+ */
+typedef struct VersaoBanco{
+    BancoInformacoes *banco;
+    long numero;                        // 1 = banco carregado na inicialização
+    long referencias;                   // Alterado só com operações atômicas
+    struct VersaoBanco *proxima;        // Lista das versões substituídas
+}VersaoBanco;
+
+/**
+ * @brief Versão atual do banco e a thread que recarrega o CSV quando ele muda.
+ */
+typedef struct RecargaBanco RecargaBanco;
+
 /**
  * @author Maria Julia Ferraz Rocha
  * @brief Cabeçalho da interface gráfica e definições de estados do jogo.
@@ -83,6 +575,142 @@ Item* obterItemAleatorio(BancoInformacoes* banco);
  */
 void leArquivoCSV(BancoInformacoes* banco);
 
+/**
+ * @brief Troca a resposta de um item, mantendo o índice de respostas em dia.
+ */
+int alterarRespostaItem(BancoInformacoes* banco, int posicao, const char* resposta);
+
+/**
+ * @brief Troca a categoria de um item.
+ */
+int alterarCategoriaItem(BancoInformacoes* banco, int posicao, const char* categoria);
+
+/**
+ * @brief Troca o nível de dificuldade de um item.
+ */
+int alterarNivelItem(BancoInformacoes* banco, int posicao, int nivel);
+
+/**
+ * @brief Troca as dicas de um item sem interação com o usuário.
+ */
+int alterarDicasItem(BancoInformacoes* banco, int posicao, const char* dicas[MAX_DICAS]);
+
+/**
+ * @brief Carrega um arquivo CSV de itens, em paralelo, anexando-os ao banco.
+ */
+int carregarCSV(BancoInformacoes* banco, const char* caminho);
+
+/**
+ * @brief Adiciona um item ao banco sem interação com o usuário.
+ */
+int adicionarItemBanco(BancoInformacoes* banco, const char* resposta, int nivel,
+                       const char* dicas[MAX_DICAS], const char* categoria);
+
+/**
+ * @brief Retorna a resposta de um item do banco.
+ */
+const char* obterResposta(const BancoInformacoes* banco, const Item* item);
+
+/**
+ * @brief Retorna a chave normalizada da resposta de um item (Item::tamChave bytes).
+ */
+const char* obterChaveResposta(const BancoInformacoes* banco, const Item* item);
+
+/**
+ * @brief Retorna a dica de número 1 a MAX_DICAS de um item com dicas em texto (ver copiarDica).
+ */
+const char* obterDica(const BancoInformacoes* banco, const Item* item, int numeroDica);
+
+/**
+ * @brief Copia para 'destino' a dica de número 1 a MAX_DICAS de um item, decodificando-a se preciso.
+ */
+size_t copiarDica(const BancoInformacoes* banco, const Item* item, int numeroDica, char* destino, size_t tamDestino);
+
+/**
+ * @brief Codifica as dicas de todos os itens com um dicionário de palavras montado a partir delas.
+ */
+int codificarDicasBanco(BancoInformacoes* banco);
+
+/**
+ * @brief Volta a guardar as dicas de todos os itens em texto e descarta o dicionário.
+ */
+int decodificarDicasBanco(BancoInformacoes* banco);
+
+/**
+ * @brief Codifica as dicas do banco se PERFIL_DICAS=compactadas.
+ */
+void aplicarModoDicas(BancoInformacoes* banco);
+
+/**
+ * @brief Retorna a categoria de um item do banco.
+ */
+const char* obterCategoria(const BancoInformacoes* banco, const Item* item);
+
+/**
+ * @brief Retorna o nome de uma categoria pelo seu identificador.
+ */
+const char* nomeCategoria(const BancoInformacoes* banco, int categoria);
+
+/**
+ * @brief Localiza uma categoria pelo nome (sem diferenciar maiúsculas nem acentos).
+ */
+int buscarCategoria(const BancoInformacoes* banco, const char* nome);
+
+/**
+ * @brief (Re)constrói o índice composto (categoria, nível) do banco.
+ */
+int construirIndiceCategorias(BancoInformacoes* banco);
+
+/**
+ * @brief Quantidade de itens de uma categoria em uma faixa de níveis.
+ */
+long contarItensCategoria(const BancoInformacoes* banco, int categoria, int nivelMinimo, int nivelMaximo);
+
+/**
+ * @brief Gera a chave de comparação de uma resposta ou palpite (minúsculas, sem acentos, só letras e dígitos).
+ */
+size_t normalizarResposta(const char* texto, size_t tam, char* saida, size_t tamSaida);
+
+/**
+ * @brief Calcula o hash da chave normalizada de uma resposta.
+ */
+uint32_t calcularHashResposta(const char* resposta, size_t tam);
+
+/**
+ * @brief (Re)constrói de uma vez o índice de respostas do banco.
+ */
+int construirIndiceRespostas(BancoInformacoes* banco);
+
+/**
+ * @brief Localiza um item pela resposta em tempo constante.
+ */
+int buscarItemPorResposta(BancoInformacoes* banco, const char* resposta);
+
+/**
+ * @brief Localiza um item pelo seu identificador estável.
+ */
+int buscarItemPorId(const BancoInformacoes* banco, uint32_t id);
+
+/**
+ * @brief Exclui um item sem interação com o usuário (marca de exclusão).
+ */
+int removerItemBanco(BancoInformacoes* banco, int posicao);
+
+/**
+ * @brief Copia para o heap um banco aberto de um snapshot mapeado, antes de alterá-lo.
+ */
+int prepararEscrita(BancoInformacoes* banco);
+
+/**
+ * @brief Remove de vez os itens excluídos e os textos sem uso.
+ */
+int compactarBanco(BancoInformacoes* banco);
+
+/**
+ * @brief Quantidade de itens não excluídos do banco.
+ */
+int itensAtivos(const BancoInformacoes* banco);
+
 /**
  * @brief Lê uma string do usuário de forma segura, convertendo-a para minúsculas.
  */
@@ -133,18 +761,95 @@ void salvarItensBinario(BancoInformacoes *banco);
  */
 BancoInformacoes* carregarItensBinario(const char *nomeArquivo);
 
+/**
+ * @brief Preenche a identificação e a posição das seções de um cabeçalho de snapshot.
+ */
+void prepararCabecalhoSnapshot(CabecalhoSnapshot* cabecalho, uint64_t totalItens, uint64_t totalCategorias,
+                               uint64_t tamanhoTextos);
+
+/**
+ * @brief Grava o banco no formato de snapshot (CabecalhoSnapshot) de forma atômica.
+ */
+int salvarSnapshot(const BancoInformacoes* banco, const char* caminho);
+
+/**
+ * @brief Mapeia um snapshot em memória e o usa como banco, sem copiar os dados.
+ */
+BancoInformacoes* abrirSnapshot(const char* caminho, int verificarConteudo);
+
+/**
+ * @brief Carrega o banco na inicialização, preferindo o snapshot quando ele é mais novo que o CSV.
+ */
+BancoInformacoes* carregarBancoInicial(void);
+
+/**
+ * @brief Reaplica o diário sobre o banco recém-carregado (doSnapshot = 1 se ele veio de ARQUIVO_BINARIO).
+ */
+int abrirDiario(BancoInformacoes* banco, int doSnapshot);
+
+/**
+ * @brief Acrescenta ao diário uma alteração já feita no banco.
+ */
+int registrarNoDiario(BancoInformacoes* banco, OperacaoDiario operacao, uint32_t id);
+
+/**
+ * @brief Começa um diário vazio sobre o snapshot recém-gravado em ARQUIVO_BINARIO.
+ */
+int reiniciarDiario(void);
+
+/**
+ * @brief Força o fsync dos registros do diário ainda não sincronizados.
+ */
+int sincronizarDiario(void);
+
+/**
+ * @brief Opção "Sair" do menu: garante em disco as alterações (diário ou snapshot).
+ */
+void salvarAlteracoes(BancoInformacoes* banco);
+
+/**
+ * @brief Sincroniza e fecha o diário no fim do programa.
+ */
+void encerrarDiario(void);
+
+/**
+ * @brief Acumula bytes em um checksum FNV-1a de 64 bits.
+ */
+uint64_t atualizarChecksum(uint64_t estado, const void* dados, size_t tamanho);
+
+/**
+ * @brief Hash FNV-1a de 32 bits de um trecho de bytes.
+ */
+uint32_t hashBytes(const char* dados, size_t tam);
+
+/**
+ * @brief Garante espaço para 'necessario' elementos em um vetor, dobrando a capacidade.
+ */
+int crescerVetor(void** dados, size_t* capacidade, size_t necessario, size_t tamElemento);
+
+/**
+ * @brief Segundos decorridos desde 'inicio' (CLOCK_MONOTONIC).
+ */
+struct timespec;    // <time.h>, com _POSIX_C_SOURCE
+double segundosDesde(const struct timespec* inicio);
+
+/**
+ * @brief Grava exatamente 'tamanho' bytes em um descritor, repetindo gravações parciais.
+ */
+int gravarTudo(int descritor, const void* origem, size_t tamanho);
+
 /**
  * @brief Executa a lógica principal do jogo (Modo Jogar).
  */
 void jogar(BancoInformacoes* banco);
 
 /**
- * @brief Salva a pontuação no ranking. Mantém apenas o Top 10.
+ * @brief Salva a pontuação no ranking e informa a posição do jogador.
  */
 void salvarRanking(const char* nome, int pontuacao);
 
 /**
- * @brief Exibe o Top 10 jogadores.
+ * @brief Exibe o ranking, página por página.
  */
 void listarRanking();
 
@@ -153,11 +858,340 @@ void listarRanking();
  */
 void formatarRanking();
 
+/**
+ * @brief Tamanho em bytes do caractere UTF-8 que começa em 'texto' (0 no fim da string).
+ */
+int tamanhoLetra(const char* texto);
+
+/**
+ * @brief Revela na máscara a primeira letra ainda oculta da resposta.
+ */
+int revelarLetra(const char* resposta, char* mascara);
+
+/**
+ * @brief Prepara uma sessão de jogo vazia, sem jogadores nem item.
+ */
+void iniciarSessao(SessaoJogo* sessao, const BancoInformacoes* banco, SorteadorItens* sorteador,
+                   int nivelMinimo, int nivelMaximo);
+
+/**
+ * @brief Acrescenta um jogador à sessão, antes do primeiro item.
+ */
+int adicionarJogadorSessao(SessaoJogo* sessao, const char* nome);
+
+/**
+ * @brief Sorteia o próximo item da sessão e devolve as tentativas a todos.
+ */
+const Item* proximoItemSessao(SessaoJogo* sessao);
+
+/**
+ * @brief Aplica a ação do jogador da vez e passa a vez quando a regra manda.
+ */
+ResultadoAcao aplicarAcaoSessao(SessaoJogo* sessao, AcaoJogador acao, const char* palpite);
+
+/**
+ * @brief Jogador da vez (NULL se a sessão não tem jogadores).
+ */
+const JogadorSessao* jogadorDaVez(const SessaoJogo* sessao);
+
+/**
+ * @brief Texto da dica em vigor no item em jogo.
+ */
+const char* dicaAtualSessao(SessaoJogo* sessao);
+
+/**
+ * @brief Resposta do item em jogo (ou do último jogado).
+ */
+const char* respostaSessao(const SessaoJogo* sessao);
+
+/**
+ * @brief Publica o banco inicial e passa a recarregar o CSV quando ele mudar.
+ */
+RecargaBanco* iniciarRecargaBanco(BancoInformacoes* banco, const char* caminhoCsv);
+
+/**
+ * @brief Pega uma referência à versão mais recente do banco.
+ */
+VersaoBanco* adquirirVersaoBanco(RecargaBanco* recarga);
+
+/**
+ * @brief Pega mais uma referência a uma versão que o chamador já segura.
+ */
+void reterVersaoBanco(VersaoBanco* versao);
+
+/**
+ * @brief Devolve uma referência a uma versão do banco.
+ */
+void liberarVersaoBanco(VersaoBanco* versao);
+
+/**
+ * @brief Número da versão mais recente do banco (leitura sem trava).
+ */
+long numeroVersaoBanco(const RecargaBanco* recarga);
+
+/**
+ * @brief Para a recarga e libera todas as versões do banco.
+ */
+void encerrarRecargaBanco(RecargaBanco* recarga);
+
+/**
+ * @brief Modo servidor: hospeda sessões de jogo em um socket TCP ou Unix.
+ *
+ * O banco passa a ser do servidor, que o libera ao encerrar.
+ */
+int executarServidor(BancoInformacoes* banco, int argc, char* argv[]);
+
+/**
+ * @brief Cliente de carga do modo servidor (sessões/s e latência por turno).
+ */
+int executarCarga(int argc, char* argv[]);
+
+/**
+ * @brief Simulação sem interface: sessões de robôs, vazão, latência e pontuações.
+ */
+int executarSimulacao(const BancoInformacoes* banco, int argc, char* argv[]);
+
+/**
+ * @brief Procura um texto em todas as dicas do banco (varredura SIMD em paralelo).
+ */
+int buscarTextoNasDicas(const BancoInformacoes* banco, const char* texto, int threads, ResultadoBuscaDicas* resultado);
+
+/**
+ * @brief Libera as ocorrências de uma busca nas dicas.
+ */
+void liberarResultadoBusca(ResultadoBuscaDicas* resultado);
+
+/**
+ * @brief Opção do menu: lista os itens cujas dicas contêm um texto.
+ */
+void pesquisarDicas(BancoInformacoes* banco);
+
+/**
+ * @brief Busca nas dicas pela linha de comando ("jogo buscar texto" ou "jogo buscar --palavras ...").
+ */
+int executarBusca(BancoInformacoes* banco, int argc, char* argv[]);
+
+/**
+ * @brief (Re)constrói em paralelo o índice invertido das dicas do banco.
+ */
+int construirIndiceDicas(BancoInformacoes* banco, int threads);
+
+/**
+ * @brief Libera o índice invertido das dicas (se houver).
+ */
+void descartarIndiceDicas(BancoInformacoes* banco);
+
+/**
+ * @brief Põe no índice das dicas o item da posição dada (inserido ou com as dicas trocadas).
+ */
+void indexarDicasItem(BancoInformacoes* banco, int posicao);
+
+/**
+ * @brief Tira do índice das dicas o item da posição dada (antes de excluí-lo ou de trocar as dicas).
+ */
+void desindexarDicasItem(BancoInformacoes* banco, int posicao);
+
+/**
+ * @brief Consulta o índice das dicas por palavras (E ou OU), com os itens ordenados por TF-IDF.
+ */
+int consultarIndiceDicas(const BancoInformacoes* banco, const char* consulta, int qualquerTermo, int limite,
+                         ResultadoConsultaDicas* resultado);
+
+/**
+ * @brief Libera os itens de uma consulta ao índice das dicas.
+ */
+void liberarConsultaDicas(ResultadoConsultaDicas* resultado);
+
+/**
+ * @brief Opção do menu: pesquisa itens pelas palavras das dicas, os mais relevantes primeiro.
+ */
+void pesquisarPalavrasChave(BancoInformacoes* banco);
+
+/**
+ * @brief Política de duplicatas em uso (PERFIL_DUPLICATAS, lida na primeira chamada).
+ */
+PoliticaDuplicatas politicaDuplicatas(void);
+
+/**
+ * @brief Define a política de duplicatas; substitui também a lida do ambiente.
+ */
+void definirPoliticaDuplicatas(PoliticaDuplicatas nova);
+
+/**
+ * @brief Nome de uma política de duplicatas ("manter", "mesclar" ou "rejeitar").
+ */
+const char* nomePoliticaDuplicatas(PoliticaDuplicatas qual);
+
+/**
+ * @brief Hash de 64 bits das dicas de um item, sem diferenciar maiúsculas ASCII (0 se ele não tiver dicas).
+ */
+uint64_t calcularHashDicas(const BancoInformacoes* banco, const Item* item);
+
+/**
+ * @brief Acrescenta a um item as dicas que ele ainda não tem, nas posições vazias.
+ */
+int mesclarDicasItem(BancoInformacoes* banco, int posicao, const char* dicas[MAX_DICAS]);
+
+/**
+ * @brief Aplica a política de duplicatas aos itens recém-importados [inicio, totalItens).
+ */
+int tratarDuplicatas(BancoInformacoes* banco, int inicio, const uint64_t* hashesDicas, ResumoDuplicatas* resumo);
+
+/**
+ * @brief Gerador de bancos sintéticos ("jogo gerar"): CSV ou snapshot, em fluxo contínuo.
+ */
+int executarGerador(int argc, char* argv[]);
+
+/**
+ * @brief Manutenção sem o menu ("jogo importar|exportar|apagar|estatisticas"), ver lote.c.
+ */
+int executarLote(const char* comando, int argc, char* argv[]);
+
 /**
  * @brief Remove espaço de palavras reconhecendo como iguais.
  */
 void removerEspacos(char str[]);
 
+/**
+ * @brief Define como os palpites são comparados com as respostas.
+ */
+void definirToleranciaPalpite(ToleranciaPalpite config);
+
+/**
+ * @brief Retorna a configuração de tolerância em uso.
+ */
+ToleranciaPalpite obterToleranciaPalpite(void);
+
+/**
+ * @brief Quantos erros de digitação são aceitos para uma resposta deste tamanho.
+ */
+int errosPermitidos(size_t tamResposta);
+
+/**
+ * @brief Distância de edição (Levenshtein) limitada, pelo algoritmo bit-paralelo de Myers.
+ */
+int distanciaEdicao(const char* padrao, size_t tamPadrao, const char* texto, size_t tamTexto, int limite);
+
+/**
+ * @brief Compara um palpite com a resposta, aceitando erros de digitação.
+ */
+int avaliarPalpite(const char* palpite, const char* resposta);
+
+/**
+ * @brief Compara um palpite já normalizado com a chave da resposta, aceitando erros de digitação.
+ */
+int avaliarChavePalpite(const char* chavePalpite, size_t tamPalpite, const char* chaveResposta, size_t tamResposta);
+
+/**
+ * @brief Inicia o gerador xoshiro256** a partir de uma semente.
+ */
+void iniciarGerador(GeradorAleatorio* gerador, uint64_t semente);
+
+/**
+ * @brief Gera o próximo número pseudoaleatório de 64 bits.
+ */
+uint64_t proximoAleatorio(GeradorAleatorio* gerador);
+
+/**
+ * @brief Sorteia um inteiro uniforme em [0, limite).
+ */
+uint32_t aleatorioAte(GeradorAleatorio* gerador, uint32_t limite);
+
+/**
+ * @brief Semente padrão das sessões (PERFIL_SEMENTE ou relógio).
+ */
+uint64_t sementePadrao(void);
+
+/**
+ * @brief Cria um sorteador de itens para uma sessão, de uma categoria ou de todas.
+ */
+SorteadorItens* criarSorteador(const BancoInformacoes* banco, int categoria, uint64_t semente);
+
+/**
+ * @brief Sorteia, sem repetição, um item com nível na faixa pedida.
+ */
+Item* sortearItem(SorteadorItens* sorteador, int nivelMinimo, int nivelMaximo);
+
+/**
+ * @brief Volta o sorteador ao estado de recém-criado, com uma nova semente.
+ */
+int reiniciarSorteador(SorteadorItens* sorteador, uint64_t semente);
+
+/**
+ * @brief Libera a memória de um sorteador.
+ */
+void liberarSorteador(SorteadorItens* sorteador);
+
+/**
+ * @brief Cria um ranking vazio, apenas em memória.
+ */
+RankingJogadores* criarRanking(void);
+
+/**
+ * @brief Libera a memória de um ranking.
+ */
+void liberarRanking(RankingJogadores* ranking);
+
+/**
+ * @brief Lê o log de pontuações e monta o ranking em memória.
+ */
+RankingJogadores* carregarRanking(const char* caminho);
+
+/**
+ * @brief Insere uma pontuação no ranking em memória.
+ */
+long inserirNoRanking(RankingJogadores* ranking, const char* nome, int pontuacao);
+
+/**
+ * @brief Insere uma pontuação no ranking e a acrescenta ao log em disco.
+ */
+long registrarPontuacao(RankingJogadores* ranking, const char* caminho, const char* nome, int pontuacao);
+
+/**
+ * @brief Regrava o log do ranking em ordem, de forma atômica.
+ */
+int compactarRanking(RankingJogadores* ranking, const char* caminho);
+
+/**
+ * @brief Incorpora ao ranking em memória o que outros processos gravaram no log.
+ */
+int atualizarRanking(RankingJogadores* ranking, const char* caminho);
+
+/**
+ * @brief Apaga todas as pontuações do ranking e do log.
+ */
+int apagarRanking(RankingJogadores* ranking, const char* caminho);
+
+/**
+ * @brief Força o fsync dos acréscimos ao log ainda não sincronizados.
+ */
+int sincronizarRanking(RankingJogadores* ranking);
+
+/**
+ * @brief Sincroniza o ranking de ARQUIVO_RANKING (fim de uma sessão de jogo).
+ */
+void sincronizarRankingAtual(void);
+
+/**
+ * @brief Sincroniza e libera o ranking de ARQUIVO_RANKING (fim do programa).
+ */
+void encerrarRanking(void);
+
+/**
+ * @brief Posição que uma pontuação ocupa (ou ocuparia) no ranking.
+ */
+long posicaoDaPontuacao(const RankingJogadores* ranking, int pontuacao);
+
+/**
+ * @brief Registro que está em uma posição do ranking.
+ */
+const PosicaoRanking* obterPosicaoRanking(const RankingJogadores* ranking, long posicao);
+
+/**
+ * @brief Copia um trecho consecutivo do ranking (Top K ou uma página).
+ */
+int copiarTrechoRanking(const RankingJogadores* ranking, long inicio, int quantidade, PosicaoRanking saida[]);
+
 /**
  * @brief Inicia o jogo, dando a opção multijogador
  */
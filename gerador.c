@@ -0,0 +1,598 @@
+/**
+ * @file gerador.c
+ * @brief Gerador de bancos sintéticos para testes em grande escala.
+ *
+ * Iniciado com "jogo gerar [opções]". Escreve N linhas no formato do CSV do
+ * jogo (Resposta;Nivel;Categoria;Dica1..Dica5) ou diretamente um snapshot
+ * binário (CabecalhoSnapshot), com:
+ *
+ * - tamanhos de resposta e de dica sorteados de uma distribuição configurável
+ *   (uniforme, normal ou cauda: muitos curtos e poucos longos);
+ * - níveis sorteados com pesos configuráveis e categorias sorteadas de
+ *   maneira uniforme entre as N primeiras de uma lista fixa;
+ * - uma taxa de respostas duplicadas (às vezes só com maiúsculas diferentes);
+ * - uma taxa de linhas inválidas no CSV (campo faltando, nível inválido ou
+ *   resposta vazia), que o leitor descarta.
+ *
+ * Tudo é derivado da semente: a mesma linha de comando gera sempre o mesmo
+ * arquivo. A saída é gravada em fluxo, sem guardar os itens, de modo que gerar
+ * 10 milhões de linhas usa a mesma memória que gerar 10. Para isso:
+ *
+ * - a resposta do item j é uma função só de (semente, j): uma duplicata refaz
+ *   a resposta de um item anterior em vez de procurá-la;
+ * - toda resposta começa por uma "palavra-chave" de tamanho fixo que codifica
+ *   j, o que garante respostas distintas (mesmo depois de normalizadas) fora
+ *   das duplicatas intencionais;
+ * - no snapshot, as seções de itens e de dicas têm tamanho conhecido de
+ *   antemão (os nomes das categorias abrem a seção de textos); cada seção é gravada por um fluxo próprio já posicionado no seu
+ *   deslocamento final, e o cabeçalho (com os checksums acumulados) por último.
+ *
+ * @date 2025-11-26
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "funcoes.h"
+
+#define TAM_BUFFER_GERADOR (1 << 20)    // Buffer de cada fluxo de saída
+#define SILABAS_POR_PALAVRA_MAX 4       // Palavras extras da resposta: 2 a 4 sílabas
+#define MULTIPLICADOR_ITEM 0x9E3779B97F4A7C15ULL
+
+typedef enum {DISTRIBUICAO_UNIFORME, DISTRIBUICAO_NORMAL, DISTRIBUICAO_CAUDA}TipoDistribuicao;
+
+static const char* nomesDistribuicoes[] = {"uniforme", "normal", "cauda"};
+
+/**
+ * @brief Distribuição dos tamanhos (em bytes) de um tipo de texto.
+ */
+typedef struct{
+    TipoDistribuicao tipo;
+    int minimo;
+    int maximo;
+}DistribuicaoTamanho;
+
+/**
+ * @brief Opções da linha de comando do gerador.
+ */
+typedef struct{
+    long long itens;
+    uint64_t semente;
+    DistribuicaoTamanho tamResposta;
+    DistribuicaoTamanho tamDica;
+    unsigned pesosNiveis[NUM_NIVEIS];
+    int categorias;                             // Quantidade de categorias (0: itens sem categoria)
+    double taxaDuplicatas;                      // Fração das linhas (0 a 1)
+    double taxaInvalidas;                       // Fração das linhas do CSV (0 a 1)
+    int snapshot;                               // 0: CSV, 1: snapshot
+    const char* saida;
+}ParametrosGerador;
+
+/**
+ * @brief Contagens do que foi gerado, para o resumo final.
+ */
+typedef struct{
+    long long linhas;
+    long long duplicatas;
+    long long invalidas;
+    uint64_t bytes;
+}ResumoGerador;
+
+// 16 consoantes x 4 vogais: cada sílaba codifica 6 bits da palavra-chave
+static const char consoantes[] = "bcdfgjklmnprstvz";
+static const char vogais[] = "aeio";
+
+static const char* palavrasDica[] = {
+    "sou", "fui", "conhecido", "conhecida", "por", "uma", "um", "de", "do", "da", "em", "no", "na",
+    "e", "é", "não", "mais", "muito", "meu", "minha", "primeiro", "primeira", "século", "país",
+    "história", "ciência", "computação", "música", "invenção", "máquina", "teoria", "prêmio",
+    "livro", "obra", "descoberta", "época", "guerra", "rede", "sistema", "linguagem", "cidade",
+    "famoso", "famosa", "trabalho", "criei", "estudei", "nasci", "vivi", "ganhei", "ajudei",
+    "jogo", "filme", "nome", "também", "até", "hoje", "usado", "usada", "mundo", "ideia",
+    "ação", "função", "números", "cálculo", "lógica", "dados", "memória", "código", "internet"
+};
+#define NUM_PALAVRAS_DICA (sizeof(palavrasDica) / sizeof(palavrasDica[0]))
+
+static const char* nomesCategorias[] = {
+    "hardware", "software", "pessoas", "redes", "linguagens", "jogos", "empresas", "conceitos"
+};
+#define NUM_NOMES_CATEGORIAS (int)(sizeof(nomesCategorias) / sizeof(nomesCategorias[0]))
+
+/**
+ * @brief Número real uniforme em [0, 1).
+ */
+static double aleatorioReal(GeradorAleatorio* gerador){
+    return (double)(proximoAleatorio(gerador) >> 11) * 0x1.0p-53;
+}
+
+/**
+ * @brief Sorteia um tamanho da distribuição (sempre entre mínimo e máximo).
+ *
+ * A "normal" é aproximada pela média de 4 uniformes (em forma de sino e sem
+ * caudas fora da faixa); a "cauda" eleva um uniforme ao cubo, o que concentra
+ * os tamanhos perto do mínimo com poucos textos longos.
+ */
+static int sortearTamanho(GeradorAleatorio* gerador, const DistribuicaoTamanho* distribuicao){
+    int faixa = distribuicao->maximo - distribuicao->minimo + 1;
+    double u;
+    switch (distribuicao->tipo){
+    case DISTRIBUICAO_NORMAL:
+        u = (aleatorioReal(gerador) + aleatorioReal(gerador) + aleatorioReal(gerador) + aleatorioReal(gerador)) / 4;
+        break;
+    case DISTRIBUICAO_CAUDA:
+        u = aleatorioReal(gerador);
+        u = u * u * u;
+        break;
+    default:
+        u = aleatorioReal(gerador);
+        break;
+    }
+    return distribuicao->minimo + (int)(u * faixa);
+}
+
+/**
+ * @brief Acrescenta uma sílaba (6 bits de 'valor') ao texto.
+ */
+static size_t escreverSilaba(char* texto, size_t tam, unsigned valor){
+    texto[tam] = consoantes[(valor >> 2) & 15];
+    texto[tam + 1] = vogais[valor & 3];
+    return tam + 2;
+}
+
+/**
+ * @brief Monta a resposta do item j (depende só da semente e de j).
+ *
+ * A palavra-chave tem sempre 'silabasChave' sílabas e codifica j embaralhado
+ * (multiplicação por ímpar e xor-deslocamento, ambos inversíveis módulo
+ * 2^(6 * silabasChave)); o restante são palavras aleatórias até o tamanho
+ * sorteado.
+ *
+ * @return size_t Tamanho da resposta (sem o '\0').
+ */
+static size_t montarResposta(const ParametrosGerador* parametros, int silabasChave, uint64_t j,
+                             char resposta[TAM_MAX_RESPOSTA]){
+    GeradorAleatorio gerador;
+    iniciarGerador(&gerador, parametros->semente + (j + 1) * MULTIPLICADOR_ITEM);
+    int alvo = sortearTamanho(&gerador, &parametros->tamResposta);
+
+    int bits = 6 * silabasChave;
+    uint64_t mascara = (bits >= 64) ? ~0ULL : ((1ULL << bits) - 1);
+    uint64_t chave = (j * MULTIPLICADOR_ITEM) & mascara;
+    chave ^= chave >> (bits / 2 + 1);
+    size_t tam = 0;
+    for (int s = 0; s < silabasChave; s++){
+        tam = escreverSilaba(resposta, tam, (unsigned)(chave >> (6 * s)) & 63);
+    }
+    resposta[0] = (char)(resposta[0] - 'a' + 'A');
+
+    while (1){
+        int silabas = 2 + (int)aleatorioAte(&gerador, SILABAS_POR_PALAVRA_MAX - 1);
+        if ((int)tam + 1 + 2 * silabas > alvo) break;
+        resposta[tam++] = ' ';
+        size_t inicioPalavra = tam;
+        for (int s = 0; s < silabas; s++) tam = escreverSilaba(resposta, tam, aleatorioAte(&gerador, 64));
+        resposta[inicioPalavra] = (char)(resposta[inicioPalavra] - 'a' + 'A');
+    }
+    resposta[tam] = '\0';
+    return tam;
+}
+
+/**
+ * @brief Monta uma dica com palavras do vocabulário até o tamanho sorteado.
+ *
+ * @return size_t Tamanho da dica (sempre pelo menos uma palavra).
+ */
+static size_t montarDica(GeradorAleatorio* gerador, const DistribuicaoTamanho* distribuicao, char dica[TAM_MAX_DICA]){
+    int alvo = sortearTamanho(gerador, distribuicao);
+    size_t tam = 0;
+    while (1){
+        const char* palavra = palavrasDica[aleatorioAte(gerador, NUM_PALAVRAS_DICA)];
+        size_t tamPalavra = strlen(palavra);
+        size_t novoTam = tam + (tam > 0) + tamPalavra;
+        if (tam > 0 && novoTam > (size_t)alvo) break;
+        if (novoTam > TAM_MAX_DICA - 1) break;
+        if (tam > 0) dica[tam++] = ' ';
+        memcpy(dica + tam, palavra, tamPalavra);
+        tam += tamPalavra;
+    }
+    dica[0] = (char)((dica[0] >= 'a' && dica[0] <= 'z') ? dica[0] - 'a' + 'A' : dica[0]);
+    dica[tam] = '\0';
+    return tam;
+}
+
+/**
+ * @brief Sorteia um nível de 1 a NUM_NIVEIS conforme os pesos.
+ */
+static int sortearNivel(GeradorAleatorio* gerador, const ParametrosGerador* parametros, unsigned somaPesos){
+    unsigned sorteio = aleatorioAte(gerador, somaPesos);
+    for (int n = 0; n < NUM_NIVEIS; n++){
+        if (sorteio < parametros->pesosNiveis[n]) return n + 1;
+        sorteio -= parametros->pesosNiveis[n];
+    }
+    return NUM_NIVEIS;
+}
+
+/**
+ * @brief Sorteia a categoria de um item (1 a parametros->categorias, ou 0 se não houver).
+ */
+static int sortearCategoria(GeradorAleatorio* gerador, const ParametrosGerador* parametros){
+    if (parametros->categorias == 0) return 0;
+    return 1 + (int)aleatorioAte(gerador, (uint32_t)parametros->categorias);
+}
+
+/**
+ * @brief Monta o nome da categoria c (1 em diante): os da lista e, depois
+ * deles, os mesmos com um número ("redes 2").
+ *
+ * @return size_t Tamanho do nome.
+ */
+static size_t montarNomeCategoria(int c, char nome[TAM_MAX_CATEGORIA]){
+    const char* base = nomesCategorias[(c - 1) % NUM_NOMES_CATEGORIAS];
+    int rodada = (c - 1) / NUM_NOMES_CATEGORIAS;
+    int tam = (rodada == 0) ? snprintf(nome, TAM_MAX_CATEGORIA, "%s", base)
+                            : snprintf(nome, TAM_MAX_CATEGORIA, "%s %d", base, rodada + 1);
+    return (size_t)tam;
+}
+
+/**
+ * @brief Gera a resposta da linha i: nova (palavra-chave i) ou duplicata de uma anterior.
+ */
+static size_t gerarResposta(GeradorAleatorio* gerador, const ParametrosGerador* parametros, int silabasChave,
+                            long long i, char resposta[TAM_MAX_RESPOSTA], ResumoGerador* resumo){
+    if (i > 0 && aleatorioReal(gerador) < parametros->taxaDuplicatas){
+        uint64_t original = proximoAleatorio(gerador) % (uint64_t)i;
+        size_t tam = montarResposta(parametros, silabasChave, original, resposta);
+        // Metade das duplicatas só difere nas maiúsculas (mesma chave normalizada)
+        if (aleatorioAte(gerador, 2) == 0){
+            for (size_t k = 0; k < tam; k++){
+                if (resposta[k] >= 'A' && resposta[k] <= 'Z') resposta[k] = (char)(resposta[k] - 'A' + 'a');
+            }
+        }
+        resumo->duplicatas++;
+        return tam;
+    }
+    return montarResposta(parametros, silabasChave, (uint64_t)i, resposta);
+}
+
+/**
+ * @brief Grava as linhas no formato do CSV do jogo.
+ */
+static int gerarCSV(FILE* arquivo, const ParametrosGerador* parametros, int silabasChave, ResumoGerador* resumo){
+    GeradorAleatorio gerador;
+    iniciarGerador(&gerador, parametros->semente);
+    unsigned somaPesos = 0;
+    for (int n = 0; n < NUM_NIVEIS; n++) somaPesos += parametros->pesosNiveis[n];
+
+    char resposta[TAM_MAX_RESPOSTA];
+    char dica[TAM_MAX_DICA];
+    char categoria[TAM_MAX_CATEGORIA];
+    if (fprintf(arquivo, "Resposta;Nivel;Categoria;Dica1;Dica2;Dica3;Dica4;Dica5\n") < 0) return -1;
+    for (long long i = 0; i < parametros->itens; i++){
+        size_t tamResposta = gerarResposta(&gerador, parametros, silabasChave, i, resposta, resumo);
+        int nivel = sortearNivel(&gerador, parametros, somaPesos);
+        int idCategoria = sortearCategoria(&gerador, parametros);
+        int numeroDicas = MAX_DICAS;
+
+        // Só sorteia quando há taxa: sem linhas inválidas, CSV e snapshot têm os mesmos itens
+        if (parametros->taxaInvalidas > 0 && aleatorioReal(&gerador) < parametros->taxaInvalidas){
+            switch (aleatorioAte(&gerador, 3)){
+            case 0: numeroDicas = MAX_DICAS - 1; break;          // Campo faltando
+            case 1: nivel = 0; break;                            // Nível fora de 1..5
+            default: tamResposta = 0; break;                     // Resposta vazia
+            }
+            resumo->invalidas++;
+        }
+        fwrite(resposta, 1, tamResposta, arquivo);
+        fprintf(arquivo, ";%d;", nivel);
+        if (idCategoria != 0) fwrite(categoria, 1, montarNomeCategoria(idCategoria, categoria), arquivo);
+        for (int d = 0; d < numeroDicas; d++){
+            size_t tamDica = montarDica(&gerador, &parametros->tamDica, dica);
+            fputc(';', arquivo);
+            fwrite(dica, 1, tamDica, arquivo);
+        }
+        if (fputc('\n', arquivo) == EOF) return -1;
+        resumo->linhas++;
+    }
+    return 0;
+}
+
+/**
+ * @brief Fluxo de gravação de uma seção do snapshot, com checksum acumulado.
+ */
+typedef struct{
+    FILE* arquivo;
+    uint64_t checksum;
+    uint64_t gravados;
+}SecaoSnapshot;
+
+static int abrirSecao(SecaoSnapshot* secao, const char* caminho, uint64_t deslocamento){
+    secao->checksum = CHECKSUM_INICIAL;
+    secao->gravados = 0;
+    secao->arquivo = fopen(caminho, "r+b");
+    if (secao->arquivo == NULL) return -1;
+    setvbuf(secao->arquivo, NULL, _IOFBF, TAM_BUFFER_GERADOR);
+    return fseeko(secao->arquivo, (off_t)deslocamento, SEEK_SET);
+}
+
+static int gravarSecao(SecaoSnapshot* secao, const void* dados, size_t tamanho){
+    secao->checksum = atualizarChecksum(secao->checksum, dados, tamanho);
+    secao->gravados += tamanho;
+    return fwrite(dados, 1, tamanho, secao->arquivo) == tamanho ? 0 : -1;
+}
+
+/**
+ * @brief Grava um texto na seção de textos e devolve o seu deslocamento (como guardarTrecho).
+ */
+static int gravarTextoSecao(SecaoSnapshot* textos, const char* texto, size_t tam,
+                            uint32_t* deslocamento, uint16_t* tamanho){
+    if (tam == 0){
+        *deslocamento = 0;
+        *tamanho = 0;
+        return 0;
+    }
+    if (textos->gravados + tam + 1 > UINT32_MAX) return -1;
+    *deslocamento = (uint32_t)textos->gravados;
+    *tamanho = (uint16_t)tam;
+    return gravarSecao(textos, texto, tam + 1);
+}
+
+/**
+ * @brief Grava a resposta seguida da sua chave normalizada, no mesmo formato de guardarResposta().
+ */
+static int gravarRespostaSecao(SecaoSnapshot* textos, const char* resposta, size_t tam, Item* item){
+    char chave[TAM_MAX_RESPOSTA];
+    size_t tamChave = normalizarResposta(resposta, tam, chave, sizeof(chave));
+    if (textos->gravados + tam + tamChave + 2 > UINT32_MAX) return -1;
+    item->resposta = (uint32_t)textos->gravados;
+    item->tamResposta = (uint8_t)tam;
+    item->tamChave = (uint8_t)tamChave;
+    item->hashResposta = calcularHashResposta(resposta, tam);
+    if (gravarSecao(textos, resposta, tam + 1) != 0) return -1;
+    return gravarSecao(textos, chave, tamChave + 1);
+}
+
+static int fecharSecao(SecaoSnapshot* secao){
+    if (secao->arquivo == NULL) return 0;
+    int erro = fflush(secao->arquivo) != 0;
+#ifndef _WIN32
+    erro = erro || fsync(fileno(secao->arquivo)) != 0;
+#endif
+    erro = (fclose(secao->arquivo) != 0) || erro;
+    secao->arquivo = NULL;
+    return erro ? -1 : 0;
+}
+
+/**
+ * @brief Grava os itens diretamente no formato de snapshot.
+ *
+ * Linhas inválidas não têm como existir em um snapshot; só as duplicatas se
+ * aplicam. O arquivo é escrito em "<saida>.tmp" e renomeado no final, como em
+ * salvarSnapshot().
+ */
+static int gerarSnapshot(const ParametrosGerador* parametros, int silabasChave, ResumoGerador* resumo){
+    char temporario[FILENAME_MAX];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", parametros->saida);
+    FILE* arquivo = fopen(temporario, "wb");
+    if (arquivo == NULL) return -1;
+
+    uint64_t total = (uint64_t)parametros->itens;
+    CabecalhoSnapshot cabecalho;
+    uint64_t totalCategorias = (uint64_t)parametros->categorias + 1;     // Mais a 0, "sem categoria"
+    prepararCabecalhoSnapshot(&cabecalho, total, totalCategorias, 0);
+
+    SecaoSnapshot itens = {NULL, 0, 0}, dicas = {NULL, 0, 0}, categorias = {NULL, 0, 0}, textos = {NULL, 0, 0};
+    int erro = abrirSecao(&itens, temporario, cabecalho.deslocamentoItens) != 0
+            || abrirSecao(&dicas, temporario, cabecalho.deslocamentoDicas) != 0
+            || abrirSecao(&categorias, temporario, cabecalho.deslocamentoCategorias) != 0
+            || abrirSecao(&textos, temporario, cabecalho.deslocamentoTextos) != 0;
+    erro = erro || gravarSecao(&textos, "", 1) != 0;           // Deslocamento 0: string vazia
+
+    // Nomes das categorias com as suas chaves, no formato de internarCategoria()
+    uint32_t semNome = 0;
+    erro = erro || gravarSecao(&categorias, &semNome, sizeof(semNome)) != 0;
+    for (int c = 1; c <= parametros->categorias && !erro; c++){
+        char nome[TAM_MAX_CATEGORIA];
+        char chave[TAM_MAX_CATEGORIA];
+        size_t tamNome = montarNomeCategoria(c, nome);
+        size_t tamChave = normalizarResposta(nome, tamNome, chave, sizeof(chave));
+        uint32_t deslocamento = (uint32_t)textos.gravados;
+        erro = gravarSecao(&categorias, &deslocamento, sizeof(deslocamento)) != 0
+            || gravarSecao(&textos, nome, tamNome + 1) != 0
+            || gravarSecao(&textos, chave, tamChave + 1) != 0;
+    }
+
+    GeradorAleatorio gerador;
+    iniciarGerador(&gerador, parametros->semente);
+    unsigned somaPesos = 0;
+    for (int n = 0; n < NUM_NIVEIS; n++) somaPesos += parametros->pesosNiveis[n];
+    char resposta[TAM_MAX_RESPOSTA];
+    char dica[TAM_MAX_DICA];
+
+    for (long long i = 0; i < parametros->itens && !erro; i++){
+        Item item;
+        DicasItem dicasItem;
+        memset(&item, 0, sizeof(item));
+        memset(&dicasItem, 0, sizeof(dicasItem));
+
+        size_t tamResposta = gerarResposta(&gerador, parametros, silabasChave, i, resposta, resumo);
+        item.id = (uint32_t)i;
+        item.nivel = (uint8_t)sortearNivel(&gerador, parametros, somaPesos);
+        dicasItem.categoria = (uint16_t)sortearCategoria(&gerador, parametros);
+        erro = gravarRespostaSecao(&textos, resposta, tamResposta, &item) != 0;
+        for (int d = 0; d < MAX_DICAS && !erro; d++){
+            size_t tamDica = montarDica(&gerador, &parametros->tamDica, dica);
+            erro = gravarTextoSecao(&textos, dica, tamDica, &dicasItem.dica[d], &dicasItem.tamDica[d]) != 0;
+        }
+        erro = erro || gravarSecao(&itens, &item, sizeof(item)) != 0;
+        erro = erro || gravarSecao(&dicas, &dicasItem, sizeof(dicasItem)) != 0;
+        resumo->linhas++;
+    }
+    if (textos.gravados > UINT32_MAX){
+        erro = 1;
+    }
+
+    cabecalho.tamanhoTextos = textos.gravados;
+    cabecalho.proximoId = total;
+    cabecalho.totalExcluidos = 0;
+    cabecalho.checksumItens = itens.checksum;
+    cabecalho.checksumDicas = dicas.checksum;
+    cabecalho.checksumCategorias = categorias.checksum;
+    cabecalho.checksumTextos = textos.checksum;
+    cabecalho.checksumCabecalho = atualizarChecksum(CHECKSUM_INICIAL, &cabecalho, sizeof(cabecalho));
+    erro = (fecharSecao(&itens) != 0) || erro;
+    erro = (fecharSecao(&dicas) != 0) || erro;
+    erro = (fecharSecao(&categorias) != 0) || erro;
+    erro = (fecharSecao(&textos) != 0) || erro;
+    erro = erro || fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo) != 1;
+    erro = erro || fflush(arquivo) != 0;
+#ifndef _WIN32
+    erro = erro || fsync(fileno(arquivo)) != 0;
+#endif
+    erro = (fclose(arquivo) != 0) || erro;
+    resumo->bytes = cabecalho.deslocamentoTextos + textos.gravados;
+    if (erro){
+        remove(temporario);
+        return -1;
+    }
+#ifdef _WIN32
+    remove(parametros->saida); // rename() do Windows não substitui um arquivo existente
+#endif
+    if (rename(temporario, parametros->saida) != 0){
+        remove(temporario);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Lê "[tipo:]minimo:maximo" (tipo uniforme, normal ou cauda).
+ *
+ * @return int 0 se a especificação é válida e cabe em 1..limite-1, -1 senão.
+ */
+static int lerDistribuicao(const char* texto, int limite, DistribuicaoTamanho* distribuicao){
+    DistribuicaoTamanho lida = {DISTRIBUICAO_UNIFORME, 0, 0};
+    const char* numeros = texto;
+    for (int t = 0; t < 3; t++){
+        size_t tamNome = strlen(nomesDistribuicoes[t]);
+        if (strncmp(texto, nomesDistribuicoes[t], tamNome) == 0 && texto[tamNome] == ':'){
+            lida.tipo = (TipoDistribuicao)t;
+            numeros = texto + tamNome + 1;
+        }
+    }
+    if (sscanf(numeros, "%d:%d", &lida.minimo, &lida.maximo) != 2) return -1;
+    if (lida.minimo < 1 || lida.maximo < lida.minimo || lida.maximo > limite - 1) return -1;
+    *distribuicao = lida;
+    return 0;
+}
+
+/**
+ * @brief Gerador de bancos sintéticos: grava um CSV ou um snapshot com N itens.
+ *
+ * Opções: --itens N (padrão 100000), --saida caminho (padrão "itens_gerados.csv"
+ * ou "itens_gerados.dat"), --formato csv|snapshot (padrão csv), --semente N
+ * (padrão 42), --tam-resposta [tipo:]min:max (padrão normal:6:40),
+ * --tam-dica [tipo:]min:max (padrão normal:20:120), --niveis p1,p2,p3,p4,p5
+ * (pesos, padrão 1,1,1,1,1), --categorias N (padrão 8; 0 para itens sem
+ * categoria), --duplicatas taxa e --invalidas taxa (frações
+ * de 0 a 1, padrão 0).
+ *
+ * @param argc Quantidade de opções.
+ * @param argv Opções (sem o nome do programa nem a palavra "gerar").
+ * @return int Código de saída do programa.
+ */
+int executarGerador(int argc, char* argv[]){
+    ParametrosGerador parametros;
+    memset(&parametros, 0, sizeof(parametros));
+    parametros.itens = 100000;
+    parametros.semente = 42;
+    parametros.tamResposta = (DistribuicaoTamanho){DISTRIBUICAO_NORMAL, 6, 40};
+    parametros.tamDica = (DistribuicaoTamanho){DISTRIBUICAO_NORMAL, 20, 120};
+    for (int n = 0; n < NUM_NIVEIS; n++) parametros.pesosNiveis[n] = 1;
+    parametros.categorias = NUM_NOMES_CATEGORIAS;
+    int opcaoInvalida = 0;
+
+    for (int i = 0; i < argc && !opcaoInvalida; i++){
+        int temValor = i + 1 < argc;
+        if (strcmp(argv[i], "--itens") == 0 && temValor) parametros.itens = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--saida") == 0 && temValor) parametros.saida = argv[++i];
+        else if (strcmp(argv[i], "--semente") == 0 && temValor) parametros.semente = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--duplicatas") == 0 && temValor) parametros.taxaDuplicatas = atof(argv[++i]);
+        else if (strcmp(argv[i], "--invalidas") == 0 && temValor) parametros.taxaInvalidas = atof(argv[++i]);
+        else if (strcmp(argv[i], "--categorias") == 0 && temValor) parametros.categorias = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--formato") == 0 && temValor){
+            const char* formato = argv[++i];
+            if (strcmp(formato, "snapshot") == 0) parametros.snapshot = 1;
+            else if (strcmp(formato, "csv") != 0) opcaoInvalida = 1;
+        } else if (strcmp(argv[i], "--tam-resposta") == 0 && temValor){
+            opcaoInvalida = lerDistribuicao(argv[++i], TAM_MAX_RESPOSTA, &parametros.tamResposta) != 0;
+        } else if (strcmp(argv[i], "--tam-dica") == 0 && temValor){
+            opcaoInvalida = lerDistribuicao(argv[++i], TAM_MAX_DICA, &parametros.tamDica) != 0;
+        } else if (strcmp(argv[i], "--niveis") == 0 && temValor){
+            unsigned* p = parametros.pesosNiveis;
+            opcaoInvalida = sscanf(argv[++i], "%u,%u,%u,%u,%u", &p[0], &p[1], &p[2], &p[3], &p[4]) != NUM_NIVEIS
+                            || p[0] + p[1] + p[2] + p[3] + p[4] == 0;
+        } else {
+            opcaoInvalida = 1;
+        }
+        if (opcaoInvalida){
+            printf("[Erro] Opção inválida: '%s'.\n", argv[i]);
+        }
+    }
+    if (opcaoInvalida){
+        printf("Uso: jogo gerar [--itens N] [--saida caminho] [--formato csv|snapshot] [--semente N]"
+               " [--tam-resposta [uniforme|normal|cauda:]min:max] [--tam-dica [tipo:]min:max]"
+               " [--niveis p1,p2,p3,p4,p5] [--categorias N] [--duplicatas taxa] [--invalidas taxa]\n");
+        return 1;
+    }
+    if (parametros.itens < 1 || parametros.itens > INT32_MAX || parametros.taxaDuplicatas < 0
+        || parametros.taxaDuplicatas > 1 || parametros.taxaInvalidas < 0 || parametros.taxaInvalidas > 1
+        || parametros.categorias < 0 || parametros.categorias > MAX_CATEGORIAS - 1){
+        printf("[Erro] Parâmetros do gerador inválidos.\n");
+        return 1;
+    }
+    if (parametros.saida == NULL) parametros.saida = parametros.snapshot ? "itens_gerados.dat" : "itens_gerados.csv";
+    if (parametros.snapshot && parametros.taxaInvalidas > 0){
+        printf("[Aviso] Um snapshot não tem linhas inválidas: --invalidas foi ignorada.\n");
+        parametros.taxaInvalidas = 0;
+    }
+
+    // Palavra-chave: sílabas suficientes para numerar todos os itens
+    int silabasChave = 1;
+    while (silabasChave < 6 && ((long long)1 << (6 * silabasChave)) < parametros.itens) silabasChave++;
+    if (2 * silabasChave > parametros.tamResposta.minimo){
+        printf("[Aviso] Respostas têm no mínimo %d caracteres (palavra-chave única de cada item).\n", 2 * silabasChave);
+    }
+
+    struct timespec inicio, fim;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    ResumoGerador resumo = {0, 0, 0, 0};
+    int erro;
+    if (parametros.snapshot){
+        erro = gerarSnapshot(&parametros, silabasChave, &resumo);
+    } else {
+        FILE* arquivo = fopen(parametros.saida, "w");
+        erro = (arquivo == NULL);
+        if (!erro){
+            setvbuf(arquivo, NULL, _IOFBF, TAM_BUFFER_GERADOR);
+            erro = gerarCSV(arquivo, &parametros, silabasChave, &resumo) != 0;
+            erro = (fflush(arquivo) != 0) || erro;
+            long tamanho = ftell(arquivo);
+            resumo.bytes = tamanho > 0 ? (uint64_t)tamanho : 0;
+            erro = (fclose(arquivo) != 0) || erro;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+    double segundos = (double)(fim.tv_sec - inicio.tv_sec) + (double)(fim.tv_nsec - inicio.tv_nsec) / 1e9;
+
+    if (erro){
+        printf("[Erro] Não foi possível gravar '%s'%s.\n", parametros.saida,
+               parametros.snapshot ? " (os textos de um snapshot não podem passar de 4 GiB)" : "");
+        return 1;
+    }
+    printf("[OK] %lld linha(s) gravada(s) em '%s' (%s): %lld duplicata(s), %lld inválida(s), "
+           "%.1f MiB em %.2f s.\n", resumo.linhas, parametros.saida, parametros.snapshot ? "snapshot" : "CSV",
+           resumo.duplicatas, resumo.invalidas, (double)resumo.bytes / (1 << 20), segundos);
+    return 0;
+}
@@ -6,6 +6,7 @@
  */
 #include "raylib.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 #include "funcoes.h"
@@ -13,99 +14,285 @@
 
 typedef enum { TELA_MENU, TELA_JOGO, TELA_RESULTADO } EstadoGrafico;
 
+#define X_DICAS 50
+#define TOPO_DICAS 70
+#define LARGURA_DICAS 700                // Até a margem direita da janela de 800px
+#define ALTURA_DICAS 280                 // Termina acima do placar (y = 360)
+#define ESPACO_ENTRE_DICAS 6
+#define MAX_LINHAS_DICAS 40
+
+static const int TAMANHOS_FONTE_DICAS[] = { 20, 18, 16, 14, 12 };
+static const char* const PREFIXOS_DICA[MAX_DICAS] = { "1. ", "2. ", "3. ", "4. ", "5. " };
+
+/**
+ * @brief Uma linha já quebrada de uma dica, pronta para o DrawText.
+ */
+typedef struct {
+    int numeroDica;                      // 1 a MAX_DICAS
+    int primeira;                        // Primeira linha da dica (desenha o "n. " na frente)
+    int x;
+    int y;
+    int inicio;                          // Deslocamento do texto da linha em LayoutDicas.textos
+} LinhaDica;
+
+/**
+ * @brief Diagramação das cinco dicas do item em jogo.
+ *
+ * Feita uma vez quando o item é sorteado (todas as dicas, com a maior fonte
+ * em que cabem na área das dicas); liberar uma dica só passa a desenhar
+ * mais linhas já prontas. Assim o custo de cada quadro não depende do
+ * tamanho das dicas.
+ */
+typedef struct {
+    int tamanhoFonte;
+    int totalLinhas;
+    LinhaDica linhas[MAX_LINHAS_DICAS];
+    char textos[MAX_DICAS * TAM_MAX_DICA + MAX_LINHAS_DICAS];
+    int usado;
+} LayoutDicas;
+
+/**
+ * @brief Largura em pixels de 'tam' bytes de 'texto' na fonte padrão.
+ */
+static int medirTrecho(const char* texto, int tam, int tamanhoFonte) {
+    char trecho[TAM_MAX_DICA];
+    memcpy(trecho, texto, (size_t)tam);
+    trecho[tam] = '\0';
+    return MeasureText(trecho, tamanhoFonte);
+}
+
+/**
+ * @brief Quebra uma dica em linhas de até 'largura' pixels, nos espaços
+ * (ou entre caracteres, se uma palavra sozinha não couber).
+ *
+ * @return int 0 em caso de sucesso, -1 se faltar espaço para as linhas.
+ */
+static int quebrarDica(LayoutDicas* layout, int numeroDica, const char* dica, int* y) {
+    int fonte = layout->tamanhoFonte;
+    int x = X_DICAS + MeasureText(PREFIXOS_DICA[numeroDica - 1], fonte);
+    int largura = X_DICAS + LARGURA_DICAS - x;
+    int primeira = 1;
+    const char* p = dica;
+    while (*p == ' ') p++;
+    while (*p != '\0') {
+        // Junta palavras enquanto couberem
+        const char* fim = p;
+        const char* q = p;
+        while (*q != '\0') {
+            const char* fimPalavra = q;
+            while (*fimPalavra != '\0' && *fimPalavra != ' ') fimPalavra++;
+            if (medirTrecho(p, (int)(fimPalavra - p), fonte) > largura) break;
+            fim = fimPalavra;
+            q = fimPalavra;
+            while (*q == ' ') q++;
+        }
+        // Palavra maior que a linha: corta entre caracteres UTF-8
+        if (fim == p) {
+            do {
+                const char* proximo = fim + 1;
+                while (((unsigned char)*proximo & 0xC0) == 0x80) proximo++;
+                if (fim != p && medirTrecho(p, (int)(proximo - p), fonte) > largura) break;
+                fim = proximo;
+            } while (*fim != '\0' && *fim != ' ');
+        }
+        if (layout->totalLinhas == MAX_LINHAS_DICAS) return -1;
+        LinhaDica* linha = &layout->linhas[layout->totalLinhas++];
+        linha->numeroDica = numeroDica;
+        linha->primeira = primeira;
+        linha->x = x;
+        linha->y = *y;
+        linha->inicio = layout->usado;
+        memcpy(layout->textos + layout->usado, p, (size_t)(fim - p));
+        layout->usado += (int)(fim - p);
+        layout->textos[layout->usado++] = '\0';
+        *y += fonte + fonte / 5;
+        primeira = 0;
+        p = fim;
+        while (*p == ' ') p++;
+    }
+    return 0;
+}
+
+/**
+ * @brief Diagrama todas as dicas do item com a maior fonte em que caibam na área das dicas.
+ */
+static void diagramarDicas(LayoutDicas* layout, const BancoInformacoes* banco, const Item* item) {
+    int totalFontes = (int)(sizeof(TAMANHOS_FONTE_DICAS) / sizeof(TAMANHOS_FONTE_DICAS[0]));
+    for (int f = 0; f < totalFontes; f++) {
+        layout->tamanhoFonte = TAMANHOS_FONTE_DICAS[f];
+        layout->totalLinhas = 0;
+        layout->usado = 0;
+        int y = TOPO_DICAS;
+        int coube = 1;
+        char dica[TAM_MAX_DICA];
+        for (int d = 1; d <= MAX_DICAS && coube; d++) {
+            copiarDica(banco, item, d, dica, sizeof(dica));
+            coube = (quebrarDica(layout, d, dica, &y) == 0);
+            y += ESPACO_ENTRE_DICAS;
+        }
+        if (coube && y - ESPACO_ENTRE_DICAS <= TOPO_DICAS + ALTURA_DICAS) break;
+        // Na menor fonte fica o que couber
+    }
+}
+
+/**
+ * @brief Janela do jogo para um jogador, com as mesmas regras do console (ver sessao.c).
+ *
+ * ENTER responde, TAB libera a próxima dica, F1 revela uma letra e F2 pula a vez.
+ *
+ * Por padrão a tela só é redesenhada depois de uma entrada que muda algo
+ * (tecla, troca de tela, janela redimensionada ou focada); no resto do tempo
+ * o laço fica parado esperando eventos, e uma máquina ociosa não gasta CPU.
+ * PERFIL_RENDER=continuo volta a redesenhar a 60 quadros por segundo. Ao
+ * fechar, informa quantos quadros foram desenhados.
+ */
 void iniciarJogoGrafico(BancoInformacoes* banco) {
     const int screenWidth = 800;
     const int screenHeight = 600;
 
     InitWindow(screenWidth, screenHeight, "Perfil - Trabalho Final");
     SetTargetFPS(60);
+    const char* modoRender = getenv("PERFIL_RENDER");
+    int porEventos = (modoRender == NULL || strcmp(modoRender, "continuo") != 0);
+    if (porEventos) EnableEventWaiting();
 
+    SorteadorItens* sorteador = criarSorteador(banco, CATEGORIA_TODAS, sementePadrao());
+    SessaoJogo sessao;
+    iniciarSessao(&sessao, banco, sorteador, MUITOFACIL, MUITODIFICIL);
+    adicionarJogadorSessao(&sessao, "Jogador");
     EstadoGrafico estado = TELA_MENU;
-    int indiceSorteado = 0;
-    int dicasAbertas = 1;
     char inputTexto[100] = "\0";
     int letrasCount = 0;
     char feedback[100] = "";
+    static LayoutDicas layout;           // ~1 KiB de texto: fora da pilha
+    // Textos formatados só quando mudam, não a cada quadro
+    char textoItens[32], textoPontos[32], textoPlacar[96], textoResposta[TAM_MAX_RESPOSTA + 8];
+    snprintf(textoItens, sizeof(textoItens), "Itens: %d", itensAtivos(banco));
+    snprintf(textoPontos, sizeof(textoPontos), "Pontos: %d", 0);
+    textoPlacar[0] = '\0';
+    textoResposta[0] = '\0';
+    int redesenhar = 1;
+    int focada = IsWindowFocused();
+    long quadrosDesenhados = 0;
+    long voltasLaco = 0;
+    double inicio = GetTime();
 
     while (!WindowShouldClose()) {
+        voltasLaco++;
+        EstadoGrafico estadoAnterior = estado;
         switch (estado) {
             case TELA_MENU:
-                if (IsKeyPressed(KEY_ENTER)) {
-                    if (banco->totalItens > 0) indiceSorteado = GetRandomValue(0, banco->totalItens - 1);
-                    dicasAbertas = 1;
+                if (IsKeyPressed(KEY_ENTER) && proximoItemSessao(&sessao) != NULL) {
                     letrasCount = 0;
                     inputTexto[0] = '\0';
                     strcpy(feedback, "Digite e aperte ENTER");
+                    diagramarDicas(&layout, banco, sessao.item);
                     estado = TELA_JOGO;
                 }
                 break;
 
-            case TELA_JOGO:
+            case TELA_JOGO: {
                 int key = GetCharPressed();
                 while (key > 0) {
                     if ((key >= 32) && (key <= 125) && (letrasCount < 99)) {
                         inputTexto[letrasCount] = (char)key;
                         inputTexto[letrasCount+1] = '\0';
                         letrasCount++;
+                        redesenhar = 1;
                     }
                     key = GetCharPressed();
                 }
                 if (IsKeyPressed(KEY_BACKSPACE)) {
+                    redesenhar = 1;
                     letrasCount--;
                     if (letrasCount < 0) letrasCount = 0;
                     inputTexto[letrasCount] = '\0';
                 }
-                if (IsKeyPressed(KEY_TAB)) {
-                    if (dicasAbertas < 5) dicasAbertas++;
+                ResultadoAcao resultado = RESULTADO_INVALIDO;
+                if (IsKeyPressed(KEY_TAB)) resultado = aplicarAcaoSessao(&sessao, ACAO_NOVA_DICA, NULL);
+                else if (IsKeyPressed(KEY_F1)) resultado = aplicarAcaoSessao(&sessao, ACAO_REVELAR_LETRA, NULL);
+                else if (IsKeyPressed(KEY_F2)) resultado = aplicarAcaoSessao(&sessao, ACAO_PULAR, NULL);
+                else if (IsKeyPressed(KEY_ENTER)) {
+                    resultado = aplicarAcaoSessao(&sessao, ACAO_RESPONDER, inputTexto);
+                    letrasCount = 0; inputTexto[0] = '\0';
+                    redesenhar = 1;
                 }
-                if (IsKeyPressed(KEY_ENTER)) {
-                    Item *item = &banco->itens[indiceSorteado];
-                    char inputLow[100], respLow[100];
-                    strcpy(inputLow, inputTexto);
-                    strcpy(respLow, item->resposta);
-                    for(int i=0; inputLow[i]; i++) inputLow[i] = tolower(inputLow[i]);
-                    for(int i=0; respLow[i]; i++) respLow[i] = tolower(respLow[i]);
-
-                    if (strcmp(inputLow, respLow) == 0) estado = TELA_RESULTADO;
-                    else {
-                        strcpy(feedback, "ERROU! Tente de novo.");
-                        letrasCount = 0; inputTexto[0] = '\0';
-                    }
+                if (resultado != RESULTADO_INVALIDO) redesenhar = 1;
+                switch (resultado) {
+                    case RESULTADO_ERROU: strcpy(feedback, "ERROU! Tente de novo."); break;
+                    case RESULTADO_LETRA_REVELADA: strcpy(feedback, "Letra revelada."); break;
+                    case RESULTADO_SEM_LETRAS: strcpy(feedback, "Nao ha mais letras para revelar."); break;
+                    case RESULTADO_SEM_DICAS: strcpy(feedback, "Sem mais dicas."); break;
+                    case RESULTADO_PULOU: strcpy(feedback, "Vez pulada."); break;
+                    default: break;
+                }
+                if (sessao.estado == SESSAO_ITEM_ENCERRADO) {
+                    snprintf(textoResposta, sizeof(textoResposta), "Era: %s", respostaSessao(&sessao));
+                    snprintf(textoPontos, sizeof(textoPontos), "Pontos: %d", sessao.jogadores[0].pontuacaoSessao);
+                    estado = TELA_RESULTADO;
+                }
+                if (resultado != RESULTADO_INVALIDO || textoPlacar[0] == '\0') {
+                    const JogadorSessao* jogador = jogadorDaVez(&sessao);
+                    snprintf(textoPlacar, sizeof(textoPlacar), "Tentativas: %d | Valendo: %d | Total: %d",
+                             jogador->tentativasNoItem, sessao.pontuacaoRodada, jogador->pontuacaoSessao);
                 }
                 break;
+            }
 
             case TELA_RESULTADO:
-                if (IsKeyPressed(KEY_ENTER)) estado = TELA_MENU;
+                if (IsKeyPressed(KEY_ENTER)) {
+                    textoPlacar[0] = '\0';
+                    estado = TELA_MENU;
+                }
                 break;
         }
 
+        if (IsWindowFocused() != focada) {
+            focada = !focada;
+            redesenhar = 1;
+        }
+        if (porEventos && !redesenhar && estado == estadoAnterior && !IsWindowResized()) {
+            PollInputEvents();           // Espera o próximo evento sem desenhar
+            continue;
+        }
+        redesenhar = 0;
+        quadrosDesenhados++;
         BeginDrawing();
         ClearBackground(RAYWHITE);
 
         if (estado == TELA_MENU) {
             DrawText("JOGO PERFIL", 250, 200, 50, DARKBLUE);
             DrawText("Pressione ENTER para comecar", 230, 300, 20, DARKGRAY);
-            DrawText(TextFormat("Itens: %d", banco->totalItens), 10, 570, 20, LIGHTGRAY);
+            DrawText(textoItens, 10, 570, 20, LIGHTGRAY);
+            DrawText(textoPontos, 650, 570, 20, LIGHTGRAY);
         }
         else if (estado == TELA_JOGO) {
-            Item *item = &banco->itens[indiceSorteado];
             DrawText("QUEM SOU EU?", 50, 30, 20, BLACK);
-            int y = 70;
-            if (dicasAbertas >= 1) DrawText(TextFormat("1. %s", item->dica1), 50, y, 20, DARKGRAY); y+=30;
-            if (dicasAbertas >= 2) DrawText(TextFormat("2. %s", item->dica2), 50, y, 20, DARKGRAY); y+=30;
-            if (dicasAbertas >= 3) DrawText(TextFormat("3. %s", item->dica3), 50, y, 20, DARKGRAY); y+=30;
-            if (dicasAbertas >= 4) DrawText(TextFormat("4. %s", item->dica4), 50, y, 20, DARKGRAY); y+=30;
-            if (dicasAbertas >= 5) DrawText(TextFormat("5. %s", item->dica5), 50, y, 20, DARKGRAY);
-            DrawText("Sua Resposta (TAB para dica):", 50, 400, 20, BLACK);
+            DrawText(sessao.mascara, 250, 30, 20, DARKBLUE);
+            for (int l = 0; l < layout.totalLinhas && layout.linhas[l].numeroDica <= sessao.dicaAtual; l++) {
+                const LinhaDica* linha = &layout.linhas[l];
+                if (linha->primeira) {
+                    DrawText(PREFIXOS_DICA[linha->numeroDica - 1], X_DICAS, linha->y, layout.tamanhoFonte, DARKGRAY);
+                }
+                DrawText(layout.textos + linha->inicio, linha->x, linha->y, layout.tamanhoFonte, DARKGRAY);
+            }
+            DrawText(textoPlacar, 50, 360, 20, DARKGRAY);
+            DrawText("Sua Resposta (TAB dica, F1 letra, F2 pular):", 50, 400, 20, BLACK);
             DrawRectangleLines(50, 430, 600, 40, BLACK);
             DrawText(inputTexto, 55, 440, 20, MAROON);
             DrawText(feedback, 50, 500, 20, RED);
         }
         else if (estado == TELA_RESULTADO) {
-            DrawText("ACERTOU!", 280, 250, 40, GREEN);
+            if (sessao.itemAdivinhado) DrawText("ACERTOU!", 280, 250, 40, GREEN);
+            else DrawText(textoResposta, 150, 250, 40, MAROON);
             DrawText("Enter para voltar", 300, 400, 20, GRAY);
         }
         EndDrawing();
     }
+    double segundos = GetTime() - inicio;
     CloseWindow();
-}
\ No newline at end of file
+    printf("[OK] %ld quadro(s) desenhado(s) em %ld volta(s) do laço, %.1f s de janela (%.1f quadros/s, %s).\n",
+           quadrosDesenhados, voltasLaco, segundos, segundos > 0 ? quadrosDesenhados / segundos : 0.0,
+           porEventos ? "por eventos" : "contínuo");
+    liberarSorteador(sorteador);
+}
@@ -0,0 +1,941 @@
+/**
+ * @file indice.c
+ * @brief Índice invertido das dicas: de cada palavra para os itens que a usam, com consultas ordenadas por TF-IDF.
+ *
+ * As dicas de cada item são quebradas em palavras (sequências de letras,
+ * dígitos e bytes UTF-8) e cada palavra vira um termo com a mesma
+ * normalização das respostas (normalizarResposta()): "Turing", "TURING" e
+ * "Túring" são o mesmo termo. Termos de uma letra só são ignorados.
+ *
+ * Cada termo tem a sua lista de postagens: os Item::id dos itens que o usam,
+ * em ordem crescente, cada um com quantas vezes o termo aparece nas dicas do
+ * item (tf, até 7). A lista é compactada: cada postagem é um varint de
+ * (diferença para o id anterior << 3 | tf), quase sempre 1 ou 2 bytes. As
+ * postagens são agrupadas em blocos de até POSTAGENS_POR_BLOCO, e uma tabela
+ * com o maior id e o início de cada bloco permite saltar direto para o bloco
+ * de um id. É o que deixa rápidas:
+ *
+ * - as consultas E: o termo mais raro conduz e os outros só são decodificados
+ *   nos blocos em que pode haver um item em comum;
+ * - as alterações pontuais: só o bloco do item é reescrito.
+ *
+ * O índice é construído em paralelo (construirIndiceDicas()): cada thread
+ * indexa uma faixa contígua de itens e as faixas são emendadas em ordem, já
+ * que os ids crescem com a posição. Depois disso as rotinas do banco o mantêm
+ * em dia a cada inserção, troca de dicas ou exclusão (indexarDicasItem() e
+ * desindexarDicasItem()). Como as listas guardam ids e não posições, a
+ * compactação do banco não mexe no índice. Ele só existe em memória: não vai
+ * para o snapshot.
+ *
+ * @date 2025-11-30
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "funcoes.h"
+
+#define POSTAGENS_POR_BLOCO 128
+#define MAX_POSTAGENS_BLOCO (2 * POSTAGENS_POR_BLOCO + 1)  // Inserções no meio: com isso o bloco é dividido
+#define TAM_MAX_POSTAGEM 10                 // Bytes de um varint de 64 bits
+#define FOLGA_BLOCO 32                      // Bytes livres deixados depois de um bloco do meio que cresceu
+#define MAX_TF_POSTAGEM 7                   // tf guardado em 3 bits
+#define TAM_MIN_TERMO 2
+#define TAM_MAX_TERMO 64                    // Palavras maiores são truncadas
+#define MAX_TERMOS_ITEM (MAX_DICAS * (TAM_MAX_DICA / 2 + 1))
+#define TAM_CHAVES_ITEM (2 * MAX_DICAS * TAM_MAX_DICA + MAX_TERMOS_ITEM)  // Normalizar no máximo dobra ("æ" -> "ae")
+#define TAM_TABELA_TERMOS_ITEM 1024         // Potência de 2 maior que MAX_TERMOS_ITEM
+#define MAX_TERMOS_CONSULTA 16
+#define MAX_THREADS_INDICE 64
+#define MIN_ITENS_POR_THREAD_INDICE 16384
+
+/**
+ * @brief Maior id e início de um bloco de postagens.
+ */
+typedef struct{
+    uint32_t ultimoId;
+    uint32_t deslocamento;      // Posição do bloco em ListaPostagens::dados
+    uint32_t quantidade;
+}BlocoPostagens;
+
+/**
+ * @brief Postagens de um termo (ids crescentes), em varint, com a tabela de blocos.
+ *
+ * A primeira postagem de um bloco é relativa ao último id do bloco anterior
+ * (ou a 0, no primeiro bloco).
+ */
+typedef struct{
+    uint8_t *dados;
+    size_t tam;
+    size_t capacidade;
+    BlocoPostagens *blocos;
+    size_t totalBlocos;
+    size_t capacidadeBlocos;
+    uint32_t documentos;        // Itens na lista
+}ListaPostagens;
+
+typedef struct{
+    uint32_t chave;             // Posição da chave (terminada em '\0') em IndiceDicas::chaves
+    uint32_t hash;
+    ListaPostagens lista;
+}TermoIndice;
+
+struct IndiceDicas{
+    TermoIndice *termos;
+    size_t totalTermos;
+    size_t capacidadeTermos;
+    uint32_t *tabela;           // Índice do termo + 1 (0 = posição vazia), sondagem linear
+    uint32_t capacidadeTabela;
+    char *chaves;
+    size_t usadoChaves;
+    size_t capacidadeChaves;
+};
+
+/**
+ * @brief Um termo distinto das dicas de um item e quantas vezes ele aparece.
+ */
+typedef struct{
+    const char* chave;
+    uint32_t hash;
+    uint16_t tam;
+    uint8_t tf;
+}TermoItem;
+
+/**
+ * @brief Buffers para extrair os termos de um item (ou de uma consulta).
+ */
+typedef struct{
+    char chaves[TAM_CHAVES_ITEM];
+    TermoItem termos[MAX_TERMOS_ITEM];
+    uint16_t tabela[TAM_TABELA_TERMOS_ITEM];   // Para juntar as repetidas: índice do termo + 1
+    int total;
+}TermosItem;
+
+/**
+ * @brief Logaritmo natural para x > 0 (o programa não liga com a libm).
+ *
+ * x = m * 2^e com m em [1, 2); ln(m) = 2 atanh((m - 1) / (m + 1)), pela série.
+ */
+static double logaritmo(double x){
+    int expoente = 0;
+    while (x >= 2){ x /= 2; expoente++; }
+    while (x < 1){ x *= 2; expoente--; }
+    double s = (x - 1) / (x + 1), s2 = s * s, termo = s, soma = 0;
+    for (int k = 1; k < 24; k += 2){
+        soma += termo / k;
+        termo *= s2;
+    }
+    return 2 * soma + expoente * 0.69314718055994530942;
+}
+
+static size_t gravarPostagem(uint8_t* destino, uint32_t diferenca, uint8_t tf){
+    uint64_t valor = ((uint64_t)diferenca << 3) | tf;
+    size_t n = 0;
+    while (valor >= 0x80){
+        destino[n++] = (uint8_t)(valor | 0x80);
+        valor >>= 7;
+    }
+    destino[n++] = (uint8_t)valor;
+    return n;
+}
+
+static uint64_t lerPostagem(const uint8_t** cursor){
+    uint64_t valor = 0;
+    for (int deslocamento = 0; ; deslocamento += 7){
+        uint8_t byte = *(*cursor)++;
+        valor |= (uint64_t)(byte & 0x7F) << deslocamento;
+        if (byte < 0x80) return valor;
+    }
+}
+
+/**
+ * @brief Id de referência da primeira postagem do bloco b.
+ */
+static uint32_t baseBloco(const ListaPostagens* lista, size_t b){
+    return b == 0 ? 0 : lista->blocos[b - 1].ultimoId;
+}
+
+/**
+ * @brief Primeiro bloco, a partir de 'desde', cujo maior id é >= id (totalBlocos se nenhum).
+ */
+static size_t localizarBloco(const ListaPostagens* lista, size_t desde, uint32_t id){
+    size_t inicio = desde, fim = lista->totalBlocos;
+    while (inicio < fim){
+        size_t meio = inicio + (fim - inicio) / 2;
+        if (lista->blocos[meio].ultimoId < id) inicio = meio + 1;
+        else fim = meio;
+    }
+    return inicio;
+}
+
+static uint32_t decodificarBloco(const ListaPostagens* lista, size_t b, uint32_t* ids, uint8_t* tfs){
+    const uint8_t* cursor = lista->dados + lista->blocos[b].deslocamento;
+    uint32_t id = baseBloco(lista, b);
+    for (uint32_t k = 0; k < lista->blocos[b].quantidade; k++){
+        uint64_t valor = lerPostagem(&cursor);
+        id += (uint32_t)(valor >> 3);
+        ids[k] = id;
+        tfs[k] = (uint8_t)(valor & 7);
+    }
+    return lista->blocos[b].quantidade;
+}
+
+/**
+ * @brief Posição logo depois da última postagem do bloco b (antes da folga, se houver).
+ */
+static size_t fimBloco(const ListaPostagens* lista, size_t b){
+    const uint8_t* cursor = lista->dados + lista->blocos[b].deslocamento;
+    for (uint32_t k = 0; k < lista->blocos[b].quantidade; k++) lerPostagem(&cursor);
+    return (size_t)(cursor - lista->dados);
+}
+
+/**
+ * @brief Acrescenta uma postagem com id maior que todos os da lista.
+ *
+ * @return int 0 em caso de sucesso, -1 se faltar memória (a lista não muda).
+ */
+static int acrescentarPostagem(ListaPostagens* lista, uint32_t id, uint8_t tf){
+    size_t ultimo = lista->totalBlocos;
+    uint32_t anterior = ultimo ? lista->blocos[ultimo - 1].ultimoId : 0;
+    int blocoNovo = (ultimo == 0 || lista->blocos[ultimo - 1].quantidade >= POSTAGENS_POR_BLOCO);
+    if (crescerVetor((void**)&lista->dados, &lista->capacidade, lista->tam + TAM_MAX_POSTAGEM, 1) != 0 ||
+        (blocoNovo && crescerVetor((void**)&lista->blocos, &lista->capacidadeBlocos, ultimo + 1,
+                                   sizeof(BlocoPostagens)) != 0)){
+        return -1;
+    }
+    if (blocoNovo){
+        lista->blocos[ultimo].deslocamento = (uint32_t)lista->tam;
+        lista->blocos[ultimo].quantidade = 0;
+        lista->totalBlocos = ++ultimo;
+    }
+    lista->tam += gravarPostagem(lista->dados + lista->tam, id - anterior, tf);
+    lista->blocos[ultimo - 1].ultimoId = id;
+    lista->blocos[ultimo - 1].quantidade++;
+    lista->documentos++;
+    return 0;
+}
+
+/**
+ * @brief Regrava o bloco b com 'n' postagens: sem nenhuma, o bloco some; com
+ * mais de MAX_POSTAGENS_BLOCO - 1, vira dois.
+ *
+ * O primeiro id do bloco continua relativo ao bloco anterior; quem muda o
+ * último id do bloco regrava também o seguinte. Só o último bloco da lista
+ * termina exatamente em 'tam': os outros podem ter bytes livres depois deles.
+ *
+ * @return int 0 em caso de sucesso, -1 se faltar memória (a lista não muda).
+ */
+static int substituirBloco(ListaPostagens* lista, size_t b, const uint32_t* ids, const uint8_t* tfs, uint32_t n){
+    uint8_t codificado[MAX_POSTAGENS_BLOCO * TAM_MAX_POSTAGEM];
+    uint32_t divisao = (n >= MAX_POSTAGENS_BLOCO) ? n / 2 : n;
+    size_t tam = 0, tamPrimeiro = 0;
+    uint32_t anterior = baseBloco(lista, b);
+    for (uint32_t k = 0; k < n; k++){
+        if (k == divisao) tamPrimeiro = tam;
+        tam += gravarPostagem(codificado + tam, ids[k] - anterior, tfs[k]);
+        anterior = ids[k];
+    }
+    if (divisao == n) tamPrimeiro = tam;
+
+    // Os blocos são lidos pela quantidade de postagens: um bloco do meio que
+    // encolhe deixa uma folga até o seguinte, e só cresce além dela deslocando o
+    // resto da lista (com FOLGA_BLOCO bytes a mais, para as próximas inserções)
+    size_t inicio = lista->blocos[b].deslocamento;
+    int ultimo = (b + 1 == lista->totalBlocos);
+    size_t fimAntigo = ultimo ? lista->tam : lista->blocos[b + 1].deslocamento;
+    size_t fimNovo = (ultimo || inicio + tam > fimAntigo) ? inicio + tam + (ultimo ? 0 : FOLGA_BLOCO) : fimAntigo;
+    size_t tamNovo = lista->tam - fimAntigo + fimNovo;
+    if (crescerVetor((void**)&lista->dados, &lista->capacidade, tamNovo, 1) != 0) return -1;
+    if (divisao < n && crescerVetor((void**)&lista->blocos, &lista->capacidadeBlocos, lista->totalBlocos + 1,
+                                    sizeof(BlocoPostagens)) != 0) return -1;
+
+    if (fimNovo != fimAntigo){
+        memmove(lista->dados + fimNovo, lista->dados + fimAntigo, lista->tam - fimAntigo);
+        uint32_t ajuste = (uint32_t)(fimNovo - fimAntigo);
+        for (size_t s = b + 1; s < lista->totalBlocos; s++) lista->blocos[s].deslocamento += ajuste;
+    }
+    memcpy(lista->dados + inicio, codificado, tam);
+    lista->tam = tamNovo;
+    lista->documentos = lista->documentos - lista->blocos[b].quantidade + n;
+
+    BlocoPostagens* blocos = lista->blocos;
+    if (n == 0){
+        memmove(blocos + b, blocos + b + 1, (lista->totalBlocos - b - 1) * sizeof(BlocoPostagens));
+        lista->totalBlocos--;
+        if (ultimo) lista->tam = (b > 0) ? fimBloco(lista, b - 1) : 0;   // O novo último não pode ter folga
+    } else if (divisao == n){
+        blocos[b].ultimoId = ids[n - 1];
+        blocos[b].quantidade = n;
+    } else {
+        memmove(blocos + b + 2, blocos + b + 1, (lista->totalBlocos - b - 1) * sizeof(BlocoPostagens));
+        blocos[b] = (BlocoPostagens){ids[divisao - 1], (uint32_t)inicio, divisao};
+        blocos[b + 1] = (BlocoPostagens){ids[n - 1], (uint32_t)(inicio + tamPrimeiro), n - divisao};
+        lista->totalBlocos++;
+    }
+    return 0;
+}
+
+/**
+ * @brief Põe um id em qualquer ponto da lista (ou troca o tf, se ele já estiver lá).
+ */
+static int inserirPostagem(ListaPostagens* lista, uint32_t id, uint8_t tf){
+    if (lista->totalBlocos == 0 || id > lista->blocos[lista->totalBlocos - 1].ultimoId){
+        return acrescentarPostagem(lista, id, tf);
+    }
+    uint32_t ids[MAX_POSTAGENS_BLOCO];
+    uint8_t tfs[MAX_POSTAGENS_BLOCO];
+    size_t b = localizarBloco(lista, 0, id);
+    uint32_t n = decodificarBloco(lista, b, ids, tfs);
+    uint32_t k = 0;
+    while (ids[k] < id) k++;            // O último id do bloco é >= id
+    if (ids[k] != id){
+        memmove(ids + k + 1, ids + k, (n - k) * sizeof(uint32_t));
+        memmove(tfs + k + 1, tfs + k, n - k);
+        ids[k] = id;
+        n++;
+    }
+    tfs[k] = tf;
+    return substituirBloco(lista, b, ids, tfs, n);
+}
+
+/**
+ * @brief Tira um id da lista, se ele estiver lá.
+ */
+static int removerPostagem(ListaPostagens* lista, uint32_t id){
+    size_t b = localizarBloco(lista, 0, id);
+    if (b == lista->totalBlocos) return 0;
+    uint32_t ids[MAX_POSTAGENS_BLOCO], idsSeguinte[MAX_POSTAGENS_BLOCO];
+    uint8_t tfs[MAX_POSTAGENS_BLOCO], tfsSeguinte[MAX_POSTAGENS_BLOCO];
+    uint32_t n = decodificarBloco(lista, b, ids, tfs);
+    uint32_t k = 0;
+    while (ids[k] < id) k++;
+    if (ids[k] != id) return 0;
+
+    // O bloco seguinte é relativo ao último id deste: se ele sair, o seguinte é regravado
+    int regravarSeguinte = (k == n - 1) && (b + 1 < lista->totalBlocos);
+    uint32_t nSeguinte = regravarSeguinte ? decodificarBloco(lista, b + 1, idsSeguinte, tfsSeguinte) : 0;
+    memmove(ids + k, ids + k + 1, (n - k - 1) * sizeof(uint32_t));
+    memmove(tfs + k, tfs + k + 1, n - k - 1);
+    n--;
+    if (substituirBloco(lista, b, ids, tfs, n) != 0) return -1;
+    if (!regravarSeguinte) return 0;
+    return substituirBloco(lista, n == 0 ? b : b + 1, idsSeguinte, tfsSeguinte, nSeguinte);
+}
+
+/**
+ * @brief Junta ao fim de 'destino' as postagens de 'origem', todas com ids maiores. 'origem' fica vazia.
+ */
+static int emendarLista(ListaPostagens* destino, ListaPostagens* origem){
+    if (origem->totalBlocos == 0) return 0;
+    if (destino->totalBlocos == 0){
+        free(destino->dados);
+        free(destino->blocos);
+        *destino = *origem;
+        memset(origem, 0, sizeof(*origem));
+        return 0;
+    }
+    // Só a primeira postagem muda (passa a ser relativa ao último id do destino)
+    uint32_t ids[MAX_POSTAGENS_BLOCO];
+    uint8_t tfs[MAX_POSTAGENS_BLOCO];
+    uint8_t codificado[MAX_POSTAGENS_BLOCO * TAM_MAX_POSTAGEM];
+    uint32_t n = decodificarBloco(origem, 0, ids, tfs);
+    uint32_t anterior = destino->blocos[destino->totalBlocos - 1].ultimoId;
+    size_t tamPrimeiro = 0;
+    for (uint32_t k = 0; k < n; k++){
+        tamPrimeiro += gravarPostagem(codificado + tamPrimeiro, ids[k] - anterior, tfs[k]);
+        anterior = ids[k];
+    }
+    size_t inicioResto = (origem->totalBlocos > 1) ? origem->blocos[1].deslocamento : origem->tam;
+    size_t tamResto = origem->tam - inicioResto;
+    if (crescerVetor((void**)&destino->dados, &destino->capacidade, destino->tam + tamPrimeiro + tamResto, 1) != 0 ||
+        crescerVetor((void**)&destino->blocos, &destino->capacidadeBlocos, destino->totalBlocos + origem->totalBlocos,
+                     sizeof(BlocoPostagens)) != 0){
+        return -1;
+    }
+    size_t inicio = destino->tam;
+    memcpy(destino->dados + inicio, codificado, tamPrimeiro);
+    memcpy(destino->dados + inicio + tamPrimeiro, origem->dados + inicioResto, tamResto);
+    destino->tam += tamPrimeiro + tamResto;
+    BlocoPostagens* blocos = destino->blocos + destino->totalBlocos;
+    blocos[0] = (BlocoPostagens){origem->blocos[0].ultimoId, (uint32_t)inicio, n};
+    for (size_t s = 1; s < origem->totalBlocos; s++){
+        blocos[s] = origem->blocos[s];
+        blocos[s].deslocamento = (uint32_t)(origem->blocos[s].deslocamento - inicioResto + inicio + tamPrimeiro);
+    }
+    destino->totalBlocos += origem->totalBlocos;
+    destino->documentos += origem->documentos;
+    free(origem->dados);
+    free(origem->blocos);
+    memset(origem, 0, sizeof(*origem));
+    return 0;
+}
+
+static IndiceDicas* criarIndice(void){
+    IndiceDicas* indice = calloc(1, sizeof(IndiceDicas));
+    if (indice == NULL) return NULL;
+    indice->capacidadeTabela = 1024;
+    indice->tabela = calloc(indice->capacidadeTabela, sizeof(uint32_t));
+    if (indice->tabela == NULL){
+        free(indice);
+        return NULL;
+    }
+    return indice;
+}
+
+static void liberarIndice(IndiceDicas* indice){
+    if (indice == NULL) return;
+    for (size_t t = 0; t < indice->totalTermos; t++){
+        free(indice->termos[t].lista.dados);
+        free(indice->termos[t].lista.blocos);
+    }
+    free(indice->termos);
+    free(indice->tabela);
+    free(indice->chaves);
+    free(indice);
+}
+
+/**
+ * @brief Dobra a tabela hash dos termos e reinsere todos.
+ */
+static int crescerTabelaTermos(IndiceDicas* indice){
+    uint32_t capacidade = indice->capacidadeTabela * 2;
+    uint32_t* tabela = calloc(capacidade, sizeof(uint32_t));
+    if (tabela == NULL) return -1;
+    for (size_t t = 0; t < indice->totalTermos; t++){
+        uint32_t slot = indice->termos[t].hash & (capacidade - 1);
+        while (tabela[slot] != 0) slot = (slot + 1) & (capacidade - 1);
+        tabela[slot] = (uint32_t)t + 1;
+    }
+    free(indice->tabela);
+    indice->tabela = tabela;
+    indice->capacidadeTabela = capacidade;
+    return 0;
+}
+
+/**
+ * @brief Localiza um termo; com 'criar', acrescenta-o (com a lista vazia) se ainda não existir.
+ *
+ * @return TermoIndice* O termo, ou NULL se ele não existir (ou faltar memória).
+ */
+static TermoIndice* encontrarTermo(IndiceDicas* indice, const char* chave, size_t tam, uint32_t hash, int criar){
+    uint32_t mascara = indice->capacidadeTabela - 1;
+    uint32_t slot = hash & mascara;
+    while (indice->tabela[slot] != 0){
+        TermoIndice* termo = &indice->termos[indice->tabela[slot] - 1];
+        const char* existente = indice->chaves + termo->chave;
+        if (termo->hash == hash && strncmp(existente, chave, tam) == 0 && existente[tam] == '\0') return termo;
+        slot = (slot + 1) & mascara;
+    }
+    if (!criar) return NULL;
+    if (indice->usadoChaves + tam + 1 > UINT32_MAX ||
+        crescerVetor((void**)&indice->termos, &indice->capacidadeTermos, indice->totalTermos + 1,
+                     sizeof(TermoIndice)) != 0 ||
+        crescerVetor((void**)&indice->chaves, &indice->capacidadeChaves, indice->usadoChaves + tam + 1, 1) != 0){
+        return NULL;
+    }
+    TermoIndice* termo = &indice->termos[indice->totalTermos];
+    memset(termo, 0, sizeof(*termo));
+    termo->chave = (uint32_t)indice->usadoChaves;
+    termo->hash = hash;
+    memcpy(indice->chaves + indice->usadoChaves, chave, tam);
+    indice->chaves[indice->usadoChaves + tam] = '\0';
+    indice->usadoChaves += tam + 1;
+    indice->tabela[slot] = (uint32_t)++indice->totalTermos;
+    // Carga máxima de 1/2; a reconstrução já inclui o termo novo
+    if (indice->totalTermos * 2 > indice->capacidadeTabela && crescerTabelaTermos(indice) != 0){
+        indice->tabela[slot] = 0;
+        indice->totalTermos--;
+        return NULL;
+    }
+    return &indice->termos[indice->totalTermos - 1];
+}
+
+static int ehLetraTermo(unsigned char c){
+    return c >= 0x80 || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+}
+
+/**
+ * @brief Acrescenta a 'termos' as palavras de um texto, já normalizadas (sem juntar as repetidas).
+ */
+static void extrairPalavras(const char* texto, size_t tam, TermosItem* termos, size_t* usado){
+    size_t i = 0;
+    while (i < tam && termos->total < MAX_TERMOS_ITEM){
+        while (i < tam && !ehLetraTermo((unsigned char)texto[i])) i++;
+        size_t inicio = i;
+        while (i < tam && ehLetraTermo((unsigned char)texto[i])) i++;
+        size_t livre = TAM_CHAVES_ITEM - *usado;
+        if (i == inicio || livre < TAM_MIN_TERMO + 1) break;
+        char* chave = termos->chaves + *usado;
+        size_t tamChave = normalizarResposta(texto + inicio, i - inicio, chave,
+                                             livre < TAM_MAX_TERMO + 1 ? livre : TAM_MAX_TERMO + 1);
+        if (tamChave < TAM_MIN_TERMO) continue;
+        termos->termos[termos->total].chave = chave;
+        termos->termos[termos->total].hash = hashBytes(chave, tamChave);
+        termos->termos[termos->total].tam = (uint16_t)tamChave;
+        termos->total++;
+        *usado += tamChave + 1;
+    }
+}
+
+/**
+ * @brief Junta as palavras repetidas de 'termos' (fica a primeira de cada), contando o tf de cada uma.
+ */
+static void juntarRepetidos(TermosItem* termos){
+    memset(termos->tabela, 0, sizeof(termos->tabela));
+    int distintos = 0;
+    for (int k = 0; k < termos->total; k++){
+        const TermoItem* termo = &termos->termos[k];
+        uint32_t slot = termo->hash & (TAM_TABELA_TERMOS_ITEM - 1);
+        TermoItem* repetido = NULL;
+        while (termos->tabela[slot] != 0 && repetido == NULL){
+            TermoItem* anterior = &termos->termos[termos->tabela[slot] - 1];
+            if (anterior->hash == termo->hash && anterior->tam == termo->tam &&
+                memcmp(anterior->chave, termo->chave, termo->tam) == 0) repetido = anterior;
+            slot = (slot + 1) & (TAM_TABELA_TERMOS_ITEM - 1);
+        }
+        if (repetido != NULL){
+            if (repetido->tf < MAX_TF_POSTAGEM) repetido->tf++;
+            continue;
+        }
+        termos->termos[distintos] = *termo;
+        termos->termos[distintos].tf = 1;
+        termos->tabela[slot] = (uint16_t)++distintos;
+    }
+    termos->total = distintos;
+}
+
+/**
+ * @brief Termos distintos das dicas do item da posição i, com o tf de cada um.
+ */
+static void extrairTermosItem(const BancoInformacoes* banco, int i, TermosItem* termos){
+    const Item* item = &banco->itens[i];
+    const DicasItem* dicas = &banco->dicas[i];
+    char dica[TAM_MAX_DICA];
+    size_t usado = 0;
+    termos->total = 0;
+    for (int d = 0; d < MAX_DICAS; d++){
+        const char* texto = banco->textos.dados + dicas->dica[d];
+        size_t tam = dicas->tamDica[d];
+        if (item->marcas & ITEM_DICAS_CODIFICADAS){
+            tam = copiarDica(banco, item, d + 1, dica, sizeof(dica));
+            texto = dica;
+        }
+        extrairPalavras(texto, tam, termos, &usado);
+    }
+    juntarRepetidos(termos);
+}
+
+/**
+ * @brief Indexa um item em 'indice' (ids crescentes: as postagens vão para o fim das listas).
+ */
+static int indexarNoFim(IndiceDicas* indice, const TermosItem* termos, uint32_t id){
+    for (int k = 0; k < termos->total; k++){
+        TermoIndice* termo = encontrarTermo(indice, termos->termos[k].chave, termos->termos[k].tam,
+                                            termos->termos[k].hash, 1);
+        if (termo == NULL || acrescentarPostagem(&termo->lista, id, termos->termos[k].tf) != 0) return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Faixa de itens indexada por uma thread em um índice próprio.
+ */
+typedef struct{
+    const BancoInformacoes* banco;
+    int inicio;
+    int fim;
+    IndiceDicas* indice;
+    int falhou;
+}FatiaIndice;
+
+static void* indexarFatia(void* argumento){
+    FatiaIndice* fatia = (FatiaIndice*)argumento;
+    const BancoInformacoes* banco = fatia->banco;
+    TermosItem* termos = malloc(sizeof(TermosItem));
+    fatia->indice = criarIndice();
+    if (termos == NULL || fatia->indice == NULL){
+        fatia->falhou = 1;
+        free(termos);
+        return NULL;
+    }
+    for (int i = fatia->inicio; i < fatia->fim && !fatia->falhou; i++){
+        if (banco->itens[i].marcas & ITEM_EXCLUIDO) continue;
+        extrairTermosItem(banco, i, termos);
+        fatia->falhou = indexarNoFim(fatia->indice, termos, banco->itens[i].id) != 0;
+    }
+    free(termos);
+    return NULL;
+}
+
+/**
+ * @brief Emenda o índice de uma fatia ao fim do índice das fatias anteriores.
+ */
+static int emendarIndice(IndiceDicas* destino, IndiceDicas* origem){
+    for (size_t t = 0; t < origem->totalTermos; t++){
+        TermoIndice* termoOrigem = &origem->termos[t];
+        const char* chave = origem->chaves + termoOrigem->chave;
+        TermoIndice* termo = encontrarTermo(destino, chave, strlen(chave), termoOrigem->hash, 1);
+        if (termo == NULL || emendarLista(&termo->lista, &termoOrigem->lista) != 0) return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief (Re)constrói o índice invertido das dicas, em paralelo.
+ *
+ * @param banco Banco a indexar; o índice fica em banco->indiceDicas.
+ * @param threads Número de threads (0 = uma por núcleo); bancos pequenos usam menos.
+ * @return int 0 em caso de sucesso, -1 se faltar memória (o banco fica sem índice).
+ */
+int construirIndiceDicas(BancoInformacoes* banco, int threads){
+    if (banco == NULL) return -1;
+    descartarIndiceDicas(banco);
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+
+    if (threads <= 0){
+        threads = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+        threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    }
+    int maximoPorTamanho = banco->totalItens / MIN_ITENS_POR_THREAD_INDICE;
+    if (threads > maximoPorTamanho) threads = maximoPorTamanho;
+    if (threads > MAX_THREADS_INDICE) threads = MAX_THREADS_INDICE;
+    if (threads < 1) threads = 1;
+
+    FatiaIndice fatias[MAX_THREADS_INDICE];
+    pthread_t idsThreads[MAX_THREADS_INDICE];
+    int threadCriada[MAX_THREADS_INDICE] = {0};
+    for (int t = 0; t < threads; t++){
+        memset(&fatias[t], 0, sizeof(fatias[t]));
+        fatias[t].banco = banco;
+        fatias[t].inicio = (int)((int64_t)banco->totalItens * t / threads);
+        fatias[t].fim = (int)((int64_t)banco->totalItens * (t + 1) / threads);
+    }
+    for (int t = 1; t < threads; t++){
+        threadCriada[t] = (pthread_create(&idsThreads[t], NULL, indexarFatia, &fatias[t]) == 0);
+        if (!threadCriada[t]) indexarFatia(&fatias[t]);
+    }
+    indexarFatia(&fatias[0]);
+
+    int falhou = 0;
+    for (int t = 0; t < threads; t++){
+        if (threadCriada[t]) pthread_join(idsThreads[t], NULL);
+        falhou = falhou || fatias[t].falhou;
+    }
+    // As faixas estão em ordem de posição, e portanto de id
+    IndiceDicas* indice = fatias[0].indice;
+    for (int t = 1; t < threads; t++){
+        falhou = falhou || emendarIndice(indice, fatias[t].indice) != 0;
+        liberarIndice(fatias[t].indice);
+    }
+    if (falhou){
+        printf("[Erro] Houve um erro na alocação de memória para o índice das dicas.\n");
+        liberarIndice(indice);
+        return -1;
+    }
+    banco->indiceDicas = indice;
+
+    uint64_t postagens = 0, bytes = indice->capacidadeTabela * sizeof(uint32_t) + indice->usadoChaves;
+    for (size_t t = 0; t < indice->totalTermos; t++){
+        const ListaPostagens* lista = &indice->termos[t].lista;
+        postagens += lista->documentos;
+        bytes += sizeof(TermoIndice) + lista->tam + lista->totalBlocos * sizeof(BlocoPostagens);
+    }
+    printf("[OK] Índice das dicas: %zu termos, %llu postagens em %.1f MiB (%.2f bytes por postagem), "
+           "construído em %.0f ms (%d thread(s)).\n", indice->totalTermos, (unsigned long long)postagens,
+           (double)bytes / (1 << 20), postagens ? (double)bytes / (double)postagens : 0.0,
+           segundosDesde(&inicio) * 1e3, threads);
+    return 0;
+}
+
+/**
+ * @brief Libera o índice invertido das dicas (se houver).
+ */
+void descartarIndiceDicas(BancoInformacoes* banco){
+    liberarIndice(banco->indiceDicas);
+    banco->indiceDicas = NULL;
+}
+
+/**
+ * @brief Põe no índice das dicas o item da posição dada (inserido ou com as dicas trocadas).
+ *
+ * Sem índice, não faz nada. Se faltar memória, o índice é descartado.
+ */
+void indexarDicasItem(BancoInformacoes* banco, int posicao){
+    IndiceDicas* indice = banco->indiceDicas;
+    if (indice == NULL) return;
+    TermosItem termos;
+    extrairTermosItem(banco, posicao, &termos);
+    int falhou = 0;
+    for (int k = 0; k < termos.total && !falhou; k++){
+        TermoIndice* termo = encontrarTermo(indice, termos.termos[k].chave, termos.termos[k].tam, termos.termos[k].hash, 1);
+        falhou = (termo == NULL) || inserirPostagem(&termo->lista, banco->itens[posicao].id, termos.termos[k].tf) != 0;
+    }
+    if (falhou){
+        printf("[Aviso] Falta de memória: o índice das dicas foi descartado.\n");
+        descartarIndiceDicas(banco);
+    }
+}
+
+/**
+ * @brief Tira do índice das dicas o item da posição dada (antes de excluí-lo ou de trocar as dicas).
+ *
+ * Sem índice, não faz nada. Se faltar memória, o índice é descartado.
+ */
+void desindexarDicasItem(BancoInformacoes* banco, int posicao){
+    IndiceDicas* indice = banco->indiceDicas;
+    if (indice == NULL) return;
+    TermosItem termos;
+    extrairTermosItem(banco, posicao, &termos);
+    int falhou = 0;
+    for (int k = 0; k < termos.total && !falhou; k++){
+        TermoIndice* termo = encontrarTermo(indice, termos.termos[k].chave, termos.termos[k].tam, termos.termos[k].hash, 0);
+        falhou = (termo != NULL) && removerPostagem(&termo->lista, banco->itens[posicao].id) != 0;
+    }
+    if (falhou){
+        printf("[Aviso] Falta de memória: o índice das dicas foi descartado.\n");
+        descartarIndiceDicas(banco);
+    }
+}
+
+/**
+ * @brief Leitura sequencial de uma lista de postagens, com salto por blocos.
+ */
+typedef struct{
+    const ListaPostagens* lista;
+    size_t bloco;
+    uint32_t restantes;         // Postagens ainda não lidas no bloco
+    const uint8_t* proximo;
+    uint32_t id;                // Postagem atual (se !fim)
+    uint8_t tf;
+    int fim;
+    double idf;
+}CursorPostagens;
+
+static void entrarNoBloco(CursorPostagens* cursor, size_t b){
+    if (b >= cursor->lista->totalBlocos){
+        cursor->fim = 1;
+        return;
+    }
+    cursor->bloco = b;
+    cursor->restantes = cursor->lista->blocos[b].quantidade;
+    cursor->proximo = cursor->lista->dados + cursor->lista->blocos[b].deslocamento;
+    cursor->id = baseBloco(cursor->lista, b);
+}
+
+static void avancarCursor(CursorPostagens* cursor){
+    if (cursor->restantes == 0){
+        entrarNoBloco(cursor, cursor->bloco + 1);
+        if (cursor->fim) return;
+    }
+    uint64_t valor = lerPostagem(&cursor->proximo);
+    cursor->id += (uint32_t)(valor >> 3);
+    cursor->tf = (uint8_t)(valor & 7);
+    cursor->restantes--;
+}
+
+/**
+ * @brief Avança até a primeira postagem com id >= alvo, saltando os blocos que ficam antes.
+ */
+static void avancarAte(CursorPostagens* cursor, uint32_t alvo){
+    if (cursor->fim || cursor->id >= alvo) return;
+    if (alvo > cursor->lista->blocos[cursor->bloco].ultimoId){
+        entrarNoBloco(cursor, localizarBloco(cursor->lista, cursor->bloco + 1, alvo));
+        if (cursor->fim) return;
+        avancarCursor(cursor);
+    }
+    while (!cursor->fim && cursor->id < alvo) avancarCursor(cursor);
+}
+
+/**
+ * @brief Item candidato ao resultado. Ordem: maior pontuação e, no empate, menor id.
+ */
+static int piorQue(const ItemPontuado* a, const ItemPontuado* b){
+    if (a->pontuacao != b->pontuacao) return a->pontuacao < b->pontuacao;
+    return a->id > b->id;
+}
+
+static int compararItensPontuados(const void* a, const void* b){
+    const ItemPontuado* x = a;
+    const ItemPontuado* y = b;
+    return piorQue(x, y) ? 1 : (piorQue(y, x) ? -1 : 0);
+}
+
+/**
+ * @brief Itens do resultado: um heap com os 'limite' melhores (o pior na raiz), ou todos se limite = 0.
+ */
+typedef struct{
+    ItemPontuado* itens;
+    size_t total;
+    size_t capacidade;
+    int limite;
+    int falhou;
+}MelhoresItens;
+
+static void descerHeap(ItemPontuado* heap, size_t total, size_t i){
+    for (;;){
+        size_t pior = i, esquerda = 2 * i + 1, direita = esquerda + 1;
+        if (esquerda < total && piorQue(&heap[esquerda], &heap[pior])) pior = esquerda;
+        if (direita < total && piorQue(&heap[direita], &heap[pior])) pior = direita;
+        if (pior == i) return;
+        ItemPontuado troca = heap[i]; heap[i] = heap[pior]; heap[pior] = troca;
+        i = pior;
+    }
+}
+
+static void registrarItem(MelhoresItens* melhores, uint32_t id, double pontuacao){
+    ItemPontuado novo = {-1, id, (float)pontuacao};
+    if (melhores->limite > 0 && melhores->total == (size_t)melhores->limite){
+        if (piorQue(&novo, &melhores->itens[0])) return;
+        melhores->itens[0] = novo;
+        descerHeap(melhores->itens, melhores->total, 0);
+        return;
+    }
+    if (crescerVetor((void**)&melhores->itens, &melhores->capacidade, melhores->total + 1, sizeof(ItemPontuado)) != 0){
+        melhores->falhou = 1;
+        return;
+    }
+    size_t i = melhores->total++;
+    melhores->itens[i] = novo;
+    if (melhores->limite == 0) return;
+    while (i > 0 && piorQue(&melhores->itens[i], &melhores->itens[(i - 1) / 2])){
+        ItemPontuado troca = melhores->itens[i];
+        melhores->itens[i] = melhores->itens[(i - 1) / 2];
+        melhores->itens[(i - 1) / 2] = troca;
+        i = (i - 1) / 2;
+    }
+}
+
+/**
+ * @brief Consulta o índice das dicas: itens com todas as palavras (E) ou com qualquer uma (OU).
+ *
+ * A consulta é quebrada em termos como as dicas. A pontuação de um item é a
+ * soma, sobre os termos que ele tem, de (1 + ln tf) * ln(1 + N / df), com N os
+ * itens do banco e df os que têm o termo. Na consulta E, a lista do termo
+ * mais raro conduz e as outras saltam direto para os ids dela; na OU, as
+ * listas são intercaladas em ordem de id.
+ *
+ * @param banco Banco com o índice construído (construirIndiceDicas()).
+ * @param consulta Palavras procuradas.
+ * @param qualquerTermo 0: todas as palavras (E); 1: qualquer uma (OU).
+ * @param limite Quantos itens devolver, os de maior pontuação (0 = todos).
+ * @param resultado Saída: itens em ordem decrescente de pontuação. Liberar com liberarConsultaDicas().
+ * @return int 0 em caso de sucesso, -1 se não houver índice, a consulta não
+ * tiver palavras ou faltar memória.
+ */
+int consultarIndiceDicas(const BancoInformacoes* banco, const char* consulta, int qualquerTermo, int limite,
+                         ResultadoConsultaDicas* resultado){
+    memset(resultado, 0, sizeof(*resultado));
+    if (banco == NULL || banco->indiceDicas == NULL || consulta == NULL || limite < 0) return -1;
+    IndiceDicas* indice = banco->indiceDicas;
+
+    TermosItem termos;
+    size_t usado = 0;
+    termos.total = 0;
+    extrairPalavras(consulta, strlen(consulta), &termos, &usado);
+    juntarRepetidos(&termos);
+    if (termos.total == 0 || termos.total > MAX_TERMOS_CONSULTA) return -1;
+    resultado->termos = termos.total;
+
+    double pesoTf[MAX_TF_POSTAGEM + 1];
+    for (int tf = 1; tf <= MAX_TF_POSTAGEM; tf++) pesoTf[tf] = 1 + logaritmo(tf);
+    pesoTf[0] = 0;
+    double totalItens = itensAtivos(banco) > 0 ? itensAtivos(banco) : 1;
+
+    CursorPostagens cursores[MAX_TERMOS_CONSULTA];
+    int abertos = 0;
+    for (int k = 0; k < termos.total; k++){
+        const TermoItem* palavra = &termos.termos[k];
+        const TermoIndice* termo = encontrarTermo(indice, palavra->chave, palavra->tam, palavra->hash, 0);
+        if (termo == NULL || termo->lista.documentos == 0) continue;
+        CursorPostagens* cursor = &cursores[abertos++];
+        memset(cursor, 0, sizeof(*cursor));
+        cursor->lista = &termo->lista;
+        cursor->idf = logaritmo(1 + totalItens / termo->lista.documentos);
+        entrarNoBloco(cursor, 0);
+        avancarCursor(cursor);
+    }
+    resultado->termosConhecidos = abertos;
+
+    MelhoresItens melhores = {NULL, 0, 0, limite, 0};
+    if (!qualquerTermo && abertos == resultado->termos){
+        // E: do termo mais raro para o mais comum
+        for (int a = 1; a < abertos; a++){
+            for (int b = a; b > 0 && cursores[b].lista->documentos < cursores[b - 1].lista->documentos; b--){
+                CursorPostagens troca = cursores[b]; cursores[b] = cursores[b - 1]; cursores[b - 1] = troca;
+            }
+        }
+        int esgotou = 0;
+        while (!cursores[0].fim && !esgotou && !melhores.falhou){
+            uint32_t alvo = cursores[0].id;
+            int alinhados = 1;
+            for (int j = 1; j < abertos && alinhados; j++){
+                avancarAte(&cursores[j], alvo);
+                if (cursores[j].fim){
+                    esgotou = 1;
+                    alinhados = 0;
+                } else if (cursores[j].id != alvo){
+                    alinhados = 0;
+                    alvo = cursores[j].id;
+                }
+            }
+            if (esgotou) break;
+            if (alinhados){
+                double pontuacao = 0;
+                for (int j = 0; j < abertos; j++) pontuacao += pesoTf[cursores[j].tf] * cursores[j].idf;
+                registrarItem(&melhores, alvo, pontuacao);
+                resultado->encontrados++;
+                avancarCursor(&cursores[0]);
+            } else {
+                avancarAte(&cursores[0], alvo);
+            }
+        }
+    } else if (qualquerTermo){
+        // OU: intercala as listas pelo menor id atual
+        for (;;){
+            int algum = 0;
+            uint32_t menor = UINT32_MAX;
+            for (int j = 0; j < abertos; j++){
+                if (!cursores[j].fim && (!algum || cursores[j].id < menor)){
+                    menor = cursores[j].id;
+                    algum = 1;
+                }
+            }
+            if (!algum || melhores.falhou) break;
+            double pontuacao = 0;
+            for (int j = 0; j < abertos; j++){
+                if (cursores[j].fim || cursores[j].id != menor) continue;
+                pontuacao += pesoTf[cursores[j].tf] * cursores[j].idf;
+                avancarCursor(&cursores[j]);
+            }
+            registrarItem(&melhores, menor, pontuacao);
+            resultado->encontrados++;
+        }
+    }
+    if (melhores.falhou){
+        free(melhores.itens);
+        printf("[Erro] Houve um erro na alocação de memória para o resultado da consulta.\n");
+        return -1;
+    }
+    qsort(melhores.itens, melhores.total, sizeof(ItemPontuado), compararItensPontuados);
+    for (size_t k = 0; k < melhores.total; k++){
+        melhores.itens[k].posicao = buscarItemPorId(banco, melhores.itens[k].id);
+    }
+    resultado->itens = melhores.itens;
+    resultado->total = (int)melhores.total;
+    return 0;
+}
+
+/**
+ * @brief Libera os itens de uma consulta ao índice das dicas.
+ */
+void liberarConsultaDicas(ResultadoConsultaDicas* resultado){
+    free(resultado->itens);
+    resultado->itens = NULL;
+    resultado->total = 0;
+}
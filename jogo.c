@@ -2,9 +2,10 @@
  * @file jogo.c
  * @author Tarsila Paiva Pimentel
  * @brief Implementação principal do modo de jogo multiplayer (adivinhação de itens).
- * Este arquivo contém as definições de constantes de pontuação e penalidade, 
- * e a lógica completa das funções de suporte e do fluxo principal do jogo multiplayer, 
- * incluindo a inicialização de jogadores, o ciclo de rodadas e a interação de turnos.
+ * Este arquivo contém a interface de console do jogo multiplayer: a inicialização
+ * de jogadores, o ciclo de rodadas e a interação de turnos. As regras de pontuação
+ * e penalidade ficam em sessao.c (SessaoJogo), compartilhadas com o modo servidor
+ * e a interface gráfica.
  * @version 1.0
  * @version 0.1
  * @date 2025-11-26
@@ -21,68 +22,22 @@
 #include "funcoes.h"
 #include <locale.h> 
 
-#define PONTOS_ACERTOS 100
-#define PENALIDADE_LETRA 20
-#define PENALIDADE_PULAR 30
-#define NUM_MAX_TENTATIVAS 5
 #define MAX_ACOES 10
-/**
- * @brief Revela a próxima letra oculta (sublinhado) na máscara de resposta.
- *
- * Esta função percorre a máscara de resposta (@c mascara) e localiza a primeira 
- * ocorrência de um sublinhado ('_') que não corresponde a um espaço (' ') 
- * na resposta original (@c resposta). Ao encontrar, substitui o sublinhado
- * na máscara pela letra correspondente da resposta, revelando-a ao jogador.
- *
- * @param resposta Ponteiro constante para a string que contém a resposta 
- * correta completa (a ser adivinhada).
- * @param mascara Ponteiro para a string que representa a resposta atual 
- * com letras ocultas (sublinhados). Esta string será modificada.
- *
- * @note A função prioriza a revelação de letras na ordem em que aparecem 
- * na string, da esquerda para a direita.
- * @note Espaços (' ') não são considerados caracteres a serem revelados 
- * (não são substituídos por '_').
- * 
- */
-
-    
-
-void revelarLetra(const char* resposta, char* mascara) {
-    
-    int len = strlen(resposta);
-    int indice = -1;
-
-    for (int i = 0; i < len; i++){
-        if (resposta[i] != ' ' && mascara[i] == '_') {
-            indice = i;
-            break;
-        }
-    }
-    if (indice != -1){
-        mascara[indice] = resposta[indice];
-        printf("[OK] Letra '%c' revelada!\n", mascara[indice]);
-    } else {
-        printf("[Aviso] Não há mais letras para revelar.\n");
-    }
-}
-
 /**
  * @brief Inicia e gerencia uma sessão de jogo no modo multiplayer.
  *
  * Esta função permite que múltiplos jogadores tentem adivinhar uma 
  * resposta baseada em dicas, alternando as rodadas entre eles.
- * * O jogo prossegue em ciclos de itens (rodadas), onde um item aleatório 
- * é selecionado e os jogadores se revezam para tentar adivinhar a 
+ * * O jogo prossegue em ciclos de itens (rodadas), onde um item é sorteado
+ * sem repetição, na faixa de dificuldade e na categoria escolhidas (ver sortearItem), e os jogadores se revezam para tentar adivinhar a 
  * resposta ou pedir dicas/ajudas, até que o item seja adivinhado ou 
  * todas as tentativas esgotem.
  * * @param banco Ponteiro para a estrutura BancoInformacoes que contém 
  * todos os itens disponíveis para o jogo.
- * * @warning Requer que as constantes globais TAM_MAX_NOME, MAX_JOGADORES_SESSAO, 
- * @c PONTOS_ACERTOS, @c NUM_MAX_TENTATIVAS, @c PENALIDADE_LETRA, e 
- * @c PENALIDADE_PULAR estejam definidas. Requer as estruturas @c JogadorSessao, 
- * @c BancoInformacoes, e @c Item, além das funções @c lerString, 
- * @c setbuf, @c obterItemAleatorio, @c removerEspacos, @c revelarLetra.
+ * * @note Esta função só lê as escolhas e mostra os resultados; cada ação é
+ * aplicada por @c aplicarAcaoSessao (ver sessao.c), que usa @c avaliarPalpite
+ * (aceita pequenos erros de digitação no palpite) e @c revelarLetra.
+ * Cancelar uma ajuda ou o pulo não passa a vez.
  * * @note O ciclo de jogo continua até que o grupo decida sair.
  * @note Cada jogador tem um número limitado de tentativas (@c NUM_MAX_TENTATIVAS) por item.
  */
@@ -91,12 +46,12 @@ void jogarMultiplayer(BancoInformacoes* banco){
         setlocale(LC_ALL, "Portuguese");
     
     // ETAPA 1: VERIFICAÇÃO INICIAL (COMENTEI TUDO ASSIM PORQUE ESSA FUNÇAO É ENORME)
-    if (banco == NULL || banco->totalItens == 0){
+    if (banco == NULL || itensAtivos(banco) == 0){
         printf("[Aviso] Não há itens cadastrados para jogar.\n");
         return;
     }
 
-    JogadorSessao jogadores[MAX_JOGADORES_SESSAO]; 
+    char nomes[MAX_JOGADORES_SESSAO][TAM_MAX_NOME];
     int numeroJogadores = 0;
     
     // ETAPA 2: INICIALIZAÇÃO DE JOGADORES
@@ -113,8 +68,56 @@ void jogarMultiplayer(BancoInformacoes* banco){
 
     for (int i = 0; i < numeroJogadores; i++){
         printf("Nome do Jogador %d: \n> ", i + 1);
-        lerString(jogadores[i].nome, TAM_MAX_NOME); 
-        jogadores[i].pontuacaoSessao = 0;
+        lerString(nomes[i], TAM_MAX_NOME); 
+    }
+
+    // ETAPA 2.1: FAIXA DE DIFICULDADE, CATEGORIA, SORTEADOR E SESSÃO
+    char escolha[TAM_MAX_NOME];
+    int nivelMinimo, nivelMaximo;
+    for (;;){
+        printf("Dificuldade dos itens (0 - Todas | 1 a 5 - Só esse nível | 4-5 - Faixa): \n> ");
+        lerString(escolha, TAM_MAX_NOME);
+        int lidos = sscanf(escolha, "%d-%d", &nivelMinimo, &nivelMaximo);
+        if (lidos == 1 && nivelMinimo == 0){
+            nivelMinimo = MUITOFACIL;
+            nivelMaximo = MUITODIFICIL;
+        } else if (lidos == 1){
+            nivelMaximo = nivelMinimo;
+        }
+        if (lidos >= 1 && nivelMinimo >= MUITOFACIL && nivelMinimo <= nivelMaximo && nivelMaximo <= MUITODIFICIL) break;
+        printf("[Aviso] Nível inválido.\n");
+    }
+
+    int categoria = CATEGORIA_TODAS;
+    if (banco->categorias.total > 1){
+        if (banco->indiceCategorias.posicoes == NULL) construirIndiceCategorias(banco);
+        printf("Categorias:");
+        for (uint32_t c = 1; c < banco->categorias.total && c <= 20; c++){
+            printf(" %s (%ld)%s", nomeCategoria(banco, (int)c),
+                   contarItensCategoria(banco, (int)c, nivelMinimo, nivelMaximo),
+                   (c + 1 < banco->categorias.total && c < 20) ? "," : "");
+        }
+        if (banco->categorias.total > 21) printf(" ... e mais %u", banco->categorias.total - 21);
+        printf("\n");
+        for (;;){
+            printf("Categoria dos itens (vazio para todas): \n> ");
+            lerString(escolha, TAM_MAX_NOME);
+            if (escolha[0] == '\0') break;
+            categoria = buscarCategoria(banco, escolha);
+            if (categoria >= 0) break;
+            printf("[Aviso] Categoria desconhecida.\n");
+        }
+    }
+
+    uint64_t semente = sementePadrao();
+    SorteadorItens* sorteador = criarSorteador(banco, categoria, semente);
+    if (sorteador == NULL) return;
+    printf("Semente da partida: %llu (defina PERFIL_SEMENTE para repetir)\n", (unsigned long long)semente);
+
+    SessaoJogo sessao;
+    iniciarSessao(&sessao, banco, sorteador, nivelMinimo, nivelMaximo);
+    for (int i = 0; i < numeroJogadores; i++){
+        adicionarJogadorSessao(&sessao, nomes[i]);
     }
 
     char acao[TAM_MAX_NOME];
@@ -122,83 +125,33 @@ void jogarMultiplayer(BancoInformacoes* banco){
 
     // ETAPA 3: LOOP PRINCIPAL DE ITENS (RODADAS)
     do {
-        Item* itemAdivinhar = obterItemAleatorio(banco);
-        if (itemAdivinhar == NULL) return; 
-
-        char mascaraResposta[TAM_MAX_RESPOSTA];
-        int dicaAtual = 1;
-        int pontuacaoRodada = PONTOS_ACERTOS; 
-        bool itemAdivinhado = false;
-        
-        int tamanhoResposta = strlen(itemAdivinhar->resposta);
-        for (int k = 0; k < tamanhoResposta; k++){
-            mascaraResposta[k] = (itemAdivinhar->resposta[k] == ' ') ? ' ' : '_';
-        }
-        mascaraResposta[tamanhoResposta] = '\0';
-        
-        for(int i = 0; i < numeroJogadores; i++){
-            jogadores[i].tentativasNoItem = NUM_MAX_TENTATIVAS;
+        if (proximoItemSessao(&sessao) == NULL){
+            printf("[Aviso] Não há itens cadastrados nessa faixa de nível%s.\n", categoria == CATEGORIA_TODAS ? "" : " e categoria");
+            break;
         }
 
         printf("\n\n==== NOVO ITEM: Rodada Base de %d pontos! ====\n", PONTOS_ACERTOS);
-        printf("ADIVINHE: %s\n", mascaraResposta);
-
-        int indiceJogadorAtual = 0; 
-
-        // ETAPA 4: LOOP DE TURNOS DE ADIVINHAÇÃO
-        while (!itemAdivinhado){
-            
-            // Define quem joga agora
-            JogadorSessao* jogadorAtual = &jogadores[indiceJogadorAtual]; 
-
-            // Verifica se ALGUÉM ainda tem tentativas
-            int totalTentativasRestantes = 0;
-            for(int i = 0; i < numeroJogadores; i++){
-                totalTentativasRestantes += jogadores[i].tentativasNoItem;
-            }
-            if (totalTentativasRestantes == 0){
-                printf("\nFIM! Ninguém tem mais tentativas. A resposta era: %s\n", itemAdivinhar->resposta);
-                break;
-            }
+        printf("ADIVINHE: %s\n", sessao.mascara);
 
-            if (jogadorAtual->tentativasNoItem <= 0){ 
-                indiceJogadorAtual = (indiceJogadorAtual + 1) % numeroJogadores; 
-                continue; 
-            }
-            
+        // ETAPA 4: LOOP DE TURNOS DE ADIVINHAÇÃO (as regras ficam em sessao.c)
+        while (sessao.estado == SESSAO_EM_JOGO){
+            const JogadorSessao* jogadorAtual = jogadorDaVez(&sessao);
             printf("\n--- VEZ DE: **%s** ---\n", jogadorAtual->nome);
             printf("Tentativas Restantes: %d | Valendo: %d pts | Seu Total: %d\n", 
-                    jogadorAtual->tentativasNoItem, pontuacaoRodada, jogadorAtual->pontuacaoSessao);
-            printf("Progresso: %s\n", mascaraResposta);
-            printf("=> DICA %d: ", dicaAtual);
-            switch (dicaAtual){
-                case 1: printf("%s\n", itemAdivinhar->dica1); break;
-                case 2: printf("%s\n", itemAdivinhar->dica2); break;
-                case 3: printf("%s\n", itemAdivinhar->dica3); break;
-                case 4: printf("%s\n", itemAdivinhar->dica4); break;
-                case 5: printf("%s\n", itemAdivinhar->dica5); break;
-                default: printf("Todas as dicas foram reveladas!\n"); break;
-            }
+                    jogadorAtual->tentativasNoItem, sessao.pontuacaoRodada, jogadorAtual->pontuacaoSessao);
+            printf("Progresso: %s\n", sessao.mascara);
+            printf("=> DICA %d: %s\n", sessao.dicaAtual, dicaAtualSessao(&sessao));
 
             // 4.1: Escolha de Ação (RESPONDER | DICA | PULAR)
             printf("\nEscolha sua Ação (RESPONDER | DICA | PULAR):\n> ");
             lerString(acao, TAM_MAX_NOME);
             removerEspacos(acao);
-            
+
+            ResultadoAcao resultado;
             if (strcmp(acao, "responder") == 0){
                 printf("Qual é o seu palpite? \n> ");
                 lerString(tentativa, TAM_MAX_RESPOSTA); 
-                removerEspacos(tentativa);
-                
-                if (strcmp(tentativa, itemAdivinhar->resposta) == 0){
-                    printf("\n--- PARABÉNS, %s! Você acertou: **%s** ---\n", jogadorAtual->nome, itemAdivinhar->resposta);
-                    jogadorAtual->pontuacaoSessao += pontuacaoRodada;
-                    itemAdivinhado = true; 
-                } else {
-                    printf("[Incorreto] Palpite errado.\n");
-                    jogadorAtual->tentativasNoItem--;
-                    if(dicaAtual < 5) dicaAtual++;
-                }
+                resultado = aplicarAcaoSessao(&sessao, ACAO_RESPONDER, tentativa);
 
             } else if (strcmp(acao, "dica") == 0){
                 printf("\n--- MENU DE AJUDAS ---\n");
@@ -211,29 +164,22 @@ void jogarMultiplayer(BancoInformacoes* banco){
                 if (scanf("%d", &opcao_dica) != 1){ setbuf(stdin, NULL); opcao_dica = -1; } else { setbuf(stdin, NULL); }
                 
                 if (opcao_dica == 1){
-                    revelarLetra(itemAdivinhar->resposta, mascaraResposta);
-                    pontuacaoRodada -= PENALIDADE_LETRA;
-                    if(pontuacaoRodada < 0) pontuacaoRodada = 0;
-                    jogadorAtual->tentativasNoItem--;
+                    resultado = aplicarAcaoSessao(&sessao, ACAO_REVELAR_LETRA, NULL);
                 } else if (opcao_dica == 2){
-                    if (dicaAtual < 5){
-                        dicaAtual++;
-                        printf("[OK] Próxima Dica liberada.\n");
-                    } else {
-                        printf("[Aviso] Sem mais dicas.\n");
-                    }
+                    resultado = aplicarAcaoSessao(&sessao, ACAO_NOVA_DICA, NULL);
                 } else if (opcao_dica == 3){
                     printf("[Ação] Cancelada.\n");
+                    continue;
                 } else {
                     printf("[Erro] Inválido.\n");
+                    continue;
                 }
 
             } else if (strcmp(acao, "pular") == 0){
                 printf("[Atenção] Pular custa %d pontos do seu total. Confirmar? (s/n)\n> ", PENALIDADE_PULAR);
                 lerString(acao, TAM_MAX_NOME);
                 if (acao[0] == 's'){
-                    jogadorAtual->pontuacaoSessao -= PENALIDADE_PULAR;
-                    printf("Penalidade aplicada. Vez passada.\n");
+                    resultado = aplicarAcaoSessao(&sessao, ACAO_PULAR, NULL);
                 } else {
                     printf("[Ação] Cancelada. Sua vez continua.\n");
                     continue;
@@ -243,13 +189,39 @@ void jogarMultiplayer(BancoInformacoes* banco){
                 continue;
             }
 
-            if (!itemAdivinhado){
-                indiceJogadorAtual = (indiceJogadorAtual + 1) % numeroJogadores;
+            switch (resultado){
+            case RESULTADO_ACERTOU:
+                printf("\n--- PARABÉNS, %s! Você acertou: **%s** ---\n", jogadorDaVez(&sessao)->nome, respostaSessao(&sessao));
+                if (sessao.errosUltimoAcerto > 0) printf("(Aceito com %d erro(s) de digitação.)\n", sessao.errosUltimoAcerto);
+                break;
+            case RESULTADO_ERROU:
+                printf("[Incorreto] Palpite errado.\n");
+                break;
+            case RESULTADO_LETRA_REVELADA:
+                // A letra inteira: um caractere acentuado ocupa mais de um byte
+                printf("[OK] Letra '%.*s' revelada!\n", tamanhoLetra(sessao.mascara + sessao.ultimaLetra),
+                       sessao.mascara + sessao.ultimaLetra);
+                break;
+            case RESULTADO_SEM_LETRAS:
+                printf("[Aviso] Não há mais letras para revelar.\n");
+                break;
+            case RESULTADO_DICA_LIBERADA:
+                printf("[OK] Próxima Dica liberada.\n");
+                break;
+            case RESULTADO_SEM_DICAS:
+                printf("[Aviso] Sem mais dicas.\n");
+                break;
+            case RESULTADO_PULOU:
+                printf("Penalidade aplicada. Vez passada.\n");
+                break;
+            default:
+                break;
             }
         }
 
-        if (!itemAdivinhado){
-            printf("\n--- A resposta correta era: **%s** ---\n", itemAdivinhar->resposta);
+        if (!sessao.itemAdivinhado){
+            printf("\nFIM! Ninguém tem mais tentativas.\n");
+            printf("\n--- A resposta correta era: **%s** ---\n", respostaSessao(&sessao));
         }
 
         // ETAPA 5: FIM DO ITEM E OPÇÃO DE CONTINUIDADE
@@ -261,11 +233,14 @@ void jogarMultiplayer(BancoInformacoes* banco){
 
     // ETAPA 6: ENCERRAMENTO DA SESSÃO
     } while (1);
+    liberarSorteador(sorteador);
     printf("\n==== FIM DA SESSÃO DE JOGO ====\n");
-    for (int i = 0; i < numeroJogadores; i++){
-        printf("Pontuação final de **%s**: %d\n", jogadores[i].nome, jogadores[i].pontuacaoSessao);
-        if (jogadores[i].pontuacaoSessao > 0){
-            salvarRanking(jogadores[i].nome, jogadores[i].pontuacaoSessao);
+    for (int i = 0; i < sessao.numeroJogadores; i++){
+        const JogadorSessao* jogador = &sessao.jogadores[i];
+        printf("Pontuação final de **%s**: %d\n", jogador->nome, jogador->pontuacaoSessao);
+        if (jogador->pontuacaoSessao > 0){
+            salvarRanking(jogador->nome, jogador->pontuacaoSessao);
         }
     }
+    sincronizarRankingAtual();
 }
@@ -0,0 +1,379 @@
+/**
+ * @file lote.c
+ * @brief Manutenção do banco sem o menu: importar, exportar, apagar e estatísticas.
+ *
+ * Iniciado com "jogo importar|exportar|apagar|estatisticas [opções]". Nada é
+ * perguntado: tudo vem da linha de comando, para rodar em scripts (por
+ * exemplo, refazer o banco todas as noites a partir de um CSV).
+ *
+ * - importar: lê um CSV com carregarCSV() (arquivo mapeado, uma thread por
+ *   fatia, duplicatas conforme PERFIL_DUPLICATAS ou --duplicatas) e grava o
+ *   snapshot. Sem --anexar o banco é refeito só com o CSV (um CSV sem itens
+ *   válidos é recusado); com --anexar os itens vão para o fim do banco atual.
+ * - exportar: grava o banco em CSV (fluxo com buffer de TAM_BUFFER_LOTE) ou
+ *   em snapshot, num arquivo temporário renomeado no fim.
+ * - apagar: exclui os itens que atendem a todos os filtros (nível, categoria,
+ *   resposta, id) de uma vez, compacta e grava o snapshot. Com --resposta
+ *   saem todas as cópias da resposta, não só a primeira.
+ * - estatisticas: conta itens por nível e por categoria, dicas e memória.
+ *
+ * Os comandos que alteram o banco gravam o snapshot (ARQUIVO_BINARIO) inteiro
+ * e começam um diário vazio sobre ele, em vez de registrar cada item no
+ * diário. Eles não devem rodar com o menu aberto sobre a mesma pasta.
+ *
+ * @date 2025-12-02
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "funcoes.h"
+
+#define TAM_BUFFER_LOTE (1 << 20)   // Buffer do fluxo do CSV exportado
+
+/**
+ * @brief Grava o banco alterado em ARQUIVO_BINARIO e começa um diário vazio sobre ele.
+ *
+ * @return int 0 em caso de sucesso, -1 se o snapshot não puder ser gravado.
+ */
+static int gravarBancoLote(BancoInformacoes* banco){
+    if (banco->totalExcluidos > 0 && compactarBanco(banco) != 0){
+        printf("[Aviso] Não foi possível compactar o banco; os itens excluídos serão gravados marcados.\n");
+    }
+    if (salvarSnapshot(banco, ARQUIVO_BINARIO) != 0){
+        printf("[Erro] Não foi possível gravar o snapshot '%s'.\n", ARQUIVO_BINARIO);
+        return -1;
+    }
+    reiniciarDiario();  // O diário antigo valia sobre o snapshot anterior
+    printf("[OK] %d itens salvos no snapshot '%s'.\n", itensAtivos(banco), ARQUIVO_BINARIO);
+    return 0;
+}
+
+/**
+ * @brief "jogo importar arquivo.csv [--anexar] [--duplicatas manter|mesclar|rejeitar]".
+ */
+static int importar(int argc, char* argv[]){
+    const char* caminho = NULL;
+    int anexar = 0, opcaoInvalida = 0;
+    for (int i = 0; i < argc && !opcaoInvalida; i++){
+        int temValor = i + 1 < argc;
+        if (strcmp(argv[i], "--anexar") == 0) anexar = 1;
+        else if (strcmp(argv[i], "--duplicatas") == 0 && temValor){
+            const char* nome = argv[++i];
+            opcaoInvalida = 1;
+            for (int p = DUPLICATAS_MANTER; p <= DUPLICATAS_REJEITAR; p++){
+                if (strcmp(nome, nomePoliticaDuplicatas((PoliticaDuplicatas)p)) == 0){
+                    definirPoliticaDuplicatas((PoliticaDuplicatas)p);
+                    opcaoInvalida = 0;
+                }
+            }
+        } else if (caminho == NULL && strncmp(argv[i], "--", 2) != 0) caminho = argv[i];
+        else opcaoInvalida = 1;
+        if (opcaoInvalida) printf("[Erro] Opção inválida: '%s'.\n", argv[i]);
+    }
+    if (opcaoInvalida || caminho == NULL){
+        printf("Uso: jogo importar arquivo.csv [--anexar] [--duplicatas manter|mesclar|rejeitar]\n");
+        return 1;
+    }
+
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    // Sem --anexar o banco atual nem é lido: o CSV o substitui por inteiro
+    BancoInformacoes* banco = anexar ? carregarBancoInicial() : inicializarBanco();
+    if (banco == NULL) return 1;
+    int antes = itensAtivos(banco);
+    int lidos = carregarCSV(banco, caminho);
+    if (lidos < 0){
+        printf("[Erro] Não foi possível importar '%s'; o banco não foi alterado.\n", caminho);
+        liberarBanco(banco);
+        return 1;
+    }
+    if (!anexar && itensAtivos(banco) == 0){
+        printf("[Erro] '%s' não tem nenhum item válido; o banco atual foi mantido.\n", caminho);
+        liberarBanco(banco);
+        return 1;
+    }
+    aplicarModoDicas(banco);
+    printf("[OK] %d item(ns) importado(s) de '%s' em %.2f s. Total de itens: %d\n",
+           itensAtivos(banco) - antes, caminho, segundosDesde(&inicio), itensAtivos(banco));
+    int codigo = gravarBancoLote(banco) == 0 ? 0 : 1;
+    liberarBanco(banco);
+    return codigo;
+}
+
+/**
+ * @brief Grava um campo do CSV, trocando por espaço o que quebraria a linha.
+ *
+ * Só a última dica pode conter ';' (o leitor a lê até o fim da linha).
+ *
+ * @return int Quantos caracteres foram trocados.
+ */
+static int escreverCampo(FILE* arquivo, const char* texto, int ultimo){
+    int trocados = 0;
+    const char* inicio = texto;
+    for (const char* p = texto; *p != '\0'; p++){
+        if (*p == '\n' || *p == '\r' || (*p == ';' && !ultimo)){
+            fwrite(inicio, 1, (size_t)(p - inicio), arquivo);
+            fputc(' ', arquivo);
+            inicio = p + 1;
+            trocados++;
+        }
+    }
+    fputs(inicio, arquivo);
+    return trocados;
+}
+
+/**
+ * @brief Grava os itens ativos no formato do CSV do jogo (com a coluna Categoria).
+ *
+ * @return int 0 em caso de sucesso, -1 em caso de erro de escrita.
+ */
+static int exportarCSV(const BancoInformacoes* banco, FILE* arquivo, long* camposAjustados){
+    char dica[TAM_MAX_DICA];
+    if (fprintf(arquivo, "Resposta;Nivel;Categoria;Dica1;Dica2;Dica3;Dica4;Dica5\n") < 0) return -1;
+    for (int i = 0; i < banco->totalItens; i++){
+        const Item* item = &banco->itens[i];
+        if (item->marcas & ITEM_EXCLUIDO) continue;
+        int trocados = escreverCampo(arquivo, obterResposta(banco, item), 0);
+        fprintf(arquivo, ";%d;", item->nivel);
+        trocados += escreverCampo(arquivo, obterCategoria(banco, item), 0);
+        for (int d = 1; d <= MAX_DICAS; d++){
+            copiarDica(banco, item, d, dica, sizeof(dica));
+            fputc(';', arquivo);
+            trocados += escreverCampo(arquivo, dica, d == MAX_DICAS);
+        }
+        if (fputc('\n', arquivo) == EOF) return -1;
+        if (trocados > 0) (*camposAjustados)++;
+    }
+    return 0;
+}
+
+/**
+ * @brief "jogo exportar [--formato csv|snapshot] [--saida caminho]".
+ */
+static int exportar(int argc, char* argv[]){
+    const char* saida = NULL;
+    int snapshot = 0, opcaoInvalida = 0;
+    for (int i = 0; i < argc && !opcaoInvalida; i++){
+        int temValor = i + 1 < argc;
+        if (strcmp(argv[i], "--saida") == 0 && temValor) saida = argv[++i];
+        else if (strcmp(argv[i], "--formato") == 0 && temValor){
+            const char* formato = argv[++i];
+            if (strcmp(formato, "snapshot") == 0) snapshot = 1;
+            else if (strcmp(formato, "csv") != 0) opcaoInvalida = 1;
+        } else opcaoInvalida = 1;
+        if (opcaoInvalida) printf("[Erro] Opção inválida: '%s'.\n", argv[i]);
+    }
+    if (opcaoInvalida){
+        printf("Uso: jogo exportar [--formato csv|snapshot] [--saida caminho]\n");
+        return 1;
+    }
+    if (saida == NULL) saida = snapshot ? "itens_exportados.dat" : "itens_exportados.csv";
+
+    BancoInformacoes* banco = carregarBancoInicial();
+    if (banco == NULL) return 1;
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    int erro;
+    long camposAjustados = 0;
+    if (snapshot){
+        erro = salvarSnapshot(banco, saida) != 0;
+    } else {
+        char temporario[FILENAME_MAX];
+        snprintf(temporario, sizeof(temporario), "%s.tmp", saida);
+        FILE* arquivo = fopen(temporario, "w");
+        erro = (arquivo == NULL);
+        if (!erro){
+            setvbuf(arquivo, NULL, _IOFBF, TAM_BUFFER_LOTE);
+            erro = exportarCSV(banco, arquivo, &camposAjustados) != 0;
+            erro = (fflush(arquivo) != 0) || erro;
+            erro = (fclose(arquivo) != 0) || erro;
+#ifdef _WIN32
+            if (!erro) remove(saida);   // rename() do Windows não substitui um arquivo existente
+#endif
+            if (erro || rename(temporario, saida) != 0){
+                remove(temporario);
+                erro = 1;
+            }
+        }
+    }
+    if (erro){
+        printf("[Erro] Não foi possível gravar '%s'.\n", saida);
+    } else {
+        if (camposAjustados > 0){
+            printf("[Aviso] %ld item(ns) tinham ';' ou quebras de linha fora da última dica, trocados por espaço.\n",
+                   camposAjustados);
+        }
+        printf("[OK] %d itens exportados para '%s' (%s) em %.2f s.\n", itensAtivos(banco), saida,
+               snapshot ? "snapshot" : "CSV", segundosDesde(&inicio));
+    }
+    liberarBanco(banco);
+    return erro ? 1 : 0;
+}
+
+/**
+ * @brief "jogo apagar [--nivel N] [--categoria nome] [--resposta texto] [--id N]".
+ *
+ * Apaga os itens que atendem a todos os filtros dados (ao menos um).
+ */
+static int apagar(int argc, char* argv[]){
+    int nivel = 0;
+    const char* categoria = NULL;
+    const char* resposta = NULL;
+    long id = -1;
+    int opcaoInvalida = 0;
+    for (int i = 0; i < argc && !opcaoInvalida; i++){
+        int temValor = i + 1 < argc;
+        if (strcmp(argv[i], "--nivel") == 0 && temValor){
+            nivel = atoi(argv[++i]);
+            opcaoInvalida = (nivel < MUITOFACIL || nivel > MUITODIFICIL);
+        } else if (strcmp(argv[i], "--categoria") == 0 && temValor) categoria = argv[++i];
+        else if (strcmp(argv[i], "--resposta") == 0 && temValor) resposta = argv[++i];
+        else if (strcmp(argv[i], "--id") == 0 && temValor){
+            char* fim;
+            id = strtol(argv[++i], &fim, 10);
+            opcaoInvalida = (*fim != '\0' || id < 0 || id > (long)UINT32_MAX);
+        } else opcaoInvalida = 1;
+        if (opcaoInvalida) printf("[Erro] Opção inválida: '%s'.\n", argv[i]);
+    }
+    if (opcaoInvalida || (nivel == 0 && categoria == NULL && resposta == NULL && id < 0)){
+        printf("Uso: jogo apagar [--nivel N] [--categoria nome] [--resposta texto] [--id N]"
+               " (apaga os itens que atendem a todos os filtros)\n");
+        return 1;
+    }
+
+    BancoInformacoes* banco = carregarBancoInicial();
+    if (banco == NULL) return 1;
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+
+    // O id aponta no máximo um item; a resposta pode ter várias cópias (política 'manter'), e todas saem
+    int unico = -1, idCategoria = -1;
+    if (id >= 0) unico = buscarItemPorId(banco, (uint32_t)id);
+    char chave[TAM_MAX_RESPOSTA];
+    size_t tamChave = 0;
+    uint32_t hashResposta = 0;
+    if (resposta != NULL){
+        tamChave = normalizarResposta(resposta, strlen(resposta), chave, sizeof(chave));
+        hashResposta = calcularHashResposta(resposta, strlen(resposta));
+    }
+    if (categoria != NULL) idCategoria = buscarCategoria(banco, categoria);
+    int semCandidatos = (id >= 0 && unico < 0) || (resposta != NULL && tamChave == 0) ||
+                        (categoria != NULL && idCategoria < 0);
+
+    long apagados = 0;
+    if (!semCandidatos){
+        int primeiro = (unico >= 0) ? unico : 0;
+        int ultimo = (unico >= 0) ? unico + 1 : banco->totalItens;
+        for (int i = primeiro; i < ultimo; i++){
+            Item* item = &banco->itens[i];
+            if (item->marcas & ITEM_EXCLUIDO) continue;
+            if (nivel != 0 && item->nivel != nivel) continue;
+            if (idCategoria >= 0 && banco->dicas[i].categoria != idCategoria) continue;
+            if (resposta != NULL && (item->hashResposta != hashResposta || item->tamChave != tamChave ||
+                                     memcmp(obterChaveResposta(banco, item), chave, tamChave) != 0)) continue;
+            // Só marca (no lugar, mesmo no snapshot mapeado): a compactação de gravarBancoLote()
+            // tira todos e refaz os índices de uma vez
+            item->marcas |= ITEM_EXCLUIDO;
+            banco->totalExcluidos++;
+            apagados++;
+        }
+    }
+    if (apagados == 0){
+        printf("[Aviso] Nenhum item atende aos filtros informados; o banco não foi alterado.\n");
+        liberarBanco(banco);
+        return 1;
+    }
+    printf("[OK] %ld item(ns) apagado(s) em %.3f s. Total de itens: %d\n", apagados, segundosDesde(&inicio),
+           itensAtivos(banco));
+    int codigo = 0;
+    if (itensAtivos(banco) == 0){
+        printf("[Aviso] O banco ficou vazio e não foi gravado.\n");
+        codigo = 1;
+    } else if (gravarBancoLote(banco) != 0){
+        codigo = 1;
+    }
+    liberarBanco(banco);
+    return codigo;
+}
+
+/**
+ * @brief "jogo estatisticas": itens por nível e por categoria, dicas e memória.
+ */
+static int estatisticas(int argc, char* argv[]){
+    if (argc > 0){
+        printf("[Erro] Opção inválida: '%s'.\nUso: jogo estatisticas\n", argv[0]);
+        return 1;
+    }
+    BancoInformacoes* banco = carregarBancoInicial();
+    if (banco == NULL) return 1;
+
+    long* porCategoria = calloc(banco->categorias.total > 0 ? banco->categorias.total : 1, sizeof(long));
+    if (porCategoria == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para as estatísticas.\n");
+        liberarBanco(banco);
+        return 1;
+    }
+    long porNivel[NUM_NIVEIS] = {0};
+    long dicasPorQuantidade[MAX_DICAS + 1] = {0};
+    long codificados = 0;
+    uint64_t bytesRespostas = 0;
+    for (int i = 0; i < banco->totalItens; i++){
+        const Item* item = &banco->itens[i];
+        if (item->marcas & ITEM_EXCLUIDO) continue;
+        porNivel[item->nivel - 1]++;
+        porCategoria[banco->dicas[i].categoria]++;
+        bytesRespostas += item->tamResposta;
+        int dicas = 0;
+        for (int d = 0; d < MAX_DICAS; d++) dicas += (banco->dicas[i].tamDica[d] > 0);
+        dicasPorQuantidade[dicas]++;
+        if (item->marcas & ITEM_DICAS_CODIFICADAS) codificados++;
+    }
+
+    int ativos = itensAtivos(banco);
+    static const char* nomesNiveis[NUM_NIVEIS] = {"Muito Fácil", "Fácil", "Médio", "Difícil", "Muito Difícil"};
+    printf("====== ESTATÍSTICAS DO BANCO ======\n");
+    printf("Itens: %d (%d excluído(s) ainda não compactado(s)), próximo id: %u\n", ativos, banco->totalExcluidos,
+           (unsigned)banco->proximoId);
+    printf("Tamanho médio da resposta: %.1f bytes\n", ativos ? (double)bytesRespostas / ativos : 0.0);
+    printf("\nPor nível:\n");
+    for (int n = 0; n < NUM_NIVEIS; n++){
+        printf("  %-14s %10ld (%5.1f%%)\n", nomesNiveis[n], porNivel[n], ativos ? 100.0 * porNivel[n] / ativos : 0.0);
+    }
+    printf("\nPor categoria:\n");
+    for (uint32_t c = 0; c < banco->categorias.total; c++){
+        if (porCategoria[c] == 0) continue;
+        printf("  %-24s %10ld\n", c == 0 ? "(sem categoria)" : nomeCategoria(banco, (int)c), porCategoria[c]);
+    }
+    printf("\nItens por quantidade de dicas:\n");
+    for (int d = 0; d <= MAX_DICAS; d++){
+        if (dicasPorQuantidade[d] > 0) printf("  %d dica(s) %10ld\n", d, dicasPorQuantidade[d]);
+    }
+    printf("\nDicas compactadas em %ld item(ns); dicionário de %u bytes\n", codificados,
+           (unsigned)banco->tamDicionarioDicas);
+    printf("Memória: itens %.1f MiB, dicas %.1f MiB, textos %.1f MiB (%s)\n",
+           (double)banco->totalItens * sizeof(Item) / (1 << 20),
+           (double)banco->totalItens * sizeof(DicasItem) / (1 << 20), (double)banco->textos.usado / (1 << 20),
+           banco->mapeamento != NULL ? "snapshot mapeado" : "heap");
+    free(porCategoria);
+    liberarBanco(banco);
+    return 0;
+}
+
+/**
+ * @brief Comandos de manutenção do banco sem o menu (ver o início deste arquivo).
+ *
+ * @param comando "importar", "exportar", "apagar" ou "estatisticas".
+ * @param argc Quantidade de opções.
+ * @param argv Opções (sem o nome do programa nem o comando).
+ * @return int Código de saída do programa (0 em caso de sucesso).
+ */
+int executarLote(const char* comando, int argc, char* argv[]){
+    if (strcmp(comando, "importar") == 0) return importar(argc, argv);
+    if (strcmp(comando, "exportar") == 0) return exportar(argc, argv);
+    if (strcmp(comando, "apagar") == 0) return apagar(argc, argv);
+    if (strcmp(comando, "estatisticas") == 0) return estatisticas(argc, argv);
+    printf("[Erro] Comando desconhecido: '%s'.\n", comando);
+    return 1;
+}
@@ -10,9 +10,23 @@
 #include "funcoes.h"
 #include <locale.h> 
 
-int main(){
-    // 1. INICIALIZAR: Chama a função que dá o malloc e prepara a memória
-    BancoInformacoes* banco = inicializarBanco(); 
+int main(int argc, char* argv[]){
+    // Modos sem menu: "jogo carga ..." e "jogo gerar ..." (não usam o banco) e "jogo servidor ..."
+    if (argc > 1 && strcmp(argv[1], "carga") == 0){
+        return executarCarga(argc - 2, argv + 2);
+    }
+    if (argc > 1 && strcmp(argv[1], "gerar") == 0){
+        return executarGerador(argc - 2, argv + 2);
+    }
+    // Manutenção sem perguntas: cada comando carrega (ou refaz) e grava o banco por conta própria
+    if (argc > 1 && (strcmp(argv[1], "importar") == 0 || strcmp(argv[1], "exportar") == 0 ||
+                     strcmp(argv[1], "apagar") == 0 || strcmp(argv[1], "estatisticas") == 0)){
+        return executarLote(argv[1], argc - 2, argv + 2);
+    }
+
+    // 1. INICIALIZAR: usa o snapshot binário se ele for mais novo que o CSV;
+    // senão aloca o banco e lê o arquivo 'dados_jogoadvinhacao.csv'
+    BancoInformacoes* banco = carregarBancoInicial(); 
 
   //Definir a linguagem para Português  
     setlocale(LC_ALL, "Portuguese");
@@ -20,9 +34,24 @@ int main(){
     if (banco == NULL){
         exit(1); // Sai se falhou a alocação
     }
-    
-    // 2. salvando dados do arquivo 'dados_jogoadvinhacao.csv' nas estrutura 'Item'
-    leArquivoCSV(banco);
+
+    if (argc > 1 && strcmp(argv[1], "servidor") == 0){
+        return executarServidor(banco, argc - 2, argv + 2);   // O servidor libera o banco
+    }
+    if (argc > 1 && strcmp(argv[1], "simular") == 0){
+        int codigo = executarSimulacao(banco, argc - 2, argv + 2);
+        liberarBanco(banco);
+        return codigo;
+    }
+    if (argc > 1 && strcmp(argv[1], "buscar") == 0){
+        int codigo = executarBusca(banco, argc - 2, argv + 2);
+        liberarBanco(banco);
+        return codigo;
+    }
+
+    // Índice das dicas para a pesquisa por palavras; as alterações do menu o mantêm em dia
+    construirIndiceDicas(banco, 0);
+
     printf("-------- BEM-VINDO(A)!! --------\n");//mensagem inicial de incentivo
     int opcao;
     do{
@@ -34,6 +63,8 @@ int main(){
         printf(" 6 - Jogar \n");
         printf(" 7 - Listar Ranking \n");
         printf(" 8 - Excluir Ranking \n");
+        printf(" 9 - Pesquisar nas Dicas \n");
+        printf("10 - Pesquisar por Palavras-chave \n");
         printf(" 0 - Sair \n");
         printf("Escolha uma opção: \n>");
         scanf("%d",&opcao);
@@ -64,9 +95,14 @@ int main(){
         case 8:
             formatarRanking();
             break;
+        case 9:
+            pesquisarDicas(banco);
+            break;
+        case 10:
+            pesquisarPalavrasChave(banco);
+            break;
         case 0:
-            printf("Salvando dados do jogo para um arquivo binário...\n");
-            salvarItensBinario(banco);
+            salvarAlteracoes(banco);
             break;
         default:
             printf("[Aviso] Opção inválida, tente novamente!\n");
@@ -74,6 +110,8 @@ int main(){
         }//switch
     }//do 
     while (opcao != 0 );
+    encerrarRanking();
+    encerrarDiario();
     liberarBanco(banco);
     return 0;
 }
@@ -0,0 +1,214 @@
+/**
+ * @file palpite.c
+ * @brief Comparação tolerante de palpites com a resposta do item.
+ *
+ * Um palpite é aceito quando, depois de normalizado (normalizarResposta():
+ * minúsculas, sem acentos, sem espaços nem pontuação), está a no máximo N
+ * edições (inserção, remoção ou troca de um caractere) da chave da resposta,
+ * com N proporcional ao tamanho da resposta. Assim
+ * "turring" é aceito para "turing", mas "ada" não é aceito para "cobol".
+ *
+ * A distância de edição é calculada com o algoritmo bit-paralelo de Myers
+ * (na formulação de Hyyrö), que processa a resposta inteira em uma palavra de
+ * 64 bits por caractere do palpite. Respostas normalizadas maiores que 64
+ * caracteres usam a programação dinâmica clássica, limitada à faixa permitida.
+ *
+ * @date 2025-11-26
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "funcoes.h"
+
+#define MAX_BITS_MYERS 64
+
+static ToleranciaPalpite tolerancia = {1, CARACTERES_POR_ERRO_PADRAO, MAX_ERROS_PADRAO};
+static int toleranciaLidaAmbiente = 0;
+
+/**
+ * @brief Lê a variável de ambiente PERFIL_TOLERANCIA na primeira consulta.
+ *
+ * PERFIL_TOLERANCIA=0 desativa a tolerância (só aceita a resposta exata);
+ * um valor N > 0 permite um erro a cada N caracteres da resposta.
+ */
+static void lerToleranciaAmbiente(void){
+    if (toleranciaLidaAmbiente) return;
+    toleranciaLidaAmbiente = 1;
+    const char* valor = getenv("PERFIL_TOLERANCIA");
+    if (valor == NULL || *valor == '\0') return;
+    int caracteres = atoi(valor);
+    tolerancia.ativo = caracteres > 0;
+    if (caracteres > 0) tolerancia.caracteresPorErro = caracteres;
+}
+
+/**
+ * @brief Define como os palpites são comparados com as respostas.
+ *
+ * @param config Nova configuração; substitui também a lida do ambiente.
+ */
+void definirToleranciaPalpite(ToleranciaPalpite config){
+    if (config.caracteresPorErro < 1) config.caracteresPorErro = 1;
+    if (config.maxErros < 0) config.maxErros = 0;
+    tolerancia = config;
+    toleranciaLidaAmbiente = 1;
+}
+
+/**
+ * @brief Retorna a configuração de tolerância em uso.
+ */
+ToleranciaPalpite obterToleranciaPalpite(void){
+    lerToleranciaAmbiente();
+    return tolerancia;
+}
+
+/**
+ * @brief Distância de edição por programação dinâmica, para textos longos.
+ *
+ * Só as células a até 'limite' da diagonal são calculadas; as demais são
+ * tratadas como maiores que o limite.
+ */
+static int distanciaProgramacaoDinamica(const char* a, size_t tamA, const char* b, size_t tamB, int limite){
+    int linhaAnterior[TAM_MAX_RESPOSTA + 1];
+    int linhaAtual[TAM_MAX_RESPOSTA + 1];
+    int infinito = limite + 1;
+    if (tamA > TAM_MAX_RESPOSTA) tamA = TAM_MAX_RESPOSTA;
+
+    for (size_t i = 0; i <= tamA; i++) linhaAnterior[i] = (i <= (size_t)limite) ? (int)i : infinito;
+    for (size_t j = 1; j <= tamB; j++){
+        size_t inicio = (j > (size_t)limite) ? j - (size_t)limite : 1;
+        size_t fim = (j + (size_t)limite < tamA) ? j + (size_t)limite : tamA;
+        int menorDaLinha = infinito;
+        linhaAtual[0] = (j <= (size_t)limite) ? (int)j : infinito;
+        for (size_t i = 1; i <= tamA; i++){
+            if (i < inicio || i > fim){
+                linhaAtual[i] = infinito;
+                continue;
+            }
+            int custo = (a[i - 1] == b[j - 1]) ? 0 : 1;
+            int valor = linhaAnterior[i - 1] + custo;
+            if (linhaAnterior[i] + 1 < valor) valor = linhaAnterior[i] + 1;
+            if (linhaAtual[i - 1] + 1 < valor) valor = linhaAtual[i - 1] + 1;
+            if (valor > infinito) valor = infinito;
+            linhaAtual[i] = valor;
+            if (valor < menorDaLinha) menorDaLinha = valor;
+        }
+        if (linhaAtual[0] < menorDaLinha) menorDaLinha = linhaAtual[0];
+        if (menorDaLinha > limite) return infinito;
+        memcpy(linhaAnterior, linhaAtual, (tamA + 1) * sizeof(int));
+    }
+    return linhaAnterior[tamA] > limite ? infinito : linhaAnterior[tamA];
+}
+
+/**
+ * @brief Calcula a distância de edição (Levenshtein) entre dois textos, até um limite.
+ *
+ * Para 'padrao' com até 64 caracteres usa o algoritmo bit-paralelo de Myers:
+ * cada coluna da matriz de programação dinâmica é representada pelas diferenças
+ * verticais (+1/-1) codificadas em duas palavras de 64 bits, e cada caractere do
+ * 'texto' atualiza a coluna inteira com algumas operações lógicas e uma soma.
+ *
+ * @param padrao Primeiro texto (normalmente a resposta).
+ * @param tamPadrao Tamanho do primeiro texto.
+ * @param texto Segundo texto (normalmente o palpite).
+ * @param tamTexto Tamanho do segundo texto.
+ * @param limite Maior distância de interesse.
+ * @return int A distância, ou limite + 1 se ela for maior que o limite.
+ */
+int distanciaEdicao(const char* padrao, size_t tamPadrao, const char* texto, size_t tamTexto, int limite){
+    size_t diferenca = (tamPadrao > tamTexto) ? tamPadrao - tamTexto : tamTexto - tamPadrao;
+    if (diferenca > (size_t)limite) return limite + 1;
+    if (tamPadrao == 0) return (int)tamTexto;
+    if (tamPadrao > MAX_BITS_MYERS){
+        return distanciaProgramacaoDinamica(padrao, tamPadrao, texto, tamTexto, limite);
+    }
+
+    // Na pilha e sem zerar os 2 KB inteiros: só as posições que o laço lê
+    // (caracteres do texto e do padrão) são zeradas antes de marcar o padrão
+    uint64_t mapaCaracteres[256];
+    for (size_t j = 0; j < tamTexto; j++) mapaCaracteres[(unsigned char)texto[j]] = 0;
+    for (size_t i = 0; i < tamPadrao; i++) mapaCaracteres[(unsigned char)padrao[i]] = 0;
+    for (size_t i = 0; i < tamPadrao; i++){
+        mapaCaracteres[(unsigned char)padrao[i]] |= (uint64_t)1 << i;
+    }
+
+    uint64_t positivosV = ~(uint64_t)0;     // Pv: diferenças verticais +1
+    uint64_t negativosV = 0;                // Mv: diferenças verticais -1
+    uint64_t ultimoBit = (uint64_t)1 << (tamPadrao - 1);
+    int distancia = (int)tamPadrao;
+
+    for (size_t j = 0; j < tamTexto; j++){
+        uint64_t iguais = mapaCaracteres[(unsigned char)texto[j]];
+        uint64_t xv = iguais | negativosV;
+        uint64_t xh = (((iguais & positivosV) + positivosV) ^ positivosV) | iguais;
+        uint64_t positivosH = negativosV | ~(xh | positivosV);
+        uint64_t negativosH = positivosV & xh;
+
+        if (positivosH & ultimoBit) distancia++;
+        else if (negativosH & ultimoBit) distancia--;
+
+        // A primeira linha da matriz cresce de 1 em 1 (distância global)
+        positivosH = (positivosH << 1) | 1;
+        negativosH <<= 1;
+        positivosV = negativosH | ~(xv | positivosH);
+        negativosV = positivosH & xv;
+
+        // Mesmo que todos os caracteres restantes acertem, a distância não cai abaixo disto
+        size_t restantes = tamTexto - j - 1;
+        if (distancia - (int)restantes > limite) break;
+    }
+    return distancia > limite ? limite + 1 : distancia;
+}
+
+/**
+ * @brief Quantos erros de digitação são aceitos para uma resposta deste tamanho.
+ *
+ * @param tamResposta Tamanho da resposta normalizada.
+ * @return int Zero se a tolerância estiver desativada.
+ */
+int errosPermitidos(size_t tamResposta){
+    lerToleranciaAmbiente();
+    if (!tolerancia.ativo) return 0;
+    int erros = (int)(tamResposta / (size_t)tolerancia.caracteresPorErro);
+    return erros > tolerancia.maxErros ? tolerancia.maxErros : erros;
+}
+
+/**
+ * @brief Compara um palpite já normalizado com a chave da resposta, aceitando erros de digitação.
+ *
+ * O caso comum (palpite exato) custa uma comparação de tamanhos e um memcmp();
+ * só os palpites diferentes passam pela distância de edição, limitada por
+ * errosPermitidos().
+ *
+ * @param chavePalpite Palpite normalizado com normalizarResposta().
+ * @param tamPalpite Tamanho do palpite normalizado.
+ * @param chaveResposta Chave da resposta (ver obterChaveResposta()).
+ * @param tamResposta Tamanho da chave da resposta.
+ * @return int -1 se o palpite for recusado; senão a quantidade de erros (0 = exato).
+ */
+int avaliarChavePalpite(const char* chavePalpite, size_t tamPalpite, const char* chaveResposta, size_t tamResposta){
+    if (tamPalpite == 0) return -1;
+    if (tamPalpite == tamResposta && memcmp(chavePalpite, chaveResposta, tamResposta) == 0) return 0;
+    int limite = errosPermitidos(tamResposta);
+    if (limite == 0) return -1;
+    int distancia = distanciaEdicao(chaveResposta, tamResposta, chavePalpite, tamPalpite, limite);
+    return distancia <= limite ? distancia : -1;
+}
+
+/**
+ * @brief Compara um palpite com a resposta, aceitando erros de digitação.
+ *
+ * Os dois textos são normalizados com normalizarResposta() e comparados por
+ * avaliarChavePalpite(). Quem tem o item em mãos deve usar a chave já guardada
+ * (obterChaveResposta()) e normalizar só o palpite.
+ *
+ * @param palpite Texto digitado pelo jogador.
+ * @param resposta Resposta correta do item.
+ * @return int -1 se o palpite for recusado; senão a quantidade de erros (0 = exato).
+ */
+int avaliarPalpite(const char* palpite, const char* resposta){
+    char chavePalpite[TAM_MAX_RESPOSTA];
+    char chaveResposta[TAM_MAX_RESPOSTA];
+    size_t tamPalpite = normalizarResposta(palpite, strlen(palpite), chavePalpite, sizeof(chavePalpite));
+    size_t tamResposta = normalizarResposta(resposta, strlen(resposta), chaveResposta, sizeof(chaveResposta));
+    return avaliarChavePalpite(chavePalpite, tamPalpite, chaveResposta, tamResposta);
+}
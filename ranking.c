@@ -0,0 +1,815 @@
+/**
+ * @file ranking.c
+ * @brief Ranking histórico dos jogadores, sem limite de registros.
+ *
+ * Todas as pontuações ficam em memória em uma skip list indexável
+ * (RankingJogadores), ordenada por pontuação decrescente; empates ficam na
+ * ordem de chegada. Cada ligação da skip list guarda quantas posições ela
+ * avança, então inserir, saber a posição de uma pontuação e ir direto a uma
+ * posição custam O(log n) esperado, e uma página de K registros custa
+ * O(log n + K).
+ *
+ * Em disco, ARQUIVO_RANKING é um log (CabecalhoRanking + RegistroLogRanking):
+ * cada nova pontuação é apenas acrescentada ao fim do arquivo, com um checksum.
+ * De tempos em tempos o log é regravado na ordem do ranking (compactarRanking());
+ * como um log ordenado é lido inserindo sempre no fim da lista, a carga dele é
+ * linear. O antigo arquivo com o Top 10 (PosicaoRanking sem cabeçalho) continua
+ * sendo lido e é convertido na primeira gravação.
+ *
+ * Vários processos podem usar o mesmo log ao mesmo tempo:
+ * - toda leitura ou gravação acontece com uma trava consultiva (fcntl) em
+ *   "<log>.lock", compartilhada para ler e exclusiva para gravar; a trava fica
+ *   em um arquivo à parte porque a compactação troca o log por outro arquivo;
+ * - antes de cada operação, o processo incorpora à sua memória os registros
+ *   que os outros acrescentaram (o log só cresce) ou, se o arquivo foi
+ *   trocado por uma compactação ou formatação, relê o log inteiro;
+ * - compactação e formatação gravam um arquivo temporário e o renomeiam por
+ *   cima do log, então uma queda nunca deixa o log pela metade;
+ * - um acréscimo interrompido deixa no máximo um registro incompleto no fim,
+ *   que é descartado, ou um registro com checksum errado, que é ignorado;
+ * - os fsync são agrupados: um a cada LOTE_SINCRONIA_RANKING acréscimos ou
+ *   INTERVALO_SINCRONIA_RANKING segundos (e em sincronizarRanking()). Uma queda
+ *   do processo não perde nada; uma queda de energia perde no máximo o lote aberto.
+ *
+ * No Windows as travas não estão disponíveis e o log deve ter um único processo gravando.
+ *
+ * @date 2025-11-27
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef _WIN32
+#include <io.h>
+#define fsync _commit
+#endif
+#include "funcoes.h"
+
+#define REGISTROS_POR_LEITURA 1024
+
+static RankingJogadores* rankingAtual = NULL; // Ranking de ARQUIVO_RANKING, carregado no primeiro uso
+
+/**
+ * @brief Monta um registro de ranking com o nome truncado e sem lixo após o '\0'.
+ */
+static PosicaoRanking montarRegistro(const char* nome, int pontuacao){
+    PosicaoRanking registro;
+    memset(&registro, 0, sizeof(registro));
+    snprintf(registro.nome, sizeof(registro.nome), "%s", nome);
+    registro.pontuacao = pontuacao;
+    return registro;
+}
+
+/**
+ * @brief Sorteia a altura de um novo nó (probabilidade 1/4 de subir cada nível).
+ */
+static int sortearAltura(RankingJogadores* ranking){
+    uint64_t bits = proximoAleatorio(&ranking->gerador);
+    int altura = 1;
+    while (altura < NIVEL_MAX_RANKING && (bits & 3) == 0){
+        altura++;
+        bits >>= 2;
+    }
+    return altura;
+}
+
+/**
+ * @brief Cria um ranking vazio, apenas em memória.
+ *
+ * @return RankingJogadores* Ranking alocado, ou NULL em caso de falha de memória.
+ */
+RankingJogadores* criarRanking(void){
+    RankingJogadores* ranking = calloc(1, sizeof(RankingJogadores));
+    NoRanking* cabeca = calloc(1, sizeof(NoRanking) + NIVEL_MAX_RANKING * sizeof(LigacaoRanking));
+    if (ranking == NULL || cabeca == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para o ranking.\n");
+        free(ranking);
+        free(cabeca);
+        return NULL;
+    }
+    cabeca->altura = NIVEL_MAX_RANKING;
+    ranking->cabeca = cabeca;
+    ranking->nivel = 1;
+    for (int i = 0; i < NIVEL_MAX_RANKING; i++){
+        ranking->ultimos[i] = cabeca;
+    }
+    // A altura dos nós não precisa ser imprevisível, só bem distribuída
+    iniciarGerador(&ranking->gerador, 0x52414e4b494e47ULL);
+    ranking->descritorLog = -1;
+    ranking->descritorTrava = -1;
+    return ranking;
+}
+
+/**
+ * @brief Remove todos os registros da memória, mantendo o ranking utilizável.
+ */
+static void esvaziarRanking(RankingJogadores* ranking){
+    NoRanking* no = ranking->cabeca->ligacoes[0].proximo;
+    while (no != NULL){
+        NoRanking* proximo = no->ligacoes[0].proximo;
+        free(no);
+        no = proximo;
+    }
+    for (int i = 0; i < NIVEL_MAX_RANKING; i++){
+        ranking->cabeca->ligacoes[i].proximo = NULL;
+        ranking->cabeca->ligacoes[i].largura = 0;
+        ranking->ultimos[i] = ranking->cabeca;
+        ranking->posicaoUltimos[i] = 0;
+    }
+    ranking->nivel = 1;
+    ranking->total = 0;
+    ranking->registrosForaDeOrdem = 0;
+}
+
+/**
+ * @brief Libera a memória de um ranking, sincronizando antes o log com o disco.
+ */
+void liberarRanking(RankingJogadores* ranking){
+    if (ranking == NULL) return;
+    sincronizarRanking(ranking);
+    if (ranking->descritorLog >= 0) close(ranking->descritorLog);
+    if (ranking->descritorTrava >= 0) close(ranking->descritorTrava);
+    esvaziarRanking(ranking);
+    free(ranking->cabeca);
+    free(ranking);
+}
+
+/**
+ * @brief Insere uma pontuação no ranking em memória.
+ *
+ * O novo registro fica depois de todos os que têm pontuação maior ou igual.
+ * Se ele não supera o último colocado (caso de um log já ordenado), é
+ * encadeado direto no fim de cada nível, sem percorrer a lista.
+ *
+ * @param ranking Ranking que recebe o registro.
+ * @param nome Nome do jogador.
+ * @param pontuacao Pontuação obtida.
+ * @return long Posição (a partir de 1) ocupada pelo registro, ou -1 se faltar memória.
+ */
+long inserirNoRanking(RankingJogadores* ranking, const char* nome, int pontuacao){
+    NoRanking* anteriores[NIVEL_MAX_RANKING];
+    long posicoes[NIVEL_MAX_RANKING];      // Posição de cada anteriores[i] (0 = cabeça)
+
+    int altura = sortearAltura(ranking);
+    NoRanking* novo = malloc(sizeof(NoRanking) + (size_t)altura * sizeof(LigacaoRanking));
+    if (novo == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para o ranking.\n");
+        return -1;
+    }
+    novo->registro = montarRegistro(nome, pontuacao);
+    novo->sequencia = ranking->proximaSequencia++;
+    novo->altura = altura;
+
+    if (ranking->total == 0 || ranking->ultimos[0]->registro.pontuacao >= pontuacao){
+        for (int i = 0; i < ranking->nivel; i++){
+            anteriores[i] = ranking->ultimos[i];
+            posicoes[i] = ranking->posicaoUltimos[i];
+        }
+    } else {
+        NoRanking* atual = ranking->cabeca;
+        long posicao = 0;
+        for (int i = ranking->nivel - 1; i >= 0; i--){
+            while (atual->ligacoes[i].proximo != NULL &&
+                   atual->ligacoes[i].proximo->registro.pontuacao >= pontuacao){
+                posicao += atual->ligacoes[i].largura;
+                atual = atual->ligacoes[i].proximo;
+            }
+            anteriores[i] = atual;
+            posicoes[i] = posicao;
+        }
+    }
+    if (altura > ranking->nivel){
+        for (int i = ranking->nivel; i < altura; i++){
+            anteriores[i] = ranking->cabeca;
+            posicoes[i] = 0;
+            ranking->cabeca->ligacoes[i].proximo = NULL;
+            ranking->cabeca->ligacoes[i].largura = ranking->total;
+        }
+        ranking->nivel = altura;
+    }
+
+    // Ligações que terminam em NULL guardam quantos registros há depois do nó
+    long posicaoNovo = posicoes[0] + 1;
+    for (int i = 0; i < altura; i++){
+        LigacaoRanking* ligacao = &anteriores[i]->ligacoes[i];
+        novo->ligacoes[i].proximo = ligacao->proximo;
+        novo->ligacoes[i].largura = ligacao->largura - (posicoes[0] - posicoes[i]);
+        ligacao->proximo = novo;
+        ligacao->largura = posicoes[0] - posicoes[i] + 1;
+    }
+    for (int i = altura; i < ranking->nivel; i++){
+        anteriores[i]->ligacoes[i].largura++;
+    }
+    ranking->total++;
+
+    for (int i = 0; i < ranking->nivel; i++){
+        if (i < altura && novo->ligacoes[i].proximo == NULL){
+            ranking->ultimos[i] = novo;
+            ranking->posicaoUltimos[i] = posicaoNovo;
+        } else if (ranking->posicaoUltimos[i] >= posicaoNovo){
+            ranking->posicaoUltimos[i]++;
+        }
+    }
+    if (posicaoNovo != ranking->total) ranking->registrosForaDeOrdem++;
+    return posicaoNovo;
+}
+
+/**
+ * @brief Posição que uma pontuação ocupa (ou ocuparia) no ranking.
+ *
+ * @param ranking Ranking consultado.
+ * @param pontuacao Pontuação de interesse.
+ * @return long 1 + a quantidade de registros com pontuação estritamente maior.
+ */
+long posicaoDaPontuacao(const RankingJogadores* ranking, int pontuacao){
+    const NoRanking* atual = ranking->cabeca;
+    long posicao = 0;
+    for (int i = ranking->nivel - 1; i >= 0; i--){
+        while (atual->ligacoes[i].proximo != NULL &&
+               atual->ligacoes[i].proximo->registro.pontuacao > pontuacao){
+            posicao += atual->ligacoes[i].largura;
+            atual = atual->ligacoes[i].proximo;
+        }
+    }
+    return posicao + 1;
+}
+
+/**
+ * @brief Localiza o nó de uma posição descendo pelos níveis e somando as larguras.
+ */
+static const NoRanking* noNaPosicao(const RankingJogadores* ranking, long posicao){
+    if (posicao < 1 || posicao > ranking->total) return NULL;
+    const NoRanking* atual = ranking->cabeca;
+    long percorrido = 0;
+    for (int i = ranking->nivel - 1; i >= 0; i--){
+        while (atual->ligacoes[i].proximo != NULL && percorrido + atual->ligacoes[i].largura <= posicao){
+            percorrido += atual->ligacoes[i].largura;
+            atual = atual->ligacoes[i].proximo;
+        }
+        if (percorrido == posicao) return atual;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Registro que está em uma posição do ranking.
+ *
+ * @param ranking Ranking consultado.
+ * @param posicao Posição, a partir de 1.
+ * @return const PosicaoRanking* O registro, ou NULL se a posição não existir.
+ */
+const PosicaoRanking* obterPosicaoRanking(const RankingJogadores* ranking, long posicao){
+    const NoRanking* no = noNaPosicao(ranking, posicao);
+    return no != NULL ? &no->registro : NULL;
+}
+
+/**
+ * @brief Copia um trecho consecutivo do ranking (Top K ou uma página).
+ *
+ * @param ranking Ranking consultado.
+ * @param inicio Primeira posição do trecho, a partir de 1.
+ * @param quantidade Máximo de registros copiados.
+ * @param saida Vetor com espaço para 'quantidade' registros.
+ * @return int Quantidade de registros copiados (menor no fim do ranking).
+ */
+int copiarTrechoRanking(const RankingJogadores* ranking, long inicio, int quantidade, PosicaoRanking saida[]){
+    const NoRanking* no = noNaPosicao(ranking, inicio);
+    int copiados = 0;
+    while (no != NULL && copiados < quantidade){
+        saida[copiados++] = no->registro;
+        no = no->ligacoes[0].proximo;
+    }
+    return copiados;
+}
+
+/**
+ * @brief Indica se o log tem registros fora de ordem demais e deve ser regravado.
+ */
+static int deveCompactarRanking(const RankingJogadores* ranking){
+    return ranking->registrosForaDeOrdem >= MIN_FORA_DE_ORDEM_RANKING &&
+           ranking->registrosForaDeOrdem * 4 >= ranking->total;
+}
+
+/**
+ * @brief Obtém a trava entre processos do log (compartilhada ou exclusiva), esperando se preciso.
+ *
+ * @return int 0 em caso de sucesso, -1 se o arquivo de trava não puder ser usado.
+ */
+static int travarRanking(RankingJogadores* ranking, const char* caminho, int exclusiva){
+#ifndef _WIN32
+    if (ranking->descritorTrava < 0){
+        char nomeTrava[FILENAME_MAX];
+        snprintf(nomeTrava, sizeof(nomeTrava), "%s.lock", caminho);
+        ranking->descritorTrava = open(nomeTrava, O_RDWR | O_CREAT, 0644);
+        if (ranking->descritorTrava < 0) return -1;
+    }
+    struct flock trava;
+    memset(&trava, 0, sizeof(trava));
+    trava.l_type = exclusiva ? F_WRLCK : F_RDLCK;
+    trava.l_whence = SEEK_SET; // l_start = l_len = 0: o arquivo inteiro
+    while (fcntl(ranking->descritorTrava, F_SETLKW, &trava) != 0){
+        if (errno != EINTR) return -1;
+    }
+#else
+    (void)ranking;
+    (void)caminho;
+    (void)exclusiva;
+#endif
+    return 0;
+}
+
+/**
+ * @brief Libera a trava obtida por travarRanking().
+ */
+static void destravarRanking(RankingJogadores* ranking){
+#ifndef _WIN32
+    struct flock trava;
+    memset(&trava, 0, sizeof(trava));
+    trava.l_type = F_UNLCK;
+    trava.l_whence = SEEK_SET;
+    fcntl(ranking->descritorTrava, F_SETLK, &trava);
+#else
+    (void)ranking;
+#endif
+}
+
+/**
+ * @brief Lê exatamente 'tamanho' bytes, repetindo leituras parciais.
+ */
+static int lerTudo(int descritor, void* destino, size_t tamanho){
+    char* p = destino;
+    while (tamanho > 0){
+        ssize_t lidos = read(descritor, p, tamanho);
+        if (lidos < 0 && errno == EINTR) continue;
+        if (lidos <= 0) return -1;
+        p += lidos;
+        tamanho -= (size_t)lidos;
+    }
+    return 0;
+}
+
+/**
+ * @brief Monta o cabeçalho gravado no início de todo log.
+ */
+static CabecalhoRanking montarCabecalho(void){
+    CabecalhoRanking cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.magica, MAGICA_RANKING, sizeof(cabecalho.magica));
+    cabecalho.versao = VERSAO_RANKING;
+    cabecalho.tamanhoRegistro = sizeof(RegistroLogRanking);
+    return cabecalho;
+}
+
+/**
+ * @brief (Re)abre o log e esvazia a memória, para que ele seja lido desde o início.
+ */
+static int abrirLog(RankingJogadores* ranking, const char* caminho){
+    if (ranking->descritorLog >= 0){
+        sincronizarRanking(ranking);
+        close(ranking->descritorLog);
+    }
+    // O_APPEND: todo acréscimo vai para o fim atual do arquivo, mesmo com outros processos gravando
+    ranking->descritorLog = open(caminho, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (ranking->descritorLog < 0) return -1;
+    struct stat info;
+    if (fstat(ranking->descritorLog, &info) != 0) return -1;
+    ranking->dispositivoLog = (uint64_t)info.st_dev;
+    ranking->inodeLog = (uint64_t)info.st_ino;
+    ranking->bytesIncorporados = 0;
+    ranking->formatoLegado = 0;
+    esvaziarRanking(ranking);
+    return 0;
+}
+
+/**
+ * @brief Traz para a memória o que ainda não foi lido do log. Exige a trava.
+ *
+ * Se o caminho passou a apontar para outro arquivo (compactação ou formatação
+ * feita por outro processo), o log é reaberto e lido do início; senão, só os
+ * bytes após ranking->bytesIncorporados são lidos. Com a trava exclusiva,
+ * também cria o cabeçalho de um log vazio e descarta um registro incompleto
+ * deixado no fim por uma gravação interrompida.
+ *
+ * @return int Quantidade de registros corrompidos encontrados (normalmente 0),
+ * ou -1 se o log não puder ser lido.
+ */
+static int lerNovosRegistros(RankingJogadores* ranking, const char* caminho, int exclusiva){
+    struct stat info;
+    if (ranking->descritorLog < 0 || stat(caminho, &info) != 0 ||
+        (uint64_t)info.st_dev != ranking->dispositivoLog || (uint64_t)info.st_ino != ranking->inodeLog){
+        if (abrirLog(ranking, caminho) != 0) return -1;
+    }
+    if (fstat(ranking->descritorLog, &info) != 0) return -1;
+    uint64_t tamanho = (uint64_t)info.st_size;
+    if (tamanho < ranking->bytesIncorporados){
+        // O log só cresce; se encolheu no mesmo arquivo, é relido do início
+        if (abrirLog(ranking, caminho) != 0) return -1;
+    }
+
+    if (ranking->bytesIncorporados == 0){
+        CabecalhoRanking esperado = montarCabecalho();
+        CabecalhoRanking cabecalho;
+        size_t lidos = tamanho < sizeof(cabecalho) ? (size_t)tamanho : sizeof(cabecalho);
+        size_t tamMagica = lidos < sizeof(cabecalho.magica) ? lidos : sizeof(cabecalho.magica);
+        memset(&cabecalho, 0, sizeof(cabecalho));
+        if (lidos > 0 && (lseek(ranking->descritorLog, 0, SEEK_SET) < 0 ||
+                          lerTudo(ranking->descritorLog, &cabecalho, lidos) != 0)){
+            return -1;
+        }
+        if (memcmp(cabecalho.magica, MAGICA_RANKING, tamMagica) != 0){
+            ranking->formatoLegado = 1; // Arquivo antigo: só registros PosicaoRanking
+        } else if (lidos < sizeof(cabecalho)){
+            // Log vazio, ou cabeçalho interrompido no meio: é (re)escrito por quem for gravar
+            if (!exclusiva) return 0;
+            if (ftruncate(ranking->descritorLog, 0) != 0 ||
+                gravarTudo(ranking->descritorLog, &esperado, sizeof(esperado)) != 0) return -1;
+            ranking->bytesIncorporados = sizeof(esperado);
+            return 0;
+        } else if (cabecalho.versao != esperado.versao || cabecalho.tamanhoRegistro != esperado.tamanhoRegistro){
+            printf("[Erro] O arquivo de ranking '%s' é de uma versão incompatível.\n", caminho);
+            return -1;
+        } else {
+            ranking->bytesIncorporados = sizeof(cabecalho);
+        }
+    }
+
+    size_t tamRegistro = ranking->formatoLegado ? sizeof(PosicaoRanking) : sizeof(RegistroLogRanking);
+    uint64_t completos = (tamanho - ranking->bytesIncorporados) / tamRegistro;
+    if (completos > 0 && lseek(ranking->descritorLog, (off_t)ranking->bytesIncorporados, SEEK_SET) < 0) return -1;
+
+    RegistroLogRanking* bloco = malloc(REGISTROS_POR_LEITURA * sizeof(RegistroLogRanking));
+    if (bloco == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para o ranking.\n");
+        return -1;
+    }
+    int invalidos = 0;
+    while (completos > 0){
+        size_t quantidade = completos < REGISTROS_POR_LEITURA ? (size_t)completos : REGISTROS_POR_LEITURA;
+        if (lerTudo(ranking->descritorLog, bloco, quantidade * tamRegistro) != 0){
+            free(bloco);
+            return -1;
+        }
+        for (size_t i = 0; i < quantidade; i++){
+            PosicaoRanking registro;
+            if (ranking->formatoLegado){
+                memcpy(&registro, (char*)bloco + i * tamRegistro, sizeof(registro));
+            } else {
+                registro = bloco[i].posicao;
+                if (atualizarChecksum(CHECKSUM_INICIAL, &bloco[i].posicao, sizeof(bloco[i].posicao)) != bloco[i].checksum){
+                    invalidos++;
+                    ranking->registrosForaDeOrdem++; // Sai do arquivo na próxima compactação
+                    continue;
+                }
+            }
+            registro.nome[TAM_MAX_NOME - 1] = '\0';
+            if (inserirNoRanking(ranking, registro.nome, registro.pontuacao) < 0){
+                free(bloco);
+                return -1;
+            }
+        }
+        ranking->bytesIncorporados += quantidade * tamRegistro;
+        completos -= quantidade;
+    }
+    free(bloco);
+
+    if (invalidos > 0){
+        printf("[Aviso] %d registro(s) corrompido(s) do ranking foram ignorados.\n", invalidos);
+    }
+    if (exclusiva && ranking->bytesIncorporados < tamanho){
+        printf("[Aviso] O ranking terminava com um registro incompleto, que foi descartado.\n");
+        if (ftruncate(ranking->descritorLog, (off_t)ranking->bytesIncorporados) != 0) return -1;
+    }
+    return invalidos;
+}
+
+/**
+ * @brief Força o fsync dos acréscimos ao log ainda não sincronizados.
+ *
+ * @param ranking Ranking ligado a um log.
+ * @return int 0 em caso de sucesso (ou se não havia nada pendente), -1 se o fsync falhar.
+ */
+int sincronizarRanking(RankingJogadores* ranking){
+    if (ranking == NULL || ranking->registrosSemSincronia == 0 || ranking->descritorLog < 0) return 0;
+    ranking->registrosSemSincronia = 0;
+    return fsync(ranking->descritorLog) == 0 ? 0 : -1;
+}
+
+/**
+ * @brief Regrava o log a partir da memória, em ordem, e passa a usar o novo arquivo. Exige a trava exclusiva.
+ */
+static int regravarLog(RankingJogadores* ranking, const char* caminho){
+    char temporario[FILENAME_MAX];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", caminho);
+    FILE* arquivo = fopen(temporario, "wb");
+    if (arquivo == NULL) return -1;
+
+    CabecalhoRanking cabecalho = montarCabecalho();
+    int erro = fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo) != 1;
+    for (const NoRanking* no = ranking->cabeca->ligacoes[0].proximo; no != NULL && !erro; no = no->ligacoes[0].proximo){
+        RegistroLogRanking registro;
+        registro.posicao = montarRegistro(no->registro.nome, no->registro.pontuacao);
+        registro.checksum = atualizarChecksum(CHECKSUM_INICIAL, &registro.posicao, sizeof(registro.posicao));
+        erro = fwrite(&registro, sizeof(registro), 1, arquivo) != 1;
+    }
+    erro = erro || fflush(arquivo) != 0;
+    erro = erro || fsync(fileno(arquivo)) != 0;
+    erro = (fclose(arquivo) != 0) || erro;
+    if (erro){
+        remove(temporario);
+        return -1;
+    }
+#ifdef _WIN32
+    if (ranking->descritorLog >= 0) close(ranking->descritorLog);
+    ranking->descritorLog = -1;
+    remove(caminho); // rename() do Windows não substitui um arquivo existente
+#endif
+    if (rename(temporario, caminho) != 0){
+        remove(temporario);
+        return -1;
+    }
+
+    // O novo arquivo já está sincronizado e contém tudo o que estava pendente
+    ranking->registrosSemSincronia = 0;
+    if (ranking->descritorLog >= 0) close(ranking->descritorLog);
+    ranking->descritorLog = open(caminho, O_RDWR | O_APPEND);
+    struct stat info;
+    if (ranking->descritorLog < 0 || fstat(ranking->descritorLog, &info) != 0) return -1;
+    ranking->dispositivoLog = (uint64_t)info.st_dev;
+    ranking->inodeLog = (uint64_t)info.st_ino;
+    ranking->bytesIncorporados = (uint64_t)info.st_size;
+    ranking->formatoLegado = 0;
+    ranking->registrosForaDeOrdem = 0;
+    return 0;
+}
+
+/**
+ * @brief Regrava o log do ranking na ordem do ranking, de forma atômica.
+ *
+ * Com a trava exclusiva, incorpora o que outros processos gravaram, escreve o
+ * log inteiro em "<caminho>.tmp", sincroniza com o disco e renomeia sobre o
+ * original, como em salvarSnapshot(). Registros corrompidos não são copiados.
+ *
+ * @param ranking Ranking ligado ao log.
+ * @param caminho Caminho do log.
+ * @return int 0 em caso de sucesso, -1 em caso de falha (o log antigo é mantido).
+ */
+int compactarRanking(RankingJogadores* ranking, const char* caminho){
+    if (travarRanking(ranking, caminho, 1) != 0) return -1;
+    int resultado = -1;
+    if (lerNovosRegistros(ranking, caminho, 1) >= 0) resultado = regravarLog(ranking, caminho);
+    destravarRanking(ranking);
+    return resultado;
+}
+
+/**
+ * @brief Incorpora ao ranking em memória o que outros processos gravaram no log.
+ *
+ * Custa um stat() quando nada mudou e O(k log n) para k registros novos.
+ *
+ * @param ranking Ranking ligado ao log.
+ * @param caminho Caminho do log.
+ * @return int 0 em caso de sucesso, -1 se o log não puder ser lido.
+ */
+int atualizarRanking(RankingJogadores* ranking, const char* caminho){
+    if (travarRanking(ranking, caminho, 0) != 0) return -1;
+    int resultado = lerNovosRegistros(ranking, caminho, 0);
+    destravarRanking(ranking);
+    return resultado < 0 ? -1 : 0;
+}
+
+/**
+ * @brief Lê o log de pontuações e monta o ranking em memória.
+ *
+ * Se o log estiver no formato antigo, tiver registros corrompidos ou muitos
+ * registros fora de ordem, ele é regravado (a próxima carga fica linear).
+ *
+ * @param caminho Caminho do log (ARQUIVO_RANKING).
+ * @return RankingJogadores* Ranking carregado (vazio se o arquivo não existir),
+ * ou NULL em caso de falha.
+ */
+RankingJogadores* carregarRanking(const char* caminho){
+    RankingJogadores* ranking = criarRanking();
+    if (ranking == NULL) return NULL;
+    int invalidos = -1;
+    if (travarRanking(ranking, caminho, 0) == 0){
+        invalidos = lerNovosRegistros(ranking, caminho, 0);
+        destravarRanking(ranking);
+    }
+    if (invalidos < 0){
+        printf("[Erro] Não foi possível ler o arquivo de ranking '%s'.\n", caminho);
+        liberarRanking(ranking);
+        return NULL;
+    }
+    if ((invalidos > 0 || ranking->formatoLegado || deveCompactarRanking(ranking)) &&
+        compactarRanking(ranking, caminho) != 0){
+        printf("[Aviso] Não foi possível regravar o arquivo de ranking.\n");
+    }
+    return ranking;
+}
+
+/**
+ * @brief Insere uma pontuação no ranking e a acrescenta ao log em disco.
+ *
+ * Com a trava exclusiva: incorpora os registros de outros processos (a posição
+ * devolvida considera todos eles), acrescenta um RegistroLogRanking ao fim do
+ * arquivo e, se for o caso, sincroniza o lote de acréscimos ou compacta o log
+ * (quando os registros fora de ordem passam de 1/4 do log e de
+ * MIN_FORA_DE_ORDEM_RANKING).
+ *
+ * @param ranking Ranking ligado a 'caminho'.
+ * @param caminho Caminho do log.
+ * @param nome Nome do jogador.
+ * @param pontuacao Pontuação obtida.
+ * @return long Posição do jogador no ranking, ou -1 se não foi possível gravar.
+ */
+long registrarPontuacao(RankingJogadores* ranking, const char* caminho, const char* nome, int pontuacao){
+    if (travarRanking(ranking, caminho, 1) != 0) return -1;
+    long posicao = -1;
+    if (lerNovosRegistros(ranking, caminho, 1) < 0 ||
+        (ranking->formatoLegado && regravarLog(ranking, caminho) != 0)){
+        destravarRanking(ranking);
+        return -1;
+    }
+
+    RegistroLogRanking registro;
+    registro.posicao = montarRegistro(nome, pontuacao);
+    registro.checksum = atualizarChecksum(CHECKSUM_INICIAL, &registro.posicao, sizeof(registro.posicao));
+    if (gravarTudo(ranking->descritorLog, &registro, sizeof(registro)) == 0){
+        ranking->bytesIncorporados += sizeof(registro);
+        posicao = inserirNoRanking(ranking, nome, pontuacao);
+        int64_t agora = (int64_t)time(NULL);
+        if (ranking->registrosSemSincronia++ == 0) ranking->inicioSemSincronia = agora;
+        if (ranking->registrosSemSincronia >= LOTE_SINCRONIA_RANKING ||
+            agora - ranking->inicioSemSincronia >= INTERVALO_SINCRONIA_RANKING){
+            sincronizarRanking(ranking);
+        }
+        if (deveCompactarRanking(ranking) && regravarLog(ranking, caminho) != 0){
+            printf("[Aviso] Não foi possível compactar o arquivo de ranking.\n");
+        }
+    }
+    destravarRanking(ranking);
+    return posicao;
+}
+
+/**
+ * @brief Apaga todas as pontuações do ranking e do log.
+ *
+ * O log é trocado, com a trava exclusiva, por um log vazio (arquivo temporário
+ * renomeado); os outros processos percebem a troca na próxima operação e
+ * também passam a ver o ranking vazio.
+ *
+ * @param ranking Ranking ligado ao log.
+ * @param caminho Caminho do log.
+ * @return int 0 em caso de sucesso, -1 em caso de falha.
+ */
+int apagarRanking(RankingJogadores* ranking, const char* caminho){
+    if (travarRanking(ranking, caminho, 1) != 0) return -1;
+    esvaziarRanking(ranking);
+    int resultado = regravarLog(ranking, caminho);
+    destravarRanking(ranking);
+    return resultado;
+}
+
+/**
+ * @brief Retorna o ranking de ARQUIVO_RANKING, carregando-o no primeiro uso.
+ */
+static RankingJogadores* obterRankingAtual(void){
+    if (rankingAtual == NULL) rankingAtual = carregarRanking(ARQUIVO_RANKING);
+    return rankingAtual;
+}
+
+/**
+ * @brief Sincroniza com o disco as pontuações pendentes de ARQUIVO_RANKING.
+ *
+ * Chamada ao fim de uma sessão de jogo, depois de salvar as pontuações de todos os jogadores.
+ */
+void sincronizarRankingAtual(void){
+    if (rankingAtual != NULL && sincronizarRanking(rankingAtual) != 0){
+        printf("[Aviso] Não foi possível sincronizar o arquivo de ranking.\n");
+    }
+}
+
+/**
+ * @brief Sincroniza e libera o ranking de ARQUIVO_RANKING, ao encerrar o programa.
+ */
+void encerrarRanking(void){
+    liberarRanking(rankingAtual);
+    rankingAtual = NULL;
+}
+
+/**
+ * @brief Adiciona o resultado de um jogador ao ranking e salva em arquivo.
+ *
+ * O registro é inserido no ranking em memória em O(log n) e acrescentado ao
+ * fim do log ARQUIVO_RANKING (ver registrarPontuacao()). Todas as pontuações
+ * são mantidas e a posição informada é a posição real do jogador, contando
+ * as pontuações gravadas por outros processos.
+ *
+ * @param nome Nome do jogador a ser registrado (string).
+ * @param pontuacao Pontuação total acumulada na sessão.
+ * * @return void
+ */
+void salvarRanking(const char* nome, int pontuacao){
+    RankingJogadores* ranking = obterRankingAtual();
+    long posicao = (ranking != NULL) ? registrarPontuacao(ranking, ARQUIVO_RANKING, nome, pontuacao) : -1;
+    if (posicao < 0){
+        printf("[Erro] Falha ao salvar ranking.\n");
+        return;
+    }
+    printf("[Ranking] Pontuação salva! Você está na posição %ld de %ld.\n", posicao, ranking->total);
+}
+
+/**
+ * @brief Exibe o ranking no terminal, MAX_RANKING_ENTRIES posições por página.
+ *
+ * Mostra a tabela (Posição | Nome | Pontos) a partir do primeiro colocado. Se
+ * houver mais de uma página, o usuário pode avançar, voltar ou ir direto à
+ * página de uma posição; cada página custa O(log n + MAX_RANKING_ENTRIES) e
+ * já inclui as pontuações que outros processos gravaram enquanto isso.
+ * Caso o arquivo não exista ou esteja vazio, exibe uma mensagem informando.
+ * * @return void
+ */
+void listarRanking(){
+    RankingJogadores* ranking = obterRankingAtual();
+    if (ranking != NULL && atualizarRanking(ranking, ARQUIVO_RANKING) != 0){
+        printf("[Aviso] Não foi possível reler o arquivo de ranking.\n");
+    }
+    if (ranking == NULL || ranking->total == 0){
+        printf("\n ====== HALL DA FAMA ====== \n");
+        printf("   [ Aviso ] Nenhum registro encontrado.\n");
+        printf("=============================================\n\n");
+        return;
+    }
+
+    long inicio = 1;
+    char opcao[TAM_MAX_NOME];
+    while (1){
+        PosicaoRanking pagina[MAX_RANKING_ENTRIES];
+        int quantidade = copiarTrechoRanking(ranking, inicio, MAX_RANKING_ENTRIES, pagina);
+        printf("\n ====== HALL DA FAMA (%ld a %ld de %ld) ====== \n", inicio, inicio + quantidade - 1, ranking->total);
+        printf("Pos | %-30s | Pontos\n", "Nome");
+        printf("---------------------------------------------\n");
+        for (int i = 0; i < quantidade; i++){
+            printf("#%02ld | %-30s | %d\n", inicio + i, pagina[i].nome, pagina[i].pontuacao);
+        }
+        printf("=============================================\n");
+        if (ranking->total <= MAX_RANKING_ENTRIES) break;
+
+        printf("[P] Próxima página  [A] Anterior  [número] Ir para a posição  [S] Sair\n> ");
+        opcao[0] = '\0';
+        lerString(opcao, TAM_MAX_NOME);
+        atualizarRanking(ranking, ARQUIVO_RANKING);
+        if (opcao[0] == 'p'){
+            if (inicio + MAX_RANKING_ENTRIES <= ranking->total) inicio += MAX_RANKING_ENTRIES;
+        } else if (opcao[0] == 'a'){
+            inicio = (inicio > MAX_RANKING_ENTRIES) ? inicio - MAX_RANKING_ENTRIES : 1;
+        } else if (isdigit((unsigned char)opcao[0])){
+            long posicao = strtol(opcao, NULL, 10);
+            if (posicao >= 1 && posicao <= ranking->total){
+                inicio = (posicao - 1) / MAX_RANKING_ENTRIES * MAX_RANKING_ENTRIES + 1;
+            } else {
+                printf("[Aviso] Posição fora do ranking.\n");
+            }
+        } else {
+            break;
+        }
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Apaga permanentemente todo o histórico de ranking.
+ *
+ * Esta função troca o arquivo binário onde os recordes estão armazenados ("ranking.dat")
+ * por um log vazio (ver apagarRanking()), com a trava exclusiva: pode ser usada
+ * enquanto outros processos gravam pontuações, e eles passam a ver o ranking vazio.
+ * É uma operação irreversível utilizada para zerar o placar do jogo.
+ * Geralmente inclui uma etapa de confirmação do usuário antes de deletar o arquivo.
+ * * @return void
+ */
+void formatarRanking(){
+    char confirmacao;
+    printf("\n  ATENÇÃO: Isso apagará todo o histórico de recordes.\n");
+    printf("Tem certeza? (S/N): ");
+
+    setbuf(stdin, NULL);
+    scanf("%c", &confirmacao);
+
+    if (confirmacao == 's' || confirmacao == 'S'){
+        RankingJogadores* ranking = obterRankingAtual();
+        if (ranking != NULL && apagarRanking(ranking, ARQUIVO_RANKING) == 0){
+            printf("[OK] Ranking formatado com sucesso.\n");
+        } else {
+            printf("[Aviso] O arquivo de ranking não pôde ser apagado.\n");
+        }
+    } else {
+        printf("[Ação] Formatação cancelada.\n");
+    }
+}
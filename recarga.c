@@ -0,0 +1,284 @@
+/**
+ * @file recarga.c
+ * @brief Recarga do banco quando o CSV muda, sem interromper as partidas em andamento.
+ *
+ * Cada banco carregado vira uma VersaoBanco com contador de referências. Quem
+ * joga (uma conexão do servidor, por exemplo) segura uma referência à versão
+ * em que a rodada começou, e os Item* dessa versão continuam válidos até a
+ * referência ser devolvida, mesmo depois de outra versão ter sido publicada.
+ *
+ * Uma thread vigia com inotify a pasta do CSV (editores costumam gravar em um
+ * arquivo temporário e renomeá-lo, por isso a pasta e não o arquivo). Quando
+ * o CSV é fechado depois de escrito ou aparece por renomeação, ela espera as
+ * gravações pararem, lê o arquivo em um banco novo, fora de qualquer trava, e
+ * o publica trocando um ponteiro. As versões substituídas ficam com essa
+ * thread, que as libera quando a última referência é devolvida: quem joga
+ * nunca paga o custo de ler nem de liberar um banco.
+ *
+ * @date 2025-11-26
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include "funcoes.h"
+
+#ifdef __linux__
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
+
+#define ESPERA_RECARGA_MS 200           // Silêncio exigido depois da última gravação no CSV
+#define TAM_MAX_CAMINHO_RECARGA 1024
+
+struct RecargaBanco{
+    pthread_mutex_t trava;              // Protege só a troca de 'atual' e as aquisições
+    VersaoBanco *atual;
+    long numeroAtual;                   // atual->numero, lido sem a trava
+    VersaoBanco *substituidas;          // Só a thread de vigia mexe nesta lista
+    char diretorio[TAM_MAX_CAMINHO_RECARGA];
+    char caminho[TAM_MAX_CAMINHO_RECARGA];
+    const char *nomeArquivo;            // Aponta para dentro de 'caminho'
+    int inotify;
+    int vigiando;
+    volatile int ativo;
+    pthread_t thread;
+};
+
+static VersaoBanco* criarVersao(BancoInformacoes* banco, long numero){
+    VersaoBanco* versao = calloc(1, sizeof(VersaoBanco));
+    if (versao == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para a versão do banco.\n");
+        return NULL;
+    }
+    versao->banco = banco;
+    versao->numero = numero;
+    return versao;
+}
+
+/**
+ * @brief Pega uma referência à versão mais recente do banco.
+ *
+ * @return VersaoBanco* Versão publicada; devolver com liberarVersaoBanco().
+ */
+VersaoBanco* adquirirVersaoBanco(RecargaBanco* recarga){
+    pthread_mutex_lock(&recarga->trava);
+    VersaoBanco* versao = recarga->atual;
+    __atomic_fetch_add(&versao->referencias, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&recarga->trava);
+    return versao;
+}
+
+/**
+ * @brief Pega mais uma referência a uma versão que o chamador já segura.
+ */
+void reterVersaoBanco(VersaoBanco* versao){
+    __atomic_fetch_add(&versao->referencias, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Devolve uma referência. Versões substituídas sem referências são
+ * liberadas depois, pela thread de vigia.
+ */
+void liberarVersaoBanco(VersaoBanco* versao){
+    if (versao != NULL) __atomic_fetch_sub(&versao->referencias, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Número da versão publicada, sem trava: serve para saber se há uma
+ * versão mais nova que a que o chamador segura.
+ */
+long numeroVersaoBanco(const RecargaBanco* recarga){
+    return __atomic_load_n(&recarga->numeroAtual, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Publica um banco novo no lugar do atual.
+ *
+ * @return int 0 em caso de sucesso, -1 se faltar memória (o banco não é publicado).
+ */
+static int publicarBanco(RecargaBanco* recarga, BancoInformacoes* banco){
+    VersaoBanco* nova = criarVersao(banco, recarga->atual->numero + 1);
+    if (nova == NULL) return -1;
+    pthread_mutex_lock(&recarga->trava);
+    VersaoBanco* antiga = recarga->atual;
+    recarga->atual = nova;
+    __atomic_store_n(&recarga->numeroAtual, nova->numero, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&recarga->trava);
+    // Depois da troca ninguém mais adquire a antiga: quando as referências
+    // zerarem, zeradas ficam
+    antiga->proxima = recarga->substituidas;
+    recarga->substituidas = antiga;
+    return 0;
+}
+
+/**
+ * @brief Libera as versões substituídas que ninguém mais usa.
+ *
+ * @param todas Libera mesmo as que têm referências (no encerramento).
+ */
+static void liberarSubstituidas(RecargaBanco* recarga, int todas){
+    VersaoBanco** ligacao = &recarga->substituidas;
+    while (*ligacao != NULL){
+        VersaoBanco* versao = *ligacao;
+        if (!todas && __atomic_load_n(&versao->referencias, __ATOMIC_ACQUIRE) != 0){
+            ligacao = &versao->proxima;
+            continue;
+        }
+        *ligacao = versao->proxima;
+        if (!todas) printf("[OK] Versão %ld do banco liberada.\n", versao->numero);
+        liberarBanco(versao->banco);
+        free(versao);
+    }
+}
+
+#ifdef __linux__
+
+/**
+ * @brief Lê o CSV em um banco novo e o publica; se a leitura falhar, o banco atual continua.
+ */
+static void recarregarCSV(RecargaBanco* recarga){
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    BancoInformacoes* banco = inicializarBanco();
+    if (banco == NULL) return;
+    // Um CSV vazio quase sempre é uma gravação pela metade: não substitui o banco
+    if (carregarCSV(banco, recarga->caminho) < 0 || itensAtivos(banco) == 0){
+        printf("[Aviso] Não foi possível recarregar '%s'; o banco atual continua em uso.\n", recarga->caminho);
+        liberarBanco(banco);
+        fflush(stdout);
+        return;
+    }
+    aplicarModoDicas(banco);    // O banco novo guarda as dicas como o inicial
+    if (publicarBanco(recarga, banco) != 0){
+        printf("[Aviso] Não foi possível recarregar '%s'; o banco atual continua em uso.\n", recarga->caminho);
+        liberarBanco(banco);
+        fflush(stdout);
+        return;
+    }
+    printf("[OK] Banco recarregado de '%s': %d itens (versão %ld, %.0f ms).\n", recarga->caminho,
+           itensAtivos(banco), recarga->atual->numero, segundosDesde(&inicio) * 1e3);
+    fflush(stdout);
+}
+
+/**
+ * @brief Thread de vigia: recarrega o CSV depois que ele para de ser gravado.
+ */
+static void* vigiarCSV(void* argumento){
+    RecargaBanco* recarga = argumento;
+    char eventos[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    int pendente = 0;
+    while (recarga->ativo){
+        struct pollfd espera = {.fd = recarga->inotify, .events = POLLIN};
+        int pronto = poll(&espera, 1, ESPERA_RECARGA_MS);
+        if (pronto > 0){
+            ssize_t lidos;
+            while ((lidos = read(recarga->inotify, eventos, sizeof(eventos))) > 0){
+                for (char* p = eventos; p < eventos + lidos; ){
+                    const struct inotify_event* evento = (const struct inotify_event*)p;
+                    if (evento->len > 0 && strcmp(evento->name, recarga->nomeArquivo) == 0) pendente = 1;
+                    p += sizeof(struct inotify_event) + evento->len;
+                }
+            }
+        } else if (pronto == 0 && pendente){
+            pendente = 0;
+            recarregarCSV(recarga);
+        }
+        liberarSubstituidas(recarga, 0);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Começa a vigiar a pasta do CSV.
+ *
+ * @return int 0 em caso de sucesso, -1 se não for possível.
+ */
+static int iniciarVigia(RecargaBanco* recarga, const char* caminhoCsv){
+    if (strlen(caminhoCsv) >= TAM_MAX_CAMINHO_RECARGA) return -1;
+    strcpy(recarga->caminho, caminhoCsv);
+    const char* barra = strrchr(recarga->caminho, '/');
+    if (barra == NULL){
+        strcpy(recarga->diretorio, ".");
+        recarga->nomeArquivo = recarga->caminho;
+    } else {
+        size_t tamDiretorio = (barra == recarga->caminho) ? 1 : (size_t)(barra - recarga->caminho);
+        memcpy(recarga->diretorio, recarga->caminho, tamDiretorio);
+        recarga->diretorio[tamDiretorio] = '\0';
+        recarga->nomeArquivo = barra + 1;
+    }
+    recarga->inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (recarga->inotify < 0) return -1;
+    if (inotify_add_watch(recarga->inotify, recarga->diretorio, IN_CLOSE_WRITE | IN_MOVED_TO) < 0){
+        close(recarga->inotify);
+        return -1;
+    }
+    recarga->ativo = 1;
+    if (pthread_create(&recarga->thread, NULL, vigiarCSV, recarga) != 0){
+        close(recarga->inotify);
+        return -1;
+    }
+    recarga->vigiando = 1;
+    return 0;
+}
+
+#else
+
+static int iniciarVigia(RecargaBanco* recarga, const char* caminhoCsv){
+    (void)recarga; (void)caminhoCsv;
+    return -1;
+}
+
+#endif
+
+/**
+ * @brief Publica o banco inicial e, se 'caminhoCsv' for informado, passa a
+ * recarregá-lo sempre que o arquivo mudar (só no Linux).
+ *
+ * @param banco Banco inicial; passa a ser da recarga, que o libera.
+ * @param caminhoCsv CSV a ser vigiado, ou NULL para nunca recarregar.
+ * @return RecargaBanco* Recarga pronta, ou NULL se faltar memória (o banco
+ * continua sendo do chamador).
+ */
+RecargaBanco* iniciarRecargaBanco(BancoInformacoes* banco, const char* caminhoCsv){
+    RecargaBanco* recarga = calloc(1, sizeof(RecargaBanco));
+    if (recarga == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para a recarga do banco.\n");
+        return NULL;
+    }
+    recarga->atual = criarVersao(banco, 1);
+    if (recarga->atual == NULL){
+        free(recarga);
+        return NULL;
+    }
+    recarga->numeroAtual = 1;
+    pthread_mutex_init(&recarga->trava, NULL);
+    if (caminhoCsv != NULL && iniciarVigia(recarga, caminhoCsv) != 0){
+        printf("[Aviso] Não foi possível vigiar '%s'; o banco não será recarregado.\n", caminhoCsv);
+    }
+    return recarga;
+}
+
+/**
+ * @brief Para a vigia e libera todas as versões do banco.
+ *
+ * Deve ser chamada depois que todos devolveram as suas referências.
+ */
+void encerrarRecargaBanco(RecargaBanco* recarga){
+    if (recarga == NULL) return;
+#ifdef __linux__
+    if (recarga->vigiando){
+        recarga->ativo = 0;
+        pthread_join(recarga->thread, NULL);
+        close(recarga->inotify);
+    }
+#endif
+    liberarSubstituidas(recarga, 1);
+    liberarBanco(recarga->atual->banco);
+    free(recarga->atual);
+    pthread_mutex_destroy(&recarga->trava);
+    free(recarga);
+}
@@ -0,0 +1,750 @@
+/**
+ * @file servidor.c
+ * @brief Modo servidor: muitas sessões de jogo simultâneas em um socket TCP ou Unix.
+ *
+ * Iniciado com "jogo servidor [opções]". Cada conexão hospeda uma SessaoJogo por
+ * vez, com as mesmas regras do modo console (ver sessao.c).
+ *
+ * As conexões são atendidas por um pequeno grupo de threads, cada uma com o seu
+ * próprio laço de eventos epoll e sockets não bloqueantes. O socket de escuta é
+ * registrado em todas elas com EPOLLEXCLUSIVE, de modo que cada nova conexão
+ * acorda uma única thread, que passa a atendê-la até o fim. Nenhuma estrutura é
+ * compartilhada entre as threads durante o jogo, a não ser o banco (só leitura)
+ * e o ranking, protegido por um mutex.
+ *
+ * Se o CSV mudar, o banco é recarregado em segundo plano (ver recarga.c). Cada
+ * conexão segura uma referência à versão do banco do item em jogo e só passa
+ * para a versão nova ao sortear o próximo item; cada thread remonta o seu
+ * sorteador na primeira vez que sorteia depois da recarga.
+ *
+ * Protocolo (texto, uma linha por comando; cada resposta é um bloco de linhas
+ * terminado por uma linha vazia):
+ *
+ *     NOVA <nivel> <nome1>[;<nome2>...]   nível 0 = todos; até MAX_JOGADORES_SESSAO nomes
+ *     RESPONDER <palpite>
+ *     LETRA                               revela uma letra (-PENALIDADE_LETRA, -1 tentativa)
+ *     DICA                                libera a próxima dica
+ *     PULAR                               passa a vez (-PENALIDADE_PULAR do total)
+ *     PROXIMO                             sorteia o próximo item, depois de FIM_ITEM
+ *     SAIR                                encerra a sessão e grava as pontuações no ranking
+ *
+ * Linhas enviadas pelo servidor:
+ *
+ *     ITEM <mascara>                      novo item
+ *     DICA <n> <texto>                    dica em vigor
+ *     VEZ <indice> <tentativas> <valendo> <total> <nome>
+ *     ERROU | LETRA <mascara> | PULOU <nome>
+ *     ACERTOU <erros> <pontos> <nome>
+ *     FIM_ITEM <resposta>                 o item acabou; aguarda PROXIMO ou SAIR
+ *     PLACAR <pontos> <posicao no ranking> <nome>
+ *     TCHAU                               fim da sessão; a conexão pode iniciar outra
+ *     ERRO <mensagem>
+ *
+ * Itens são sorteados por um SorteadorItens por thread: as sessões de uma mesma
+ * thread retiram itens da mesma sacola, o que mantém a garantia de não repetir
+ * itens dentro de uma sessão sem o custo de montar as sacolas a cada conexão.
+ *
+ * @date 2025-11-26
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "funcoes.h"
+
+#ifdef __linux__
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define MAX_THREADS_SERVIDOR 64
+#define THREADS_PADRAO_SERVIDOR 8       // Teto do padrão (número de núcleos)
+#define MAX_EVENTOS_SERVIDOR 256        // Eventos tratados por chamada a epoll_wait
+#define ESPERA_EVENTOS_MS 200           // Intervalo para perceber o pedido de encerramento
+#define MAX_ACEITES_POR_EVENTO 16       // Conexões aceitas por despertar (reparte entre as threads)
+#define INTERVALO_ESTATISTICAS 5        // Segundos entre os relatórios do servidor
+
+typedef struct ThreadServidor ThreadServidor;
+
+/**
+ * @brief Uma conexão de jogador, com os seus buffers e a sessão em andamento.
+ */
+typedef struct ConexaoServidor{
+    int descritor;
+    ThreadServidor *thread;
+    struct ConexaoServidor *anterior;   // Lista das conexões da thread (para o encerramento)
+    struct ConexaoServidor *proxima;
+    char entrada[TAM_MAX_LINHA_SERVIDOR];
+    size_t usadoEntrada;
+    char *saida;                        // Respostas ainda não enviadas
+    size_t tamSaida;
+    size_t capSaida;
+    size_t enviadoSaida;
+    int aguardandoEscrita;              // Só EPOLLOUT registrado: o socket encheu e a leitura espera o envio
+    int emPartida;                      // NOVA recebido e SAIR ainda não
+    VersaoBanco *versao;                // Banco da sessão (referência da conexão), NULL fora de partida
+    SessaoJogo sessao;
+}ConexaoServidor;
+
+/**
+ * @brief Dados compartilhados por todas as threads do servidor.
+ */
+typedef struct{
+    RecargaBanco *recarga;              // Versão atual do banco (só leitura)
+    RankingJogadores *ranking;          // NULL: as pontuações não são gravadas
+    const char *arquivoRanking;
+    pthread_mutex_t travaRanking;
+    int escuta;
+}ContextoServidor;
+
+/**
+ * @brief Uma thread de atendimento: o seu epoll, o seu sorteador e os seus contadores.
+ *
+ * Os contadores são escritos só pela própria thread e lidos pela principal
+ * com operações atômicas relaxadas.
+ */
+struct ThreadServidor{
+    pthread_t thread;
+    int epoll;
+    ContextoServidor *contexto;
+    VersaoBanco *versao;                // Banco de onde o sorteador tira os itens
+    SorteadorItens *sorteador;
+    uint64_t semente;
+    ConexaoServidor *conexoes;
+    long conexoesAbertas;
+    long sessoesIniciadas;
+    long sessoesConcluidas;
+    long comandos;
+};
+
+static volatile sig_atomic_t servidorAtivo = 1;
+
+static void pedirEncerramento(int sinal){
+    (void)sinal;
+    servidorAtivo = 0;
+}
+
+static void somarContador(long* contador, long valor){
+    __atomic_fetch_add(contador, valor, __ATOMIC_RELAXED);
+}
+
+static long lerContador(long* contador){
+    return __atomic_load_n(contador, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Acrescenta uma linha formatada às respostas pendentes da conexão.
+ *
+ * @return int 0 em caso de sucesso, -1 se faltar memória.
+ */
+static int responder(ConexaoServidor* conexao, const char* formato, ...){
+    for (;;){
+        size_t livre = conexao->capSaida - conexao->tamSaida;
+        va_list argumentos;
+        va_start(argumentos, formato);
+        int escritos = vsnprintf(conexao->saida + conexao->tamSaida, livre, formato, argumentos);
+        va_end(argumentos);
+        if (escritos < 0) return -1;
+        if ((size_t)escritos < livre){
+            conexao->tamSaida += (size_t)escritos;
+            return 0;
+        }
+        size_t capacidade = conexao->capSaida ? conexao->capSaida * 2 : 1024;
+        while (capacidade - conexao->tamSaida <= (size_t)escritos) capacidade *= 2;
+        char* saida = realloc(conexao->saida, capacidade);
+        if (saida == NULL) return -1;
+        conexao->saida = saida;
+        conexao->capSaida = capacidade;
+    }
+}
+
+/**
+ * @brief Informa a dica em vigor e de quem é a vez; se o item acabou, revela a resposta.
+ */
+static void enviarSituacao(ConexaoServidor* conexao){
+    SessaoJogo* sessao = &conexao->sessao;
+    if (sessao->estado != SESSAO_EM_JOGO){
+        responder(conexao, "FIM_ITEM %s\n", respostaSessao(sessao));
+        return;
+    }
+    const JogadorSessao* jogador = jogadorDaVez(sessao);
+    responder(conexao, "DICA %d %s\n", sessao->dicaAtual, dicaAtualSessao(sessao));
+    responder(conexao, "VEZ %d %d %d %d %s\n", sessao->jogadorAtual, jogador->tentativasNoItem,
+              sessao->pontuacaoRodada, jogador->pontuacaoSessao, jogador->nome);
+}
+
+/**
+ * @brief Passa a thread para a versão mais recente do banco, remontando o sorteador.
+ *
+ * Sessões no meio de um item continuam com a versão antiga, que é só delas.
+ */
+static void atualizarVersaoThread(ThreadServidor* thread){
+    RecargaBanco* recarga = thread->contexto->recarga;
+    if (numeroVersaoBanco(recarga) == thread->versao->numero) return;
+    VersaoBanco* nova = adquirirVersaoBanco(recarga);
+    SorteadorItens* sorteador = criarSorteador(nova->banco, CATEGORIA_TODAS, thread->semente + (uint64_t)nova->numero);
+    if (sorteador == NULL){
+        liberarVersaoBanco(nova);       // Fica na versão antiga e tenta de novo no próximo sorteio
+        return;
+    }
+    liberarSorteador(thread->sorteador);
+    liberarVersaoBanco(thread->versao);
+    thread->sorteador = sorteador;
+    thread->versao = nova;
+}
+
+/**
+ * @brief Antes de sortear um item: a sessão passa a usar o banco e o sorteador atuais da thread.
+ */
+static void sincronizarBancoConexao(ConexaoServidor* conexao){
+    ThreadServidor* thread = conexao->thread;
+    atualizarVersaoThread(thread);
+    if (conexao->versao != thread->versao){
+        reterVersaoBanco(thread->versao);
+        liberarVersaoBanco(conexao->versao);
+        conexao->versao = thread->versao;
+    }
+    conexao->sessao.banco = conexao->versao->banco;
+    conexao->sessao.sorteador = thread->sorteador;
+}
+
+/**
+ * @brief Fora de partida a conexão não segura versão nenhuma do banco.
+ */
+static void soltarBancoConexao(ConexaoServidor* conexao){
+    liberarVersaoBanco(conexao->versao);
+    conexao->versao = NULL;
+}
+
+/**
+ * @brief Sorteia o próximo item da sessão e o anuncia.
+ *
+ * @return int 0 em caso de sucesso, -1 se não há itens na faixa de níveis.
+ */
+static int anunciarItem(ConexaoServidor* conexao){
+    sincronizarBancoConexao(conexao);
+    if (proximoItemSessao(&conexao->sessao) == NULL){
+        responder(conexao, "ERRO nao ha itens cadastrados nesse nivel\n");
+        return -1;
+    }
+    responder(conexao, "ITEM %s\n", conexao->sessao.mascara);
+    enviarSituacao(conexao);
+    return 0;
+}
+
+/**
+ * @brief NOVA <nivel> <nome1>[;<nome2>...]: inicia uma sessão na conexão.
+ */
+static void comandoNova(ConexaoServidor* conexao, char* argumentos){
+    SessaoJogo* sessao = &conexao->sessao;
+    char* nomes = NULL;
+    long nivel = strtol(argumentos, &nomes, 10);
+    if (nomes == argumentos || nivel < 0 || nivel > MUITODIFICIL){
+        responder(conexao, "ERRO nivel invalido\n");
+        return;
+    }
+    while (*nomes == ' ') nomes++;
+
+    sincronizarBancoConexao(conexao);
+    iniciarSessao(sessao, conexao->versao->banco, conexao->thread->sorteador,
+                  (nivel == 0) ? MUITOFACIL : (int)nivel, (nivel == 0) ? MUITODIFICIL : (int)nivel);
+    char* contexto = NULL;
+    for (char* nome = strtok_r(nomes, ";", &contexto); nome != NULL; nome = strtok_r(NULL, ";", &contexto)){
+        if (*nome == '\0') continue;
+        if (adicionarJogadorSessao(sessao, nome) < 0){
+            responder(conexao, "ERRO no maximo %d jogadores\n", MAX_JOGADORES_SESSAO);
+            return;
+        }
+    }
+    if (sessao->numeroJogadores == 0){
+        responder(conexao, "ERRO informe o nome de pelo menos um jogador\n");
+        return;
+    }
+    if (anunciarItem(conexao) != 0) return;
+    conexao->emPartida = 1;
+    somarContador(&conexao->thread->sessoesIniciadas, 1);
+}
+
+/**
+ * @brief SAIR: informa o placar, grava as pontuações positivas e encerra a sessão.
+ */
+static void comandoSair(ConexaoServidor* conexao){
+    SessaoJogo* sessao = &conexao->sessao;
+    ContextoServidor* contexto = conexao->thread->contexto;
+    for (int i = 0; i < sessao->numeroJogadores; i++){
+        const JogadorSessao* jogador = &sessao->jogadores[i];
+        long posicao = 0;
+        if (jogador->pontuacaoSessao > 0 && contexto->ranking != NULL){
+            pthread_mutex_lock(&contexto->travaRanking);
+            posicao = registrarPontuacao(contexto->ranking, contexto->arquivoRanking,
+                                         jogador->nome, jogador->pontuacaoSessao);
+            pthread_mutex_unlock(&contexto->travaRanking);
+        }
+        responder(conexao, "PLACAR %d %ld %s\n", jogador->pontuacaoSessao, posicao, jogador->nome);
+    }
+    responder(conexao, "TCHAU\n");
+    conexao->emPartida = 0;
+    soltarBancoConexao(conexao);
+    somarContador(&conexao->thread->sessoesConcluidas, 1);
+}
+
+/**
+ * @brief Aplica uma ação do jogador da vez e informa o resultado e a nova situação.
+ */
+static void comandoAcao(ConexaoServidor* conexao, AcaoJogador acao, const char* palpite){
+    SessaoJogo* sessao = &conexao->sessao;
+    const JogadorSessao* jogador = jogadorDaVez(sessao);
+    switch (aplicarAcaoSessao(sessao, acao, palpite)){
+    case RESULTADO_ACERTOU:
+        responder(conexao, "ACERTOU %d %d %s\n", sessao->errosUltimoAcerto, sessao->pontuacaoRodada, jogador->nome);
+        break;
+    case RESULTADO_ERROU:
+        responder(conexao, "ERROU\n");
+        break;
+    case RESULTADO_LETRA_REVELADA:
+    case RESULTADO_SEM_LETRAS:
+        responder(conexao, "LETRA %s\n", sessao->mascara);
+        break;
+    case RESULTADO_PULOU:
+        responder(conexao, "PULOU %s\n", jogador->nome);
+        break;
+    default:
+        break;
+    }
+    enviarSituacao(conexao);
+}
+
+/**
+ * @brief Executa um comando do protocolo e acrescenta a resposta (terminada por linha vazia).
+ */
+static void executarComando(ConexaoServidor* conexao, char* linha){
+    char* argumentos = strchr(linha, ' ');
+    if (argumentos != NULL){
+        *argumentos++ = '\0';
+    } else {
+        argumentos = linha + strlen(linha);
+    }
+    somarContador(&conexao->thread->comandos, 1);
+
+    if (strcmp(linha, "NOVA") == 0){
+        if (conexao->emPartida) responder(conexao, "ERRO sessao em andamento\n");
+        else comandoNova(conexao, argumentos);
+        if (!conexao->emPartida) soltarBancoConexao(conexao);
+    } else if (!conexao->emPartida){
+        responder(conexao, "ERRO nenhuma sessao em andamento (use NOVA)\n");
+    } else if (strcmp(linha, "SAIR") == 0){
+        comandoSair(conexao);
+    } else if (strcmp(linha, "PROXIMO") == 0){
+        if (conexao->sessao.estado == SESSAO_EM_JOGO) responder(conexao, "ERRO o item ainda esta em jogo\n");
+        else anunciarItem(conexao);
+    } else if (conexao->sessao.estado != SESSAO_EM_JOGO){
+        responder(conexao, "ERRO o item acabou (use PROXIMO ou SAIR)\n");
+    } else if (strcmp(linha, "RESPONDER") == 0){
+        comandoAcao(conexao, ACAO_RESPONDER, argumentos);
+    } else if (strcmp(linha, "LETRA") == 0){
+        comandoAcao(conexao, ACAO_REVELAR_LETRA, NULL);
+    } else if (strcmp(linha, "DICA") == 0){
+        comandoAcao(conexao, ACAO_NOVA_DICA, NULL);
+    } else if (strcmp(linha, "PULAR") == 0){
+        comandoAcao(conexao, ACAO_PULAR, NULL);
+    } else {
+        responder(conexao, "ERRO comando desconhecido\n");
+    }
+    responder(conexao, "\n");
+}
+
+/**
+ * @brief Fecha a conexão e libera os seus buffers.
+ */
+static void fecharConexao(ConexaoServidor* conexao){
+    ThreadServidor* thread = conexao->thread;
+    if (conexao->anterior != NULL) conexao->anterior->proxima = conexao->proxima;
+    else thread->conexoes = conexao->proxima;
+    if (conexao->proxima != NULL) conexao->proxima->anterior = conexao->anterior;
+    close(conexao->descritor);
+    liberarVersaoBanco(conexao->versao);
+    somarContador(&thread->conexoesAbertas, -1);
+    free(conexao->saida);
+    free(conexao);
+}
+
+/**
+ * @brief Envia o que for possível das respostas pendentes, sem bloquear.
+ *
+ * Se o socket encher, passa a esperar só por EPOLLOUT: a conexão para de ser
+ * lida, e um cliente que manda comandos sem ler as respostas não faz a saída
+ * pendente crescer sem limite. Quando tudo foi enviado, volta a esperar por EPOLLIN.
+ *
+ * @return int 0 se a conexão continua, -1 se ela deve ser fechada.
+ */
+static int enviarPendentes(ConexaoServidor* conexao){
+    while (conexao->enviadoSaida < conexao->tamSaida){
+        ssize_t enviados = send(conexao->descritor, conexao->saida + conexao->enviadoSaida,
+                                conexao->tamSaida - conexao->enviadoSaida, MSG_NOSIGNAL);
+        if (enviados < 0){
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) return -1;
+            if (!conexao->aguardandoEscrita){
+                struct epoll_event evento = {.events = EPOLLOUT, .data.ptr = conexao};
+                if (epoll_ctl(conexao->thread->epoll, EPOLL_CTL_MOD, conexao->descritor, &evento) != 0) return -1;
+                conexao->aguardandoEscrita = 1;
+            }
+            return 0;
+        }
+        conexao->enviadoSaida += (size_t)enviados;
+    }
+    conexao->tamSaida = 0;
+    conexao->enviadoSaida = 0;
+    if (conexao->aguardandoEscrita){
+        struct epoll_event evento = {.events = EPOLLIN, .data.ptr = conexao};
+        if (epoll_ctl(conexao->thread->epoll, EPOLL_CTL_MOD, conexao->descritor, &evento) != 0) return -1;
+        conexao->aguardandoEscrita = 0;
+    }
+    return 0;
+}
+
+/**
+ * @brief Lê o que chegou na conexão e executa cada linha completa.
+ *
+ * @return int 0 se a conexão continua, -1 se ela foi encerrada pelo cliente
+ * ou deve ser fechada.
+ */
+static int receberComandos(ConexaoServidor* conexao){
+    for (;;){
+        size_t livre = sizeof(conexao->entrada) - conexao->usadoEntrada;
+        ssize_t lidos = recv(conexao->descritor, conexao->entrada + conexao->usadoEntrada, livre, 0);
+        if (lidos == 0) return -1;
+        if (lidos < 0){
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+            return -1;
+        }
+        conexao->usadoEntrada += (size_t)lidos;
+
+        char* inicio = conexao->entrada;
+        char* fim = conexao->entrada + conexao->usadoEntrada;
+        char* quebra;
+        while ((quebra = memchr(inicio, '\n', (size_t)(fim - inicio))) != NULL){
+            *quebra = '\0';
+            if (quebra > inicio && quebra[-1] == '\r') quebra[-1] = '\0';
+            executarComando(conexao, inicio);
+            inicio = quebra + 1;
+        }
+        conexao->usadoEntrada = (size_t)(fim - inicio);
+        memmove(conexao->entrada, inicio, conexao->usadoEntrada);
+        if (conexao->usadoEntrada == sizeof(conexao->entrada)){
+            responder(conexao, "ERRO linha maior que %d bytes\n\n", TAM_MAX_LINHA_SERVIDOR - 1);
+            enviarPendentes(conexao);
+            return -1;
+        }
+        if (enviarPendentes(conexao) != 0) return -1;
+        // Com respostas pendentes, o resto fica no socket até enviarPendentes() liberar a leitura
+        if (conexao->aguardandoEscrita || (size_t)lidos < livre) return 0;
+    }
+}
+
+/**
+ * @brief Aceita as conexões pendentes no socket de escuta.
+ */
+static void aceitarConexoes(ThreadServidor* thread){
+    for (int i = 0; i < MAX_ACEITES_POR_EVENTO; i++){
+        int descritor = accept4(thread->contexto->escuta, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (descritor < 0){
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR && errno != ECONNABORTED){
+                printf("[Aviso] Falha ao aceitar conexão: %s\n", strerror(errno));
+            }
+            return;
+        }
+        int ativo = 1;
+        setsockopt(descritor, IPPROTO_TCP, TCP_NODELAY, &ativo, sizeof(ativo));   // Falha em socket Unix (sem efeito)
+
+        ConexaoServidor* conexao = calloc(1, sizeof(ConexaoServidor));
+        if (conexao == NULL){
+            close(descritor);
+            continue;
+        }
+        conexao->descritor = descritor;
+        conexao->thread = thread;
+        struct epoll_event evento = {.events = EPOLLIN, .data.ptr = conexao};
+        if (epoll_ctl(thread->epoll, EPOLL_CTL_ADD, descritor, &evento) != 0){
+            close(descritor);
+            free(conexao);
+            continue;
+        }
+        conexao->proxima = thread->conexoes;
+        if (thread->conexoes != NULL) thread->conexoes->anterior = conexao;
+        thread->conexoes = conexao;
+        somarContador(&thread->conexoesAbertas, 1);
+    }
+}
+
+/**
+ * @brief Laço de eventos de uma thread de atendimento.
+ */
+static void* atenderConexoes(void* argumento){
+    ThreadServidor* thread = argumento;
+    struct epoll_event eventos[MAX_EVENTOS_SERVIDOR];
+    while (servidorAtivo){
+        int total = epoll_wait(thread->epoll, eventos, MAX_EVENTOS_SERVIDOR, ESPERA_EVENTOS_MS);
+        for (int i = 0; i < total; i++){
+            ConexaoServidor* conexao = eventos[i].data.ptr;
+            if (conexao == NULL){
+                aceitarConexoes(thread);
+                continue;
+            }
+            int fechar = (eventos[i].events & (EPOLLERR | EPOLLHUP)) != 0;
+            if (!fechar && (eventos[i].events & EPOLLOUT)) fechar = enviarPendentes(conexao) != 0;
+            if (!fechar && (eventos[i].events & EPOLLIN)) fechar = receberComandos(conexao) != 0;
+            if (fechar) fecharConexao(conexao);
+        }
+    }
+    while (thread->conexoes != NULL) fecharConexao(thread->conexoes);
+    return NULL;
+}
+
+/**
+ * @brief Cria o socket de escuta, TCP em 127.0.0.1 ou Unix.
+ *
+ * @return int Descritor não bloqueante, ou -1 em caso de erro.
+ */
+static int abrirEscuta(int porta, const char* caminhoUnix){
+    int descritor;
+    if (caminhoUnix != NULL){
+        struct sockaddr_un endereco;
+        memset(&endereco, 0, sizeof(endereco));
+        endereco.sun_family = AF_UNIX;
+        if (strlen(caminhoUnix) >= sizeof(endereco.sun_path)){
+            printf("[Erro] Caminho de socket muito longo: '%s'.\n", caminhoUnix);
+            return -1;
+        }
+        strcpy(endereco.sun_path, caminhoUnix);
+        descritor = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (descritor < 0) return -1;
+        unlink(caminhoUnix);
+        if (bind(descritor, (struct sockaddr*)&endereco, sizeof(endereco)) != 0){
+            printf("[Erro] Não foi possível usar o socket '%s': %s\n", caminhoUnix, strerror(errno));
+            close(descritor);
+            return -1;
+        }
+    } else {
+        struct sockaddr_in endereco;
+        memset(&endereco, 0, sizeof(endereco));
+        endereco.sin_family = AF_INET;
+        endereco.sin_port = htons((uint16_t)porta);
+        endereco.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        descritor = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (descritor < 0) return -1;
+        int ativo = 1;
+        setsockopt(descritor, SOL_SOCKET, SO_REUSEADDR, &ativo, sizeof(ativo));
+        if (bind(descritor, (struct sockaddr*)&endereco, sizeof(endereco)) != 0){
+            printf("[Erro] Não foi possível usar a porta %d: %s\n", porta, strerror(errno));
+            close(descritor);
+            return -1;
+        }
+    }
+    if (listen(descritor, SOMAXCONN) != 0){
+        printf("[Erro] Falha ao escutar conexões: %s\n", strerror(errno));
+        close(descritor);
+        return -1;
+    }
+    return descritor;
+}
+
+/**
+ * @brief Soma os contadores de todas as threads.
+ */
+static void somarEstatisticas(ThreadServidor* threads, int numeroThreads, long totais[4]){
+    memset(totais, 0, 4 * sizeof(long));
+    for (int i = 0; i < numeroThreads; i++){
+        totais[0] += lerContador(&threads[i].conexoesAbertas);
+        totais[1] += lerContador(&threads[i].sessoesIniciadas);
+        totais[2] += lerContador(&threads[i].sessoesConcluidas);
+        totais[3] += lerContador(&threads[i].comandos);
+    }
+}
+
+/**
+ * @brief Modo servidor: hospeda sessões de jogo até receber SIGINT ou SIGTERM.
+ *
+ * Opções: --porta N (padrão PORTA_PADRAO_SERVIDOR, só em 127.0.0.1),
+ * --unix CAMINHO (socket Unix no lugar do TCP), --threads N (padrão: número
+ * de núcleos, até THREADS_PADRAO_SERVIDOR), --ranking ARQUIVO (padrão
+ * ARQUIVO_RANKING), --sem-ranking (não grava as pontuações; útil em testes
+ * de carga) e --sem-recarga (não recarrega o banco quando ARQUIVO_CSV muda).
+ *
+ * @param banco Banco de itens, que não é alterado enquanto o servidor roda.
+ * Passa a ser do servidor: é liberado (ou substituído, se o CSV mudar) por ele.
+ * @param argc Quantidade de opções.
+ * @param argv Opções (sem o nome do programa nem a palavra "servidor").
+ * @return int Código de saída do programa.
+ */
+int executarServidor(BancoInformacoes* banco, int argc, char* argv[]){
+    int porta = PORTA_PADRAO_SERVIDOR;
+    const char* caminhoUnix = NULL;
+    const char* arquivoRanking = ARQUIVO_RANKING;
+    int gravarRanking = 1;
+    int recarregar = 1;
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    int numeroThreads = (nucleos < 1) ? 1 : (nucleos > THREADS_PADRAO_SERVIDOR ? THREADS_PADRAO_SERVIDOR : (int)nucleos);
+
+    for (int i = 0; i < argc; i++){
+        int temValor = i + 1 < argc;
+        if (strcmp(argv[i], "--porta") == 0 && temValor){
+            porta = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--unix") == 0 && temValor){
+            caminhoUnix = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && temValor){
+            numeroThreads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--ranking") == 0 && temValor){
+            arquivoRanking = argv[++i];
+        } else if (strcmp(argv[i], "--sem-ranking") == 0){
+            gravarRanking = 0;
+        } else if (strcmp(argv[i], "--sem-recarga") == 0){
+            recarregar = 0;
+        } else {
+            printf("[Erro] Opção inválida: '%s'.\n", argv[i]);
+            printf("Uso: jogo servidor [--porta N | --unix CAMINHO] [--threads N] [--ranking ARQUIVO | --sem-ranking]"
+                   " [--sem-recarga]\n");
+            liberarBanco(banco);
+            return 1;
+        }
+    }
+    if (porta < 1 || porta > 65535 || numeroThreads < 1 || numeroThreads > MAX_THREADS_SERVIDOR){
+        printf("[Erro] Porta (1 a 65535) ou número de threads (1 a %d) inválido.\n", MAX_THREADS_SERVIDOR);
+        liberarBanco(banco);
+        return 1;
+    }
+    if (banco == NULL || itensAtivos(banco) == 0){
+        printf("[Aviso] Não há itens cadastrados para jogar.\n");
+        liberarBanco(banco);
+        return 1;
+    }
+    int totalItens = itensAtivos(banco);
+
+    ContextoServidor contexto;
+    memset(&contexto, 0, sizeof(contexto));
+    contexto.arquivoRanking = arquivoRanking;
+    contexto.recarga = iniciarRecargaBanco(banco, recarregar ? ARQUIVO_CSV : NULL);
+    if (contexto.recarga == NULL){
+        liberarBanco(banco);
+        return 1;
+    }
+    pthread_mutex_init(&contexto.travaRanking, NULL);
+    if (gravarRanking){
+        contexto.ranking = carregarRanking(arquivoRanking);
+        if (contexto.ranking == NULL){
+            encerrarRecargaBanco(contexto.recarga);
+            return 1;
+        }
+    }
+    contexto.escuta = abrirEscuta(porta, caminhoUnix);
+    if (contexto.escuta < 0){
+        liberarRanking(contexto.ranking);
+        encerrarRecargaBanco(contexto.recarga);
+        return 1;
+    }
+
+    struct sigaction acao;
+    memset(&acao, 0, sizeof(acao));
+    acao.sa_handler = pedirEncerramento;
+    sigaction(SIGINT, &acao, NULL);
+    sigaction(SIGTERM, &acao, NULL);
+    signal(SIGPIPE, SIG_IGN);
+    servidorAtivo = 1;
+
+    ThreadServidor* threads = calloc((size_t)numeroThreads, sizeof(ThreadServidor));
+    if (threads == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para o servidor.\n");
+        close(contexto.escuta);
+        liberarRanking(contexto.ranking);
+        encerrarRecargaBanco(contexto.recarga);
+        return 1;
+    }
+    uint64_t semente = sementePadrao();
+    int iniciadas = 0;
+    for (; iniciadas < numeroThreads; iniciadas++){
+        ThreadServidor* thread = &threads[iniciadas];
+        thread->contexto = &contexto;
+        thread->epoll = epoll_create1(EPOLL_CLOEXEC);
+        thread->semente = semente + (uint64_t)iniciadas;
+        thread->versao = adquirirVersaoBanco(contexto.recarga);
+        thread->sorteador = criarSorteador(thread->versao->banco, CATEGORIA_TODAS, thread->semente);
+        struct epoll_event evento = {.events = EPOLLIN | EPOLLEXCLUSIVE, .data.ptr = NULL};
+        if (thread->epoll < 0 || thread->sorteador == NULL
+            || epoll_ctl(thread->epoll, EPOLL_CTL_ADD, contexto.escuta, &evento) != 0
+            || pthread_create(&thread->thread, NULL, atenderConexoes, thread) != 0){
+            printf("[Erro] Não foi possível iniciar a thread %d do servidor.\n", iniciadas + 1);
+            if (thread->epoll >= 0) close(thread->epoll);
+            liberarSorteador(thread->sorteador);
+            liberarVersaoBanco(thread->versao);
+            servidorAtivo = 0;
+            break;
+        }
+    }
+
+    if (servidorAtivo){
+        if (caminhoUnix != NULL) printf("[OK] Servidor no socket '%s'", caminhoUnix);
+        else printf("[OK] Servidor em 127.0.0.1:%d", porta);
+        printf(" com %d thread(s) e %d itens. Ctrl+C encerra.\n", numeroThreads, totalItens);
+        fflush(stdout);
+    }
+
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    double ultimoRelatorio = 0;
+    long ultimos[4] = {0}, totais[4];
+    while (servidorAtivo){
+        struct timespec pausa = {0, ESPERA_EVENTOS_MS * 1000000L};
+        nanosleep(&pausa, NULL);
+        double decorrido = segundosDesde(&inicio);
+        if (decorrido - ultimoRelatorio < INTERVALO_ESTATISTICAS) continue;
+        somarEstatisticas(threads, iniciadas, totais);
+        if (totais[3] != ultimos[3]){
+            double intervalo = decorrido - ultimoRelatorio;
+            printf("[Servidor] %ld conexões | %.0f sessões/s | %.0f comandos/s\n", totais[0],
+                   (double)(totais[2] - ultimos[2]) / intervalo, (double)(totais[3] - ultimos[3]) / intervalo);
+            fflush(stdout);
+        }
+        memcpy(ultimos, totais, sizeof(ultimos));
+        ultimoRelatorio = decorrido;
+    }
+
+    for (int i = 0; i < iniciadas; i++){
+        pthread_join(threads[i].thread, NULL);
+        close(threads[i].epoll);
+        liberarSorteador(threads[i].sorteador);
+        liberarVersaoBanco(threads[i].versao);
+    }
+    double decorrido = segundosDesde(&inicio);
+    somarEstatisticas(threads, iniciadas, totais);
+    printf("\n[OK] Servidor encerrado após %.1f s: %ld sessões iniciadas, %ld concluídas (%.0f/s), %ld comandos.\n",
+           decorrido, totais[1], totais[2], decorrido > 0 ? (double)totais[2] / decorrido : 0.0, totais[3]);
+
+    free(threads);
+    close(contexto.escuta);
+    if (caminhoUnix != NULL) unlink(caminhoUnix);
+    liberarRanking(contexto.ranking);
+    pthread_mutex_destroy(&contexto.travaRanking);
+    encerrarRecargaBanco(contexto.recarga);
+    return iniciadas == numeroThreads ? 0 : 1;
+}
+
+#else
+
+int executarServidor(BancoInformacoes* banco, int argc, char* argv[]){
+    (void)argc; (void)argv;
+    liberarBanco(banco);
+    printf("[Erro] O modo servidor só está disponível no Linux.\n");
+    return 1;
+}
+
+#endif
@@ -0,0 +1,275 @@
+/**
+ * @file sessao.c
+ * @brief Regras de uma sessão de jogo, sem entrada nem saída.
+ *
+ * Uma SessaoJogo guarda os jogadores, o item em jogo e a pontuação da rodada,
+ * e aplica as ações RESPONDER, DICA (revelar letra ou nova dica) e PULAR com as
+ * regras do jogo (PONTOS_ACERTOS, PENALIDADE_LETRA, PENALIDADE_PULAR,
+ * NUM_MAX_TENTATIVAS). As interfaces (console em jogo.c, servidor em
+ * servidor.c e a gráfica em grafica.c) só leem a entrada do jogador, chamam
+ * aplicarAcaoSessao() e mostram o resultado.
+ *
+ * Nenhuma função aloca memória: a sessão fica onde quem chama quiser (pilha,
+ * conexão do servidor, vetor de simulação) e o sorteador é emprestado.
+ *
+ * @date 2025-11-26
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "funcoes.h"
+
+/**
+ * @brief Tamanho em bytes do caractere UTF-8 que começa em 'texto'.
+ *
+ * Conta o primeiro byte e os bytes de continuação (10xxxxxx) que o seguem;
+ * o '\0' final nunca é de continuação.
+ *
+ * @return int 0 se 'texto' está no fim da string; senão 1 a 4.
+ */
+int tamanhoLetra(const char* texto){
+    if (*texto == '\0') return 0;
+    int tamanho = 1;
+    while (((unsigned char)texto[tamanho] & 0xC0) == 0x80) tamanho++;
+    return tamanho;
+}
+
+/**
+ * @brief Revela a próxima letra oculta (sublinhado) na máscara de resposta.
+ *
+ * Esta função percorre a máscara de resposta (@c mascara) e localiza a primeira
+ * ocorrência de um sublinhado ('_') que não corresponde a um espaço (' ')
+ * na resposta original (@c resposta). Ao encontrar, substitui o sublinhado
+ * na máscara pela letra correspondente da resposta, revelando-a ao jogador.
+ *
+ * @param resposta Ponteiro constante para a string que contém a resposta
+ * correta completa (a ser adivinhada).
+ * @param mascara Ponteiro para a string que representa a resposta atual
+ * com letras ocultas (sublinhados). Esta string será modificada.
+ *
+ * @note A função prioriza a revelação de letras na ordem em que aparecem
+ * na string, da esquerda para a direita.
+ * @note Espaços (' ') não são considerados caracteres a serem revelados
+ * (não são substituídos por '_'). Um caractere UTF-8 de vários bytes é
+ * revelado de uma vez.
+ * @note Não imprime nada: quem chama informa o jogador (console, servidor ou
+ * interface gráfica).
+ *
+ * @return int Posição da letra revelada, ou -1 se não havia mais letras ocultas.
+ */
+int revelarLetra(const char* resposta, char* mascara) {
+
+    int len = strlen(resposta);
+    int indice = -1;
+
+    for (int i = 0; i < len; i++){
+        if (resposta[i] != ' ' && mascara[i] == '_') {
+            indice = i;
+            break;
+        }
+    }
+    if (indice != -1){
+        // Revela o caractere inteiro (os bytes de continuação de um caractere UTF-8 acentuado)
+        memcpy(mascara + indice, resposta + indice, (size_t)tamanhoLetra(resposta + indice));
+    }
+    return indice;
+}
+
+/**
+ * @brief Prepara uma sessão de jogo vazia, sem jogadores nem item.
+ *
+ * @param sessao Sessão a ser preparada (qualquer conteúdo anterior é descartado).
+ * @param banco Banco de onde vêm as respostas e dicas.
+ * @param sorteador Sorteador dos itens; pode ser compartilhado por várias sessões
+ * e continua pertencendo a quem chama.
+ * @param nivelMinimo Menor nível de dificuldade sorteado (1 a 5).
+ * @param nivelMaximo Maior nível de dificuldade sorteado (1 a 5).
+ */
+void iniciarSessao(SessaoJogo* sessao, const BancoInformacoes* banco, SorteadorItens* sorteador,
+                   int nivelMinimo, int nivelMaximo){
+    memset(sessao, 0, sizeof(*sessao));
+    sessao->banco = banco;
+    sessao->sorteador = sorteador;
+    sessao->nivelMinimo = nivelMinimo;
+    sessao->nivelMaximo = nivelMaximo;
+    sessao->estado = SESSAO_AGUARDANDO_ITEM;
+    sessao->dicaAtual = 1;
+    sessao->ultimaLetra = -1;
+}
+
+/**
+ * @brief Acrescenta um jogador à sessão, com pontuação zero.
+ *
+ * @param sessao Sessão que ainda não jogou nenhum item.
+ * @param nome Nome do jogador (truncado em TAM_MAX_NOME - 1 caracteres).
+ * @return int Índice do jogador, ou -1 se a sessão já tem MAX_JOGADORES_SESSAO
+ * jogadores ou já começou.
+ */
+int adicionarJogadorSessao(SessaoJogo* sessao, const char* nome){
+    if (sessao->numeroJogadores == MAX_JOGADORES_SESSAO || sessao->itensJogados > 0) return -1;
+    JogadorSessao* jogador = &sessao->jogadores[sessao->numeroJogadores];
+    snprintf(jogador->nome, TAM_MAX_NOME, "%s", nome);
+    jogador->pontuacaoSessao = 0;
+    jogador->tentativasNoItem = 0;
+    return sessao->numeroJogadores++;
+}
+
+/**
+ * @brief Sorteia o próximo item da sessão e devolve as tentativas a todos.
+ *
+ * O item começa valendo PONTOS_ACERTOS, com a primeira dica e com a vez do
+ * primeiro jogador.
+ *
+ * @param sessao Sessão com pelo menos um jogador e sem item em jogo.
+ * @return const Item* Item sorteado, ou NULL se não há itens na faixa de
+ * níveis, se a sessão não tem jogadores ou se o item atual ainda está em jogo.
+ */
+const Item* proximoItemSessao(SessaoJogo* sessao){
+    if (sessao->numeroJogadores == 0 || sessao->estado == SESSAO_EM_JOGO) return NULL;
+    const Item* item = sortearItem(sessao->sorteador, sessao->nivelMinimo, sessao->nivelMaximo);
+    if (item == NULL) return NULL;
+
+    const char* resposta = obterResposta(sessao->banco, item);
+    int tamanho = item->tamResposta;
+    for (int k = 0; k < tamanho; k++){
+        sessao->mascara[k] = (resposta[k] == ' ') ? ' ' : '_';
+    }
+    sessao->mascara[tamanho] = '\0';
+    for (int i = 0; i < sessao->numeroJogadores; i++){
+        sessao->jogadores[i].tentativasNoItem = NUM_MAX_TENTATIVAS;
+    }
+    sessao->item = item;
+    sessao->estado = SESSAO_EM_JOGO;
+    sessao->dicaAtual = 1;
+    sessao->dicaMostrada = 0;
+    sessao->pontuacaoRodada = PONTOS_ACERTOS;
+    sessao->jogadorAtual = 0;
+    sessao->itemAdivinhado = 0;
+    sessao->errosUltimoAcerto = 0;
+    sessao->ultimaLetra = -1;
+    sessao->itensJogados++;
+    return item;
+}
+
+/**
+ * @brief Passa a vez ao próximo jogador com tentativas; sem nenhum, encerra o item.
+ */
+static void passarVez(SessaoJogo* sessao){
+    for (int passo = 1; passo <= sessao->numeroJogadores; passo++){
+        int indice = (sessao->jogadorAtual + passo) % sessao->numeroJogadores;
+        if (sessao->jogadores[indice].tentativasNoItem > 0){
+            sessao->jogadorAtual = indice;
+            return;
+        }
+    }
+    sessao->estado = SESSAO_ITEM_ENCERRADO;
+}
+
+/**
+ * @brief Aplica a ação do jogador da vez.
+ *
+ * - RESPONDER: se avaliarChavePalpite() aceitar o palpite, o jogador ganha
+ *   pontuacaoRodada e o item termina; senão ele perde uma tentativa e a
+ *   próxima dica é liberada.
+ * - REVELAR_LETRA: revela uma letra, tira PENALIDADE_LETRA do valor do item e
+ *   uma tentativa do jogador.
+ * - NOVA_DICA: libera a próxima dica.
+ * - PULAR: tira PENALIDADE_PULAR do total do jogador.
+ *
+ * Exceto no acerto, a vez passa ao próximo jogador com tentativas; quando
+ * ninguém mais tem tentativas, o item termina sem acerto.
+ *
+ * @param sessao Sessão com um item em jogo.
+ * @param acao Ação escolhida pelo jogador da vez.
+ * @param palpite Palpite (só para ACAO_RESPONDER; NULL é tratado como vazio).
+ * @return ResultadoAcao O que aconteceu, para a interface informar o jogador.
+ */
+ResultadoAcao aplicarAcaoSessao(SessaoJogo* sessao, AcaoJogador acao, const char* palpite){
+    if (sessao->estado != SESSAO_EM_JOGO) return RESULTADO_INVALIDO;
+    JogadorSessao* jogador = &sessao->jogadores[sessao->jogadorAtual];
+    const char* resposta = obterResposta(sessao->banco, sessao->item);
+    ResultadoAcao resultado;
+
+    switch (acao){
+    case ACAO_RESPONDER: {
+        // Só o palpite é normalizado: a chave da resposta já está guardada no banco
+        char chavePalpite[TAM_MAX_RESPOSTA];
+        size_t tamPalpite = (palpite != NULL) ? normalizarResposta(palpite, strlen(palpite), chavePalpite,
+                                                                   sizeof(chavePalpite)) : 0;
+        int erros = avaliarChavePalpite(chavePalpite, tamPalpite, obterChaveResposta(sessao->banco, sessao->item),
+                                        sessao->item->tamChave);
+        if (erros >= 0){
+            jogador->pontuacaoSessao += sessao->pontuacaoRodada;
+            sessao->errosUltimoAcerto = erros;
+            sessao->itemAdivinhado = 1;
+            sessao->estado = SESSAO_ITEM_ENCERRADO;
+            return RESULTADO_ACERTOU;
+        }
+        jogador->tentativasNoItem--;
+        if (sessao->dicaAtual < MAX_DICAS) sessao->dicaAtual++;
+        resultado = RESULTADO_ERROU;
+        break;
+    }
+    case ACAO_REVELAR_LETRA:
+        sessao->ultimaLetra = revelarLetra(resposta, sessao->mascara);
+        sessao->pontuacaoRodada -= PENALIDADE_LETRA;
+        if (sessao->pontuacaoRodada < 0) sessao->pontuacaoRodada = 0;
+        jogador->tentativasNoItem--;
+        resultado = (sessao->ultimaLetra >= 0) ? RESULTADO_LETRA_REVELADA : RESULTADO_SEM_LETRAS;
+        break;
+    case ACAO_NOVA_DICA:
+        if (sessao->dicaAtual < MAX_DICAS){
+            sessao->dicaAtual++;
+            resultado = RESULTADO_DICA_LIBERADA;
+        } else {
+            resultado = RESULTADO_SEM_DICAS;
+        }
+        break;
+    case ACAO_PULAR:
+        jogador->pontuacaoSessao -= PENALIDADE_PULAR;
+        resultado = RESULTADO_PULOU;
+        break;
+    default:
+        return RESULTADO_INVALIDO;
+    }
+    passarVez(sessao);
+    return resultado;
+}
+
+/**
+ * @brief Jogador da vez (ou o que acertou, depois de RESULTADO_ACERTOU).
+ *
+ * @return const JogadorSessao* NULL se a sessão não tem jogadores.
+ */
+const JogadorSessao* jogadorDaVez(const SessaoJogo* sessao){
+    if (sessao->numeroJogadores == 0) return NULL;
+    return &sessao->jogadores[sessao->jogadorAtual];
+}
+
+/**
+ * @brief Texto da dica em vigor (SessaoJogo::dicaAtual) do item.
+ *
+ * A dica é copiada (e decodificada, se o banco guarda as dicas compactadas)
+ * para SessaoJogo::dica só quando alguém vai mostrá-la; quem nunca mostra as
+ * dicas, como os robôs da simulação, não paga por isso.
+ *
+ * @return const char* Texto da dica, válido até a próxima chamada; "" antes do primeiro item.
+ */
+const char* dicaAtualSessao(SessaoJogo* sessao){
+    if (sessao->item == NULL) return "";
+    if (sessao->dicaMostrada != sessao->dicaAtual){
+        copiarDica(sessao->banco, sessao->item, sessao->dicaAtual, sessao->dica, sizeof(sessao->dica));
+        sessao->dicaMostrada = sessao->dicaAtual;
+    }
+    return sessao->dica;
+}
+
+/**
+ * @brief Resposta do item em jogo, ou do último jogado.
+ *
+ * @return const char* Resposta, ou "" antes do primeiro item.
+ */
+const char* respostaSessao(const SessaoJogo* sessao){
+    if (sessao->item == NULL) return "";
+    return obterResposta(sessao->banco, sessao->item);
+}
@@ -0,0 +1,420 @@
+/**
+ * @file simulacao.c
+ * @brief Simulação sem interface: sessões de jogadores-robô para medir vazão e latência.
+ *
+ * Iniciada com "jogo simular [opções]". Joga N sessões com o banco carregado,
+ * direto sobre a SessaoJogo (sessao.c), repartidas entre várias threads, e
+ * informa turnos por segundo, percentis de latência de cada ação e a
+ * distribuição das pontuações finais por estratégia de robô:
+ *
+ * - chute-cedo: responde logo na primeira vez;
+ * - todas-dicas: libera todas as dicas antes de responder;
+ * - revelar-letras: revela letras até metade da resposta e então responde;
+ * - pular: pula a vez (até 2 vezes por item) enquanto não sabe a resposta;
+ * - misto: cada jogador da sessão usa uma estratégia diferente.
+ *
+ * Um robô "sabe" a resposta com uma chance que cresce com as dicas liberadas e
+ * as letras reveladas; quando sabe, às vezes a digita com um erro (o que passa
+ * pela comparação tolerante de palpites).
+ *
+ * Resultados reproduzíveis: a sessão i usa um gerador iniciado com semente + i
+ * e a thread t joga as sessões t, t + T, t + 2T... com um sorteador de itens
+ * próprio, reiniciado a cada sessão com uma semente tirada de (semente, i)
+ * (reiniciarSorteador()). Com a mesma semente e o mesmo banco, as pontuações e
+ * a assinatura final são sempre as mesmas, com qualquer número de threads; só
+ * os tempos mudam.
+ *
+ * A latência de cada ação é guardada em um histograma logarítmico (8 faixas
+ * por potência de 2, erro de no máximo 12,5%), que não cresce com o número de
+ * turnos e é somado entre as threads no final.
+ *
+ * @date 2025-11-26
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include "funcoes.h"
+
+#define MAX_THREADS_SIMULACAO 64
+#define NUM_ACOES 4                     // Valores de AcaoJogador
+#define BITS_FAIXA_LATENCIA 3           // 2^3 faixas por potência de 2
+#define NUM_FAIXAS_LATENCIA (64 << BITS_FAIXA_LATENCIA)
+#define MAX_PULOS_POR_ITEM 2            // Estratégia "pular": depois disto o robô responde
+#define CHANCE_ERRO_DIGITACAO 25        // % dos palpites certos digitados com um erro
+
+typedef enum {ROBO_CHUTE_CEDO, ROBO_TODAS_DICAS, ROBO_REVELAR_LETRAS, ROBO_PULAR, NUM_ESTRATEGIAS}EstrategiaRobo;
+#define ESTRATEGIA_MISTA NUM_ESTRATEGIAS
+
+static const char* nomesEstrategias[NUM_ESTRATEGIAS] = {"chute-cedo", "todas-dicas", "revelar-letras", "pular"};
+static const char* nomesAcoes[NUM_ACOES] = {"RESPONDER", "REVELAR_LETRA", "NOVA_DICA", "PULAR"};
+
+/**
+ * @brief Contagem de latências por faixa logarítmica.
+ */
+typedef struct{
+    uint64_t faixas[NUM_FAIXAS_LATENCIA];
+    uint64_t total;
+}HistogramaLatencia;
+
+/**
+ * @brief Pontuações finais dos robôs de uma estratégia.
+ */
+typedef struct{
+    int *valores;
+    size_t total;
+    size_t capacidade;
+    long acertos;                       // Itens acertados por robôs desta estratégia
+}PontuacoesEstrategia;
+
+/**
+ * @brief Parâmetros da simulação, compartilhados (só leitura) pelas threads.
+ */
+typedef struct{
+    const BancoInformacoes *banco;
+    long sessoes;
+    int rodadas;
+    int jogadores;
+    int estrategia;                     // EstrategiaRobo ou ESTRATEGIA_MISTA
+    int nivelMinimo;
+    int nivelMaximo;
+    int categoria;                      // Identificador da categoria sorteada, ou CATEGORIA_TODAS
+    int threads;
+    uint64_t semente;
+}ParametrosSimulacao;
+
+/**
+ * @brief Uma thread da simulação e o que ela mediu.
+ */
+typedef struct{
+    pthread_t thread;
+    const ParametrosSimulacao *parametros;
+    int indice;
+    int falhou;
+    long turnos;
+    long itens;
+    uint64_t assinatura;                // Soma dos hashes de cada sessão (independe da ordem)
+    HistogramaLatencia latencias[NUM_ACOES];
+    PontuacoesEstrategia pontuacoes[NUM_ESTRATEGIAS];
+}ThreadSimulacao;
+
+/**
+ * @brief Faixa do histograma de uma latência: 3 bits de mantissa por expoente.
+ */
+static int faixaLatencia(uint64_t nanossegundos){
+    if (nanossegundos < (1u << BITS_FAIXA_LATENCIA)) return (int)nanossegundos;
+    int expoente = 63 - __builtin_clzll(nanossegundos);
+    int mantissa = (int)((nanossegundos >> (expoente - BITS_FAIXA_LATENCIA)) & ((1u << BITS_FAIXA_LATENCIA) - 1));
+    return ((expoente - BITS_FAIXA_LATENCIA + 1) << BITS_FAIXA_LATENCIA) + mantissa;
+}
+
+/**
+ * @brief Maior latência que cai em uma faixa do histograma.
+ */
+static uint64_t limiteFaixa(int faixa){
+    if (faixa < (1 << BITS_FAIXA_LATENCIA)) return (uint64_t)faixa;
+    int expoente = (faixa >> BITS_FAIXA_LATENCIA) + BITS_FAIXA_LATENCIA - 1;
+    uint64_t mantissa = (uint64_t)(faixa & ((1 << BITS_FAIXA_LATENCIA) - 1)) + (1u << BITS_FAIXA_LATENCIA);
+    return ((mantissa + 1) << (expoente - BITS_FAIXA_LATENCIA)) - 1;
+}
+
+/**
+ * @brief Latência no percentil pedido (limite superior da faixa correspondente).
+ */
+static uint64_t percentilHistograma(const HistogramaLatencia* histograma, double fracao){
+    if (histograma->total == 0) return 0;
+    uint64_t alvo = (uint64_t)(fracao * (double)(histograma->total - 1)) + 1;
+    uint64_t acumulado = 0;
+    for (int f = 0; f < NUM_FAIXAS_LATENCIA; f++){
+        acumulado += histograma->faixas[f];
+        if (acumulado >= alvo) return limiteFaixa(f);
+    }
+    return limiteFaixa(NUM_FAIXAS_LATENCIA - 1);
+}
+
+static int guardarPontuacao(PontuacoesEstrategia* pontuacoes, int valor){
+    if (pontuacoes->total == pontuacoes->capacidade){
+        size_t capacidade = pontuacoes->capacidade ? pontuacoes->capacidade * 2 : 1024;
+        int* valores = realloc(pontuacoes->valores, capacidade * sizeof(int));
+        if (valores == NULL) return -1;
+        pontuacoes->valores = valores;
+        pontuacoes->capacidade = capacidade;
+    }
+    pontuacoes->valores[pontuacoes->total++] = valor;
+    return 0;
+}
+
+static uint64_t nanossegundosAgora(void){
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    return (uint64_t)agora.tv_sec * 1000000000ULL + (uint64_t)agora.tv_nsec;
+}
+
+/**
+ * @brief Decide se o robô sabe a resposta nesta vez.
+ *
+ * A chance começa em 15% e cresce 15 pontos por dica liberada e até 60 pontos
+ * conforme as letras reveladas, com teto de 95%.
+ */
+static int roboSabe(const SessaoJogo* sessao, GeradorAleatorio* gerador){
+    int letras = 0, ocultas = 0;
+    for (const char* c = sessao->mascara; *c != '\0'; c++){
+        if (*c == ' ') continue;
+        letras++;
+        if (*c == '_') ocultas++;
+    }
+    uint32_t chance = 15 + 15 * (uint32_t)(sessao->dicaAtual - 1);
+    if (letras > 0) chance += (uint32_t)(60 * (letras - ocultas) / letras);
+    if (chance > 95) chance = 95;
+    return aleatorioAte(gerador, 100) < chance;
+}
+
+/**
+ * @brief Escolhe a ação do robô da vez e, se for responder, monta o palpite.
+ */
+static AcaoJogador decidirAcao(EstrategiaRobo estrategia, const SessaoJogo* sessao, GeradorAleatorio* gerador,
+                               int pulosNoItem, char palpite[TAM_MAX_RESPOSTA]){
+    const JogadorSessao* jogador = jogadorDaVez(sessao);
+    int letras = 0, ocultas = 0;
+    for (const char* c = sessao->mascara; *c != '\0'; c++){
+        if (*c == ' ') continue;
+        letras++;
+        if (*c == '_') ocultas++;
+    }
+
+    if (estrategia == ROBO_TODAS_DICAS && sessao->dicaAtual < MAX_DICAS) return ACAO_NOVA_DICA;
+    if (estrategia == ROBO_REVELAR_LETRAS && ocultas * 2 > letras && jogador->tentativasNoItem > 1) return ACAO_REVELAR_LETRA;
+
+    int sabe = roboSabe(sessao, gerador);
+    if (estrategia == ROBO_PULAR && !sabe && pulosNoItem < MAX_PULOS_POR_ITEM) return ACAO_PULAR;
+
+    if (!sabe){
+        snprintf(palpite, TAM_MAX_RESPOSTA, "nao sei");
+        return ACAO_RESPONDER;
+    }
+    snprintf(palpite, TAM_MAX_RESPOSTA, "%s", respostaSessao(sessao));
+    size_t tamanho = strlen(palpite);
+    if (tamanho > 0 && aleatorioAte(gerador, 100) < CHANCE_ERRO_DIGITACAO){
+        size_t posicao = aleatorioAte(gerador, (uint32_t)tamanho);
+        palpite[posicao] = (palpite[posicao] == 'x') ? 'y' : 'x';
+    }
+    return ACAO_RESPONDER;
+}
+
+/**
+ * @brief Joga as sessões da thread e acumula as medidas.
+ */
+static void* simularSessoes(void* argumento){
+    ThreadSimulacao* thread = argumento;
+    const ParametrosSimulacao* parametros = thread->parametros;
+    SorteadorItens* sorteador = criarSorteador(parametros->banco, parametros->categoria, parametros->semente);
+    if (sorteador == NULL){
+        thread->falhou = 1;
+        return NULL;
+    }
+
+    SessaoJogo sessao;
+    char palpite[TAM_MAX_RESPOSTA];
+    char nome[TAM_MAX_NOME];
+    for (long s = thread->indice; s < parametros->sessoes; s += parametros->threads){
+        GeradorAleatorio gerador;
+        iniciarGerador(&gerador, parametros->semente + (uint64_t)s);
+        // Os itens da sessão dependem só de (semente, s), e não das sessões que a thread jogou antes
+        if (reiniciarSorteador(sorteador, parametros->semente ^ (0x9e3779b97f4a7c15ULL * (uint64_t)(s + 1))) != 0){
+            thread->falhou = 1;
+            break;
+        }
+        iniciarSessao(&sessao, parametros->banco, sorteador, parametros->nivelMinimo, parametros->nivelMaximo);
+        EstrategiaRobo estrategias[MAX_JOGADORES_SESSAO];
+        for (int j = 0; j < parametros->jogadores; j++){
+            estrategias[j] = (parametros->estrategia == ESTRATEGIA_MISTA)
+                             ? (EstrategiaRobo)((s + j) % NUM_ESTRATEGIAS) : (EstrategiaRobo)parametros->estrategia;
+            snprintf(nome, sizeof(nome), "robo%d", j + 1);
+            adicionarJogadorSessao(&sessao, nome);
+        }
+
+        for (int r = 0; r < parametros->rodadas; r++){
+            if (proximoItemSessao(&sessao) == NULL) break;
+            int pulos[MAX_JOGADORES_SESSAO] = {0};
+            thread->itens++;
+            while (sessao.estado == SESSAO_EM_JOGO){
+                int vez = sessao.jogadorAtual;
+                AcaoJogador acao = decidirAcao(estrategias[vez], &sessao, &gerador, pulos[vez], palpite);
+                uint64_t inicio = nanossegundosAgora();
+                ResultadoAcao resultado = aplicarAcaoSessao(&sessao, acao, palpite);
+                uint64_t duracao = nanossegundosAgora() - inicio;
+
+                HistogramaLatencia* histograma = &thread->latencias[acao];
+                histograma->faixas[faixaLatencia(duracao)]++;
+                histograma->total++;
+                thread->turnos++;
+                if (resultado == RESULTADO_PULOU) pulos[vez]++;
+                if (resultado == RESULTADO_ACERTOU) thread->pontuacoes[estrategias[vez]].acertos++;
+            }
+        }
+
+        uint64_t hashSessao = atualizarChecksum(CHECKSUM_INICIAL, &s, sizeof(s));
+        for (int j = 0; j < sessao.numeroJogadores; j++){
+            int pontos = sessao.jogadores[j].pontuacaoSessao;
+            hashSessao = atualizarChecksum(hashSessao, &pontos, sizeof(pontos));
+            if (guardarPontuacao(&thread->pontuacoes[estrategias[j]], pontos) != 0) thread->falhou = 1;
+        }
+        thread->assinatura += hashSessao;
+    }
+    liberarSorteador(sorteador);
+    return NULL;
+}
+
+static int compararInteiros(const void* a, const void* b){
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Simulação sem interface: joga sessões de robôs e informa vazão, latência e pontuações.
+ *
+ * Opções: --sessoes N (padrão 100000), --rodadas N (itens por sessão, padrão 3),
+ * --jogadores N (padrão 2), --estrategia chute-cedo|todas-dicas|revelar-letras|pular|misto
+ * (padrão misto), --nivel N (0 = todos), --categoria NOME (padrão: todas),
+ * --threads N (padrão 4) e --semente N (padrão: sementePadrao()).
+ *
+ * @param banco Banco com os itens; não é alterado.
+ * @param argc Quantidade de opções.
+ * @param argv Opções (sem o nome do programa nem a palavra "simular").
+ * @return int Código de saída do programa.
+ */
+int executarSimulacao(const BancoInformacoes* banco, int argc, char* argv[]){
+    ParametrosSimulacao parametros;
+    memset(&parametros, 0, sizeof(parametros));
+    parametros.banco = banco;
+    parametros.sessoes = 100000;
+    parametros.rodadas = 3;
+    parametros.jogadores = 2;
+    parametros.estrategia = ESTRATEGIA_MISTA;
+    parametros.threads = 4;
+    parametros.semente = sementePadrao();
+    int nivel = 0;
+    const char* nomeCategoria = NULL;
+
+    for (int i = 0; i < argc; i++){
+        int temValor = i + 1 < argc;
+        if (strcmp(argv[i], "--sessoes") == 0 && temValor) parametros.sessoes = atol(argv[++i]);
+        else if (strcmp(argv[i], "--rodadas") == 0 && temValor) parametros.rodadas = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--jogadores") == 0 && temValor) parametros.jogadores = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--nivel") == 0 && temValor) nivel = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--categoria") == 0 && temValor) nomeCategoria = argv[++i];
+        else if (strcmp(argv[i], "--threads") == 0 && temValor) parametros.threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--semente") == 0 && temValor) parametros.semente = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--estrategia") == 0 && temValor){
+            const char* nome = argv[++i];
+            parametros.estrategia = -1;
+            if (strcmp(nome, "misto") == 0) parametros.estrategia = ESTRATEGIA_MISTA;
+            for (int e = 0; e < NUM_ESTRATEGIAS; e++){
+                if (strcmp(nome, nomesEstrategias[e]) == 0) parametros.estrategia = e;
+            }
+            if (parametros.estrategia < 0){
+                printf("[Erro] Estratégia desconhecida: '%s'.\n", nome);
+                return 1;
+            }
+        } else {
+            printf("[Erro] Opção inválida: '%s'.\n", argv[i]);
+            printf("Uso: jogo simular [--sessoes N] [--rodadas N] [--jogadores N] [--nivel N] [--categoria NOME] [--threads N]"
+                   " [--semente N] [--estrategia chute-cedo|todas-dicas|revelar-letras|pular|misto]\n");
+            return 1;
+        }
+    }
+    if (parametros.sessoes < 1 || parametros.rodadas < 1 || parametros.jogadores < 1
+        || parametros.jogadores > MAX_JOGADORES_SESSAO || nivel < 0 || nivel > MUITODIFICIL
+        || parametros.threads < 1 || parametros.threads > MAX_THREADS_SIMULACAO){
+        printf("[Erro] Parâmetros da simulação inválidos.\n");
+        return 1;
+    }
+    if (banco == NULL || itensAtivos(banco) == 0){
+        printf("[Aviso] Não há itens cadastrados para jogar.\n");
+        return 1;
+    }
+    parametros.nivelMinimo = (nivel == 0) ? MUITOFACIL : nivel;
+    parametros.nivelMaximo = (nivel == 0) ? MUITODIFICIL : nivel;
+    parametros.categoria = CATEGORIA_TODAS;
+    if (nomeCategoria != NULL && (parametros.categoria = buscarCategoria(banco, nomeCategoria)) < 0){
+        printf("[Erro] Categoria desconhecida: '%s'.\n", nomeCategoria);
+        return 1;
+    }
+
+    ThreadSimulacao* threads = calloc((size_t)parametros.threads, sizeof(ThreadSimulacao));
+    if (threads == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para a simulação.\n");
+        return 1;
+    }
+    printf("Simulação: %ld sessões de %d rodada(s), %d jogador(es), estratégia %s, %d thread(s), semente %llu\n",
+           parametros.sessoes, parametros.rodadas, parametros.jogadores,
+           parametros.estrategia == ESTRATEGIA_MISTA ? "misto" : nomesEstrategias[parametros.estrategia],
+           parametros.threads, (unsigned long long)parametros.semente);
+    fflush(stdout);
+
+    uint64_t inicio = nanossegundosAgora();
+    int iniciadas = 0;
+    for (; iniciadas < parametros.threads; iniciadas++){
+        threads[iniciadas].parametros = &parametros;
+        threads[iniciadas].indice = iniciadas;
+        if (pthread_create(&threads[iniciadas].thread, NULL, simularSessoes, &threads[iniciadas]) != 0) break;
+    }
+    for (int i = 0; i < iniciadas; i++){
+        pthread_join(threads[i].thread, NULL);
+    }
+    double segundos = (double)(nanossegundosAgora() - inicio) / 1e9;
+
+    // Junta as medidas de todas as threads na primeira
+    ThreadSimulacao* total = &threads[0];
+    int falhou = iniciadas < parametros.threads || total->falhou;
+    for (int i = 1; i < iniciadas; i++){
+        falhou |= threads[i].falhou;
+        total->turnos += threads[i].turnos;
+        total->itens += threads[i].itens;
+        total->assinatura += threads[i].assinatura;
+        for (int a = 0; a < NUM_ACOES; a++){
+            for (int f = 0; f < NUM_FAIXAS_LATENCIA; f++) total->latencias[a].faixas[f] += threads[i].latencias[a].faixas[f];
+            total->latencias[a].total += threads[i].latencias[a].total;
+        }
+        for (int e = 0; e < NUM_ESTRATEGIAS; e++){
+            PontuacoesEstrategia* origem = &threads[i].pontuacoes[e];
+            total->pontuacoes[e].acertos += origem->acertos;
+            for (size_t k = 0; k < origem->total; k++){
+                if (guardarPontuacao(&total->pontuacoes[e], origem->valores[k]) != 0) falhou = 1;
+            }
+            free(origem->valores);
+        }
+    }
+
+    printf("[OK] %ld turnos em %.2f s: %.0f turnos/s | %ld itens jogados\n",
+           total->turnos, segundos, segundos > 0 ? (double)total->turnos / segundos : 0.0, total->itens);
+    printf("\nLatência por ação (ns)      p50        p90        p99        máx   chamadas\n");
+    for (int a = 0; a < NUM_ACOES; a++){
+        const HistogramaLatencia* histograma = &total->latencias[a];
+        if (histograma->total == 0) continue;
+        printf("  %-16s %10llu %10llu %10llu %10llu %10llu\n", nomesAcoes[a],
+               (unsigned long long)percentilHistograma(histograma, 0.50), (unsigned long long)percentilHistograma(histograma, 0.90),
+               (unsigned long long)percentilHistograma(histograma, 0.99), (unsigned long long)percentilHistograma(histograma, 1.0),
+               (unsigned long long)histograma->total);
+    }
+    printf("\nPontuação final       robôs    média    mín    p10    p50    p90    máx   acertos\n");
+    for (int e = 0; e < NUM_ESTRATEGIAS; e++){
+        PontuacoesEstrategia* pontuacoes = &total->pontuacoes[e];
+        if (pontuacoes->total == 0) continue;
+        qsort(pontuacoes->valores, pontuacoes->total, sizeof(int), compararInteiros);
+        long long soma = 0;
+        for (size_t k = 0; k < pontuacoes->total; k++) soma += pontuacoes->valores[k];
+        size_t ultimo = pontuacoes->total - 1;
+        printf("  %-16s %9zu %8.1f %6d %6d %6d %6d %6d %9ld\n", nomesEstrategias[e], pontuacoes->total,
+               (double)soma / (double)pontuacoes->total, pontuacoes->valores[0],
+               pontuacoes->valores[(size_t)(0.1 * (double)ultimo)], pontuacoes->valores[(size_t)(0.5 * (double)ultimo)],
+               pontuacoes->valores[(size_t)(0.9 * (double)ultimo)], pontuacoes->valores[ultimo], pontuacoes->acertos);
+        free(pontuacoes->valores);
+    }
+    printf("\nAssinatura dos resultados: %016llx\n", (unsigned long long)total->assinatura);
+    if (falhou) printf("[Aviso] A simulação não terminou por falta de memória ou de threads.\n");
+    free(threads);
+    return falhou ? 1 : 0;
+}
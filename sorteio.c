@@ -0,0 +1,340 @@
+/**
+ * @file sorteio.c
+ * @brief Sorteio de itens sem repetição, por nível de dificuldade, com gerador reproduzível.
+ *
+ * Cada sessão de jogo cria o seu SorteadorItens. Ele separa os itens do banco em
+ * uma "sacola" por nível de dificuldade e sorteia sem reposição: um item só volta
+ * a sair depois que todos os outros da faixa pedida já saíram. Cada sorteio custa
+ * O(1): escolhe-se uma posição entre as restantes e ela é trocada com a última.
+ * Itens excluídos do banco depois de montadas as sacolas saem delas quando
+ * sorteados; depois de uma compactação (posições novas) as sacolas são remontadas.
+ *
+ * Um sorteador pode ficar restrito a uma categoria. Nesse caso as sacolas são
+ * copiadas dos trechos (categoria, nível) do índice composto do banco
+ * (IndiceCategorias), sem varrer os itens: montar o sorteador de uma
+ * categoria custa o tamanho dela, e não o do banco.
+ *
+ * Os números aleatórios vêm do xoshiro256** (Blackman e Vigna), iniciado a partir
+ * de uma semente de 64 bits com o splitmix64. Com a mesma semente e o mesmo banco,
+ * a sequência de itens é sempre a mesma, o que permite repetir partidas e testes.
+ *
+ * @date 2025-11-26
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "funcoes.h"
+
+/**
+ * @brief Próximo valor da sequência splitmix64 (usada só para gerar o estado inicial).
+ */
+static uint64_t splitmix64(uint64_t* estado){
+    uint64_t z = (*estado += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Rotação à esquerda de 64 bits.
+ */
+static uint64_t rotacionar(uint64_t x, int k){
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * @brief Inicia o gerador a partir de uma semente; sementes iguais dão sequências iguais.
+ *
+ * @param gerador Gerador a ser iniciado.
+ * @param semente Qualquer valor de 64 bits (inclusive 0).
+ */
+void iniciarGerador(GeradorAleatorio* gerador, uint64_t semente){
+    for (int i = 0; i < 4; i++){
+        gerador->estado[i] = splitmix64(&semente);
+    }
+}
+
+/**
+ * @brief Gera o próximo número pseudoaleatório de 64 bits (xoshiro256**).
+ */
+uint64_t proximoAleatorio(GeradorAleatorio* gerador){
+    uint64_t* s = gerador->estado;
+    uint64_t resultado = rotacionar(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotacionar(s[3], 45);
+    return resultado;
+}
+
+/**
+ * @brief Sorteia um inteiro uniforme em [0, limite), sem o viés do operador %.
+ *
+ * Usa o método de multiplicação de Lemire: na grande maioria das chamadas
+ * basta uma multiplicação, sem divisão.
+ *
+ * @param gerador Gerador a ser usado.
+ * @param limite Limite superior (exclusivo); deve ser maior que zero.
+ */
+uint32_t aleatorioAte(GeradorAleatorio* gerador, uint32_t limite){
+    uint64_t produto = (proximoAleatorio(gerador) >> 32) * (uint64_t)limite;
+    uint32_t resto = (uint32_t)produto;
+    if (resto < limite){
+        uint32_t minimo = (uint32_t)(-limite) % limite;
+        while (resto < minimo){
+            produto = (proximoAleatorio(gerador) >> 32) * (uint64_t)limite;
+            resto = (uint32_t)produto;
+        }
+    }
+    return (uint32_t)(produto >> 32);
+}
+
+/**
+ * @brief Semente padrão das sessões.
+ *
+ * Se a variável de ambiente PERFIL_SEMENTE estiver definida, ela é usada (para
+ * repetir uma partida); senão a semente é derivada do relógio.
+ *
+ * @return uint64_t Semente a ser passada para criarSorteador().
+ */
+uint64_t sementePadrao(void){
+    const char* valor = getenv("PERFIL_SEMENTE");
+    if (valor != NULL && *valor != '\0'){
+        return strtoull(valor, NULL, 10);
+    }
+    uint64_t semente = (uint64_t)time(NULL) ^ ((uint64_t)clock() << 32);
+    return splitmix64(&semente);
+}
+
+/**
+ * @brief Diz se o item da posição i pode entrar nas sacolas do sorteador (varredura sem índice).
+ */
+static int itemDaSacola(const SorteadorItens* sorteador, int i){
+    const BancoInformacoes* banco = sorteador->banco;
+    int nivel = banco->itens[i].nivel;
+    if (banco->itens[i].marcas & ITEM_EXCLUIDO) return 0;
+    if (nivel < MUITOFACIL || nivel > MUITODIFICIL) return 0;
+    return sorteador->categoria == CATEGORIA_TODAS || banco->dicas[i].categoria == sorteador->categoria;
+}
+
+/**
+ * @brief (Re)monta as sacolas com os itens não excluídos do banco, por nível.
+ *
+ * Para uma categoria com trechos no índice composto do banco, as sacolas são
+ * cópias desses trechos; sem o índice (ou para todas as categorias), o banco é varrido.
+ *
+ * @return int 0 em caso de sucesso, -1 se faltar memória.
+ */
+static int montarSacolas(SorteadorItens* sorteador){
+    const BancoInformacoes* banco = sorteador->banco;
+    const IndiceCategorias* indice = &banco->indiceCategorias;
+    const uint32_t* inicios = NULL;
+    if (sorteador->categoria != CATEGORIA_TODAS && indice->posicoes != NULL &&
+        (uint32_t)sorteador->categoria < indice->totalCategorias){
+        inicios = indice->inicios + (size_t)sorteador->categoria * NUM_NIVEIS;
+    }
+    int contagem[NUM_NIVEIS] = {0};
+    if (inicios != NULL){
+        for (int n = 0; n < NUM_NIVEIS; n++) contagem[n] = (int)(inicios[n + 1] - inicios[n]);
+    } else {
+        for (int i = 0; i < banco->totalItens; i++){
+            if (itemDaSacola(sorteador, i)) contagem[banco->itens[i].nivel - 1]++;
+        }
+    }
+    for (int n = 0; n < NUM_NIVEIS; n++){
+        SacolaNivel* sacola = &sorteador->sacolas[n];
+        int32_t* itens = realloc(sacola->itens, ((size_t)contagem[n] + 1) * sizeof(int32_t));
+        if (itens == NULL){
+            printf("[Erro] Houve um erro na alocação de memória para o sorteador.\n");
+            return -1;
+        }
+        sacola->itens = itens;
+        sacola->total = 0;
+    }
+    if (inicios != NULL){
+        for (int n = 0; n < NUM_NIVEIS; n++){
+            memcpy(sorteador->sacolas[n].itens, indice->posicoes + inicios[n], (size_t)contagem[n] * sizeof(int32_t));
+            sorteador->sacolas[n].total = contagem[n];
+        }
+    } else {
+        for (int i = 0; i < banco->totalItens; i++){
+            if (!itemDaSacola(sorteador, i)) continue;
+            SacolaNivel* sacola = &sorteador->sacolas[banco->itens[i].nivel - 1];
+            sacola->itens[sacola->total++] = i;
+        }
+    }
+    for (int n = 0; n < NUM_NIVEIS; n++){
+        sorteador->sacolas[n].restantes = sorteador->sacolas[n].total;
+    }
+    sorteador->ultimoSorteado = -1;
+    sorteador->geracao = banco->geracao;
+    sorteador->totalSorteados = 0;
+    return 0;
+}
+
+/**
+ * @brief Cria um sorteador para um banco, separando os itens por nível.
+ *
+ * @param banco Banco de onde os itens serão sorteados. Itens podem ser
+ * excluídos durante o uso; inserções só passam a ser sorteadas depois da
+ * próxima compactação do banco.
+ * @param categoria Identificador da categoria sorteada (ver buscarCategoria()),
+ * ou CATEGORIA_TODAS.
+ * @param semente Semente do gerador (ver sementePadrao()).
+ * @return SorteadorItens* Sorteador pronto, ou NULL em caso de falha de memória.
+ */
+SorteadorItens* criarSorteador(const BancoInformacoes* banco, int categoria, uint64_t semente){
+    if (banco == NULL) return NULL;
+    SorteadorItens* sorteador = calloc(1, sizeof(SorteadorItens));
+    if (sorteador == NULL){
+        printf("[Erro] Houve um erro na alocação de memória para o sorteador.\n");
+        return NULL;
+    }
+    sorteador->banco = banco;
+    sorteador->categoria = categoria;
+    iniciarGerador(&sorteador->gerador, semente);
+    if (montarSacolas(sorteador) != 0){
+        liberarSorteador(sorteador);
+        return NULL;
+    }
+    return sorteador;
+}
+
+/**
+ * @brief Devolve à sacola todos os itens já sorteados, exceto o último.
+ *
+ * O último item sorteado é deixado na parte "já sorteada" da sua sacola, para
+ * que ele não saia duas vezes seguidas na virada da volta.
+ */
+static void reabastecerSacolas(SorteadorItens* sorteador, int nivelMinimo, int nivelMaximo){
+    for (int n = nivelMinimo; n <= nivelMaximo; n++){
+        SacolaNivel* sacola = &sorteador->sacolas[n - 1];
+        sacola->restantes = sacola->total;
+        if (sorteador->ultimoSorteado < 0 || sacola->total < 2) continue;
+        for (int p = 0; p < sacola->total; p++){
+            if (sacola->itens[p] == sorteador->ultimoSorteado){
+                sacola->itens[p] = sacola->itens[sacola->total - 1];
+                sacola->itens[sacola->total - 1] = sorteador->ultimoSorteado;
+                sacola->restantes--;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Sorteia, sem repetição, um item com nível entre nivelMinimo e nivelMaximo.
+ *
+ * A escolha é uniforme entre os itens da faixa que ainda não saíram nesta
+ * volta; quando todos já saíram, as sacolas da faixa são reabastecidas.
+ *
+ * @param sorteador Sorteador da sessão.
+ * @param nivelMinimo Menor nível aceito (1 a 5).
+ * @param nivelMaximo Maior nível aceito (1 a 5).
+ * @return Item* Item sorteado, ou NULL se não houver itens na faixa.
+ */
+Item* sortearItem(SorteadorItens* sorteador, int nivelMinimo, int nivelMaximo){
+    if (sorteador == NULL) return NULL;
+    if (nivelMinimo < MUITOFACIL) nivelMinimo = MUITOFACIL;
+    if (nivelMaximo > MUITODIFICIL) nivelMaximo = MUITODIFICIL;
+    if (nivelMinimo > nivelMaximo) return NULL;
+    // O banco foi compactado: as posições guardadas nas sacolas não valem mais
+    if (sorteador->geracao != sorteador->banco->geracao && montarSacolas(sorteador) != 0) return NULL;
+
+    for (;;){
+        uint32_t restantes = 0, total = 0;
+        for (int n = nivelMinimo; n <= nivelMaximo; n++){
+            restantes += (uint32_t)sorteador->sacolas[n - 1].restantes;
+            total += (uint32_t)sorteador->sacolas[n - 1].total;
+        }
+        if (total == 0) return NULL;
+        if (restantes == 0){
+            // Fim da volta: no máximo o último item sorteado fica de fora (nunca todos)
+            reabastecerSacolas(sorteador, nivelMinimo, nivelMaximo);
+            sorteador->totalSorteados = -1;
+            for (int n = nivelMinimo; n <= nivelMaximo; n++){
+                restantes += (uint32_t)sorteador->sacolas[n - 1].restantes;
+            }
+        }
+
+        uint32_t sorteio = aleatorioAte(&sorteador->gerador, restantes);
+        int n = nivelMinimo;
+        while (sorteio >= (uint32_t)sorteador->sacolas[n - 1].restantes){
+            sorteio -= (uint32_t)sorteador->sacolas[n - 1].restantes;
+            n++;
+        }
+
+        SacolaNivel* sacola = &sorteador->sacolas[n - 1];
+        int ultima = sacola->restantes - 1;
+        int32_t escolhido = sacola->itens[sorteio];
+        if (sorteador->banco->itens[escolhido].marcas & ITEM_EXCLUIDO){
+            // Excluído depois de montada a sacola: sai dela de vez e o sorteio é refeito
+            sacola->itens[sorteio] = sacola->itens[ultima];
+            sacola->itens[ultima] = sacola->itens[sacola->total - 1];
+            sacola->restantes--;
+            sacola->total--;
+            sorteador->totalSorteados = -1;
+            continue;
+        }
+        sacola->itens[sorteio] = sacola->itens[ultima];
+        sacola->itens[ultima] = escolhido;
+        sacola->restantes--;
+        if (sorteador->totalSorteados >= 0 && sorteador->totalSorteados < MAX_DESFAZER_SORTEIO){
+            sorteador->posicoesSorteadas[sorteador->totalSorteados] = (int32_t)sorteio;
+            sorteador->niveisSorteados[sorteador->totalSorteados] = (uint8_t)n;
+            sorteador->totalSorteados++;
+        } else {
+            sorteador->totalSorteados = -1;
+        }
+
+        sorteador->ultimoSorteado = escolhido;
+        return &sorteador->banco->itens[escolhido];
+    }
+}
+
+/**
+ * @brief Volta o sorteador ao estado de recém-criado, com uma nova semente.
+ *
+ * Depois da chamada, os sorteios são os mesmos de um criarSorteador() com a
+ * mesma semente, não importa o que foi sorteado antes. Até MAX_DESFAZER_SORTEIO
+ * sorteios são desfeitos de trás para a frente, sem tocar no resto das
+ * sacolas; depois de mais que isso, de uma volta completa, de um item excluído
+ * ou de uma compactação, as sacolas são montadas de novo a partir do banco.
+ *
+ * @param sorteador Sorteador a reiniciar.
+ * @param semente Nova semente do gerador.
+ * @return int 0 em caso de sucesso, -1 se faltar memória.
+ */
+int reiniciarSorteador(SorteadorItens* sorteador, uint64_t semente){
+    if (sorteador == NULL) return -1;
+    iniciarGerador(&sorteador->gerador, semente);
+    if (sorteador->totalSorteados < 0 || sorteador->geracao != sorteador->banco->geracao){
+        return montarSacolas(sorteador);
+    }
+    for (int s = sorteador->totalSorteados - 1; s >= 0; s--){
+        SacolaNivel* sacola = &sorteador->sacolas[sorteador->niveisSorteados[s] - 1];
+        int32_t posicao = sorteador->posicoesSorteadas[s];
+        int32_t sorteado = sacola->itens[sacola->restantes];
+        sacola->itens[sacola->restantes] = sacola->itens[posicao];
+        sacola->itens[posicao] = sorteado;
+        sacola->restantes++;
+    }
+    sorteador->totalSorteados = 0;
+    sorteador->ultimoSorteado = -1;
+    return 0;
+}
+
+/**
+ * @brief Libera a memória de um sorteador.
+ */
+void liberarSorteador(SorteadorItens* sorteador){
+    if (sorteador == NULL) return;
+    for (int n = 0; n < NUM_NIVEIS; n++){
+        free(sorteador->sacolas[n].itens);
+    }
+    free(sorteador);
+}
@@ -0,0 +1,93 @@
+/**
+ * @file teste_duplicatas.c
+ * @brief Teste de regressão da detecção de duplicatas na importação (make teste).
+ *
+ * Importa pequenos CSVs com carregarCSV() em cada política e confere quais
+ * respostas ficaram no banco. Sai com código diferente de 0 se algum caso falhar.
+ *
+ * @date 2025-12-03
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "funcoes.h"
+
+#define ARQUIVO_TESTE "teste_duplicatas.csv"
+
+/**
+ * @brief Um CSV de teste e os itens (resposta e duas primeiras dicas) esperados depois de importá-lo.
+ */
+typedef struct{
+    const char* descricao;
+    PoliticaDuplicatas politica;
+    const char* linhas;         // Sem o cabeçalho
+    const char* esperado;       // "resposta/dica1/dica2" de cada item, separados por '|', na ordem do banco
+}CasoDuplicatas;
+
+static const CasoDuplicatas casos[] = {
+    // Uma cópia descartada pelas dicas não pode servir de original para uma resposta igual mais abaixo
+    {"cópia pelas dicas não vira original (rejeitar)", DUPLICATAS_REJEITAR,
+     "alfa;1;pedra;vermelha;;;\nbeta;1;pedra;vermelha;;;\nbeta;2;verde;folha;;;\ngama;3;azul;ceu;;;\n",
+     "alfa/pedra/vermelha|beta/verde/folha|gama/azul/ceu"},
+    {"cópia pelas dicas não vira original (mesclar)", DUPLICATAS_MESCLAR,
+     "alfa;1;pedra;vermelha;;;\nbeta;1;pedra;vermelha;;;\nbeta;2;verde;folha;;;\ngama;3;azul;ceu;;;\n",
+     "alfa/pedra/vermelha|beta/verde/folha|gama/azul/ceu"},
+    {"manter guarda todas as cópias", DUPLICATAS_MANTER,
+     "alfa;1;pedra;vermelha;;;\nbeta;1;pedra;vermelha;;;\nbeta;2;verde;folha;;;\ngama;3;azul;ceu;;;\n",
+     "alfa/pedra/vermelha|beta/pedra/vermelha|beta/verde/folha|gama/azul/ceu"},
+    // "um" já está no original: só "dois" vai para a primeira posição vazia
+    {"mesclar leva as dicas da cópia para o original", DUPLICATAS_MESCLAR,
+     "Delta;1;um;;;;\ndelta!;2;dois;um;;;\n",
+     "Delta/um/dois"},
+    // Dicas só iguais sem diferenciar maiúsculas ASCII; pontuação diferente não é duplicata
+    {"dicas iguais a menos de maiúsculas", DUPLICATAS_REJEITAR,
+     "epsilon;1;Pedra;Vermelha;;;\nzeta;1;PEDRA;vermelha;;;\neta;1;Pedra;Vermelha!;;;\n",
+     "epsilon/Pedra/Vermelha|eta/Pedra/Vermelha!"},
+};
+
+/**
+ * @brief Importa um caso e compara as respostas do banco com as esperadas.
+ *
+ * @return int 0 se o banco ficou como esperado, 1 se não.
+ */
+static int executarCaso(const CasoDuplicatas* caso){
+    FILE* arquivo = fopen(ARQUIVO_TESTE, "w");
+    if (arquivo == NULL) return 1;
+    fprintf(arquivo, "Resposta;Nivel;Dica1;Dica2;Dica3;Dica4;Dica5\n%s", caso->linhas);
+    fclose(arquivo);
+
+    definirPoliticaDuplicatas(caso->politica);
+    BancoInformacoes* banco = inicializarBanco();
+    if (banco == NULL || carregarCSV(banco, ARQUIVO_TESTE) < 0){
+        remove(ARQUIVO_TESTE);
+        liberarBanco(banco);
+        return 1;
+    }
+    remove(ARQUIVO_TESTE);
+
+    char obtido[1024] = "";
+    char dica1[TAM_MAX_DICA], dica2[TAM_MAX_DICA];
+    for (int i = 0; i < banco->totalItens; i++){
+        const Item* item = &banco->itens[i];
+        if (item->marcas & ITEM_EXCLUIDO) continue;
+        copiarDica(banco, item, 1, dica1, sizeof(dica1));
+        copiarDica(banco, item, 2, dica2, sizeof(dica2));
+        size_t usado = strlen(obtido);
+        snprintf(obtido + usado, sizeof(obtido) - usado, "%s%s/%s/%s", usado ? "|" : "", obterResposta(banco, item),
+                 dica1, dica2);
+    }
+    liberarBanco(banco);
+
+    int falhou = strcmp(obtido, caso->esperado) != 0;
+    if (falhou) printf("[Erro] %s: esperado '%s', obtido '%s'.\n", caso->descricao, caso->esperado, obtido);
+    else printf("[OK] %s.\n", caso->descricao);
+    return falhou;
+}
+
+int main(void){
+    int falhas = 0;
+    int total = (int)(sizeof(casos) / sizeof(casos[0]));
+    for (int c = 0; c < total; c++) falhas += executarCaso(&casos[c]);
+    printf("%s %d de %d caso(s) de duplicatas passaram.\n", falhas ? "[Erro]" : "[OK]", total - falhas, total);
+    return falhas ? 1 : 0;
+}